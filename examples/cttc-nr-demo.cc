@@ -109,6 +109,15 @@ main (int argc, char *argv[])
   std::string simTag = "default";
   std::string outputDir = "./";
 
+  // Print the DCI allocation counters at the end of the simulation
+  bool printDciStats = false;
+
+  // Let idle UEs stop their slot loop, and print the events saved
+  bool idleSlotElision = false;
+
+  // Print how long the installation of the devices took
+  bool printInstallProfile = false;
+
   /*
    * From here, we instruct the ns3::CommandLine class of all the input parameters
    * that we may accept as input, as well as their description, and the storage
@@ -172,6 +181,17 @@ main (int argc, char *argv[])
   cmd.AddValue ("outputDir",
                 "directory where to store simulation results",
                 outputDir);
+  cmd.AddValue ("printDciStats",
+                "Print, at the end of the simulation, how many DCIs were created "
+                "and how many memory blocks were requested to the system for them",
+                printDciStats);
+  cmd.AddValue ("idleSlotElision",
+                "Let the UE PHYs stop their slot loop when idle, and print at the "
+                "end of the simulation how many slot events were not scheduled",
+                idleSlotElision);
+  cmd.AddValue ("printInstallProfile",
+                "Print the time spent installing the devices, per installation phase",
+                printInstallProfile);
 
 
   // Parse the command line
@@ -206,6 +226,7 @@ main (int argc, char *argv[])
    * the instances of SetDefault, but we need it for legacy code (LTE)
    */
   Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (999999999));
+  Config::SetDefault ("ns3::NrUePhy::IdleSlotElision", BooleanValue (idleSlotElision));
 
   /*
    * Create the scenario. In our examples, we heavily use helpers that setup
@@ -412,6 +433,11 @@ main (int argc, char *argv[])
   NetDeviceContainer ueLowLatNetDev = nrHelper->InstallUeDevice (ueLowLatContainer, allBwps);
   NetDeviceContainer ueVoiceNetDev = nrHelper->InstallUeDevice (ueVoiceContainer, allBwps);
 
+  if (printInstallProfile)
+    {
+      nrHelper->PrintInstallProfile (std::cout);
+    }
+
   randomStream += nrHelper->AssignStreams (enbNetDev, randomStream);
   randomStream += nrHelper->AssignStreams (ueLowLatNetDev, randomStream);
   randomStream += nrHelper->AssignStreams (ueVoiceNetDev, randomStream);
@@ -684,6 +710,34 @@ main (int argc, char *argv[])
       std::cout << f.rdbuf ();
     }
 
+  if (printDciStats)
+    {
+      // Without the pool, each DCI would cost at least one allocation, plus
+      // one for each per-stream vector (MCS, TBS, NDI, RV) of DATA and SRS DCIs
+      double simSeconds = simTime.GetSeconds ();
+      std::cout << "\n  DCIs created per simulated second: "
+                << NrDciPool::GetTotalCreated () / simSeconds << "\n"
+                << "  DCI heap allocations per simulated second: "
+                << NrDciPool::GetTotalHeapAllocations () / simSeconds << std::endl;
+    }
+
+  if (idleSlotElision)
+    {
+      uint64_t elidedEvents = 0;
+      for (const auto & devices : {ueLowLatNetDev, ueVoiceNetDev})
+        {
+          for (auto it = devices.Begin (); it != devices.End (); ++it)
+            {
+              uint32_t bwps = DynamicCast<NrUeNetDevice> (*it)->GetCcMapSize ();
+              for (uint32_t bwpId = 0; bwpId < bwps; ++bwpId)
+                {
+                  elidedEvents += NrHelper::GetUePhy (*it, bwpId)->GetElidedEventsCount ();
+                }
+            }
+        }
+      std::cout << "\n  UE slot events not scheduled: " << elidedEvents << std::endl;
+    }
+
   Simulator::Destroy ();
   return 0;
 }
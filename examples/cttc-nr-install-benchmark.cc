@@ -0,0 +1,176 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-install-benchmark.cc
+ * \brief Benchmark of the installation of the NR devices
+ *
+ * The program installs a few gNBs and many UEs (2000 by default), with one
+ * or more BWPs each, and prints how long NrHelper::InstallGnbDevice and
+ * NrHelper::InstallUeDevice took, followed by NrHelper::PrintInstallProfile.
+ * The program replaces the global operator new, to count the heap
+ * allocations, and passes its counter to the helper, so that the profile
+ * also reports the allocations of each installation phase.
+ *
+ * No simulation is run: the program stops after the installation.
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-install-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrInstallBenchmark");
+
+/// Number of calls to the global operator new
+static std::atomic<uint64_t> g_allocations {0};
+
+void *
+operator new (std::size_t size)
+{
+  g_allocations.fetch_add (1, std::memory_order_relaxed);
+  void *p = std::malloc (size == 0 ? 1 : size);
+  if (p == nullptr)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete (void *p, [[maybe_unused]] std::size_t size) noexcept
+{
+  std::free (p);
+}
+
+/**
+ * \brief Get the number of heap allocations made so far
+ * \return the number of calls to the global operator new
+ */
+static uint64_t
+GetAllocations ()
+{
+  return g_allocations.load (std::memory_order_relaxed);
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t gnbNum = 7;
+  uint32_t ueNum = 2000;
+  uint16_t numCc = 1;
+  double centralFrequency = 3.5e9;
+  double bandwidth = 20e6;
+  bool useEpc = true;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("gnbNum",
+                "Number of gNBs",
+                gnbNum);
+  cmd.AddValue ("ueNum",
+                "Number of UEs",
+                ueNum);
+  cmd.AddValue ("numCc",
+                "Number of component carriers, each with one BWP",
+                numCc);
+  cmd.AddValue ("bandwidth",
+                "Bandwidth of the band",
+                bandwidth);
+  cmd.AddValue ("useEpc",
+                "Register the devices in the EPC",
+                useEpc);
+  cmd.Parse (argc, argv);
+
+  NodeContainer gnbContainer;
+  gnbContainer.Create (gnbNum);
+  NodeContainer ueContainer;
+  ueContainer.Create (ueNum);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  Ptr<ListPositionAllocator> gnbPositionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < gnbNum; ++i)
+    {
+      gnbPositionAlloc->Add (Vector (500.0 * i, 0.0, 25.0));
+    }
+  mobility.SetPositionAllocator (gnbPositionAlloc);
+  mobility.Install (gnbContainer);
+  Ptr<UniformDiscPositionAllocator> uePositionAlloc = CreateObject<UniformDiscPositionAllocator> ();
+  uePositionAlloc->SetRho (250.0 * gnbNum);
+  uePositionAlloc->SetX (250.0 * (gnbNum - 1));
+  uePositionAlloc->SetZ (1.5);
+  uePositionAlloc->AssignStreams (0);
+  mobility.SetPositionAllocator (uePositionAlloc);
+  mobility.Install (ueContainer);
+
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  nrHelper->SetBeamformingHelper (CreateObject<IdealBeamformingHelper> ());
+  if (useEpc)
+    {
+      nrHelper->SetEpcHelper (CreateObject<NrPointToPointEpcHelper> ());
+    }
+  nrHelper->SetInstallAllocationCounter (&GetAllocations);
+
+  CcBwpCreator ccBwpCreator;
+  CcBwpCreator::SimpleOperationBandConf bandConf (centralFrequency, bandwidth, numCc, BandwidthPartInfo::UMa);
+  OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc (bandConf);
+  nrHelper->InitializeOperationBand (&band);
+  BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps ({band});
+
+  auto start = std::chrono::steady_clock::now ();
+  uint64_t allocations = GetAllocations ();
+  NetDeviceContainer gnbNetDev = nrHelper->InstallGnbDevice (gnbContainer, allBwps);
+  std::chrono::duration<double> gnbElapsed = std::chrono::steady_clock::now () - start;
+  uint64_t gnbAllocations = GetAllocations () - allocations;
+
+  start = std::chrono::steady_clock::now ();
+  allocations = GetAllocations ();
+  NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueContainer, allBwps);
+  std::chrono::duration<double> ueElapsed = std::chrono::steady_clock::now () - start;
+  uint64_t ueAllocations = GetAllocations () - allocations;
+
+  std::cout << "gNBs:                 " << gnbNum << std::endl;
+  std::cout << "UEs:                  " << ueNum << std::endl;
+  std::cout << "BWPs per device:      " << allBwps.size () << std::endl;
+  std::cout << "gNB install:          " << gnbElapsed.count () << " s, "
+            << gnbAllocations << " allocations" << std::endl;
+  std::cout << "UE install:           " << ueElapsed.count () << " s, "
+            << ueAllocations << " allocations" << std::endl;
+  std::cout << "UE install per UE:    " << 1e6 * ueElapsed.count () / ueNum << " us, "
+            << static_cast<double> (ueAllocations) / ueNum << " allocations" << std::endl;
+  nrHelper->PrintInstallProfile (std::cout);
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,168 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-stats-sink-benchmark.cc
+ * \brief Benchmark of the NrStatsSink against the text traces
+ *
+ * The program calls the trace sinks of the PHY RX packet trace, of the gNB
+ * MAC received control messages and of the RLC DL RX statistics the given
+ * number of times each, as the simulator would do, and measures how many
+ * rows per second of wall-clock time they write:
+ *
+ * - to their text files (the default of the helper);
+ * - to a NrStatsSink that writes a SQLite database (if the simulator is
+ *   built with SQLite);
+ * - to a NrStatsSink that writes the columnar file.
+ *
+ * The time spent in Flush () and in the disposal of the sink is included.
+ * No simulation is run, so that only the cost of the output is measured.
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-stats-sink-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/nr-module.h"
+#include <chrono>
+#include <cstdio>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrStatsSinkBenchmark");
+
+/**
+ * \brief Call the trace sinks, as the simulator would do
+ * \param rows number of calls of each trace sink
+ * \param sink the sink of the traces, or nullptr for the text files
+ * \return the wall-clock time spent, in seconds
+ */
+static double
+WriteRows (uint32_t rows, const Ptr<NrStatsSink> &sink)
+{
+  Ptr<NrPhyRxTrace> phyStats = CreateObject<NrPhyRxTrace> ();
+  Ptr<NrMacRxTrace> macStats = CreateObject<NrMacRxTrace> ();
+  Ptr<NrBearerStatsSimple> rlcStats = CreateObject<NrBearerStatsSimple> ("RLC");
+  if (sink != nullptr)
+    {
+      phyStats->SetStatsSink (sink);
+      macStats->SetStatsSink (sink);
+      rlcStats->SetStatsSink (sink);
+    }
+
+  RxPacketTraceParams params;
+  params.m_cellId = 1;
+  params.m_symStart = 1;
+  params.m_numSym = 12;
+  params.m_tbSize = 1500;
+  params.m_mcs = 20;
+  params.m_rv = 0;
+  params.m_sinr = 100.0;
+  params.m_tbler = 0.01;
+  params.m_bwpId = 0;
+  params.m_streamId = 0;
+  params.m_cqi = 12;
+  Ptr<const NrControlMessage> msg = Create<NrSRMessage> ();
+
+  auto start = std::chrono::steady_clock::now ();
+  for (uint32_t i = 0; i < rows; ++i)
+    {
+      uint16_t rnti = static_cast<uint16_t> (1 + i % 100);
+      SfnSf sfn (i / 40 % 1024, static_cast<uint8_t> (i / 4 % 10),
+                 static_cast<uint8_t> (i % 4), 2);
+      params.m_rnti = rnti;
+      params.m_frameNum = sfn.GetFrame ();
+      params.m_subframeNum = sfn.GetSubframe ();
+      params.m_slotNum = sfn.GetSlot ();
+      params.m_corrupt = (i % 10 == 0);
+      NrPhyRxTrace::RxPacketTraceUeCallback (phyStats, "", params);
+      NrMacRxTrace::RxedGnbMacCtrlMsgsCallback (macStats, "", sfn, 1, rnti, 0, msg);
+      rlcStats->DlRxPdu (1, rnti, rnti, 3, 1400, 2000000);
+    }
+  if (sink != nullptr)
+    {
+      sink->Dispose ();
+    }
+  rlcStats->Dispose ();
+  macStats->Dispose ();
+  phyStats->Dispose ();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+/**
+ * \brief Open a sink on a new file
+ * \param fileName the output file, removed if it exists
+ * \param useSqlite the value of the `UseSqlite` attribute
+ * \return the open sink
+ */
+static Ptr<NrStatsSink>
+OpenSink (const std::string &fileName, bool useSqlite)
+{
+  std::remove (fileName.c_str ());
+  Ptr<NrStatsSink> sink = CreateObjectWithAttributes<NrStatsSink> ("UseSqlite",
+                                                                   BooleanValue (useSqlite));
+  sink->Open (fileName);
+  return sink;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t rows = 1000000;
+  std::string outputDir = "./";
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("rows",
+                "Number of calls of each trace sink",
+                rows);
+  cmd.AddValue ("outputDir",
+                "Directory of the database and of the columnar file",
+                outputDir);
+  cmd.Parse (argc, argv);
+
+  // Three rows for each iteration: PHY, MAC and RLC
+  const double written = 3.0 * rows;
+
+  double textElapsed = WriteRows (rows, nullptr);
+  std::cout << "Rows:                 " << static_cast<uint64_t> (written) << std::endl;
+  std::cout << "Text files:           " << textElapsed << " s, "
+            << written / textElapsed << " rows/s" << std::endl;
+
+  Ptr<NrStatsSink> sqliteSink = OpenSink (outputDir + "stats-sink-benchmark.db", true);
+  if (sqliteSink->IsSqlite ())
+    {
+      double sqliteElapsed = WriteRows (rows, sqliteSink);
+      std::cout << "SQLite sink:          " << sqliteElapsed << " s, "
+                << written / sqliteElapsed << " rows/s" << std::endl;
+    }
+  else
+    {
+      sqliteSink->Dispose ();
+      std::cout << "SQLite sink:          not available" << std::endl;
+    }
+
+  Ptr<NrStatsSink> columnarSink = OpenSink (outputDir + "stats-sink-benchmark.bin", false);
+  double columnarElapsed = WriteRows (rows, columnarSink);
+  std::cout << "Columnar sink:        " << columnarElapsed << " s, "
+            << written / columnarElapsed << " rows/s" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
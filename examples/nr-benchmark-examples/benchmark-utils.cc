@@ -0,0 +1,171 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "benchmark-utils.h"
+#include <ns3/mobility-module.h>
+#include <ns3/point-to-point-module.h>
+#include <chrono>
+
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("BenchmarkUtils");
+
+namespace ns3 {
+
+void
+BenchmarkUtils::SetDefaults ()
+{
+  Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (999999999));
+  Config::SetDefault ("ns3::ThreeGppChannelModel::UpdatePeriod", TimeValue (MilliSeconds (0)));
+}
+
+void
+BenchmarkUtils::PlaceGnbsOnRow (const NodeContainer &gnbs, double interSiteDistance)
+{
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  Ptr<ListPositionAllocator> gnbPositionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < gnbs.GetN (); ++i)
+    {
+      gnbPositionAlloc->Add (Vector (i * interSiteDistance, 0.0, 25.0));
+    }
+  mobility.SetPositionAllocator (gnbPositionAlloc);
+  mobility.Install (gnbs);
+}
+
+void
+BenchmarkUtils::PlaceUesAroundRow (const NodeContainer &ues, uint32_t gnbNum,
+                                   double interSiteDistance, int64_t stream)
+{
+  Ptr<RandomBoxPositionAllocator> uePositionAlloc = CreateObject<RandomBoxPositionAllocator> ();
+  Ptr<UniformRandomVariable> ueX = CreateObject<UniformRandomVariable> ();
+  ueX->SetAttribute ("Min", DoubleValue (-interSiteDistance / 2));
+  ueX->SetAttribute ("Max", DoubleValue ((gnbNum - 0.5) * interSiteDistance));
+  ueX->SetStream (stream);
+  Ptr<UniformRandomVariable> ueY = CreateObject<UniformRandomVariable> ();
+  ueY->SetAttribute ("Min", DoubleValue (-interSiteDistance / 2));
+  ueY->SetAttribute ("Max", DoubleValue (interSiteDistance / 2));
+  ueY->SetStream (stream + 1);
+  uePositionAlloc->SetX (ueX);
+  uePositionAlloc->SetY (ueY);
+  uePositionAlloc->SetZ (CreateObjectWithAttributes<ConstantRandomVariable> ("Constant", DoubleValue (1.5)));
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (uePositionAlloc);
+  mobility.Install (ues);
+}
+
+Ptr<NrHelper>
+BenchmarkUtils::CreateNrHelper (const Ptr<NrPointToPointEpcHelper> &epcHelper)
+{
+  Ptr<IdealBeamformingHelper> idealBeamformingHelper = CreateObject<IdealBeamformingHelper> ();
+  idealBeamformingHelper->SetAttribute ("BeamformingMethod", TypeIdValue (DirectPathBeamforming::GetTypeId ()));
+  epcHelper->SetAttribute ("S1uLinkDelay", TimeValue (MilliSeconds (0)));
+
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  nrHelper->SetBeamformingHelper (idealBeamformingHelper);
+  nrHelper->SetEpcHelper (epcHelper);
+  nrHelper->SetChannelConditionModelAttribute ("UpdatePeriod", TimeValue (MilliSeconds (0)));
+  nrHelper->SetPathlossAttribute ("ShadowingEnabled", BooleanValue (false));
+  return nrHelper;
+}
+
+BandwidthPartInfoPtrVector
+BenchmarkUtils::InitializeBand (const Ptr<NrHelper> &nrHelper, OperationBandInfo &band,
+                                double centralFrequency, double bandwidth, uint8_t numBwps)
+{
+  CcBwpCreator ccBwpCreator;
+  CcBwpCreator::SimpleOperationBandConf bandConf (centralFrequency, bandwidth, 1, BandwidthPartInfo::UMa);
+  bandConf.m_numBwp = numBwps;
+  band = ccBwpCreator.CreateOperationBandContiguousCc (bandConf);
+  nrHelper->InitializeOperationBand (&band);
+  return CcBwpCreator::GetAllBwps ({band});
+}
+
+void
+BenchmarkUtils::UpdateConfig (const NetDeviceContainer &gnbNetDev, const NetDeviceContainer &ueNetDev)
+{
+  for (auto it = gnbNetDev.Begin (); it != gnbNetDev.End (); ++it)
+    {
+      DynamicCast<NrGnbNetDevice> (*it)->UpdateConfig ();
+    }
+  for (auto it = ueNetDev.Begin (); it != ueNetDev.End (); ++it)
+    {
+      DynamicCast<NrUeNetDevice> (*it)->UpdateConfig ();
+    }
+}
+
+Ptr<Node>
+BenchmarkUtils::ConnectRemoteHost (const Ptr<NrPointToPointEpcHelper> &epcHelper,
+                                   const NodeContainer &ues,
+                                   const NetDeviceContainer &ueNetDev,
+                                   Ipv4InterfaceContainer &ueIpIface)
+{
+  Ptr<Node> pgw = epcHelper->GetPgwNode ();
+  NodeContainer remoteHostContainer;
+  remoteHostContainer.Create (1);
+  Ptr<Node> remoteHost = remoteHostContainer.Get (0);
+  InternetStackHelper internet;
+  internet.Install (remoteHostContainer);
+  PointToPointHelper p2ph;
+  p2ph.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("100Gb/s")));
+  p2ph.SetDeviceAttribute ("Mtu", UintegerValue (2500));
+  p2ph.SetChannelAttribute ("Delay", TimeValue (Seconds (0.000)));
+  NetDeviceContainer internetDevices = p2ph.Install (pgw, remoteHost);
+  Ipv4AddressHelper ipv4h;
+  ipv4h.SetBase ("1.0.0.0", "255.0.0.0");
+  ipv4h.Assign (internetDevices);
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  Ptr<Ipv4StaticRouting> remoteHostStaticRouting = ipv4RoutingHelper.GetStaticRouting (remoteHost->GetObject<Ipv4> ());
+  remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"), 1);
+
+  internet.Install (ues);
+  ueIpIface = epcHelper->AssignUeIpv4Address (ueNetDev);
+  for (uint32_t u = 0; u < ues.GetN (); ++u)
+    {
+      Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ues.Get (u)->GetObject<Ipv4> ());
+      ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+    }
+  return remoteHost;
+}
+
+Ipv4Address
+BenchmarkUtils::GetRemoteHostAddress (const Ptr<Node> &remoteHost)
+{
+  // Interface 0 is the loopback, 1 the link to the PGW
+  return remoteHost->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ();
+}
+
+double
+BenchmarkUtils::Run (Time simTime)
+{
+  Simulator::Stop (simTime);
+  auto start = std::chrono::steady_clock::now ();
+  Simulator::Run ();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+  return elapsed.count ();
+}
+
+std::string
+BenchmarkUtils::PadLabel (const std::string &label)
+{
+  std::string padded = label + ":";
+  padded.resize (std::max<std::size_t> (padded.size () + 1, 22), ' ');
+  return padded;
+}
+
+} // namespace ns3
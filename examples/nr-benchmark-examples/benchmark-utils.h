@@ -0,0 +1,149 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef NR_BENCHMARK_UTILS_H
+#define NR_BENCHMARK_UTILS_H
+
+#include <ns3/nr-module.h>
+#include <ns3/internet-module.h>
+#include <iostream>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * \ingroup examples
+ * \brief Scaffolding shared by the benchmark examples
+ *
+ * The benchmarks build the same kind of network: gNBs and UEs with constant
+ * positions, an ideal direct-path beamforming, no shadowing and no channel
+ * update, and a remote host behind the EPC. They time Simulator::Run () and
+ * print their results as aligned "Label: value" lines. Only what changes
+ * from one benchmark to another (the scheduler, the antennas, the traffic,
+ * the traces) is left to each program.
+ */
+class BenchmarkUtils
+{
+public:
+  /**
+   * \brief Set the defaults shared by the benchmarks: an unlimited RLC UM
+   * buffer, and no update of the 3GPP channel
+   */
+  static void SetDefaults ();
+
+  /**
+   * \brief Place the gNBs on a row, along the x axis, at a height of 25 m
+   * \param gnbs the gNBs
+   * \param interSiteDistance the distance between two neighbour gNBs, in m
+   */
+  static void PlaceGnbsOnRow (const NodeContainer &gnbs, double interSiteDistance);
+
+  /**
+   * \brief Drop the UEs uniformly in the rectangle around a row of gNBs
+   * placed by PlaceGnbsOnRow (), at a height of 1.5 m
+   * \param ues the UEs
+   * \param gnbNum the number of gNBs of the row
+   * \param interSiteDistance the distance between two neighbour gNBs, in m
+   * \param stream the first random stream to use; two streams are used
+   */
+  static void PlaceUesAroundRow (const NodeContainer &ues, uint32_t gnbNum,
+                                 double interSiteDistance, int64_t stream);
+
+  /**
+   * \brief Create the NR helper of a benchmark
+   * \param epcHelper the EPC helper
+   * \return the helper, with an ideal direct-path beamforming, no
+   * shadowing, no channel condition update and no S1-U delay
+   */
+  static Ptr<NrHelper> CreateNrHelper (const Ptr<NrPointToPointEpcHelper> &epcHelper);
+
+  /**
+   * \brief Create a band with one CC in the UMa scenario, and initialize it
+   * \param nrHelper the NR helper
+   * \param band the band to fill; it owns the BWPs, so it must outlive them
+   * \param centralFrequency the central frequency of the band
+   * \param bandwidth the bandwidth of the band
+   * \param numBwps the number of BWPs of the CC
+   * \return all the BWPs of the band
+   */
+  static BandwidthPartInfoPtrVector InitializeBand (const Ptr<NrHelper> &nrHelper,
+                                                    OperationBandInfo &band,
+                                                    double centralFrequency,
+                                                    double bandwidth, uint8_t numBwps = 1);
+
+  /**
+   * \brief Apply the configuration of the devices, once their attributes are set
+   * \param gnbNetDev the gNB devices
+   * \param ueNetDev the UE devices
+   */
+  static void UpdateConfig (const NetDeviceContainer &gnbNetDev, const NetDeviceContainer &ueNetDev);
+
+  /**
+   * \brief Create a remote host behind the EPC, and give the UEs an IP
+   * stack, an address and a default route through the EPC
+   * \param epcHelper the EPC helper
+   * \param ues the UEs
+   * \param ueNetDev the devices of the UEs
+   * \param ueIpIface the IP interfaces of the UEs, filled by the function
+   * \return the remote host
+   */
+  static Ptr<Node> ConnectRemoteHost (const Ptr<NrPointToPointEpcHelper> &epcHelper,
+                                      const NodeContainer &ues,
+                                      const NetDeviceContainer &ueNetDev,
+                                      Ipv4InterfaceContainer &ueIpIface);
+
+  /**
+   * \brief Get the address of the remote host created by ConnectRemoteHost ()
+   * \param remoteHost the remote host
+   * \return its address on the link to the PGW
+   */
+  static Ipv4Address GetRemoteHostAddress (const Ptr<Node> &remoteHost);
+
+  /**
+   * \brief Run the simulation until the given time
+   * \param simTime the simulation time
+   * \return the wall-clock time spent in Simulator::Run (), in seconds
+   */
+  static double Run (Time simTime);
+
+  /**
+   * \brief Print a result as an aligned "Label: value" line
+   * \param label the label, without the colon
+   * \param value the value
+   * \param unit the unit, if any, printed after the value
+   */
+  template <typename T>
+  static void PrintResult (const std::string &label, const T &value, const std::string &unit = "")
+  {
+    std::cout << PadLabel (label) << value;
+    if (!unit.empty ())
+      {
+        std::cout << " " << unit;
+      }
+    std::cout << std::endl;
+  }
+
+private:
+  /**
+   * \param label the label, without the colon
+   * \return the label, with the colon, padded so that the values are aligned
+   */
+  static std::string PadLabel (const std::string &label);
+};
+
+} // namespace ns3
+
+#endif // NR_BENCHMARK_UTILS_H
@@ -0,0 +1,115 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-bearer-stats-benchmark.cc
+ * \brief Throughput of the PDU callbacks of NrBearerStatsCalculator
+ *
+ * The program calls the PDU callbacks of an RLC NrBearerStatsCalculator, as
+ * the RLC traces of `ueNum` UEs (100 by default) with `lcNum` logical
+ * channels each would do: for every PDU, DlTxPdu, DlRxPdu, UlTxPdu and
+ * UlRxPdu, over the bearers in turn. No simulation is run, so that only the
+ * cost of the callbacks is measured; the results of the single epoch are
+ * written when the calculator is disposed, out of the timed part.
+ *
+ * The program prints the number of callbacks per second of wall-clock time:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-bearer-stats-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/nr-module.h"
+#include "benchmark-utils.h"
+#include <chrono>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrBearerStatsBenchmark");
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t ueNum = 100;
+  uint32_t lcNum = 2;
+  uint32_t pdusPerBearer = 10000;
+  bool delayHistogram = false;
+  std::string outputDir = "./";
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("ueNum",
+                "Number of UEs",
+                ueNum);
+  cmd.AddValue ("lcNum",
+                "Number of logical channels of each UE",
+                lcNum);
+  cmd.AddValue ("pdusPerBearer",
+                "Number of PDUs of each bearer, in each direction",
+                pdusPerBearer);
+  cmd.AddValue ("delayHistogram",
+                "If true, the calculator also keeps the delay histograms",
+                delayHistogram);
+  cmd.AddValue ("outputDir",
+                "Directory of the statistics files",
+                outputDir);
+  cmd.Parse (argc, argv);
+
+  Ptr<NrBearerStatsCalculator> calculator = CreateObject<NrBearerStatsCalculator> ("RLC");
+  calculator->SetAttribute ("DelayHistogram", BooleanValue (delayHistogram));
+  calculator->SetAttribute ("DlRlcOutputFilename", StringValue (outputDir + "NrDlRlcStatsBenchmark.txt"));
+  calculator->SetAttribute ("UlRlcOutputFilename", StringValue (outputDir + "NrUlRlcStatsBenchmark.txt"));
+
+  // Ten UEs per cell, with RNTIs from 1 in each cell; the LCIDs of the data
+  // bearers start from 3
+  const uint32_t uesPerCell = 10;
+  uint64_t callbacks = 0;
+  auto start = std::chrono::steady_clock::now ();
+  for (uint32_t pdu = 0; pdu < pdusPerBearer; ++pdu)
+    {
+      for (uint32_t ue = 0; ue < ueNum; ++ue)
+        {
+          uint16_t cellId = static_cast<uint16_t> (1 + ue / uesPerCell);
+          uint64_t imsi = 1 + ue;
+          uint16_t rnti = static_cast<uint16_t> (1 + ue % uesPerCell);
+          uint32_t packetSize = 100 + (pdu + ue) % 1400;
+          uint64_t delay = 1000000 + 1000 * ((pdu + ue) % 500); // ns
+          for (uint32_t lc = 0; lc < lcNum; ++lc)
+            {
+              uint8_t lcid = static_cast<uint8_t> (3 + lc);
+              calculator->DlTxPdu (cellId, imsi, rnti, lcid, packetSize);
+              calculator->DlRxPdu (cellId, imsi, rnti, lcid, packetSize, delay);
+              calculator->UlTxPdu (cellId, imsi, rnti, lcid, packetSize);
+              calculator->UlRxPdu (cellId, imsi, rnti, lcid, packetSize, delay);
+              callbacks += 4;
+            }
+        }
+    }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+
+  calculator->Dispose ();
+
+  BenchmarkUtils::PrintResult ("UEs", ueNum);
+  BenchmarkUtils::PrintResult ("Bearers", ueNum * lcNum);
+  BenchmarkUtils::PrintResult ("Callbacks", callbacks);
+  BenchmarkUtils::PrintResult ("Wall-clock time", elapsed.count (), "s");
+  BenchmarkUtils::PrintResult ("Callbacks/s", callbacks / elapsed.count ());
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,344 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-bwp-tx-opportunity-benchmark.cc
+ * \brief Benchmark of the routing of the TX opportunities among BWPs
+ *
+ * A row of gNBs serves many UEs (500 by default). Each UE has four dedicated
+ * bearers with DL UDP traffic, and the BWP managers route two of them to
+ * the first BWP and two to the second one. Every RLC TX opportunity given by
+ * the MAC of a BWP goes through BwpManagerGnb before reaching its RLC.
+ *
+ * At the end, the program prints the number of DL DCIs of each BWP, the
+ * number of RLC PDUs built on the TX opportunities, and the TX opportunities
+ * per second of wall-clock time spent in Simulator::Run ().
+ *
+ * Then, BwpManagerGnb::DoNotifyTxOpportunity is timed in isolation: a
+ * standalone BwpManagerGnb is given the same UEs and bearers, with RLC
+ * stubs that only count their calls, and the MAC side of its SAP is called
+ * `dispatchCalls` times, cycling over all the bearers. The program prints
+ * the time per dispatch, and its share of Simulator::Run (), estimated as
+ * the number of RLC PDUs times the time per dispatch. The share is a lower
+ * bound, as the TX opportunities that do not produce a PDU are not counted:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-bwp-tx-opportunity-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/antenna-module.h"
+#include "ns3/lte-ccm-rrc-sap.h"
+#include "ns3/lte-enb-rrc.h"
+#include "ns3/lte-mac-sap.h"
+#include "benchmark-utils.h"
+#include <chrono>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrBwpTxOpportunityBenchmark");
+
+/**
+ * \brief Count the DL DCIs of each BWP, reported by NrGnbMac one stream at a time
+ * \param dcis the DCIs of each BWP
+ * \param info the scheduling information of one stream of a DCI
+ */
+static void
+NotifyDlScheduling (std::vector<uint64_t> *dcis, NrSchedulingCallbackInfo info)
+{
+  if (info.m_streamId == 0 && info.m_bwpId < dcis->size ())
+    {
+      dcis->at (info.m_bwpId)++;
+    }
+}
+
+/**
+ * \brief Count an RLC PDU built on a TX opportunity
+ * \param counter the counter
+ * \param rnti the RNTI of the UE
+ * \param lcid the LCID of the bearer
+ * \param bytes the size of the PDU
+ */
+static void
+NotifyRlcTxPdu (uint64_t *counter, [[maybe_unused]] uint16_t rnti,
+                [[maybe_unused]] uint8_t lcid, [[maybe_unused]] uint32_t bytes)
+{
+  (*counter)++;
+}
+
+/**
+ * \brief Connect the RLC PDU traces of the gNBs, once the bearers exist
+ * \param counter the counter
+ */
+static void
+ConnectRlcTraces (uint64_t *counter)
+{
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/LteEnbRrc/UeMap/*/DataRadioBearerMap/*/LteRlc/TxPDU",
+                                 MakeBoundCallback (&NotifyRlcTxPdu, counter));
+}
+
+/**
+ * \brief RLC stub that only counts its TX opportunities
+ */
+class CountingMacSapUser : public LteMacSapUser
+{
+public:
+  void NotifyTxOpportunity ([[maybe_unused]] TxOpportunityParameters params) override
+  {
+    ++m_txOpportunities;
+  }
+  void NotifyHarqDeliveryFailure () override
+  {
+  }
+  void ReceivePdu ([[maybe_unused]] ReceivePduParameters params) override
+  {
+  }
+
+  uint64_t m_txOpportunities {0}; //!< Number of TX opportunities received
+};
+
+/**
+ * \brief Time BwpManagerGnb::DoNotifyTxOpportunity alone
+ * \param ueNum number of UEs
+ * \param qcis the QCI of each dedicated bearer of a UE
+ * \param numBwps number of BWPs
+ * \param calls number of TX opportunities to dispatch
+ * \return the wall-clock time of a dispatch, in seconds
+ */
+static double
+TimeTxOpportunityDispatch (uint32_t ueNum, const std::vector<EpsBearer::Qci> &qcis,
+                           uint8_t numBwps, uint64_t calls)
+{
+  Ptr<BwpManagerGnb> bwpManager = CreateObject<BwpManagerGnb> ();
+  bwpManager->SetNumberOfComponentCarriers (numBwps);
+  LteCcmRrcSapProvider *ccmRrcSapProvider = bwpManager->GetLteCcmRrcSapProvider ();
+
+  // One RLC stub per bearer, as the real RLC instances are one per bearer
+  std::vector<CountingMacSapUser> rlcs (ueNum * qcis.size ());
+  std::vector<LteMacSapUser::TxOpportunityParameters> txOps;
+  txOps.reserve (rlcs.size ());
+  LteMacSapUser *bwpManagerMacSapUser = nullptr;
+  for (uint32_t u = 0; u < ueNum; ++u)
+    {
+      uint16_t rnti = static_cast<uint16_t> (u + 1);
+      ccmRrcSapProvider->AddUe (rnti, UeManager::CONNECTED_NORMALLY);
+      for (uint32_t b = 0; b < qcis.size (); ++b)
+        {
+          uint8_t lcid = static_cast<uint8_t> (3 + b);
+          std::vector<LteCcmRrcSapProvider::LcsConfig> lcsConfig =
+            ccmRrcSapProvider->SetupDataRadioBearer (EpsBearer (qcis.at (b)), static_cast<uint8_t> (b + 1),
+                                                     rnti, lcid, 1,
+                                                     &rlcs.at (u * qcis.size () + b));
+          bwpManagerMacSapUser = lcsConfig.at (0).msu;
+
+          LteMacSapUser::TxOpportunityParameters txOp;
+          txOp.bytes = 100;
+          txOp.layer = 0;
+          txOp.harqId = 0;
+          txOp.componentCarrierId = b % numBwps;
+          txOp.rnti = rnti;
+          txOp.lcid = lcid;
+          txOps.push_back (txOp);
+        }
+    }
+
+  auto start = std::chrono::steady_clock::now ();
+  for (uint64_t i = 0, j = 0; i < calls; ++i)
+    {
+      bwpManagerMacSapUser->NotifyTxOpportunity (txOps[j]);
+      j = (j + 1 == txOps.size ()) ? 0 : j + 1;
+    }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+
+  uint64_t delivered = 0;
+  for (const auto & rlc : rlcs)
+    {
+      delivered += rlc.m_txOpportunities;
+    }
+  NS_ABORT_MSG_IF (delivered != calls, "Some TX opportunities were not delivered to their RLC");
+
+  bwpManager->Dispose ();
+  return elapsed.count () / calls;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t gnbNum = 5;
+  uint32_t ueNum = 500;
+  double interSiteDistance = 200.0; // m
+  uint16_t numerology = 1;
+  double centralFrequency = 3.5e9;
+  double bandwidth = 100e6;
+  uint32_t udpPacketSize = 100;
+  Time packetInterval = MilliSeconds (2);
+  Time appStartTime = MilliSeconds (400);
+  Time simTime = MilliSeconds (1000);
+  uint64_t dispatchCalls = 10000000;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("gnbNum",
+                "Number of gNBs, on a row",
+                gnbNum);
+  cmd.AddValue ("ueNum",
+                "Number of UEs, dropped around the gNBs",
+                ueNum);
+  cmd.AddValue ("interSiteDistance",
+                "Distance between two neighbour gNBs, in m",
+                interSiteDistance);
+  cmd.AddValue ("numerology",
+                "The numerology to be used in both BWPs",
+                numerology);
+  cmd.AddValue ("bandwidth",
+                "The system bandwidth, split in two BWPs",
+                bandwidth);
+  cmd.AddValue ("packetInterval",
+                "Interval between the DL UDP packets of each bearer",
+                packetInterval);
+  cmd.AddValue ("simTime",
+                "Simulation time",
+                simTime);
+  cmd.AddValue ("dispatchCalls",
+                "Number of TX opportunities dispatched by the isolated BWP manager",
+                dispatchCalls);
+  cmd.Parse (argc, argv);
+
+  BenchmarkUtils::SetDefaults ();
+
+  NodeContainer gnbContainer;
+  gnbContainer.Create (gnbNum);
+  NodeContainer ueContainer;
+  ueContainer.Create (ueNum);
+
+  BenchmarkUtils::PlaceGnbsOnRow (gnbContainer, interSiteDistance);
+  BenchmarkUtils::PlaceUesAroundRow (ueContainer, gnbNum, interSiteDistance, 0);
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<NrHelper> nrHelper = BenchmarkUtils::CreateNrHelper (epcHelper);
+
+  // One CC with two BWPs
+  OperationBandInfo band;
+  BandwidthPartInfoPtrVector allBwps = BenchmarkUtils::InitializeBand (nrHelper, band, centralFrequency, bandwidth, 2);
+
+  nrHelper->SetSchedulerTypeId (TypeId::LookupByName ("ns3::NrMacSchedulerOfdmaRR"));
+
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbAntennaAttribute ("NumRows", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("NumColumns", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+
+  // Two bearers in each BWP
+  const std::vector<EpsBearer::Qci> qcis {EpsBearer::NGBR_LOW_LAT_EMBB, EpsBearer::GBR_CONV_VOICE,
+                                          EpsBearer::NGBR_VIDEO_TCP_PREMIUM, EpsBearer::NGBR_VOICE_VIDEO_GAMING};
+  nrHelper->SetGnbBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+  nrHelper->SetGnbBwpManagerAlgorithmAttribute ("GBR_CONV_VOICE", UintegerValue (1));
+  nrHelper->SetGnbBwpManagerAlgorithmAttribute ("NGBR_VIDEO_TCP_PREMIUM", UintegerValue (0));
+  nrHelper->SetGnbBwpManagerAlgorithmAttribute ("NGBR_VOICE_VIDEO_GAMING", UintegerValue (1));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("GBR_CONV_VOICE", UintegerValue (1));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("NGBR_VIDEO_TCP_PREMIUM", UintegerValue (0));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("NGBR_VOICE_VIDEO_GAMING", UintegerValue (1));
+
+  NetDeviceContainer gnbNetDev = nrHelper->InstallGnbDevice (gnbContainer, allBwps);
+  NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueContainer, allBwps);
+
+  int64_t randomStream = 2;
+  randomStream += nrHelper->AssignStreams (gnbNetDev, randomStream);
+  randomStream += nrHelper->AssignStreams (ueNetDev, randomStream);
+
+  for (uint32_t i = 0; i < gnbNetDev.GetN (); ++i)
+    {
+      for (uint32_t bwpId = 0; bwpId < allBwps.size (); ++bwpId)
+        {
+          nrHelper->GetGnbPhy (gnbNetDev.Get (i), bwpId)->SetAttribute ("Numerology", UintegerValue (numerology));
+        }
+    }
+
+  BenchmarkUtils::UpdateConfig (gnbNetDev, ueNetDev);
+
+  Ipv4InterfaceContainer ueIpIface;
+  Ptr<Node> remoteHost = BenchmarkUtils::ConnectRemoteHost (epcHelper, ueContainer, ueNetDev, ueIpIface);
+
+  nrHelper->AttachToClosestEnb (ueNetDev, gnbNetDev);
+
+  // One DL UDP flow on each dedicated bearer; the port tells the bearer
+  ApplicationContainer serverApps;
+  ApplicationContainer clientApps;
+  for (uint32_t u = 0; u < ueContainer.GetN (); ++u)
+    {
+      for (uint16_t flow = 0; flow < qcis.size (); ++flow)
+        {
+          uint16_t dlPort = 1234 + flow;
+          UdpServerHelper dlPacketSink (dlPort);
+          serverApps.Add (dlPacketSink.Install (ueContainer.Get (u)));
+
+          UdpClientHelper dlClient (ueIpIface.GetAddress (u), dlPort);
+          dlClient.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+          dlClient.SetAttribute ("PacketSize", UintegerValue (udpPacketSize));
+          dlClient.SetAttribute ("Interval", TimeValue (packetInterval));
+          clientApps.Add (dlClient.Install (remoteHost));
+
+          Ptr<EpcTft> tft = Create<EpcTft> ();
+          EpcTft::PacketFilter dlpf;
+          dlpf.localPortStart = dlPort;
+          dlpf.localPortEnd = dlPort;
+          tft->Add (dlpf);
+          nrHelper->ActivateDedicatedEpsBearer (ueNetDev.Get (u), EpsBearer (qcis.at (flow)), tft);
+        }
+    }
+  serverApps.Start (appStartTime);
+  clientApps.Start (appStartTime);
+  serverApps.Stop (simTime);
+  clientApps.Stop (simTime);
+
+  std::vector<uint64_t> dcis (allBwps.size (), 0);
+  uint64_t rlcTxPdus = 0;
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/DlScheduling",
+                                 MakeBoundCallback (&NotifyDlScheduling, &dcis));
+  Simulator::Schedule (appStartTime, &ConnectRlcTraces, &rlcTxPdus);
+
+  double elapsed = BenchmarkUtils::Run (simTime);
+
+  BenchmarkUtils::PrintResult ("gNBs", gnbNum);
+  BenchmarkUtils::PrintResult ("UEs", ueNum);
+  BenchmarkUtils::PrintResult ("Bearers per UE", qcis.size ());
+  for (uint32_t bwpId = 0; bwpId < dcis.size (); ++bwpId)
+    {
+      BenchmarkUtils::PrintResult ("DL DCIs in BWP " + std::to_string (bwpId), dcis.at (bwpId));
+    }
+  BenchmarkUtils::PrintResult ("RLC TX PDUs", rlcTxPdus);
+  BenchmarkUtils::PrintResult ("Wall-clock time", elapsed, "s");
+  BenchmarkUtils::PrintResult ("TX opportunities/s", rlcTxPdus / elapsed);
+
+  double dispatchTime = TimeTxOpportunityDispatch (ueNum, qcis, static_cast<uint8_t> (allBwps.size ()),
+                                                   dispatchCalls);
+  BenchmarkUtils::PrintResult ("Dispatch alone", 1e9 * dispatchTime, "ns");
+  BenchmarkUtils::PrintResult ("Dispatch share", 100 * rlcTxPdus * dispatchTime / elapsed,
+                               "% of Simulator::Run ()");
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,238 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-ctrl-msg-allocation-benchmark.cc
+ * \brief Heap allocations of the MAC control messages in untraced runs
+ *
+ * A row of gNBs (4 by default) serves `ueNum` UEs (100 by default), each
+ * with a DL and an UL UDP flow, so that the UEs send CQIs, HARQ feedback,
+ * SRs and BSRs all the time. The MACs build the control messages that only
+ * feed GnbMacRxedCtrlMsgsTrace and UeMacTxedCtrlMsgsTrace when these traces
+ * have a sink. With `traceCtrlMsgs`, the program connects a sink that counts
+ * the messages to both traces.
+ *
+ * The program counts the calls of the global operator new during
+ * Simulator::Run (), and prints them, also divided by the duration of the
+ * traffic in ms, with the wall-clock time of the run. The difference between a traced and an
+ * untraced run is the number of allocations saved when nobody listens:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-ctrl-msg-allocation-benchmark --traceCtrlMsgs=false"
+$ ./ns3 run "cttc-nr-ctrl-msg-allocation-benchmark --traceCtrlMsgs=true"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/antenna-module.h"
+#include "benchmark-utils.h"
+#include <cstdlib>
+#include <new>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrCtrlMsgAllocationBenchmark");
+
+static uint64_t g_allocations = 0; //!< Number of calls of the global operator new
+
+void *
+operator new (std::size_t size)
+{
+  ++g_allocations;
+  void *p = std::malloc (size == 0 ? 1 : size);
+  if (p == nullptr)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+/**
+ * \brief Count a traced MAC control message
+ * \param counter the counter
+ * \param sfn the slot of the message
+ * \param nodeId the node ID
+ * \param rnti the RNTI
+ * \param bwpId the BWP ID
+ * \param msg the message
+ */
+static void
+NotifyCtrlMsg (uint64_t *counter, [[maybe_unused]] SfnSf sfn, [[maybe_unused]] uint16_t nodeId,
+               [[maybe_unused]] uint16_t rnti, [[maybe_unused]] uint8_t bwpId,
+               [[maybe_unused]] Ptr<const NrControlMessage> msg)
+{
+  (*counter)++;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t gnbNum = 4;
+  uint32_t ueNum = 100;
+  double interSiteDistance = 500.0; // m
+  bool traceCtrlMsgs = false;
+  uint16_t numerology = 1;
+  double centralFrequency = 3.5e9;
+  double bandwidth = 20e6;
+  uint32_t udpPacketSize = 500;
+  Time packetInterval = MilliSeconds (2);
+  Time appStartTime = MilliSeconds (400);
+  Time simTime = Seconds (1.4);
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("gnbNum",
+                "Number of gNBs",
+                gnbNum);
+  cmd.AddValue ("ueNum",
+                "Number of UEs",
+                ueNum);
+  cmd.AddValue ("traceCtrlMsgs",
+                "If true, connect a sink to the MAC control message traces",
+                traceCtrlMsgs);
+  cmd.AddValue ("packetInterval",
+                "Interval between the UDP packets of each flow",
+                packetInterval);
+  cmd.AddValue ("simTime",
+                "Simulation time",
+                simTime);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (simTime <= appStartTime, "The simulation must last beyond " << appStartTime.As (Time::MS));
+
+  BenchmarkUtils::SetDefaults ();
+
+  NodeContainer gnbContainer;
+  gnbContainer.Create (gnbNum);
+  NodeContainer ueContainer;
+  ueContainer.Create (ueNum);
+
+  BenchmarkUtils::PlaceGnbsOnRow (gnbContainer, interSiteDistance);
+  BenchmarkUtils::PlaceUesAroundRow (ueContainer, gnbNum, interSiteDistance, 0);
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<NrHelper> nrHelper = BenchmarkUtils::CreateNrHelper (epcHelper);
+  OperationBandInfo band;
+  BandwidthPartInfoPtrVector allBwps = BenchmarkUtils::InitializeBand (nrHelper, band, centralFrequency, bandwidth);
+
+  nrHelper->SetSchedulerTypeId (TypeId::LookupByName ("ns3::NrMacSchedulerOfdmaPF"));
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbAntennaAttribute ("NumRows", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("NumColumns", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+
+  nrHelper->SetGnbBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+
+  NetDeviceContainer gnbNetDev = nrHelper->InstallGnbDevice (gnbContainer, allBwps);
+  NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueContainer, allBwps);
+
+  int64_t randomStream = 2;
+  randomStream += nrHelper->AssignStreams (gnbNetDev, randomStream);
+  randomStream += nrHelper->AssignStreams (ueNetDev, randomStream);
+
+  for (uint32_t i = 0; i < gnbNetDev.GetN (); ++i)
+    {
+      nrHelper->GetGnbPhy (gnbNetDev.Get (i), 0)->SetAttribute ("Numerology", UintegerValue (numerology));
+    }
+
+  BenchmarkUtils::UpdateConfig (gnbNetDev, ueNetDev);
+
+  Ipv4InterfaceContainer ueIpIface;
+  Ptr<Node> remoteHost = BenchmarkUtils::ConnectRemoteHost (epcHelper, ueContainer, ueNetDev, ueIpIface);
+  Ipv4Address remoteHostAddr = BenchmarkUtils::GetRemoteHostAddress (remoteHost);
+
+  nrHelper->AttachToClosestEnb (ueNetDev, gnbNetDev);
+
+  uint16_t dlPort = 1234;
+  uint16_t ulPort = 2000;
+  ApplicationContainer serverApps;
+  ApplicationContainer clientApps;
+  UdpServerHelper dlPacketSink (dlPort);
+  serverApps.Add (dlPacketSink.Install (ueContainer));
+  UdpClientHelper client;
+  client.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+  client.SetAttribute ("PacketSize", UintegerValue (udpPacketSize));
+  client.SetAttribute ("Interval", TimeValue (packetInterval));
+  for (uint32_t u = 0; u < ueContainer.GetN (); ++u)
+    {
+      client.SetAttribute ("RemotePort", UintegerValue (dlPort));
+      client.SetAttribute ("RemoteAddress", AddressValue (ueIpIface.GetAddress (u)));
+      clientApps.Add (client.Install (remoteHost));
+
+      UdpServerHelper ulPacketSink (ulPort + u);
+      serverApps.Add (ulPacketSink.Install (remoteHost));
+      client.SetAttribute ("RemotePort", UintegerValue (ulPort + u));
+      client.SetAttribute ("RemoteAddress", AddressValue (remoteHostAddr));
+      clientApps.Add (client.Install (ueContainer.Get (u)));
+    }
+  serverApps.Start (appStartTime);
+  clientApps.Start (appStartTime);
+  serverApps.Stop (simTime);
+  clientApps.Stop (simTime);
+
+  uint64_t ctrlMsgs = 0;
+  if (traceCtrlMsgs)
+    {
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/GnbMacRxedCtrlMsgsTrace",
+                                     MakeBoundCallback (&NotifyCtrlMsg, &ctrlMsgs));
+      Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/NrUeMac/UeMacTxedCtrlMsgsTrace",
+                                     MakeBoundCallback (&NotifyCtrlMsg, &ctrlMsgs));
+    }
+
+  uint64_t allocations = g_allocations;
+  double elapsed = BenchmarkUtils::Run (simTime);
+  allocations = g_allocations - allocations;
+
+  uint64_t rxPackets = 0;
+  for (uint32_t i = 0; i < serverApps.GetN (); ++i)
+    {
+      rxPackets += DynamicCast<UdpServer> (serverApps.Get (i))->GetReceived ();
+    }
+
+  BenchmarkUtils::PrintResult ("gNBs", gnbNum);
+  BenchmarkUtils::PrintResult ("UEs", ueNum);
+  BenchmarkUtils::PrintResult ("MAC ctrl msg traces", traceCtrlMsgs ? "on" : "off");
+  BenchmarkUtils::PrintResult ("Ctrl msgs traced", ctrlMsgs);
+  BenchmarkUtils::PrintResult ("UDP packets received", rxPackets);
+  BenchmarkUtils::PrintResult ("Allocations", allocations);
+  BenchmarkUtils::PrintResult ("Allocations per ms",
+                               static_cast<double> (allocations) / (simTime - appStartTime).GetMilliSeconds ());
+  BenchmarkUtils::PrintResult ("Wall-clock time", elapsed, "s");
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,240 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-harq-stress-benchmark.cc
+ * \brief Benchmark of the DL HARQ retransmission scheduling
+ *
+ * One gNB serves many UEs (200 by default) with full-buffer DL UDP traffic.
+ * The gNB and the UEs have dual-polarized antennas, and the UEs report a
+ * fixed rank of 2, so that each DCI carries two streams. The DL MCS is fixed
+ * at a high value, so that most of the TBs fail and the OFDMA RR scheduler
+ * spends most of the slots in NrMacSchedulerHarqRr::ScheduleDlHarq.
+ *
+ * At the end, the program prints the number of DL DCIs, how many of them are
+ * retransmissions, and the DCIs scheduled per second of wall-clock time spent
+ * in Simulator::Run ():
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-harq-stress-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/antenna-module.h"
+#include "benchmark-utils.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrHarqStressBenchmark");
+
+/**
+ * \brief Counters of the DL DCIs
+ */
+struct DciCounters
+{
+  uint64_t m_dcis {0};     //!< DL DCIs
+  uint64_t m_reTxDcis {0}; //!< DL DCIs whose first stream is a retransmission
+  uint64_t m_streams {0};  //!< Streams with data of the DL DCIs
+};
+
+/**
+ * \brief Count the DL DCIs, reported by NrGnbMac one stream at a time
+ * \param counters the counters
+ * \param info the scheduling information of one stream of a DCI
+ */
+static void
+NotifyDlScheduling (DciCounters *counters, NrSchedulingCallbackInfo info)
+{
+  if (info.m_tbSize > 0)
+    {
+      counters->m_streams++;
+    }
+  if (info.m_streamId == 0)
+    {
+      counters->m_dcis++;
+      if (info.m_rv > 0)
+        {
+          counters->m_reTxDcis++;
+        }
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t ueNum = 200;
+  double cellRadius = 250.0; // m
+  uint16_t numerology = 1;
+  double centralFrequency = 3.5e9;
+  double bandwidth = 40e6;
+  double gnbTxPower = 30; // dBm
+  uint8_t dlMcs = 28;
+  uint32_t udpPacketSize = 1000;
+  Time packetInterval = MicroSeconds (500);
+  Time appStartTime = MilliSeconds (400);
+  Time simTime = MilliSeconds (1400);
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("ueNum",
+                "Number of UEs attached to the gNB",
+                ueNum);
+  cmd.AddValue ("cellRadius",
+                "Radius of the disc in which the UEs are dropped, in m",
+                cellRadius);
+  cmd.AddValue ("numerology",
+                "The numerology to be used",
+                numerology);
+  cmd.AddValue ("bandwidth",
+                "The system bandwidth to be used",
+                bandwidth);
+  cmd.AddValue ("dlMcs",
+                "Fixed DL MCS; a high value gives a high BLER",
+                dlMcs);
+  cmd.AddValue ("packetInterval",
+                "Interval between the DL UDP packets of each UE",
+                packetInterval);
+  cmd.AddValue ("simTime",
+                "Simulation time",
+                simTime);
+  cmd.Parse (argc, argv);
+
+  BenchmarkUtils::SetDefaults ();
+
+  NodeContainer gnbContainer;
+  gnbContainer.Create (1);
+  NodeContainer ueContainer;
+  ueContainer.Create (ueNum);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  Ptr<ListPositionAllocator> gnbPositionAlloc = CreateObject<ListPositionAllocator> ();
+  gnbPositionAlloc->Add (Vector (0.0, 0.0, 25.0));
+  mobility.SetPositionAllocator (gnbPositionAlloc);
+  mobility.Install (gnbContainer);
+  Ptr<UniformDiscPositionAllocator> uePositionAlloc = CreateObject<UniformDiscPositionAllocator> ();
+  uePositionAlloc->SetRho (cellRadius);
+  uePositionAlloc->SetZ (1.5);
+  uePositionAlloc->AssignStreams (0);
+  mobility.SetPositionAllocator (uePositionAlloc);
+  mobility.Install (ueContainer);
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<NrHelper> nrHelper = BenchmarkUtils::CreateNrHelper (epcHelper);
+  OperationBandInfo band;
+  BandwidthPartInfoPtrVector allBwps = BenchmarkUtils::InitializeBand (nrHelper, band, centralFrequency, bandwidth);
+
+  // MCS table 1 goes up to MCS 28, table 2 only up to 27
+  NS_ABORT_MSG_IF (dlMcs > CreateObject<NrEesmIrT1> ()->GetMaxMcs (),
+                   "dlMcs out of the range of the MCS table 1: " << +dlMcs);
+  nrHelper->SetDlErrorModel ("ns3::NrEesmIrT1");
+  nrHelper->SetUlErrorModel ("ns3::NrEesmIrT1");
+  nrHelper->SetGnbDlAmcAttribute ("AmcModel", EnumValue (NrAmc::ErrorModel));
+  nrHelper->SetGnbUlAmcAttribute ("AmcModel", EnumValue (NrAmc::ErrorModel));
+  nrHelper->SetSchedulerTypeId (TypeId::LookupByName ("ns3::NrMacSchedulerOfdmaRR"));
+  nrHelper->SetSchedulerAttribute ("FixedMcsDl", BooleanValue (true));
+  nrHelper->SetSchedulerAttribute ("StartingMcsDl", UintegerValue (dlMcs));
+
+  // Rank 2: dual-polarized arrays and a fixed rank indicator
+  nrHelper->SetUePhyAttribute ("UseFixedRi", BooleanValue (true));
+  nrHelper->SetUePhyAttribute ("FixedRankIndicator", UintegerValue (2));
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbAntennaAttribute ("NumRows", UintegerValue (2));
+  nrHelper->SetGnbAntennaAttribute ("NumColumns", UintegerValue (2));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement", PointerValue (CreateObject<ThreeGppAntennaModel> ()));
+
+  nrHelper->SetGnbBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+
+  NetDeviceContainer gnbNetDev = nrHelper->InstallGnbDevice (gnbContainer, allBwps, 2);
+  NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueContainer, allBwps, 2);
+
+  int64_t randomStream = 1;
+  randomStream += nrHelper->AssignStreams (gnbNetDev, randomStream);
+  randomStream += nrHelper->AssignStreams (ueNetDev, randomStream);
+
+  nrHelper->GetGnbPhy (gnbNetDev.Get (0), 0)->SetAttribute ("Numerology", UintegerValue (numerology));
+  nrHelper->GetGnbPhy (gnbNetDev.Get (0), 0)->SetAttribute ("TxPower", DoubleValue (gnbTxPower));
+
+  // Second sub-array with a slant angle of 90 degrees
+  auto setSecondPolarization = [] (Ptr<NrPhy> phy)
+    {
+      ObjectVectorValue spectrumPhys;
+      phy->GetAttribute ("NrSpectrumPhyList", spectrumPhys);
+      if (spectrumPhys.GetN () == 2)
+        {
+          Ptr<NrSpectrumPhy> nrSpectrumPhy = spectrumPhys.Get (1)->GetObject <NrSpectrumPhy> ();
+          nrSpectrumPhy->GetAntenna ()->GetObject<UniformPlanarArray> ()->SetAttribute ("PolSlantAngle", DoubleValue (M_PI / 2));
+        }
+    };
+  setSecondPolarization (nrHelper->GetGnbPhy (gnbNetDev.Get (0), 0));
+  for (uint32_t u = 0; u < ueNetDev.GetN (); ++u)
+    {
+      setSecondPolarization (nrHelper->GetUePhy (ueNetDev.Get (u), 0));
+    }
+
+  BenchmarkUtils::UpdateConfig (gnbNetDev, ueNetDev);
+
+  Ipv4InterfaceContainer ueIpIface;
+  Ptr<Node> remoteHost = BenchmarkUtils::ConnectRemoteHost (epcHelper, ueContainer, ueNetDev, ueIpIface);
+
+  nrHelper->AttachToClosestEnb (ueNetDev, gnbNetDev);
+
+  uint16_t dlPort = 1234;
+  ApplicationContainer serverApps;
+  UdpServerHelper dlPacketSink (dlPort);
+  serverApps.Add (dlPacketSink.Install (ueContainer));
+  UdpClientHelper dlClient;
+  dlClient.SetAttribute ("RemotePort", UintegerValue (dlPort));
+  dlClient.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+  dlClient.SetAttribute ("PacketSize", UintegerValue (udpPacketSize));
+  dlClient.SetAttribute ("Interval", TimeValue (packetInterval));
+  ApplicationContainer clientApps;
+  for (uint32_t u = 0; u < ueContainer.GetN (); ++u)
+    {
+      dlClient.SetAttribute ("RemoteAddress", AddressValue (ueIpIface.GetAddress (u)));
+      clientApps.Add (dlClient.Install (remoteHost));
+    }
+  serverApps.Start (appStartTime);
+  clientApps.Start (appStartTime);
+  serverApps.Stop (simTime);
+  clientApps.Stop (simTime);
+
+  DciCounters counters;
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/DlScheduling",
+                                 MakeBoundCallback (&NotifyDlScheduling, &counters));
+
+  double elapsed = BenchmarkUtils::Run (simTime);
+
+  BenchmarkUtils::PrintResult ("UEs", ueNum);
+  BenchmarkUtils::PrintResult ("DL DCIs", counters.m_dcis);
+  BenchmarkUtils::PrintResult ("  retransmissions", counters.m_reTxDcis);
+  BenchmarkUtils::PrintResult ("  streams with data", counters.m_streams);
+  BenchmarkUtils::PrintResult ("Wall-clock time", elapsed, "s");
+  BenchmarkUtils::PrintResult ("DCIs/s", counters.m_dcis / elapsed);
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,107 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-hexagonal-grid-benchmark.cc
+ * \brief Benchmark of the generation of large hexagonal deployments
+ *
+ * The program deploys `hexRings` complete hexagonal rings of 3-sector sites
+ * (11 rings by default, i.e., 397 sites and 1191 sectors) with
+ * HexagonalGridScenarioHelper, and drops `ueNum` UEs in them (100000 by
+ * default), without writing the topology file. Then, for every UE, it
+ * computes the wrap-around position of every site, as a wrap-around
+ * deployment does when it looks for the closest copy of each gNB.
+ *
+ * The program prints the wall-clock time of the deployment, and the time per
+ * call of GetWrapAroundPosition:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-hexagonal-grid-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/hexagonal-grid-scenario-helper.h"
+#include "benchmark-utils.h"
+#include <chrono>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrHexagonalGridBenchmark");
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t hexRings = 11;
+  uint32_t ueNum = 100000;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("hexRings",
+                "Number of complete hexagonal rings of sites around the central site",
+                hexRings);
+  cmd.AddValue ("ueNum",
+                "Number of UEs",
+                ueNum);
+  cmd.Parse (argc, argv);
+
+  HexagonalGridScenarioHelper grid;
+  grid.SetScenarioParameters ("UMa");
+  grid.SetTopologyFileFormat (HexagonalGridScenarioHelper::NO_FILE);
+  grid.SetUtNumber (ueNum);
+
+  auto start = std::chrono::steady_clock::now ();
+  grid.SetSitesNumber (1 + 3 * hexRings * (hexRings + 1));
+  grid.CreateScenario ();
+  std::chrono::duration<double> deployElapsed = std::chrono::steady_clock::now () - start;
+
+  const std::vector<Vector> sites = grid.GetSitePositions ();
+  const NodeContainer &ues = grid.GetUserTerminals ();
+  std::vector<Vector> uePositions;
+  uePositions.reserve (ues.GetN ());
+  for (uint32_t u = 0; u < ues.GetN (); ++u)
+    {
+      uePositions.push_back (ues.Get (u)->GetObject<MobilityModel> ()->GetPosition ());
+    }
+
+  // Sum the distances, so that the calls are not optimized away
+  double distanceSum = 0.0;
+  start = std::chrono::steady_clock::now ();
+  for (const auto &uePos : uePositions)
+    {
+      for (const auto &site : sites)
+        {
+          distanceSum += CalculateDistance (grid.GetWrapAroundPosition (site, uePos), uePos);
+        }
+    }
+  std::chrono::duration<double> wrapElapsed = std::chrono::steady_clock::now () - start;
+  uint64_t wrapCalls = static_cast<uint64_t> (uePositions.size ()) * sites.size ();
+
+  BenchmarkUtils::PrintResult ("Sites", grid.GetNumSites ());
+  BenchmarkUtils::PrintResult ("Sectors", grid.GetNumCells ());
+  BenchmarkUtils::PrintResult ("UEs", ues.GetN ());
+  BenchmarkUtils::PrintResult ("Deployment", deployElapsed.count (), "s");
+  BenchmarkUtils::PrintResult ("Wrap-around calls", wrapCalls);
+  BenchmarkUtils::PrintResult ("Wrap-around", wrapElapsed.count (), "s");
+  BenchmarkUtils::PrintResult ("Wrap-around per call", 1e9 * wrapElapsed.count () / wrapCalls, "ns");
+  BenchmarkUtils::PrintResult ("Mean distance", distanceSum / wrapCalls, "m");
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,204 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-highway-distance-cutoff-benchmark.cc
+ * \brief Scaling of a highway deployment with the distance cut-off of the channel
+ *
+ * A row of gNBs (20 by default, 1 km apart) covers a highway, and vehicular
+ * UEs (1000 by default) drive on its lanes in both directions, with a low
+ * rate DL UDP flow each. The channel uses
+ * DistanceBasedThreeGppSpectrumPropagationLossModel, so that the fast fading
+ * is computed only up to `maxDistance`. With `skipFarReceivers`, the
+ * spectrum channel does not even deliver the signals beyond that distance.
+ *
+ * The program prints the wall-clock time spent in Simulator::Run (), and
+ * the time per UE. To see how the cost grows with the number of UEs, run it
+ * from 1000 to 5000 UEs, with and without `skipFarReceivers`:
+ *
+ * \code{.unparsed}
+$ for ues in 1000 2000 3000 4000 5000; do
+    ./ns3 run "cttc-nr-highway-distance-cutoff-benchmark --ueNum=$ues --skipFarReceivers=true";
+    ./ns3 run "cttc-nr-highway-distance-cutoff-benchmark --ueNum=$ues --skipFarReceivers=false";
+  done
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/antenna-module.h"
+#include "benchmark-utils.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrHighwayDistanceCutoffBenchmark");
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t gnbNum = 20;
+  uint32_t ueNum = 1000;
+  double interSiteDistance = 1000.0; // m
+  uint16_t lanesPerDirection = 3;
+  double laneWidth = 4.0; // m
+  double speed = 140.0 / 3.6; // m/s
+  double maxDistance = 1500.0; // m
+  bool skipFarReceivers = true;
+  uint16_t numerology = 1;
+  double centralFrequency = 3.5e9;
+  double bandwidth = 20e6;
+  uint32_t udpPacketSize = 200;
+  Time packetInterval = MilliSeconds (10);
+  Time appStartTime = MilliSeconds (400);
+  Time simTime = MilliSeconds (800);
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("gnbNum",
+                "Number of gNBs along the highway",
+                gnbNum);
+  cmd.AddValue ("ueNum",
+                "Number of vehicular UEs on the highway",
+                ueNum);
+  cmd.AddValue ("interSiteDistance",
+                "Distance between two neighbour gNBs, in m",
+                interSiteDistance);
+  cmd.AddValue ("lanesPerDirection",
+                "Number of lanes in each direction",
+                lanesPerDirection);
+  cmd.AddValue ("maxDistance",
+                "Distance beyond which the fast fading is not computed, in m",
+                maxDistance);
+  cmd.AddValue ("skipFarReceivers",
+                "If true, the channel does not deliver the signals beyond maxDistance",
+                skipFarReceivers);
+  cmd.AddValue ("packetInterval",
+                "Interval between the DL UDP packets of each UE",
+                packetInterval);
+  cmd.AddValue ("simTime",
+                "Simulation time",
+                simTime);
+  cmd.Parse (argc, argv);
+
+  BenchmarkUtils::SetDefaults ();
+
+  NodeContainer gnbContainer;
+  gnbContainer.Create (gnbNum);
+  NodeContainer ueContainer;
+  ueContainer.Create (ueNum);
+
+  BenchmarkUtils::PlaceGnbsOnRow (gnbContainer, interSiteDistance);
+
+  // The highway runs along the gNBs, 10 m away from them; the first lanes
+  // go east, the others west
+  Ptr<UniformRandomVariable> ueX = CreateObject<UniformRandomVariable> ();
+  ueX->SetAttribute ("Min", DoubleValue (-interSiteDistance / 2));
+  ueX->SetAttribute ("Max", DoubleValue ((gnbNum - 0.5) * interSiteDistance));
+  ueX->SetStream (0);
+  Ptr<UniformRandomVariable> ueLane = CreateObject<UniformRandomVariable> ();
+  ueLane->SetStream (1);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (ueContainer);
+  for (uint32_t u = 0; u < ueContainer.GetN (); ++u)
+    {
+      uint32_t lane = ueLane->GetInteger (0, 2 * lanesPerDirection - 1);
+      Ptr<ConstantVelocityMobilityModel> mm = ueContainer.Get (u)->GetObject<ConstantVelocityMobilityModel> ();
+      mm->SetPosition (Vector (ueX->GetValue (), 10.0 + (lane + 0.5) * laneWidth, 1.5));
+      mm->SetVelocity (Vector (lane < lanesPerDirection ? speed : -speed, 0.0, 0.0));
+    }
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<NrHelper> nrHelper = BenchmarkUtils::CreateNrHelper (epcHelper);
+  nrHelper->SetPhasedArraySpectrumPropagationLossModelTypeId (DistanceBasedThreeGppSpectrumPropagationLossModel::GetTypeId ());
+  nrHelper->SetPhasedArraySpectrumPropagationLossModelAttribute ("MaxDistance", DoubleValue (maxDistance));
+  nrHelper->SetPhasedArraySpectrumPropagationLossModelAttribute ("SkipFarReceivers", BooleanValue (skipFarReceivers));
+  OperationBandInfo band;
+  BandwidthPartInfoPtrVector allBwps = BenchmarkUtils::InitializeBand (nrHelper, band, centralFrequency, bandwidth);
+
+  nrHelper->SetSchedulerTypeId (TypeId::LookupByName ("ns3::NrMacSchedulerOfdmaRR"));
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbAntennaAttribute ("NumRows", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("NumColumns", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+
+  nrHelper->SetGnbBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+
+  NetDeviceContainer gnbNetDev = nrHelper->InstallGnbDevice (gnbContainer, allBwps);
+  NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueContainer, allBwps);
+
+  int64_t randomStream = 2;
+  randomStream += nrHelper->AssignStreams (gnbNetDev, randomStream);
+  randomStream += nrHelper->AssignStreams (ueNetDev, randomStream);
+
+  for (uint32_t i = 0; i < gnbNetDev.GetN (); ++i)
+    {
+      nrHelper->GetGnbPhy (gnbNetDev.Get (i), 0)->SetAttribute ("Numerology", UintegerValue (numerology));
+    }
+
+  BenchmarkUtils::UpdateConfig (gnbNetDev, ueNetDev);
+
+  Ipv4InterfaceContainer ueIpIface;
+  Ptr<Node> remoteHost = BenchmarkUtils::ConnectRemoteHost (epcHelper, ueContainer, ueNetDev, ueIpIface);
+
+  nrHelper->AttachToClosestEnb (ueNetDev, gnbNetDev);
+
+  uint16_t dlPort = 1234;
+  ApplicationContainer serverApps;
+  UdpServerHelper dlPacketSink (dlPort);
+  serverApps.Add (dlPacketSink.Install (ueContainer));
+  UdpClientHelper dlClient;
+  dlClient.SetAttribute ("RemotePort", UintegerValue (dlPort));
+  dlClient.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+  dlClient.SetAttribute ("PacketSize", UintegerValue (udpPacketSize));
+  dlClient.SetAttribute ("Interval", TimeValue (packetInterval));
+  ApplicationContainer clientApps;
+  for (uint32_t u = 0; u < ueContainer.GetN (); ++u)
+    {
+      dlClient.SetAttribute ("RemoteAddress", AddressValue (ueIpIface.GetAddress (u)));
+      clientApps.Add (dlClient.Install (remoteHost));
+    }
+  serverApps.Start (appStartTime);
+  clientApps.Start (appStartTime);
+  serverApps.Stop (simTime);
+  clientApps.Stop (simTime);
+
+  double elapsed = BenchmarkUtils::Run (simTime);
+
+  uint64_t rxPackets = 0;
+  for (uint32_t u = 0; u < serverApps.GetN (); ++u)
+    {
+      rxPackets += DynamicCast<UdpServer> (serverApps.Get (u))->GetReceived ();
+    }
+
+  BenchmarkUtils::PrintResult ("gNBs", gnbNum);
+  BenchmarkUtils::PrintResult ("UEs", ueNum);
+  BenchmarkUtils::PrintResult ("Skip far receivers", skipFarReceivers ? "yes" : "no");
+  BenchmarkUtils::PrintResult ("DL packets received", rxPackets);
+  BenchmarkUtils::PrintResult ("Wall-clock time", elapsed, "s");
+  BenchmarkUtils::PrintResult ("Time per UE", 1e3 * elapsed / ueNum, "ms");
+
+  Simulator::Destroy ();
+  return 0;
+}
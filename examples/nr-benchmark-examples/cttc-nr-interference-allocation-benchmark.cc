@@ -0,0 +1,208 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-interference-allocation-benchmark.cc
+ * \brief Heap allocations of NrInterference per received TB
+ *
+ * The program drives an NrInterference object, as the data path of
+ * NrSpectrumPhy does, without the rest of the stack: `numTbs` TBs are
+ * received one after the other, each over `tbDuration`, and during each TB
+ * `numInterferers` interfering signals (50 by default) start at staggered
+ * times, so that every interferer triggers the evaluation of a chunk. A SINR
+ * chunk processor is attached, as the NR helper does.
+ *
+ * The program counts the calls of the global operator new. The same
+ * sequence of events is run twice: once calling the interference model, and
+ * once with empty events. The difference, divided by the number of TBs, is
+ * the number of allocations that the interference model makes per received
+ * TB. The program prints it, with the wall-clock time per TB:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-interference-allocation-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/spectrum-module.h"
+#include "ns3/nr-module.h"
+#include "benchmark-utils.h"
+#include <cstdlib>
+#include <new>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrInterferenceAllocationBenchmark");
+
+static uint64_t g_allocations = 0; //!< Number of calls of the global operator new
+
+void *
+operator new (std::size_t size)
+{
+  ++g_allocations;
+  void *p = std::malloc (size == 0 ? 1 : size);
+  if (p == nullptr)
+    {
+      throw std::bad_alloc ();
+    }
+  return p;
+}
+
+void
+operator delete (void *p) noexcept
+{
+  std::free (p);
+}
+
+void
+operator delete (void *p, std::size_t) noexcept
+{
+  std::free (p);
+}
+
+/**
+ * \brief Start the reception of a TB, or do nothing
+ * \param interference the interference model, or nullptr for the empty run
+ * \param rxPsd the PSD of the TB
+ */
+static void
+StartRx (const Ptr<NrInterference> &interference, const Ptr<const SpectrumValue> &rxPsd)
+{
+  if (interference != nullptr)
+    {
+      interference->StartRx (rxPsd);
+    }
+}
+
+/**
+ * \brief Add an interfering signal, or do nothing
+ * \param interference the interference model, or nullptr for the empty run
+ * \param psd the PSD of the signal
+ * \param duration the duration of the signal
+ */
+static void
+AddSignal (const Ptr<NrInterference> &interference, const Ptr<const SpectrumValue> &psd, Time duration)
+{
+  if (interference != nullptr)
+    {
+      interference->AddSignal (psd, duration);
+    }
+}
+
+/**
+ * \brief End the reception of a TB, or do nothing
+ * \param interference the interference model, or nullptr for the empty run
+ */
+static void
+EndRx (const Ptr<NrInterference> &interference)
+{
+  if (interference != nullptr)
+    {
+      interference->EndRx ();
+    }
+}
+
+/**
+ * \brief Receive the TBs, each with its interferers
+ * \param interference the interference model, or nullptr for the empty run
+ * \param rxPsd the PSD of the TBs
+ * \param interfererPsds the PSDs of the interferers
+ * \param numTbs the number of TBs
+ * \param tbDuration the duration of a TB
+ * \return the number of allocations and the wall-clock time of the run, in seconds
+ */
+static std::pair<uint64_t, double>
+RunTbs (const Ptr<NrInterference> &interference, const Ptr<const SpectrumValue> &rxPsd,
+        const std::vector<Ptr<const SpectrumValue> > &interfererPsds,
+        uint32_t numTbs, Time tbDuration)
+{
+  // The interferers start within the TB, and last until the start of the
+  // next one
+  Time step = tbDuration / (interfererPsds.size () + 1);
+  for (uint32_t tb = 0; tb < numTbs; ++tb)
+    {
+      Time start = tb * tbDuration;
+      Simulator::Schedule (start, &StartRx, interference, rxPsd);
+      for (uint32_t i = 0; i < interfererPsds.size (); ++i)
+        {
+          Time offset = (i + 1) * step;
+          Simulator::Schedule (start + offset, &AddSignal, interference, interfererPsds[i], tbDuration - offset);
+        }
+      Simulator::Schedule (start + tbDuration, &EndRx, interference);
+    }
+
+  uint64_t allocations = g_allocations;
+  double elapsed = BenchmarkUtils::Run (numTbs * tbDuration + tbDuration);
+  allocations = g_allocations - allocations;
+  Simulator::Destroy ();
+  return std::make_pair (allocations, elapsed);
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t numInterferers = 50;
+  uint32_t numTbs = 10000;
+  uint32_t numRbs = 106;
+  uint16_t numerology = 1;
+  Time tbDuration = MicroSeconds (500);
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("numInterferers",
+                "Number of interfering signals during each TB",
+                numInterferers);
+  cmd.AddValue ("numTbs",
+                "Number of received TBs",
+                numTbs);
+  cmd.AddValue ("numRbs",
+                "Number of RBs of the spectrum model",
+                numRbs);
+  cmd.AddValue ("tbDuration",
+                "Duration of each TB",
+                tbDuration);
+  cmd.Parse (argc, argv);
+
+  Ptr<const SpectrumModel> sm = NrSpectrumValueHelper::GetSpectrumModel (numRbs, 3.5e9, 15e3 * (1 << numerology));
+  Ptr<SpectrumValue> noisePsd = NrSpectrumValueHelper::CreateNoisePowerSpectralDensity (5.0, sm);
+  Ptr<SpectrumValue> rxPsd = Create<SpectrumValue> (sm);
+  (*rxPsd) = 1e-16;
+  std::vector<Ptr<const SpectrumValue> > interfererPsds;
+  for (uint32_t i = 0; i < numInterferers; ++i)
+    {
+      Ptr<SpectrumValue> psd = Create<SpectrumValue> (sm);
+      (*psd) = 1e-19 * (1 + i % 10);
+      interfererPsds.push_back (psd);
+    }
+
+  Ptr<NrInterference> interference = CreateObject<NrInterference> ();
+  interference->SetNoisePowerSpectralDensity (noisePsd);
+  interference->AddSinrChunkProcessor (Create<LteChunkProcessor> ());
+
+  std::pair<uint64_t, double> model = RunTbs (interference, rxPsd, interfererPsds, numTbs, tbDuration);
+  std::pair<uint64_t, double> empty = RunTbs (nullptr, rxPsd, interfererPsds, numTbs, tbDuration);
+
+  BenchmarkUtils::PrintResult ("Interferers", numInterferers);
+  BenchmarkUtils::PrintResult ("TBs", numTbs);
+  BenchmarkUtils::PrintResult ("RBs", numRbs);
+  BenchmarkUtils::PrintResult ("Allocations per TB",
+                               static_cast<double> (model.first - empty.first) / numTbs);
+  BenchmarkUtils::PrintResult ("Time per TB", 1e6 * (model.second - empty.second) / numTbs, "us");
+
+  interference->Dispose ();
+  return 0;
+}
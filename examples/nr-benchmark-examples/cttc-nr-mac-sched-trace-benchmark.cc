@@ -0,0 +1,189 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-mac-sched-trace-benchmark.cc
+ * \brief Cost of the MAC scheduling traces of the NR helper
+ *
+ * A row of gNBs (4 by default) serves `ueNum` UEs (100 by default), each
+ * with a DL and an UL UDP flow, so that the schedulers allocate TBs to
+ * many UEs in every slot. With `enableTraces`, the program enables the DL
+ * and UL MAC scheduling traces through NrHelper::EnableDlMacSchedTraces and
+ * EnableUlMacSchedTraces. `preResolvedStatsContext` sets the
+ * PreResolvedStatsContext attribute of the helper: when true, the sinks are
+ * connected with the cell ID and the RRC of each gNB already resolved,
+ * instead of through a Config path with the context string built for every
+ * TB.
+ *
+ * The program prints the wall-clock time spent in Simulator::Run (). To
+ * see the cost of the traces, compare the three runs:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-mac-sched-trace-benchmark --enableTraces=false"
+$ ./ns3 run "cttc-nr-mac-sched-trace-benchmark --enableTraces=true --preResolvedStatsContext=false"
+$ ./ns3 run "cttc-nr-mac-sched-trace-benchmark --enableTraces=true --preResolvedStatsContext=true"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/antenna-module.h"
+#include "benchmark-utils.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrMacSchedTraceBenchmark");
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t gnbNum = 4;
+  uint32_t ueNum = 100;
+  double interSiteDistance = 500.0; // m
+  bool enableTraces = true;
+  bool preResolvedStatsContext = true;
+  uint16_t numerology = 1;
+  double centralFrequency = 3.5e9;
+  double bandwidth = 20e6;
+  uint32_t udpPacketSize = 500;
+  Time packetInterval = MilliSeconds (2);
+  Time appStartTime = MilliSeconds (400);
+  Time simTime = Seconds (1.4);
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("gnbNum",
+                "Number of gNBs",
+                gnbNum);
+  cmd.AddValue ("ueNum",
+                "Number of UEs",
+                ueNum);
+  cmd.AddValue ("enableTraces",
+                "If true, enable the DL and UL MAC scheduling traces",
+                enableTraces);
+  cmd.AddValue ("preResolvedStatsContext",
+                "If true, connect the traces with a context resolved at connection time",
+                preResolvedStatsContext);
+  cmd.AddValue ("packetInterval",
+                "Interval between the UDP packets of each flow",
+                packetInterval);
+  cmd.AddValue ("simTime",
+                "Simulation time",
+                simTime);
+  cmd.Parse (argc, argv);
+
+  BenchmarkUtils::SetDefaults ();
+
+  NodeContainer gnbContainer;
+  gnbContainer.Create (gnbNum);
+  NodeContainer ueContainer;
+  ueContainer.Create (ueNum);
+
+  BenchmarkUtils::PlaceGnbsOnRow (gnbContainer, interSiteDistance);
+  BenchmarkUtils::PlaceUesAroundRow (ueContainer, gnbNum, interSiteDistance, 0);
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<NrHelper> nrHelper = BenchmarkUtils::CreateNrHelper (epcHelper);
+  nrHelper->SetAttribute ("PreResolvedStatsContext", BooleanValue (preResolvedStatsContext));
+  OperationBandInfo band;
+  BandwidthPartInfoPtrVector allBwps = BenchmarkUtils::InitializeBand (nrHelper, band, centralFrequency, bandwidth);
+
+  nrHelper->SetSchedulerTypeId (TypeId::LookupByName ("ns3::NrMacSchedulerOfdmaPF"));
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbAntennaAttribute ("NumRows", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("NumColumns", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+
+  nrHelper->SetGnbBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+
+  NetDeviceContainer gnbNetDev = nrHelper->InstallGnbDevice (gnbContainer, allBwps);
+  NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueContainer, allBwps);
+
+  int64_t randomStream = 2;
+  randomStream += nrHelper->AssignStreams (gnbNetDev, randomStream);
+  randomStream += nrHelper->AssignStreams (ueNetDev, randomStream);
+
+  for (uint32_t i = 0; i < gnbNetDev.GetN (); ++i)
+    {
+      nrHelper->GetGnbPhy (gnbNetDev.Get (i), 0)->SetAttribute ("Numerology", UintegerValue (numerology));
+    }
+
+  BenchmarkUtils::UpdateConfig (gnbNetDev, ueNetDev);
+
+  Ipv4InterfaceContainer ueIpIface;
+  Ptr<Node> remoteHost = BenchmarkUtils::ConnectRemoteHost (epcHelper, ueContainer, ueNetDev, ueIpIface);
+  Ipv4Address remoteHostAddr = BenchmarkUtils::GetRemoteHostAddress (remoteHost);
+
+  nrHelper->AttachToClosestEnb (ueNetDev, gnbNetDev);
+
+  uint16_t dlPort = 1234;
+  uint16_t ulPort = 2000;
+  ApplicationContainer serverApps;
+  ApplicationContainer clientApps;
+  UdpServerHelper dlPacketSink (dlPort);
+  serverApps.Add (dlPacketSink.Install (ueContainer));
+  UdpClientHelper client;
+  client.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+  client.SetAttribute ("PacketSize", UintegerValue (udpPacketSize));
+  client.SetAttribute ("Interval", TimeValue (packetInterval));
+  for (uint32_t u = 0; u < ueContainer.GetN (); ++u)
+    {
+      client.SetAttribute ("RemotePort", UintegerValue (dlPort));
+      client.SetAttribute ("RemoteAddress", AddressValue (ueIpIface.GetAddress (u)));
+      clientApps.Add (client.Install (remoteHost));
+
+      UdpServerHelper ulPacketSink (ulPort + u);
+      serverApps.Add (ulPacketSink.Install (remoteHost));
+      client.SetAttribute ("RemotePort", UintegerValue (ulPort + u));
+      client.SetAttribute ("RemoteAddress", AddressValue (remoteHostAddr));
+      clientApps.Add (client.Install (ueContainer.Get (u)));
+    }
+  serverApps.Start (appStartTime);
+  clientApps.Start (appStartTime);
+  serverApps.Stop (simTime);
+  clientApps.Stop (simTime);
+
+  if (enableTraces)
+    {
+      nrHelper->EnableDlMacSchedTraces ();
+      nrHelper->EnableUlMacSchedTraces ();
+    }
+
+  double elapsed = BenchmarkUtils::Run (simTime);
+
+  uint64_t rxPackets = 0;
+  for (uint32_t i = 0; i < serverApps.GetN (); ++i)
+    {
+      rxPackets += DynamicCast<UdpServer> (serverApps.Get (i))->GetReceived ();
+    }
+
+  BenchmarkUtils::PrintResult ("gNBs", gnbNum);
+  BenchmarkUtils::PrintResult ("UEs", ueNum);
+  BenchmarkUtils::PrintResult ("MAC sched traces", enableTraces ? (preResolvedStatsContext ? "pre-resolved" : "Config path") : "off");
+  BenchmarkUtils::PrintResult ("UDP packets received", rxPackets);
+  BenchmarkUtils::PrintResult ("Wall-clock time", elapsed, "s");
+
+  Simulator::Destroy ();
+  return 0;
+}
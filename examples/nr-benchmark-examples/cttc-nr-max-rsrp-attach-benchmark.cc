@@ -0,0 +1,134 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-max-rsrp-attach-benchmark.cc
+ * \brief Scaling of the attachment of the UEs in a large hexagonal deployment
+ *
+ * The program deploys, with HexagonalGridScenarioHelper, `numSites` 3-sector
+ * sites (19 by default, i.e., 57 sectors) in the UMa scenario, with the
+ * antenna of each sector pointed as the helper says, and drops `ueNum` UEs
+ * (10000 by default) in them. Once the devices are installed, it attaches
+ * the UEs with NrHelper::AttachToMaxRsrpEnb, which evaluates the received
+ * power of the sectors of the `candidates` closest sites, or with
+ * NrHelper::AttachToClosestEnb when `maxRsrp` is false. No simulation is run.
+ *
+ * The program prints the wall-clock time of the attachment, and the time
+ * per UE:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-max-rsrp-attach-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/antenna-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/hexagonal-grid-scenario-helper.h"
+#include "benchmark-utils.h"
+#include <chrono>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrMaxRsrpAttachBenchmark");
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t numSites = 19;
+  uint32_t ueNum = 10000;
+  uint32_t candidates = 3;
+  bool maxRsrp = true;
+  double centralFrequency = 3.5e9;
+  double bandwidth = 20e6;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("numSites",
+                "Number of 3-sector sites",
+                numSites);
+  cmd.AddValue ("ueNum",
+                "Number of UEs",
+                ueNum);
+  cmd.AddValue ("candidates",
+                "Number of closest sites whose sectors are evaluated for each UE",
+                candidates);
+  cmd.AddValue ("maxRsrp",
+                "If true, attach to the max RSRP sector, otherwise to the closest one",
+                maxRsrp);
+  cmd.Parse (argc, argv);
+
+  BenchmarkUtils::SetDefaults ();
+
+  HexagonalGridScenarioHelper grid;
+  grid.SetScenarioParameters ("UMa");
+  grid.SetTopologyFileFormat (HexagonalGridScenarioHelper::NO_FILE);
+  grid.SetSitesNumber (numSites);
+  grid.SetUtNumber (ueNum);
+  grid.CreateScenario ();
+  const NodeContainer &gnbContainer = grid.GetBaseStations ();
+  const NodeContainer &ueContainer = grid.GetUserTerminals ();
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<NrHelper> nrHelper = BenchmarkUtils::CreateNrHelper (epcHelper);
+  OperationBandInfo band;
+  BandwidthPartInfoPtrVector allBwps = BenchmarkUtils::InitializeBand (nrHelper, band, centralFrequency, bandwidth);
+
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbAntennaAttribute ("NumRows", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("NumColumns", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement", PointerValue (CreateObject<ThreeGppAntennaModel> ()));
+
+  NetDeviceContainer gnbNetDev = nrHelper->InstallGnbDevice (gnbContainer, allBwps);
+  NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueContainer, allBwps);
+
+  for (uint32_t cellId = 0; cellId < gnbNetDev.GetN (); ++cellId)
+    {
+      Ptr<UniformPlanarArray> antenna =
+        DynamicCast<UniformPlanarArray> (nrHelper->GetGnbPhy (gnbNetDev.Get (cellId), 0)->GetSpectrumPhy ()->GetAntenna ());
+      antenna->SetAttribute ("BearingAngle", DoubleValue (grid.GetAntennaOrientationRadians (cellId)));
+    }
+
+  BenchmarkUtils::UpdateConfig (gnbNetDev, ueNetDev);
+
+  Ipv4InterfaceContainer ueIpIface;
+  BenchmarkUtils::ConnectRemoteHost (epcHelper, ueContainer, ueNetDev, ueIpIface);
+
+  auto start = std::chrono::steady_clock::now ();
+  if (maxRsrp)
+    {
+      nrHelper->AttachToMaxRsrpEnb (ueNetDev, gnbNetDev, candidates);
+    }
+  else
+    {
+      nrHelper->AttachToClosestEnb (ueNetDev, gnbNetDev);
+    }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+
+  BenchmarkUtils::PrintResult ("Sites", grid.GetNumSites ());
+  BenchmarkUtils::PrintResult ("Sectors", gnbNetDev.GetN ());
+  BenchmarkUtils::PrintResult ("UEs", ueNetDev.GetN ());
+  BenchmarkUtils::PrintResult ("Attachment", maxRsrp ? "max RSRP" : "closest");
+  BenchmarkUtils::PrintResult ("Attach time", elapsed.count (), "s");
+  BenchmarkUtils::PrintResult ("Attach time per UE", 1e6 * elapsed.count () / ueNetDev.GetN (), "us");
+
+  Simulator::Destroy ();
+  return 0;
+}
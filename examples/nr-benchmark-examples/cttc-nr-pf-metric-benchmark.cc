@@ -0,0 +1,134 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-pf-metric-benchmark.cc
+ * \brief Cost of the DL proportional fair metric of a slot
+ *
+ * The program runs, without the rest of the stack, the DL loop of
+ * NrMacSchedulerOfdmaPF over `numSlots` slots for `ueNum` full-buffer UEs
+ * (128 by default) in one beam: the potential throughput of every UE, then,
+ * for every RBG of the BWP, the sort of the UEs by their PF metric, the
+ * assignment of the RBG to the first one, and the update of the PF metric
+ * of every UE. Each update asks NrAmc for the TB size of the RB the UE has
+ * in the slot, as the scheduler does. The MCS of the UEs are drawn
+ * uniformly.
+ *
+ * The program prints the wall-clock time per slot, and per TB size request:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-pf-metric-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/nr-module.h"
+#include "benchmark-utils.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrPfMetricBenchmark");
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t ueNum = 128;
+  uint32_t numSlots = 1000;
+  uint32_t bandwidthInRbg = 273;
+  uint32_t rbPerRbg = 1;
+  uint32_t beamSym = 12;
+  double timeWindow = 99.0;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("ueNum",
+                "Number of full-buffer UEs",
+                ueNum);
+  cmd.AddValue ("numSlots",
+                "Number of scheduled slots",
+                numSlots);
+  cmd.AddValue ("bandwidthInRbg",
+                "Number of RBG of the BWP",
+                bandwidthInRbg);
+  cmd.AddValue ("rbPerRbg",
+                "Number of RB per RBG",
+                rbPerRbg);
+  cmd.AddValue ("beamSym",
+                "Number of DL data symbols of a slot",
+                beamSym);
+  cmd.Parse (argc, argv);
+
+  Ptr<NrAmc> amc = CreateObject<NrAmc> ();
+  amc->SetDlMode ();
+
+  Ptr<UniformRandomVariable> mcsRv = CreateObject<UniformRandomVariable> ();
+  mcsRv->SetStream (1);
+  std::vector<NrMacSchedulerNs3::UePtrAndBufferReq> ueVector;
+  for (uint32_t u = 0; u < ueNum; ++u)
+    {
+      auto ue = std::make_shared<NrMacSchedulerUeInfoPF> (1.0, u + 1, BeamConfId (),
+                                                           [rbPerRbg] () { return rbPerRbg; });
+      ue->m_dlMcs.push_back (static_cast<uint8_t> (mcsRv->GetInteger (0, 27)));
+      ue->m_dlCqi.m_ri = 1;
+      ueVector.emplace_back (ue, UINT32_MAX);
+    }
+
+  uint32_t rbgAssignable = 1 * beamSym;
+  uint64_t tbSizeRequests = 0;
+  auto start = std::chrono::steady_clock::now ();
+  for (uint32_t slot = 0; slot < numSlots; ++slot)
+    {
+      NrMacSchedulerNs3::FTResources assigned (0, 0);
+      for (auto &ue : ueVector)
+        {
+          auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoPF> (ue.first);
+          uePtr->ResetDlSchedInfo ();
+          uePtr->CalculatePotentialTPutDl (NrMacSchedulerNs3::FTResources (rbgAssignable * beamSym, beamSym), amc);
+          ++tbSizeRequests;
+        }
+
+      for (uint32_t rbg = 0; rbg < bandwidthInRbg; ++rbg)
+        {
+          std::sort (ueVector.begin (), ueVector.end (), NrMacSchedulerUeInfoPF::CompareUeWeightsDl);
+          ueVector.front ().first->m_dlRBG += rbgAssignable;
+          ueVector.front ().first->m_dlSym = beamSym;
+          assigned.m_rbg += rbgAssignable;
+          assigned.m_sym = beamSym;
+
+          // The scheduler updates the assigned UE and then all the others
+          for (auto &ue : ueVector)
+            {
+              auto uePtr = std::dynamic_pointer_cast<NrMacSchedulerUeInfoPF> (ue.first);
+              uePtr->UpdateDlPFMetric (assigned, timeWindow, amc);
+              tbSizeRequests += uePtr->m_dlRBG > 0 ? 1 : 0;
+            }
+        }
+    }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+
+  BenchmarkUtils::PrintResult ("UEs", ueNum);
+  BenchmarkUtils::PrintResult ("Slots", numSlots);
+  BenchmarkUtils::PrintResult ("RBG per slot", bandwidthInRbg);
+  BenchmarkUtils::PrintResult ("TB size requests", tbSizeRequests);
+  BenchmarkUtils::PrintResult ("Time per slot", 1e6 * elapsed.count () / numSlots, "us");
+  BenchmarkUtils::PrintResult ("Time per request", 1e9 * elapsed.count () / tbSizeRequests, "ns");
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,194 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file cttc-nr-ul-power-control-benchmark.cc
+ * \brief Benchmark of the UL power control with many UL-heavy UEs
+ *
+ * A row of gNBs serves many UEs (1000 by default) that send UL UDP traffic
+ * to a remote host, with the UL power control of the UEs enabled. Every UL
+ * transmission of a UE goes through NrUePowerControl, to compute the power
+ * of its PUSCH, PUCCH or SRS.
+ *
+ * At the end, the program prints the number of PUSCH, PUCCH and SRS powers
+ * computed, and the power computations per second of wall-clock time spent
+ * in Simulator::Run ():
+ *
+ * \code{.unparsed}
+$ ./ns3 run "cttc-nr-ul-power-control-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/antenna-module.h"
+#include "benchmark-utils.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CttcNrUlPowerControlBenchmark");
+
+/**
+ * \brief Count one power computation
+ * \param counter the counter of the channel
+ * \param cellId the cell ID
+ * \param rnti the RNTI of the UE
+ * \param txPower the computed power, in dBm
+ */
+static void
+NotifyTxPower (uint64_t *counter, [[maybe_unused]] uint16_t cellId,
+               [[maybe_unused]] uint16_t rnti, [[maybe_unused]] double txPower)
+{
+  (*counter)++;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t gnbNum = 10;
+  uint32_t ueNum = 1000;
+  double interSiteDistance = 200.0; // m
+  uint16_t numerology = 1;
+  double centralFrequency = 3.5e9;
+  double bandwidth = 100e6;
+  bool closedLoop = true;
+  uint32_t udpPacketSize = 1000;
+  Time packetInterval = MicroSeconds (500);
+  Time appStartTime = MilliSeconds (400);
+  Time simTime = MilliSeconds (1000);
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("gnbNum",
+                "Number of gNBs, on a row",
+                gnbNum);
+  cmd.AddValue ("ueNum",
+                "Number of UEs, dropped around the gNBs",
+                ueNum);
+  cmd.AddValue ("interSiteDistance",
+                "Distance between two neighbour gNBs, in m",
+                interSiteDistance);
+  cmd.AddValue ("numerology",
+                "The numerology to be used",
+                numerology);
+  cmd.AddValue ("bandwidth",
+                "The system bandwidth to be used",
+                bandwidth);
+  cmd.AddValue ("closedLoop",
+                "If true, the UEs use the closed loop power control, driven by the TPC commands",
+                closedLoop);
+  cmd.AddValue ("packetInterval",
+                "Interval between the UL UDP packets of each UE",
+                packetInterval);
+  cmd.AddValue ("simTime",
+                "Simulation time",
+                simTime);
+  cmd.Parse (argc, argv);
+
+  BenchmarkUtils::SetDefaults ();
+  Config::SetDefault ("ns3::NrUePowerControl::ClosedLoop", BooleanValue (closedLoop));
+  Config::SetDefault ("ns3::NrUePowerControl::AccumulationEnabled", BooleanValue (true));
+
+  NodeContainer gnbContainer;
+  gnbContainer.Create (gnbNum);
+  NodeContainer ueContainer;
+  ueContainer.Create (ueNum);
+
+  BenchmarkUtils::PlaceGnbsOnRow (gnbContainer, interSiteDistance);
+  BenchmarkUtils::PlaceUesAroundRow (ueContainer, gnbNum, interSiteDistance, 0);
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<NrHelper> nrHelper = BenchmarkUtils::CreateNrHelper (epcHelper);
+  OperationBandInfo band;
+  BandwidthPartInfoPtrVector allBwps = BenchmarkUtils::InitializeBand (nrHelper, band, centralFrequency, bandwidth);
+
+  nrHelper->SetSchedulerTypeId (TypeId::LookupByName ("ns3::NrMacSchedulerOfdmaRR"));
+
+  nrHelper->SetUePhyAttribute ("EnableUplinkPowerControl", BooleanValue (true));
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbAntennaAttribute ("NumRows", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("NumColumns", UintegerValue (4));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+
+  nrHelper->SetGnbBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("NGBR_LOW_LAT_EMBB", UintegerValue (0));
+
+  NetDeviceContainer gnbNetDev = nrHelper->InstallGnbDevice (gnbContainer, allBwps);
+  NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueContainer, allBwps);
+
+  int64_t randomStream = 2;
+  randomStream += nrHelper->AssignStreams (gnbNetDev, randomStream);
+  randomStream += nrHelper->AssignStreams (ueNetDev, randomStream);
+
+  for (uint32_t i = 0; i < gnbNetDev.GetN (); ++i)
+    {
+      nrHelper->GetGnbPhy (gnbNetDev.Get (i), 0)->SetAttribute ("Numerology", UintegerValue (numerology));
+    }
+
+  BenchmarkUtils::UpdateConfig (gnbNetDev, ueNetDev);
+
+  Ipv4InterfaceContainer ueIpIface;
+  Ptr<Node> remoteHost = BenchmarkUtils::ConnectRemoteHost (epcHelper, ueContainer, ueNetDev, ueIpIface);
+  Ipv4Address remoteHostAddr = BenchmarkUtils::GetRemoteHostAddress (remoteHost);
+
+  nrHelper->AttachToClosestEnb (ueNetDev, gnbNetDev);
+
+  uint16_t ulPort = 2000;
+  ApplicationContainer serverApps;
+  UdpServerHelper ulPacketSink (ulPort);
+  serverApps.Add (ulPacketSink.Install (remoteHost));
+  UdpClientHelper ulClient (remoteHostAddr, ulPort);
+  ulClient.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+  ulClient.SetAttribute ("PacketSize", UintegerValue (udpPacketSize));
+  ulClient.SetAttribute ("Interval", TimeValue (packetInterval));
+  ApplicationContainer clientApps = ulClient.Install (ueContainer);
+  serverApps.Start (appStartTime);
+  clientApps.Start (appStartTime);
+  serverApps.Stop (simTime);
+  clientApps.Stop (simTime);
+
+  uint64_t puschTxPowers = 0;
+  uint64_t pucchTxPowers = 0;
+  uint64_t srsTxPowers = 0;
+  for (uint32_t u = 0; u < ueNetDev.GetN (); ++u)
+    {
+      Ptr<NrUePowerControl> powerControl = nrHelper->GetUePhy (ueNetDev.Get (u), 0)->GetUplinkPowerControl ();
+      powerControl->TraceConnectWithoutContext ("ReportPuschTxPower", MakeBoundCallback (&NotifyTxPower, &puschTxPowers));
+      powerControl->TraceConnectWithoutContext ("ReportPucchTxPower", MakeBoundCallback (&NotifyTxPower, &pucchTxPowers));
+      powerControl->TraceConnectWithoutContext ("ReportSrsTxPower", MakeBoundCallback (&NotifyTxPower, &srsTxPowers));
+    }
+
+  double elapsed = BenchmarkUtils::Run (simTime);
+
+  uint64_t txPowers = puschTxPowers + pucchTxPowers + srsTxPowers;
+  BenchmarkUtils::PrintResult ("gNBs", gnbNum);
+  BenchmarkUtils::PrintResult ("UEs", ueNum);
+  BenchmarkUtils::PrintResult ("PUSCH powers", puschTxPowers);
+  BenchmarkUtils::PrintResult ("PUCCH powers", pucchTxPowers);
+  BenchmarkUtils::PrintResult ("SRS powers", srsTxPowers);
+  BenchmarkUtils::PrintResult ("Wall-clock time", elapsed, "s");
+  BenchmarkUtils::PrintResult ("Power computations/s", txPowers / elapsed);
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -505,6 +505,7 @@ main (int argc, char *argv[])
   Ptr<NrSlProseHelper> nrSlProseHelper = CreateObject <NrSlProseHelper> ();
   // Install ProSe layer and corresponding SAPs in the UEs
   nrSlProseHelper->PrepareUesForProse (ueVoiceNetDev);
+  stream += nrSlProseHelper->AssignStreams (ueVoiceNetDev, stream);
 
   /*
    * Setup discovery applications 
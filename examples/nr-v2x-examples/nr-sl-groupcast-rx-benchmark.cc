@@ -0,0 +1,312 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file nr-sl-groupcast-rx-benchmark.cc
+ * \brief Benchmark of the sidelink reception path with many receivers
+ *
+ * One UE sends groupcast sidelink traffic to many receivers (100 by default),
+ * all of them in range, out of coverage. Every PSSCH transmission is thus
+ * decoded by all the receivers, and each of them goes through
+ * NrUeMac::DoReceivePsschPhyPdu to extract the SCI stage 2 and the RLC PDUs.
+ *
+ * No trace of the MAC is connected, as the MAC copies the received packets
+ * for its RLC PDU trace only when a sink is connected. The PSSCH TBs
+ * received by the PHY are counted through the RxPsschTraceUe trace of
+ * NrSpectrumPhy, and the packets received by the applications through
+ * PacketSink.
+ *
+ * At the end, the program prints these counters and the PSSCH TBs received
+ * per second of wall-clock time spent in Simulator::Run ():
+ *
+ * \code{.unparsed}
+$ ./ns3 run "nr-sl-groupcast-rx-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/antenna-module.h"
+#include <chrono>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("NrSlGroupcastRxBenchmark");
+
+/**
+ * \brief Count the PSSCH TBs received without errors
+ * \param counter the counter
+ * \param params the parameters of the received TB
+ */
+static void
+NotifySlPsschRx (uint64_t *counter, const SlRxDataPacketTraceParams params)
+{
+  if (!params.m_corrupt)
+    {
+      (*counter)++;
+    }
+}
+
+/**
+ * \brief Count a packet received by a sink application
+ * \param counter the counter
+ * \param packet the packet
+ * \param from the address of the transmitter
+ */
+static void
+NotifyAppRx (uint64_t *counter, [[maybe_unused]] Ptr<const Packet> packet,
+             [[maybe_unused]] const Address &from)
+{
+  (*counter)++;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t numReceivers = 100;
+  double interUeDistance = 5.0; // m
+  uint32_t udpPacketSize = 200;
+  double dataRate = 64; // kbps
+  Time slBearersActivationTime = Seconds (2.0);
+  Time simTime = Seconds (5.0);
+  uint16_t numerologyBwpSl = 2;
+  double centralFrequencyBandSl = 5.89e9;
+  uint16_t bandwidthBandSl = 400; // Multiple of 100 KHz; 400 = 40 MHz
+  double txPower = 23; // dBm
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("numReceivers",
+                "Number of UEs that receive each transmission",
+                numReceivers);
+  cmd.AddValue ("interUeDistance",
+                "Distance between two neighbour UEs of the grid, in m",
+                interUeDistance);
+  cmd.AddValue ("packetSize",
+                "Size of the UDP packets, in bytes",
+                udpPacketSize);
+  cmd.AddValue ("dataRate",
+                "Data rate of the transmitter, in kilobits per second",
+                dataRate);
+  cmd.AddValue ("simTime",
+                "Simulation time after the activation of the bearers",
+                simTime);
+  cmd.AddValue ("numerologyBwpSl",
+                "The numerology to be used in the sidelink bandwidth part",
+                numerologyBwpSl);
+  cmd.Parse (argc, argv);
+
+  Time finalSlBearersActivationTime = slBearersActivationTime + MilliSeconds (10);
+  Time finalSimTime = simTime + finalSlBearersActivationTime;
+
+  Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (999999999));
+  Config::SetDefault ("ns3::ThreeGppChannelModel::UpdatePeriod", TimeValue (MilliSeconds (100)));
+
+  // UE 0 transmits; the receivers are on a grid of ten columns around it
+  NodeContainer ueContainer;
+  ueContainer.Create (numReceivers + 1);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "MinX", DoubleValue (-4.5 * interUeDistance),
+                                 "MinY", DoubleValue (0.0),
+                                 "Z", DoubleValue (1.5),
+                                 "DeltaX", DoubleValue (interUeDistance),
+                                 "DeltaY", DoubleValue (interUeDistance),
+                                 "GridWidth", UintegerValue (10),
+                                 "LayoutType", StringValue ("RowFirst"));
+  mobility.Install (ueContainer);
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  nrHelper->SetEpcHelper (epcHelper);
+
+  CcBwpCreator ccBwpCreator;
+  CcBwpCreator::SimpleOperationBandConf bandConfSl (centralFrequencyBandSl, bandwidthBandSl, 1, BandwidthPartInfo::V2V_Highway);
+  OperationBandInfo bandSl = ccBwpCreator.CreateOperationBandContiguousCc (bandConfSl);
+  nrHelper->SetChannelConditionModelAttribute ("UpdatePeriod", TimeValue (MilliSeconds (0)));
+  nrHelper->SetPathlossAttribute ("ShadowingEnabled", BooleanValue (false));
+  nrHelper->InitializeOperationBand (&bandSl);
+  BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps ({bandSl});
+
+  epcHelper->SetAttribute ("S1uLinkDelay", TimeValue (MilliSeconds (0)));
+
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (2));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetUePhyAttribute ("TxPower", DoubleValue (txPower));
+
+  nrHelper->SetUeMacAttribute ("EnableSensing", BooleanValue (false));
+  nrHelper->SetUeMacAttribute ("T1", UintegerValue (2));
+  nrHelper->SetUeMacAttribute ("T2", UintegerValue (33));
+  nrHelper->SetUeMacAttribute ("ActivePoolId", UintegerValue (0));
+  nrHelper->SetUeMacAttribute ("NumSidelinkProcess", UintegerValue (4));
+  nrHelper->SetUeMacAttribute ("EnableBlindReTx", BooleanValue (true));
+
+  uint8_t bwpIdForGbrMcptt = 0;
+  nrHelper->SetBwpManagerTypeId (TypeId::LookupByName ("ns3::NrSlBwpManagerUe"));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("GBR_MC_PUSH_TO_TALK", UintegerValue (bwpIdForGbrMcptt));
+  std::set<uint8_t> bwpIdContainer;
+  bwpIdContainer.insert (bwpIdForGbrMcptt);
+
+  NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueContainer, allBwps);
+  for (auto it = ueNetDev.Begin (); it != ueNetDev.End (); ++it)
+    {
+      DynamicCast<NrUeNetDevice> (*it)->UpdateConfig ();
+    }
+
+  Ptr<NrSlHelper> nrSlHelper = CreateObject <NrSlHelper> ();
+  nrSlHelper->SetEpcHelper (epcHelper);
+  nrSlHelper->SetSlErrorModel ("ns3::NrEesmIrT1");
+  nrSlHelper->SetUeSlAmcAttribute ("AmcModel", EnumValue (NrAmc::ErrorModel));
+  nrSlHelper->SetNrSlSchedulerTypeId (NrSlUeMacSchedulerDefault::GetTypeId ());
+  nrSlHelper->SetUeSlSchedulerAttribute ("FixNrSlMcs", BooleanValue (true));
+  nrSlHelper->SetUeSlSchedulerAttribute ("InitialNrSlMcs", UintegerValue (14));
+  nrSlHelper->PrepareUeForSidelink (ueNetDev, bwpIdContainer);
+
+  // Sidelink pre-configuration, as in cttc-nr-v2x-demo-simple
+  Ptr<NrSlCommResourcePoolFactory> ptrFactory = Create<NrSlCommResourcePoolFactory> ();
+  std::vector <std::bitset<1> > slBitmap = {1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1};
+  ptrFactory->SetSlTimeResources (slBitmap);
+  ptrFactory->SetSlSensingWindow (100); // T0 in ms
+  ptrFactory->SetSlSelectionWindow (5);
+  ptrFactory->SetSlFreqResourcePscch (10); // PSCCH RBs
+  ptrFactory->SetSlSubchannelSize (50);
+  ptrFactory->SetSlMaxNumPerReserve (3);
+  std::list<uint16_t> resourceReservePeriodList = {0, 100}; // in ms
+  ptrFactory->SetSlResourceReservePeriodList (resourceReservePeriodList);
+  LteRrcSap::SlResourcePoolNr pool = ptrFactory->CreatePool ();
+
+  LteRrcSap::SlResourcePoolConfigNr slresoPoolConfigNr;
+  slresoPoolConfigNr.haveSlResourcePoolConfigNr = true;
+  LteRrcSap::SlResourcePoolIdNr slResourcePoolIdNr;
+  slResourcePoolIdNr.id = 0;
+  slresoPoolConfigNr.slResourcePoolId = slResourcePoolIdNr;
+  slresoPoolConfigNr.slResourcePool = pool;
+
+  LteRrcSap::SlBwpPoolConfigCommonNr slBwpPoolConfigCommonNr;
+  slBwpPoolConfigCommonNr.slTxPoolSelectedNormal [slResourcePoolIdNr.id] = slresoPoolConfigNr;
+
+  LteRrcSap::Bwp bwp;
+  bwp.numerology = numerologyBwpSl;
+  bwp.symbolsPerSlots = 14;
+  bwp.rbPerRbg = 1;
+  bwp.bandwidth = bandwidthBandSl;
+
+  LteRrcSap::SlBwpGeneric slBwpGeneric;
+  slBwpGeneric.bwp = bwp;
+  slBwpGeneric.slLengthSymbols = LteRrcSap::GetSlLengthSymbolsEnum (14);
+  slBwpGeneric.slStartSymbol = LteRrcSap::GetSlStartSymbolEnum (0);
+
+  LteRrcSap::SlBwpConfigCommonNr slBwpConfigCommonNr;
+  slBwpConfigCommonNr.haveSlBwpGeneric = true;
+  slBwpConfigCommonNr.slBwpGeneric = slBwpGeneric;
+  slBwpConfigCommonNr.haveSlBwpPoolConfigCommonNr = true;
+  slBwpConfigCommonNr.slBwpPoolConfigCommonNr = slBwpPoolConfigCommonNr;
+
+  LteRrcSap::SlFreqConfigCommonNr slFreConfigCommonNr;
+  for (const auto &it : bwpIdContainer)
+    {
+      slFreConfigCommonNr.slBwpList [it] = slBwpConfigCommonNr;
+    }
+
+  LteRrcSap::TddUlDlConfigCommon tddUlDlConfigCommon;
+  tddUlDlConfigCommon.tddPattern = "DL|DL|DL|F|UL|UL|UL|UL|UL|UL|";
+  LteRrcSap::SlPreconfigGeneralNr slPreconfigGeneralNr;
+  slPreconfigGeneralNr.slTddConfig = tddUlDlConfigCommon;
+
+  LteRrcSap::SlUeSelectedConfig slUeSelectedPreConfig;
+  slUeSelectedPreConfig.slProbResourceKeep = 0;
+  LteRrcSap::SlPsschTxParameters psschParams;
+  psschParams.slMaxTxTransNumPssch = 5;
+  LteRrcSap::SlPsschTxConfigList pscchTxConfigList;
+  pscchTxConfigList.slPsschTxParameters [0] = psschParams;
+  slUeSelectedPreConfig.slPsschTxConfigList = pscchTxConfigList;
+
+  LteRrcSap::SidelinkPreconfigNr slPreConfigNr;
+  slPreConfigNr.slPreconfigGeneral = slPreconfigGeneralNr;
+  slPreConfigNr.slUeSelectedPreConfig = slUeSelectedPreConfig;
+  slPreConfigNr.slPreconfigFreqInfoList [0] = slFreConfigCommonNr;
+  nrSlHelper->InstallNrSlPreConfiguration (ueNetDev, slPreConfigNr);
+
+  int64_t stream = 1;
+  stream += nrHelper->AssignStreams (ueNetDev, stream);
+  stream += nrSlHelper->AssignStreams (ueNetDev, stream);
+
+  InternetStackHelper internet;
+  internet.Install (ueContainer);
+  stream += internet.AssignStreams (ueContainer, stream);
+  epcHelper->AssignUeIpv4Address (ueNetDev);
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  for (uint32_t u = 0; u < ueContainer.GetN (); ++u)
+    {
+      Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ueContainer.Get (u)->GetObject<Ipv4> ());
+      ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+    }
+
+  uint16_t port = 8000;
+  Ipv4Address groupAddress4 ("225.0.0.0");
+  SidelinkInfo slInfo;
+  slInfo.m_castType = SidelinkInfo::CastType::Groupcast;
+  slInfo.m_dstL2Id = 255;
+  slInfo.m_rri = MilliSeconds (100);
+  Ptr<LteSlTft> tft = Create<LteSlTft> (LteSlTft::Direction::BIDIRECTIONAL, groupAddress4, slInfo);
+  nrSlHelper->ActivateNrSlBearer (finalSlBearersActivationTime, ueNetDev, tft);
+
+  OnOffHelper sidelinkClient ("ns3::UdpSocketFactory", InetSocketAddress (groupAddress4, port));
+  sidelinkClient.SetConstantRate (DataRate (std::to_string (dataRate) + "kb/s"), udpPacketSize);
+  ApplicationContainer clientApps = sidelinkClient.Install (ueContainer.Get (0));
+  clientApps.Start (finalSlBearersActivationTime);
+  clientApps.Stop (finalSimTime);
+
+  NodeContainer receivers;
+  for (uint32_t u = 1; u < ueContainer.GetN (); ++u)
+    {
+      receivers.Add (ueContainer.Get (u));
+    }
+  PacketSinkHelper sidelinkSink ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer serverApps = sidelinkSink.Install (receivers);
+  serverApps.Start (slBearersActivationTime);
+
+  uint64_t psschRx = 0;
+  uint64_t appRx = 0;
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::NrUeNetDevice/ComponentCarrierMapUe/*/NrUePhy/NrSpectrumPhyList/*/RxPsschTraceUe",
+                                 MakeBoundCallback (&NotifySlPsschRx, &psschRx));
+  for (uint32_t i = 0; i < serverApps.GetN (); ++i)
+    {
+      serverApps.Get (i)->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&NotifyAppRx, &appRx));
+    }
+
+  Simulator::Stop (finalSimTime);
+  auto start = std::chrono::steady_clock::now ();
+  Simulator::Run ();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+
+  std::cout << "Receivers:            " << numReceivers << std::endl;
+  std::cout << "PSSCH TBs received:   " << psschRx << std::endl;
+  std::cout << "App packets received: " << appRx << std::endl;
+  std::cout << "Wall-clock time:      " << elapsed.count () << " s" << std::endl;
+  std::cout << "PSSCH TBs/s:          " << psschRx / elapsed.count () << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
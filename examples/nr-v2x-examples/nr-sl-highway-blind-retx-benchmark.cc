@@ -0,0 +1,333 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+/**
+ * \ingroup examples
+ * \file nr-sl-highway-blind-retx-benchmark.cc
+ * \brief Benchmark of the sidelink grants of many vehicles with blind retransmissions
+ *
+ * Vehicular UEs (320 by default) drive on a highway, in both directions, out
+ * of coverage. Each of them sends groupcast sidelink traffic to the group
+ * that all of them join, with semi-persistent reservations (100 ms) and up
+ * to `slMaxTxTransNumPssch` blind transmissions of each TB. Every UE thus
+ * holds several grants, each with the slot allocations of its
+ * retransmissions, which NrUeMac visits at every sidelink slot and when it
+ * filters the candidate resources of a new selection.
+ *
+ * The PSSCH TBs received by the PHY are counted through the RxPsschTraceUe
+ * trace of NrSpectrumPhy, and the packets received by the applications
+ * through PacketSink. At the end, the program prints these counters, the
+ * wall-clock time spent in Simulator::Run () and the time per UE:
+ *
+ * \code{.unparsed}
+$ ./ns3 run "nr-sl-highway-blind-retx-benchmark --PrintHelp"
+    \endcode
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/antenna-module.h"
+#include <chrono>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("NrSlHighwayBlindRetxBenchmark");
+
+/**
+ * \brief Count the PSSCH TBs received without errors
+ * \param counter the counter
+ * \param params the parameters of the received TB
+ */
+static void
+NotifySlPsschRx (uint64_t *counter, const SlRxDataPacketTraceParams params)
+{
+  if (!params.m_corrupt)
+    {
+      (*counter)++;
+    }
+}
+
+/**
+ * \brief Count a packet received by a sink application
+ * \param counter the counter
+ * \param packet the packet
+ * \param from the address of the transmitter
+ */
+static void
+NotifyAppRx (uint64_t *counter, [[maybe_unused]] Ptr<const Packet> packet,
+             [[maybe_unused]] const Address &from)
+{
+  (*counter)++;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t ueNum = 320;
+  uint16_t lanesPerDirection = 3;
+  double interVehicleDistance = 20.0; // m
+  double laneWidth = 4.0; // m
+  double speed = 140.0 / 3.6; // m/s
+  uint16_t slMaxTxTransNumPssch = 5;
+  bool enableSensing = true;
+  uint32_t udpPacketSize = 200;
+  double dataRate = 16; // kbps
+  Time slBearersActivationTime = Seconds (2.0);
+  Time simTime = Seconds (2.0);
+  uint16_t numerologyBwpSl = 2;
+  double centralFrequencyBandSl = 5.89e9;
+  uint16_t bandwidthBandSl = 400; // Multiple of 100 KHz; 400 = 40 MHz
+  double txPower = 23; // dBm
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("ueNum",
+                "Number of vehicular UEs, all of them transmitting",
+                ueNum);
+  cmd.AddValue ("lanesPerDirection",
+                "Number of lanes in each direction",
+                lanesPerDirection);
+  cmd.AddValue ("interVehicleDistance",
+                "Distance between two vehicles of the same lane, in m",
+                interVehicleDistance);
+  cmd.AddValue ("slMaxTxTransNumPssch",
+                "Maximum number of transmissions of a TB, blind retransmissions included",
+                slMaxTxTransNumPssch);
+  cmd.AddValue ("enableSensing",
+                "If true, the UEs select their resources with sensing",
+                enableSensing);
+  cmd.AddValue ("packetSize",
+                "Size of the UDP packets, in bytes",
+                udpPacketSize);
+  cmd.AddValue ("dataRate",
+                "Data rate of each UE, in kilobits per second",
+                dataRate);
+  cmd.AddValue ("simTime",
+                "Simulation time after the activation of the bearers",
+                simTime);
+  cmd.AddValue ("numerologyBwpSl",
+                "The numerology to be used in the sidelink bandwidth part",
+                numerologyBwpSl);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (slMaxTxTransNumPssch < 1 || slMaxTxTransNumPssch > 32,
+                   "The number of transmissions of a TB must be in [1, 32]");
+
+  Time finalSlBearersActivationTime = slBearersActivationTime + MilliSeconds (10);
+  Time finalSimTime = simTime + finalSlBearersActivationTime;
+
+  Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (999999999));
+  Config::SetDefault ("ns3::ThreeGppChannelModel::UpdatePeriod", TimeValue (MilliSeconds (100)));
+
+  // The vehicles fill the lanes one after the other; the first lanes go
+  // east, the others west
+  NodeContainer ueContainer;
+  ueContainer.Create (ueNum);
+  uint32_t totalLanes = 2 * lanesPerDirection;
+  uint32_t vehiclesPerLane = (ueNum + totalLanes - 1) / totalLanes;
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (ueContainer);
+  for (uint32_t u = 0; u < ueContainer.GetN (); ++u)
+    {
+      uint32_t lane = u / vehiclesPerLane;
+      Ptr<ConstantVelocityMobilityModel> mm = ueContainer.Get (u)->GetObject<ConstantVelocityMobilityModel> ();
+      mm->SetPosition (Vector ((u % vehiclesPerLane) * interVehicleDistance, lane * laneWidth, 1.6));
+      mm->SetVelocity (Vector (lane < lanesPerDirection ? speed : -speed, 0.0, 0.0));
+    }
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  nrHelper->SetEpcHelper (epcHelper);
+
+  CcBwpCreator ccBwpCreator;
+  CcBwpCreator::SimpleOperationBandConf bandConfSl (centralFrequencyBandSl, bandwidthBandSl, 1, BandwidthPartInfo::V2V_Highway);
+  OperationBandInfo bandSl = ccBwpCreator.CreateOperationBandContiguousCc (bandConfSl);
+  nrHelper->SetChannelConditionModelAttribute ("UpdatePeriod", TimeValue (MilliSeconds (0)));
+  nrHelper->SetPathlossAttribute ("ShadowingEnabled", BooleanValue (false));
+  nrHelper->InitializeOperationBand (&bandSl);
+  BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps ({bandSl});
+
+  epcHelper->SetAttribute ("S1uLinkDelay", TimeValue (MilliSeconds (0)));
+
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (2));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetUePhyAttribute ("TxPower", DoubleValue (txPower));
+
+  nrHelper->SetUeMacAttribute ("EnableSensing", BooleanValue (enableSensing));
+  nrHelper->SetUeMacAttribute ("T1", UintegerValue (2));
+  nrHelper->SetUeMacAttribute ("T2", UintegerValue (33));
+  nrHelper->SetUeMacAttribute ("ActivePoolId", UintegerValue (0));
+  nrHelper->SetUeMacAttribute ("NumSidelinkProcess", UintegerValue (4));
+  nrHelper->SetUeMacAttribute ("EnableBlindReTx", BooleanValue (true));
+
+  uint8_t bwpIdForGbrMcptt = 0;
+  nrHelper->SetBwpManagerTypeId (TypeId::LookupByName ("ns3::NrSlBwpManagerUe"));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("GBR_MC_PUSH_TO_TALK", UintegerValue (bwpIdForGbrMcptt));
+  std::set<uint8_t> bwpIdContainer;
+  bwpIdContainer.insert (bwpIdForGbrMcptt);
+
+  NetDeviceContainer ueNetDev = nrHelper->InstallUeDevice (ueContainer, allBwps);
+  for (auto it = ueNetDev.Begin (); it != ueNetDev.End (); ++it)
+    {
+      DynamicCast<NrUeNetDevice> (*it)->UpdateConfig ();
+    }
+
+  Ptr<NrSlHelper> nrSlHelper = CreateObject <NrSlHelper> ();
+  nrSlHelper->SetEpcHelper (epcHelper);
+  nrSlHelper->SetSlErrorModel ("ns3::NrEesmIrT1");
+  nrSlHelper->SetUeSlAmcAttribute ("AmcModel", EnumValue (NrAmc::ErrorModel));
+  nrSlHelper->SetNrSlSchedulerTypeId (NrSlUeMacSchedulerDefault::GetTypeId ());
+  nrSlHelper->SetUeSlSchedulerAttribute ("FixNrSlMcs", BooleanValue (true));
+  nrSlHelper->SetUeSlSchedulerAttribute ("InitialNrSlMcs", UintegerValue (14));
+  nrSlHelper->PrepareUeForSidelink (ueNetDev, bwpIdContainer);
+
+  // Sidelink pre-configuration, as in cttc-nr-v2x-demo-simple
+  Ptr<NrSlCommResourcePoolFactory> ptrFactory = Create<NrSlCommResourcePoolFactory> ();
+  std::vector <std::bitset<1> > slBitmap = {1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1};
+  ptrFactory->SetSlTimeResources (slBitmap);
+  ptrFactory->SetSlSensingWindow (100); // T0 in ms
+  ptrFactory->SetSlSelectionWindow (5);
+  ptrFactory->SetSlFreqResourcePscch (10); // PSCCH RBs
+  ptrFactory->SetSlSubchannelSize (50);
+  ptrFactory->SetSlMaxNumPerReserve (3);
+  std::list<uint16_t> resourceReservePeriodList = {0, 100}; // in ms
+  ptrFactory->SetSlResourceReservePeriodList (resourceReservePeriodList);
+  LteRrcSap::SlResourcePoolNr pool = ptrFactory->CreatePool ();
+
+  LteRrcSap::SlResourcePoolConfigNr slresoPoolConfigNr;
+  slresoPoolConfigNr.haveSlResourcePoolConfigNr = true;
+  LteRrcSap::SlResourcePoolIdNr slResourcePoolIdNr;
+  slResourcePoolIdNr.id = 0;
+  slresoPoolConfigNr.slResourcePoolId = slResourcePoolIdNr;
+  slresoPoolConfigNr.slResourcePool = pool;
+
+  LteRrcSap::SlBwpPoolConfigCommonNr slBwpPoolConfigCommonNr;
+  slBwpPoolConfigCommonNr.slTxPoolSelectedNormal [slResourcePoolIdNr.id] = slresoPoolConfigNr;
+
+  LteRrcSap::Bwp bwp;
+  bwp.numerology = numerologyBwpSl;
+  bwp.symbolsPerSlots = 14;
+  bwp.rbPerRbg = 1;
+  bwp.bandwidth = bandwidthBandSl;
+
+  LteRrcSap::SlBwpGeneric slBwpGeneric;
+  slBwpGeneric.bwp = bwp;
+  slBwpGeneric.slLengthSymbols = LteRrcSap::GetSlLengthSymbolsEnum (14);
+  slBwpGeneric.slStartSymbol = LteRrcSap::GetSlStartSymbolEnum (0);
+
+  LteRrcSap::SlBwpConfigCommonNr slBwpConfigCommonNr;
+  slBwpConfigCommonNr.haveSlBwpGeneric = true;
+  slBwpConfigCommonNr.slBwpGeneric = slBwpGeneric;
+  slBwpConfigCommonNr.haveSlBwpPoolConfigCommonNr = true;
+  slBwpConfigCommonNr.slBwpPoolConfigCommonNr = slBwpPoolConfigCommonNr;
+
+  LteRrcSap::SlFreqConfigCommonNr slFreConfigCommonNr;
+  for (const auto &it : bwpIdContainer)
+    {
+      slFreConfigCommonNr.slBwpList [it] = slBwpConfigCommonNr;
+    }
+
+  LteRrcSap::TddUlDlConfigCommon tddUlDlConfigCommon;
+  tddUlDlConfigCommon.tddPattern = "DL|DL|DL|F|UL|UL|UL|UL|UL|UL|";
+  LteRrcSap::SlPreconfigGeneralNr slPreconfigGeneralNr;
+  slPreconfigGeneralNr.slTddConfig = tddUlDlConfigCommon;
+
+  LteRrcSap::SlUeSelectedConfig slUeSelectedPreConfig;
+  slUeSelectedPreConfig.slProbResourceKeep = 0;
+  LteRrcSap::SlPsschTxParameters psschParams;
+  psschParams.slMaxTxTransNumPssch = static_cast<uint8_t> (slMaxTxTransNumPssch);
+  LteRrcSap::SlPsschTxConfigList pscchTxConfigList;
+  pscchTxConfigList.slPsschTxParameters [0] = psschParams;
+  slUeSelectedPreConfig.slPsschTxConfigList = pscchTxConfigList;
+
+  LteRrcSap::SidelinkPreconfigNr slPreConfigNr;
+  slPreConfigNr.slPreconfigGeneral = slPreconfigGeneralNr;
+  slPreConfigNr.slUeSelectedPreConfig = slUeSelectedPreConfig;
+  slPreConfigNr.slPreconfigFreqInfoList [0] = slFreConfigCommonNr;
+  nrSlHelper->InstallNrSlPreConfiguration (ueNetDev, slPreConfigNr);
+
+  int64_t stream = 1;
+  stream += nrHelper->AssignStreams (ueNetDev, stream);
+  stream += nrSlHelper->AssignStreams (ueNetDev, stream);
+
+  InternetStackHelper internet;
+  internet.Install (ueContainer);
+  stream += internet.AssignStreams (ueContainer, stream);
+  epcHelper->AssignUeIpv4Address (ueNetDev);
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  for (uint32_t u = 0; u < ueContainer.GetN (); ++u)
+    {
+      Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ueContainer.Get (u)->GetObject<Ipv4> ());
+      ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+    }
+
+  uint16_t port = 8000;
+  Ipv4Address groupAddress4 ("225.0.0.0");
+  SidelinkInfo slInfo;
+  slInfo.m_castType = SidelinkInfo::CastType::Groupcast;
+  slInfo.m_dstL2Id = 255;
+  slInfo.m_rri = MilliSeconds (100);
+  Ptr<LteSlTft> tft = Create<LteSlTft> (LteSlTft::Direction::BIDIRECTIONAL, groupAddress4, slInfo);
+  nrSlHelper->ActivateNrSlBearer (finalSlBearersActivationTime, ueNetDev, tft);
+
+  // The UEs start to transmit at different times, so that their
+  // reservations are spread over the slots
+  OnOffHelper sidelinkClient ("ns3::UdpSocketFactory", InetSocketAddress (groupAddress4, port));
+  sidelinkClient.SetConstantRate (DataRate (std::to_string (dataRate) + "kb/s"), udpPacketSize);
+  ApplicationContainer clientApps = sidelinkClient.Install (ueContainer);
+  Ptr<UniformRandomVariable> startRv = CreateObject<UniformRandomVariable> ();
+  startRv->SetStream (stream++);
+  for (uint32_t i = 0; i < clientApps.GetN (); ++i)
+    {
+      clientApps.Get (i)->SetStartTime (finalSlBearersActivationTime + MilliSeconds (startRv->GetInteger (0, 99)));
+    }
+  clientApps.Stop (finalSimTime);
+
+  PacketSinkHelper sidelinkSink ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer serverApps = sidelinkSink.Install (ueContainer);
+  serverApps.Start (slBearersActivationTime);
+
+  uint64_t psschRx = 0;
+  uint64_t appRx = 0;
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::NrUeNetDevice/ComponentCarrierMapUe/*/NrUePhy/NrSpectrumPhyList/*/RxPsschTraceUe",
+                                 MakeBoundCallback (&NotifySlPsschRx, &psschRx));
+  for (uint32_t i = 0; i < serverApps.GetN (); ++i)
+    {
+      serverApps.Get (i)->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&NotifyAppRx, &appRx));
+    }
+
+  Simulator::Stop (finalSimTime);
+  auto start = std::chrono::steady_clock::now ();
+  Simulator::Run ();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now () - start;
+
+  std::cout << "UEs:                  " << ueNum << std::endl;
+  std::cout << "Max TX per TB:        " << slMaxTxTransNumPssch << std::endl;
+  std::cout << "PSSCH TBs received:   " << psschRx << std::endl;
+  std::cout << "App packets received: " << appRx << std::endl;
+  std::cout << "Wall-clock time:      " << elapsed.count () << " s" << std::endl;
+  std::cout << "Time per UE:          " << 1e3 * elapsed.count () / ueNum << " ms" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -168,6 +168,33 @@ UePacketTraceDb (UeToUePktTxRxOutputStats *stats, Ptr<Node> node, const Address
   stats->Save (txRx, localAddrs, nodeId, imsi, pktSize, srcAddrs, dstAddrs, seq);
 }
 
+/**
+ * \brief Method to listen the application level traces of type TxWithAddresses
+ *        and RxWithAddresses, feeding the online V2X KPI computation.
+ * \param kpi The NrV2xKpiAccumulator computing the KPIs
+ * \param node The pointer to the TX or RX node
+ * \param txRx The string indicating the type of node, i.e., TX or RX
+ * \param p The packet
+ * \param srcAddrs The source address from the trace
+ * \param dstAddrs The destination address from the trace
+ * \param seqTsSizeHeader The SeqTsSizeHeader
+ */
+void
+UePacketTraceKpi (Ptr<NrV2xKpiAccumulator> kpi, Ptr<Node> node,
+                  std::string txRx, Ptr<const Packet> p, const Address &srcAddrs,
+                  [[maybe_unused]] const Address &dstAddrs, const SeqTsSizeHeader &seqTsSizeHeader)
+{
+  uint32_t pktSize = p->GetSize () + seqTsSizeHeader.GetSerializedSize ();
+  if (txRx == "tx")
+    {
+      kpi->NotifyTx (node->GetId (), pktSize, seqTsSizeHeader.GetSeq ());
+    }
+  else
+    {
+      kpi->NotifyRx (node->GetId (), srcAddrs, pktSize, seqTsSizeHeader.GetSeq ());
+    }
+}
+
 /**
  * \brief Trace sink for RxRlcPduWithTxRnti trace of NrUeMac
  * \param stats Pointer to UeRlcRxOutputStats API responsible to write the
@@ -425,6 +452,40 @@ void SavePositionPerIP (V2xKpi *v2xKpi)
 }
 
 
+/**
+ * \brief Register the UEs, with their IP and their initial position, in the
+ *        online V2X KPI computation.
+ * \param kpi The NrV2xKpiAccumulator computing the KPIs
+ * \param useIPv6 If true, register the IPv6 address of the UEs
+ */
+void RegisterKpiNodes (Ptr<NrV2xKpiAccumulator> kpi, bool useIPv6)
+{
+  for (NodeList::Iterator it = NodeList::Begin (); it != NodeList::End (); ++it)
+    {
+      Ptr<Node> node = *it;
+      for (uint32_t j = 0; j < node->GetNDevices (); j++)
+        {
+          Ptr<NrUeNetDevice> uedev = node->GetDevice (j)->GetObject <NrUeNetDevice> ();
+          if (uedev)
+            {
+              Address ip;
+              if (useIPv6)
+                {
+                  ip = node->GetObject<Ipv6L3Protocol> ()->GetAddress (1,1).GetAddress ();
+                }
+              else
+                {
+                  ip = node->GetObject<Ipv4L3Protocol> ()->GetAddress (1,0).GetLocal ();
+                }
+              kpi->AddNode (node->GetId (), uedev->GetImsi (), ip,
+                            node->GetObject<MobilityModel> ()->GetPosition ());
+              break;
+            }
+        }
+    }
+}
+
+
 int
 main (int argc, char *argv[])
 {
@@ -478,6 +539,9 @@ main (int argc, char *argv[])
   bool generateInitialPosGnuScript = false;
   bool generateGifGnuScript = false;
 
+  // Compute the application KPIs online, instead of reading back the pktTxRx table
+  bool streamingKpis = false;
+
   // Where we will store the output files.
   std::string simTag = "default";
   std::string outputDir = "./";
@@ -603,6 +667,10 @@ main (int argc, char *argv[])
   cmd.AddValue ("generateGifGnuScript",
                 "generate gnuplot script to generate GIF to show UEs mobility",
                 generateGifGnuScript);
+  cmd.AddValue ("streamingKpis",
+                "If true, compute the PIR, throughput and PRR while the "
+                "simulation runs, instead of reading back the pktTxRx table",
+                streamingKpis);
 
 
   // Parse the command line
@@ -1195,6 +1263,23 @@ main (int argc, char *argv[])
   SavePositionPerIP (&v2xKpi);
   v2xKpi.SetRangeForV2xKpis (200);
 
+  Ptr<NrV2xKpiAccumulator> kpiAccumulator;
+  if (streamingKpis)
+    {
+      kpiAccumulator = CreateObject<NrV2xKpiAccumulator> ();
+      kpiAccumulator->SetAttribute ("TxAppDuration", TimeValue (Seconds (txAppDuration)));
+      kpiAccumulator->SetAttribute ("Range", DoubleValue (200));
+      RegisterKpiNodes (kpiAccumulator, useIPv6);
+      for (uint16_t ac = 0; ac < clientApps.GetN (); ac++)
+        {
+          clientApps.Get (ac)->TraceConnect ("TxWithSeqTsSize", "tx", MakeBoundCallback (&UePacketTraceKpi, kpiAccumulator, clientApps.Get (ac)->GetNode ()));
+        }
+      for (uint16_t ac = 0; ac < serverApps.GetN (); ac++)
+        {
+          serverApps.Get (ac)->TraceConnect ("RxWithSeqTsSize", "rx", MakeBoundCallback (&UePacketTraceKpi, kpiAccumulator, serverApps.Get (ac)->GetNode ()));
+        }
+    }
+
   if (generateInitialPosGnuScript)
     {
       std::string initPosFileName = "init-pos-ues-" + exampleName + ".txt";
@@ -1225,7 +1310,18 @@ main (int argc, char *argv[])
   pscchPhyStats.EmptyCache ();
   psschPhyStats.EmptyCache ();
   ueRlcRxStats.EmptyCache ();
-  v2xKpi.WriteKpis ();
+  if (streamingKpis)
+    {
+      Ptr<NrStatsSink> kpiSink = CreateObject<NrStatsSink> ();
+      kpiSink->Open (outputDir + exampleName + ".db");
+      kpiAccumulator->WriteKpis (kpiSink);
+      kpiSink->Dispose ();
+      v2xKpi.WritePsschKpis ();
+    }
+  else
+    {
+      v2xKpi.WriteKpis ();
+    }
 
   //GtkConfigStore config;
   // config.ConfigureAttributes ();
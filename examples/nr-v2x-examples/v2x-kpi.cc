@@ -76,6 +76,13 @@ V2xKpi::WriteKpis ()
   SaveAvrgPrr ();
 }
 
+void
+V2xKpi::WritePsschKpis ()
+{
+  ComputePsschTxStats ();
+  ComputePsschTbCorruptionStats ();
+}
+
 void
 V2xKpi::ConsiderAllTx (bool allTx)
 {
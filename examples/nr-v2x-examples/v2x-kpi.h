@@ -71,6 +71,14 @@ public:
    * \brief Write the KPIs in their respective tables in the DB.
    */
   void WriteKpis ();
+  /**
+   * \brief Write only the PSSCH KPIs, i.e., the simultaneous PSSCH TX and
+   * the PSSCH TB corruption stats, in their respective tables in the DB.
+   *
+   * It is meant for the simulations that compute the application KPIs
+   * online, with NrV2xKpiAccumulator.
+   */
+  void WritePsschKpis ();
   /**
    * \brief Consider all TX links while writing the stats, e.g, throughput to the DB.
    *
@@ -20,7 +20,10 @@
 #include <ns3/double.h>
 #include <ns3/mobility-helper.h>
 #include "ns3/constant-velocity-mobility-model.h"
+#include <algorithm>
 #include <cmath>
+#include <fstream>
+#include <iomanip>
 
 namespace ns3 {
 
@@ -34,21 +37,17 @@ HexagonalGridScenarioHelper::~HexagonalGridScenarioHelper ()
 {
 }
 
-const double distTo2ndRing = std::sqrt (3);
-const double distTo4thRing = std::sqrt (7);
-// Site positions in terms of distance and angle w.r.t. the central site
-std::vector<double> HexagonalGridScenarioHelper::siteDistances {0,
-                                                                1, 1, 1, 1, 1, 1,
-                                                                distTo2ndRing, distTo2ndRing, distTo2ndRing, distTo2ndRing, distTo2ndRing, distTo2ndRing,
-                                                                2, 2, 2, 2, 2, 2,
-                                                                distTo4thRing, distTo4thRing, distTo4thRing, distTo4thRing, distTo4thRing, distTo4thRing, distTo4thRing, distTo4thRing, distTo4thRing, distTo4thRing, distTo4thRing, distTo4thRing,
-                                                                3, 3, 3, 3, 3, 3
-};
-
 /*
- * Site angles w.r.t. the central site center.
+ * Site positions on the hexagonal lattice.
  *
- * Note that the angles in the following vector are when looking the deployment in which hexagons are oriented in the following way:
+ * A site is identified by its axial coordinates (q, r) on the lattice, and
+ * is at q * e1 + r * e2 from the central site, where e1 is the vector of
+ * length ISD at 30 degrees and e2 is the vector of length ISD at 90 degrees.
+ * Therefore, its distance from the central site is
+ * sqrt (q^2 + q * r + r^2) * ISD, and it is in the hexagonal ring
+ * max (|q|, |r|, |q + r|).
+ *
+ * Note that the sites are placed when looking the deployment in which hexagons are oriented in the following way:
  *
  *    ^               ______
  *    |              /      \
@@ -73,47 +72,93 @@ std::vector<double> HexagonalGridScenarioHelper::siteDistances {0,
  *
 */
 
-// the angle of the first hexagon of the fourth ring in the first quadrant
-const double ang4thRingAlpha1 = atan2 (1, (3 * sqrt (3))) * (180 / M_PI);
-// the angle of the second hexagon of the fourth ring in the first quadrant
-const double ang4thRingAlpha2 = 90 - atan2 (sqrt (3), 2) * (180 / M_PI);
-// the angle of the third hexagon of the fourth ring in the first quadrant
-const double ang4thRingAlpha3 = 90 - atan2 (3 , (5 * sqrt(3))) * (180 / M_PI);
-
-std::vector<double> HexagonalGridScenarioHelper::siteAngles {0, // 0 ring
-                                                             30, 90, 150, 210, 270, 330, // 1. ring
-                                                              0, 60, 120, 180, 240, 300, // 2. ring
-                                                             30, 90, 150, 210, 270, 330, // 3. ring
-                                                             ang4thRingAlpha1, ang4thRingAlpha2, ang4thRingAlpha3, // 4. ring 1. quadrant
-                                                             180 - ang4thRingAlpha3, 180 - ang4thRingAlpha2, 180 - ang4thRingAlpha1, // 4. ring 2. quadrant
-                                                             180 + ang4thRingAlpha1, 180 + ang4thRingAlpha2, 180 + ang4thRingAlpha3, // 4. ring 3. quadrant
-                                                             - ang4thRingAlpha3, - ang4thRingAlpha2,  -ang4thRingAlpha1,// 4. ring 4. quadrant
-                                                             30, 90, 150, 210, 270, 330  // 5. ring
+/**
+ * \brief A site of the hexagonal lattice
+ */
+struct HexagonalLatticeSite
+{
+  int32_t q {0};        //!< First axial coordinate (along e1)
+  int32_t r {0};        //!< Second axial coordinate (along e2)
+  uint32_t norm {0};    //!< Squared distance from the central site, in ISD units
+  double angle {0.0};   //!< Angle w.r.t. the x-axis in [0, 2 * pi)
 };
 
+/**
+ * \brief Append the sites of a hexagonal ring, sorted by distance from the
+ * central site and then by angle
+ * \param ring The hexagonal ring
+ * \param sites The vector to which the sites are appended
+ */
+static void
+GetHexagonalRing (uint32_t ring, std::vector<HexagonalLatticeSite> &sites)
+{
+  // Axial directions of the 6 neighbors, in counter-clockwise order
+  static const int32_t dirs[6][2] = {{1, 0}, {0, 1}, {-1, 1}, {-1, 0}, {0, -1}, {1, -1}};
+
+  auto first = sites.size ();
+  auto addSite = [&sites] (int32_t q, int32_t r)
+    {
+      HexagonalLatticeSite site;
+      site.q = q;
+      site.r = r;
+      site.norm = static_cast<uint32_t> (q * q + q * r + r * r);
+      // y = (q + 2 * r) / 2, x = q * sqrt (3) / 2; y is exactly 0 on the x-axis
+      site.angle = std::atan2 (q + 2.0 * r, q * std::sqrt (3.0));
+      if (site.angle < 0)
+        {
+          site.angle += 2 * M_PI;
+        }
+      sites.push_back (site);
+    };
+
+  if (ring == 0)
+    {
+      addSite (0, 0);
+      return;
+    }
+
+  int32_t q = 0;
+  int32_t r = -static_cast<int32_t> (ring);
+  for (uint32_t side = 0; side < 6; ++side)
+    {
+      for (uint32_t step = 0; step < ring; ++step)
+        {
+          addSite (q, r);
+          q += dirs[side][0];
+          r += dirs[side][1];
+        }
+    }
+
+  std::sort (sites.begin () + first, sites.end (),
+             [] (const HexagonalLatticeSite &a, const HexagonalLatticeSite &b)
+             {
+               return a.norm < b.norm || (a.norm == b.norm && a.angle < b.angle);
+             });
+}
+
 /**
  * \brief Creates a GNUPLOT with the hexagonal deployment including base stations
  * (BS), their hexagonal cell areas and user terminals (UT). Positions and cell
  * radius must be given in meters
  *
- * \param sitePosVector Vector of site positions
- * \param cellCenterVector Vector of cell center positions
- * \param utPosVector Vector of user terminals positions
+ * \param sitePos Vector of site positions
+ * \param cellCenterPos Vector of cell center positions
+ * \param utPos Vector of user terminals positions
  * \param cellRadius Hexagonal cell radius in meters
  */
 static void
-PlotHexagonalDeployment (const Ptr<const ListPositionAllocator> &sitePosVector,
-                         const Ptr<const ListPositionAllocator> &cellCenterVector,
-                         const Ptr<const ListPositionAllocator> &utPosVector,
+PlotHexagonalDeployment (const std::vector<Vector> &sitePos,
+                         const std::vector<Vector> &cellCenterPos,
+                         const std::vector<Vector> &utPos,
                          double cellRadius)
 {
-  uint16_t numCells = cellCenterVector->GetSize ();
-  uint16_t numSites = sitePosVector->GetSize ();
-  uint16_t numSectors = numCells / numSites;
-  uint16_t numUts = utPosVector->GetSize ();
+  std::size_t numCells = cellCenterPos.size ();
+  std::size_t numSites = sitePos.size ();
+  std::size_t numUts = utPos.size ();
   NS_ASSERT_MSG (numCells > 0, "no cells");
   NS_ASSERT_MSG (numSites > 0, "no sites");
   NS_ASSERT_MSG (numUts > 0,   "no uts");
+  std::size_t numSectors = numCells / numSites;
 
   // Try to open a new GNUPLOT file
   std::ofstream topologyOutfile;
@@ -125,34 +170,36 @@ PlotHexagonalDeployment (const Ptr<const ListPositionAllocator> &sitePosVector,
       NS_ABORT_MSG ("Can't open " << topologyFileName);
     }
 
-  topologyOutfile << "set term pdf" << std::endl;
-  topologyOutfile << "set output \"" << topologyFileRoot << ".pdf\"" << std::endl;
-  topologyOutfile << "set style arrow 1 lc \"black\" lt 1 head filled" << std::endl;
-//  topologyOutfile << "set autoscale" << std::endl;
+  topologyOutfile << "set term pdf\n";
+  topologyOutfile << "set output \"" << topologyFileRoot << ".pdf\"\n";
+  topologyOutfile << "set style arrow 1 lc \"black\" lt 1 head filled\n";
+//  topologyOutfile << "set autoscale\n";
 
-  uint16_t margin = (12 * cellRadius) + 1;  //!< This is the farthest hexagonal vertex from the cell center
-  topologyOutfile << "set xrange [-" << margin << ":" << margin <<"]" << std::endl;
-  topologyOutfile << "set yrange [-" << margin << ":" << margin <<"]" << std::endl;
+  // Farthest hexagonal vertex from the origin
+  double extent = 0.0;
+  for (const auto &cellPos : cellCenterPos)
+    {
+      extent = std::max ({extent, std::abs (cellPos.x), std::abs (cellPos.y)});
+    }
+  uint32_t margin = std::max (12 * cellRadius, extent + cellRadius) + 1;
+  topologyOutfile << "set xrange [-" << margin << ":" << margin <<"]\n";
+  topologyOutfile << "set yrange [-" << margin << ":" << margin <<"]\n";
   //FIXME: Need to recalculate ranges if the scenario origin is different to (0,0)
 
   double arrowLength = cellRadius/4.0;  //<! Control the arrow length that indicates the orientation of the sectorized antenna
-  std::vector<double> hx {0.0,-0.5,-0.5,0.0,0.5,0.5,0.0};   //<! Hexagon vertices in x-axis
-  std::vector<double> hy {-1.0,-0.5,0.5,1.0,0.5,-0.5,-1.0}; //<! Hexagon vertices in y-axis
-  Vector sitePos;
+  const double hx[7] {0.0,-0.5,-0.5,0.0,0.5,0.5,0.0};   //<! Hexagon vertices in x-axis
+  const double hy[7] {-1.0,-0.5,0.5,1.0,0.5,-0.5,-1.0}; //<! Hexagon vertices in y-axis
 
-  for (uint16_t cellId = 0; cellId < numCells; ++cellId)
+  for (std::size_t cellId = 0; cellId < numCells; ++cellId)
     {
-      Vector cellPos = cellCenterVector->GetNext ();
+      const Vector &cellPos = cellCenterPos[cellId];
+      const Vector &site = sitePos[cellId / numSectors];
       double angleDeg = 30 + 120 * (cellId % 3);
       double angleRad = angleDeg * M_PI / 180;
       double x, y;
 
-      if (cellId % numSectors == 0)
-        {
-          sitePos = sitePosVector->GetNext ();
-        }
-      topologyOutfile << "set arrow " << cellId + 1 << " from " << sitePos.x
-          << "," << sitePos.y << " rto " << arrowLength * std::cos(angleRad)
+      topologyOutfile << "set arrow " << cellId + 1 << " from " << site.x
+          << "," << site.y << " rto " << arrowLength * std::cos(angleRad)
       << "," << arrowLength * std::sin(angleRad) << " arrowstyle 1 \n";
 
       // Draw the hexagon arond the cell center
@@ -161,8 +208,8 @@ PlotHexagonalDeployment (const Ptr<const ListPositionAllocator> &sitePosVector,
       for (uint16_t vertexId = 0; vertexId <= 6; ++vertexId)
         {
           // angle of the vertex w.r.t. y-axis
-          x = cellRadius * std::sqrt(3.0) * hx.at (vertexId) + cellPos.x;
-          y = cellRadius * hy.at (vertexId) + cellPos.y;
+          x = cellRadius * std::sqrt(3.0) * hx[vertexId] + cellPos.x;
+          y = cellRadius * hy[vertexId] + cellPos.y;
           topologyOutfile << x << ", " << y;
           if (vertexId == 6)
             {
@@ -175,62 +222,227 @@ PlotHexagonalDeployment (const Ptr<const ListPositionAllocator> &sitePosVector,
         }
 
       topologyOutfile << "set label " << cellId + 1 << " \"" << (cellId + 1) <<
-          "\" at " << cellPos.x << " , " << cellPos.y << " center" << std::endl;
+          "\" at " << cellPos.x << " , " << cellPos.y << " center\n";
 
     }
 
-  for (uint16_t utId = 0; utId < numUts; ++utId)
+  for (const auto &pos : utPos)
     {
-      Vector utPos = utPosVector->GetNext ();
 //      set label at xPos, yPos, zPos "" point pointtype 7 pointsize 2
-      topologyOutfile << "set label at " << utPos.x << " , " << utPos.y <<
-          " point pointtype 7 pointsize 0.2 center" << std::endl;
+      topologyOutfile << "set label at " << pos.x << " , " << pos.y <<
+          " point pointtype 7 pointsize 0.2 center\n";
+    }
+
+   topologyOutfile << "unset key\n"; //!< Disable plot legends
+   topologyOutfile << "plot 1/0\n";  //!< Need to plot a function
+
+}
+
+/**
+ * \brief Writes the positions of the sites, cell centers and user terminals
+ * (UT) in a CSV file, one "type,id,x,y,z" line per position
+ *
+ * \param sitePos Vector of site positions
+ * \param cellCenterPos Vector of cell center positions
+ * \param utPos Vector of user terminals positions
+ */
+static void
+WriteHexagonalDeploymentCsv (const std::vector<Vector> &sitePos,
+                             const std::vector<Vector> &cellCenterPos,
+                             const std::vector<Vector> &utPos)
+{
+  std::string topologyFileName = "./hexagonal-topology.csv";
+  std::ofstream topologyOutfile (topologyFileName.c_str (), std::ios_base::out | std::ios_base::trunc);
+  if (!topologyOutfile.is_open ())
+    {
+      NS_ABORT_MSG ("Can't open " << topologyFileName);
+    }
+
+  topologyOutfile << std::fixed << std::setprecision (3);
+  topologyOutfile << "type,id,x,y,z\n";
+  auto writePositions = [&topologyOutfile] (const char *type, const std::vector<Vector> &positions)
+    {
+      for (std::size_t i = 0; i < positions.size (); ++i)
+        {
+          topologyOutfile << type << "," << i << "," << positions[i].x << ","
+                          << positions[i].y << "," << positions[i].z << "\n";
+        }
+    };
+  writePositions ("site", sitePos);
+  writePositions ("cell", cellCenterPos);
+  writePositions ("ut", utPos);
+}
+
+/**
+ * \brief Writes the positions of the sites, cell centers and user terminals
+ * (UT) in a binary file. For each of them, the file has the number of
+ * positions (uint32_t) followed by the x, y and z of each position (double),
+ * in the byte order of the host
+ *
+ * \param sitePos Vector of site positions
+ * \param cellCenterPos Vector of cell center positions
+ * \param utPos Vector of user terminals positions
+ */
+static void
+WriteHexagonalDeploymentBinary (const std::vector<Vector> &sitePos,
+                                const std::vector<Vector> &cellCenterPos,
+                                const std::vector<Vector> &utPos)
+{
+  std::string topologyFileName = "./hexagonal-topology.bin";
+  std::ofstream topologyOutfile (topologyFileName.c_str (),
+                                 std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  if (!topologyOutfile.is_open ())
+    {
+      NS_ABORT_MSG ("Can't open " << topologyFileName);
     }
 
-   topologyOutfile << "unset key" << std::endl; //!< Disable plot legends
-   topologyOutfile << "plot 1/0" << std::endl;  //!< Need to plot a function
+  std::vector<double> coordinates;
+  for (const auto positions : {&sitePos, &cellCenterPos, &utPos})
+    {
+      uint32_t size = static_cast<uint32_t> (positions->size ());
+      coordinates.resize (3 * positions->size ());
+      for (std::size_t i = 0; i < positions->size (); ++i)
+        {
+          coordinates[3 * i] = (*positions)[i].x;
+          coordinates[3 * i + 1] = (*positions)[i].y;
+          coordinates[3 * i + 2] = (*positions)[i].z;
+        }
+      topologyOutfile.write (reinterpret_cast<const char *> (&size), sizeof (size));
+      topologyOutfile.write (reinterpret_cast<const char *> (coordinates.data ()),
+                             coordinates.size () * sizeof (double));
+    }
+}
 
+/**
+ * \brief Build a position allocator from a vector of positions
+ * \param positions The positions
+ * \return A ListPositionAllocator with the positions, in the same order
+ */
+static Ptr<ListPositionAllocator>
+CreatePositionAllocator (const std::vector<Vector> &positions)
+{
+  Ptr<ListPositionAllocator> allocator = CreateObject<ListPositionAllocator> ();
+  for (const auto &pos : positions)
+    {
+      allocator->Add (pos);
+    }
+  return allocator;
 }
 
 void
 HexagonalGridScenarioHelper::SetNumRings (uint8_t numRings)
 {
-  NS_ABORT_MSG_IF(numRings > 5, "Unsupported number of outer rings (Maximum is 5");
-
   m_numRings = numRings;
 
-  /*
-   * 0 rings = 1 + 6 * 0 = 1 site
-   * 1 rings = 1 + 6 * 1 = 7 sites
-   * 2 rings = 1 + 6 * 2 = 13 sites
-   * 3 rings = 1 + 6 * 3 = 19 site5
-   * 4 rings = 1 + 6 * 5 = 31 sites
-   * 5 rings = 1 + 6 * 6 = 37 sites
-   */
-  switch (numRings)
-  {
-    case 0:
-      m_numSites = 1;
-      break;
-    case 1:
-      m_numSites = 7;
-      break;
-    case 2:
-      m_numSites = 13;
-      break;
-    case 3:
-      m_numSites = 19;
-      break;
-    case 4:
-      m_numSites = 31;
-      break;
-    case 5:
-      m_numSites = 37;
-      break;
-  }
+  // Count the sites up to the last outer ring, i.e., the last group of sites
+  // with the same distance inside a hexagonal ring
+  std::size_t numSites = 1;
+  uint32_t outerRing = 0;
+  std::vector<HexagonalLatticeSite> sites;
+  for (uint32_t ring = 1; outerRing < numRings; ++ring)
+    {
+      sites.clear ();
+      GetHexagonalRing (ring, sites);
+      for (std::size_t i = 0; i < sites.size (); ++i)
+        {
+          if (i == 0 || sites[i].norm != sites[i - 1].norm)
+            {
+              if (++outerRing > numRings)
+                {
+                  break;
+                }
+            }
+          ++numSites;
+        }
+    }
+
+  m_numSites = numSites;
   SetSitesNumber (m_numSites);
 }
 
+std::vector<Vector>
+HexagonalGridScenarioHelper::GetSitePositions () const
+{
+  std::vector<Vector> positions;
+  positions.reserve (m_numSites);
+
+  std::vector<HexagonalLatticeSite> sites;
+  for (uint32_t ring = 0; positions.size () < m_numSites; ++ring)
+    {
+      sites.clear ();
+      GetHexagonalRing (ring, sites);
+      for (const auto &site : sites)
+        {
+          if (positions.size () == m_numSites)
+            {
+              break;
+            }
+          positions.emplace_back (m_centralPos.x + m_isd * site.q * std::sqrt (3.0) / 2,
+                                  m_centralPos.y + m_isd * (site.q / 2.0 + site.r),
+                                  m_bsHeight);
+        }
+    }
+  return positions;
+}
+
+const std::array<Vector, 6> &
+HexagonalGridScenarioHelper::GetWrapAroundOffsets () const
+{
+  if (m_wrapAroundNumSites == m_numSites && m_wrapAroundIsd == m_isd)
+    {
+      return m_wrapAroundOffsets;
+    }
+
+  // Number of hexagonal rings n, from 1 + 3 * n * (n + 1) sites
+  int32_t numHexRings = static_cast<int32_t> (std::round ((std::sqrt (12.0 * m_numSites - 3) - 3) / 6));
+  NS_ABORT_MSG_IF (numHexRings < 1 || 1 + 3 * numHexRings * (numHexRings + 1) != static_cast<int32_t> (m_numSites),
+                   "The wrap-around needs complete hexagonal rings of sites, not " << m_numSites << " sites");
+
+  // The copy of the deployment to the upper right is centered on the site
+  // (n + 1, n) of the lattice, the others are rotated by multiples of 60 degrees
+  int32_t q = numHexRings + 1;
+  int32_t r = numHexRings;
+  for (auto &offset : m_wrapAroundOffsets)
+    {
+      offset = Vector (m_isd * q * std::sqrt (3.0) / 2, m_isd * (q / 2.0 + r), 0.0);
+      int32_t rotatedQ = -r;
+      r = q + r;
+      q = rotatedQ;
+    }
+  m_wrapAroundNumSites = m_numSites;
+  m_wrapAroundIsd = m_isd;
+  return m_wrapAroundOffsets;
+}
+
+Vector
+HexagonalGridScenarioHelper::GetWrapAroundPosition (const Vector &pos, const Vector &refPos) const
+{
+  auto distance2 = [&refPos] (const Vector &p)
+    {
+      return (p.x - refPos.x) * (p.x - refPos.x) + (p.y - refPos.y) * (p.y - refPos.y);
+    };
+
+  Vector closest = pos;
+  double minDistance2 = distance2 (pos);
+  for (const auto &offset : GetWrapAroundOffsets ())
+    {
+      Vector copy (pos.x + offset.x, pos.y + offset.y, pos.z);
+      double d2 = distance2 (copy);
+      if (d2 < minDistance2)
+        {
+          minDistance2 = d2;
+          closest = copy;
+        }
+    }
+  return closest;
+}
+
+void
+HexagonalGridScenarioHelper::SetTopologyFileFormat (TopologyFileFormat format)
+{
+  m_topologyFileFormat = format;
+}
+
 double
 HexagonalGridScenarioHelper::GetHexagonalCellRadius () const
 {
@@ -260,7 +472,7 @@ HexagonalGridScenarioHelper::GetHexagonalCellCenter (const Vector &sitePos,
           center.x += m_hexagonalRadius * std::sqrt (0.75);
           center.y += m_hexagonalRadius / 2;
           break;
-          
+
         case 1:
           center.x -= m_hexagonalRadius * std::sqrt (0.75);
           center.y += m_hexagonalRadius / 2;
@@ -283,57 +495,33 @@ HexagonalGridScenarioHelper::GetHexagonalCellCenter (const Vector &sitePos,
   return center;
 }
 
-
 void
-HexagonalGridScenarioHelper::CreateScenario ()
+HexagonalGridScenarioHelper::CreateBsPositions (std::vector<Vector> &sitePos,
+                                                std::vector<Vector> &bsPos,
+                                                std::vector<Vector> &cellCenterPos) const
 {
-  m_hexagonalRadius = m_isd / 3;
-  
-  m_bs.Create (m_numBs);
-  m_ut.Create (m_numUt);
+  sitePos = GetSitePositions ();
+  bsPos.clear ();
+  bsPos.reserve (m_numBs);
+  cellCenterPos.clear ();
+  cellCenterPos.reserve (m_numBs);
 
-  NS_ASSERT (m_isd > 0);
-  NS_ASSERT (m_numRings < 6);
-  NS_ASSERT (m_hexagonalRadius > 0);
-  NS_ASSERT (m_bsHeight >= 0.0);
-  NS_ASSERT (m_utHeight >= 0.0);
-  NS_ASSERT (m_bs.GetN () > 0);
-  NS_ASSERT (m_ut.GetN () > 0);
-
-  MobilityHelper mobility;
-  Ptr<ListPositionAllocator> bsPosVector = CreateObject<ListPositionAllocator> ();
-  Ptr<ListPositionAllocator> bsCenterVector = CreateObject<ListPositionAllocator> ();
-  Ptr<ListPositionAllocator> sitePosVector = CreateObject<ListPositionAllocator> ();
-  Ptr<ListPositionAllocator> utPosVector = CreateObject<ListPositionAllocator> ();
-
-  // BS position
-  for (uint16_t cellId = 0; cellId < m_numBs; cellId++)
+  for (uint32_t cellId = 0; cellId < m_numBs; cellId++)
     {
-      uint16_t siteIndex = GetSiteIndex (cellId);
-      Vector sitePos (m_centralPos);
-      const double dist = siteDistances.at(siteIndex);
-      const double angleRad = siteAngles.at(siteIndex) * M_PI / 180;
-      sitePos.x += m_isd * dist * cos(angleRad);
-      sitePos.y += m_isd * dist * sin(angleRad);
-      sitePos.z = m_bsHeight;
-
-      if (GetSectorIndex (cellId) == 0)
-        {
-          sitePosVector->Add (sitePos);
-        }
-
       // FIXME: Until sites can have more than one antenna array, it is necessary to apply some distance offset from the site center (gNBs cannot have the same location)
-      Vector bsPos = GetAntennaPosition (sitePos, cellId);
-
-      bsPosVector->Add (bsPos);
+      bsPos.push_back (GetAntennaPosition (sitePos.at (GetSiteIndex (cellId)), cellId));
 
       // Store cell center position for plotting the deployment
-      Vector cellCenterPos = GetHexagonalCellCenter (bsPos, cellId);
-      bsCenterVector->Add (cellCenterPos);
+      cellCenterPos.push_back (GetHexagonalCellCenter (bsPos.back (), cellId));
 
       //What about the antenna orientation? It should be dealt with when installing the gNB
     }
+}
 
+void
+HexagonalGridScenarioHelper::CreateUtPositions (const std::vector<Vector> &cellCenterPos,
+                                                std::vector<Vector> &utPos) const
+{
   // To allocate UEs, I need the center of the hexagonal cell.
   // Allocate UE around the disk of radius isd/3, the diameter of a the
   // hexagon representing the footprint of a single sector.
@@ -351,30 +539,76 @@ HexagonalGridScenarioHelper::CreateScenario ()
   m_theta->SetAttribute ("Min", DoubleValue (-1.0 * M_PI));
   m_theta->SetAttribute ("Max", DoubleValue (M_PI));
 
-  // UT position
-  
-  for (uint32_t utId = 0; utId < m_ut.GetN(); ++utId)
+  // UT position: UE utId is in the cell utId % numCells. The random values
+  // are drawn in UE order, to keep the drop of a given stream unchanged.
+  utPos.resize (m_numUt);
+  for (std::size_t utId = 0; utId < utPos.size (); ++utId)
     {
       double d = std::sqrt (m_r->GetValue ());
       double t = m_theta->GetValue ();
 
-      // Vector utPos (cellCenterPos);
-      Vector utPos (bsCenterVector->GetNext ());
-      utPos.x += d * cos (t);
-      utPos.y += d * sin (t);
-      utPos.z = m_utHeight;
-      
-      utPosVector->Add (utPos);
+      Vector &pos = utPos[utId];
+      pos = cellCenterPos[utId % cellCenterPos.size ()];
+      pos.x += d * cos (t);
+      pos.y += d * sin (t);
+      pos.z = m_utHeight;
+    }
+}
+
+void
+HexagonalGridScenarioHelper::WriteTopology (const std::vector<Vector> &sitePos,
+                                            const std::vector<Vector> &cellCenterPos,
+                                            const std::vector<Vector> &utPos) const
+{
+  switch (m_topologyFileFormat)
+    {
+    case NO_FILE:
+      break;
+    case GNUPLOT_FILE:
+      PlotHexagonalDeployment (sitePos, cellCenterPos, utPos, m_hexagonalRadius);
+      break;
+    case CSV_FILE:
+      WriteHexagonalDeploymentCsv (sitePos, cellCenterPos, utPos);
+      break;
+    case BINARY_FILE:
+      WriteHexagonalDeploymentBinary (sitePos, cellCenterPos, utPos);
+      break;
+    default:
+      NS_ABORT_MSG ("Unknown topology file format " << m_topologyFileFormat);
     }
+}
+
+void
+HexagonalGridScenarioHelper::CreateScenario ()
+{
+  m_hexagonalRadius = m_isd / 3;
+
+  m_bs.Create (m_numBs);
+  m_ut.Create (m_numUt);
+
+  NS_ASSERT (m_isd > 0);
+  NS_ASSERT (m_hexagonalRadius > 0);
+  NS_ASSERT (m_bsHeight >= 0.0);
+  NS_ASSERT (m_utHeight >= 0.0);
+  NS_ASSERT (m_bs.GetN () > 0);
+  NS_ASSERT (m_ut.GetN () > 0);
+
+  std::vector<Vector> sitePos;
+  std::vector<Vector> bsPos;
+  std::vector<Vector> cellCenterPos;
+  std::vector<Vector> utPos;
+  CreateBsPositions (sitePos, bsPos, cellCenterPos);
+  CreateUtPositions (cellCenterPos, utPos);
 
+  MobilityHelper mobility;
   mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
-  mobility.SetPositionAllocator (bsPosVector);
+  mobility.SetPositionAllocator (CreatePositionAllocator (bsPos));
   mobility.Install (m_bs);
 
-  mobility.SetPositionAllocator (utPosVector);
+  mobility.SetPositionAllocator (CreatePositionAllocator (utPos));
   mobility.Install (m_ut);
 
-  PlotHexagonalDeployment (sitePosVector, bsCenterVector, utPosVector, m_hexagonalRadius);
+  WriteTopology (sitePos, cellCenterPos, utPos);
 
 }
 
@@ -387,7 +621,6 @@ HexagonalGridScenarioHelper::CreateScenarioWithMobility (const Vector &speed, do
   m_ut.Create (m_numUt);
 
   NS_ASSERT (m_isd > 0);
-  NS_ASSERT (m_numRings < 6);
   NS_ASSERT (m_hexagonalRadius > 0);
   NS_ASSERT (m_bsHeight >= 0.0);
   NS_ASSERT (m_utHeight >= 0.0);
@@ -396,59 +629,12 @@ HexagonalGridScenarioHelper::CreateScenarioWithMobility (const Vector &speed, do
   NS_ASSERT_MSG (percentage >=0 || percentage <=1, "Percentage must between 0"
                                                    " and 1");
 
-  MobilityHelper mobility;
-  MobilityHelper ueMobility;
-  Ptr<ListPositionAllocator> bsPosVector = CreateObject<ListPositionAllocator> ();
-  Ptr<ListPositionAllocator> bsCenterVector = CreateObject<ListPositionAllocator> ();
-  Ptr<ListPositionAllocator> sitePosVector = CreateObject<ListPositionAllocator> ();
-  Ptr<ListPositionAllocator> utPosVector = CreateObject<ListPositionAllocator> ();
-
-  // BS position
-  for (uint16_t cellId = 0; cellId < m_numBs; cellId++)
-    {
-      uint16_t siteIndex = GetSiteIndex (cellId);
-      Vector sitePos (m_centralPos);
-      const double dist = siteDistances.at(siteIndex);
-      const double angleRad = siteAngles.at(siteIndex) * M_PI / 180;
-      sitePos.x += m_isd * dist * cos(angleRad);
-      sitePos.y += m_isd * dist * sin(angleRad);
-      sitePos.z = m_bsHeight;
-
-      if (GetSectorIndex (cellId) == 0)
-        {
-          sitePosVector->Add (sitePos);
-        }
-
-      // FIXME: Until sites can have more than one antenna array, it is necessary to apply some distance offset from the site center (gNBs cannot have the same location)
-      Vector bsPos = GetAntennaPosition (sitePos, cellId);
-
-      bsPosVector->Add (bsPos);
-
-      // Store cell center position for plotting the deployment
-      Vector cellCenterPos = GetHexagonalCellCenter (bsPos, cellId);
-      bsCenterVector->Add (cellCenterPos);
-
-      //What about the antenna orientation? It should be dealt with when installing the gNB
-    }
-
-  // To allocate UEs, I need the center of the hexagonal cell.
-  // Allocate UE around the disk of radius isd/3, the diameter of a the
-  // hexagon representing the footprint of a single sector.
-  // Reduce this radius by the min BS-UT distance, to respect that standoff
-  // at the one corner of the sector hexagon where the sector antenna lies.
-  // This results in UTs uniformly distributed in a disc centered on
-  // the sector hexagon; there are no UTs near the vertices of the hexagon.
-  // Spread UEs inside the inner hexagonal radius
-  // Need to weight r to get uniform in the sector hexagon
-  // See https://stackoverflow.com/questions/5837572
-  // Set max = radius^2 here, then take sqrt below
-  const double outerR = m_hexagonalRadius * std::sqrt(3) / 2 - m_minBsUtDistance;
-  m_r->SetAttribute ("Min", DoubleValue (0));
-  m_r->SetAttribute ("Max", DoubleValue (outerR * outerR));
-  m_theta->SetAttribute ("Min", DoubleValue (-1.0 * M_PI));
-  m_theta->SetAttribute ("Max", DoubleValue (M_PI));
-
-  // UT position
+  std::vector<Vector> sitePos;
+  std::vector<Vector> bsPos;
+  std::vector<Vector> cellCenterPos;
+  std::vector<Vector> utPos;
+  CreateBsPositions (sitePos, bsPos, cellCenterPos);
+  CreateUtPositions (cellCenterPos, utPos);
 
   uint32_t numUesWithRandomUtHeight = 0;
   if (percentage != 0)
@@ -456,42 +642,22 @@ HexagonalGridScenarioHelper::CreateScenarioWithMobility (const Vector &speed, do
       numUesWithRandomUtHeight = percentage * m_ut.GetN ();
     }
 
-  for (uint32_t utId = 0; utId < m_ut.GetN (); ++utId)
+  for (uint32_t utId = 0; utId < numUesWithRandomUtHeight; ++utId)
     {
-      double d = std::sqrt (m_r->GetValue ());
-      double t = m_theta->GetValue ();
-
-      // Vector utPos (cellCenterPos);
-      Vector utPos (bsCenterVector->GetNext ());
-      utPos.x += d * cos (t);
-      utPos.y += d * sin (t);
-
-      if (numUesWithRandomUtHeight > 0)
-        {
-          Ptr<UniformRandomVariable> uniformRandomVariable = CreateObject<UniformRandomVariable> ();
-          double Nfl = uniformRandomVariable->GetValue (4, 8);
-          double nfl = uniformRandomVariable->GetValue (1, Nfl);
-          utPos.z = 3 * (nfl - 1) + 1.5;
-
-          numUesWithRandomUtHeight--;
-        }
-      else
-        {
-          utPos.z = m_utHeight;
-        }
-
-      utPosVector->Add (utPos);
+      Ptr<UniformRandomVariable> uniformRandomVariable = CreateObject<UniformRandomVariable> ();
+      double Nfl = uniformRandomVariable->GetValue (4, 8);
+      double nfl = uniformRandomVariable->GetValue (1, Nfl);
+      utPos[utId].z = 3 * (nfl - 1) + 1.5;
     }
 
+  MobilityHelper mobility;
+  MobilityHelper ueMobility;
   mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
-  mobility.SetPositionAllocator (bsPosVector);
+  mobility.SetPositionAllocator (CreatePositionAllocator (bsPos));
   mobility.Install (m_bs);
 
-  //mobility.SetPositionAllocator (utPosVector);
-  //mobility.Install (m_ut);
-
   ueMobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
-  ueMobility.SetPositionAllocator (utPosVector);
+  ueMobility.SetPositionAllocator (CreatePositionAllocator (utPos));
   ueMobility.Install (m_ut);
 
   for (uint32_t i = 0; i < m_ut.GetN (); i++)
@@ -500,7 +666,7 @@ HexagonalGridScenarioHelper::CreateScenarioWithMobility (const Vector &speed, do
     }
 
 
-  PlotHexagonalDeployment (sitePosVector, bsCenterVector, utPosVector, m_hexagonalRadius);
+  WriteTopology (sitePos, cellCenterPos, utPos);
 
 }
 
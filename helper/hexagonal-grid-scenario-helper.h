@@ -22,17 +22,34 @@
 #include "node-distribution-scenario-interface.h"
 #include <ns3/vector.h>
 #include <ns3/random-variable-stream.h>
+#include <array>
 
 namespace ns3 {
 
 /**
  * @brief The HexagonalGridScenarioHelper class
  *
- * TODO: Documentation, tests
+ * The sites are placed on a hexagonal lattice with spacing equal to the ISD,
+ * around the central site. The positions are computed analytically, hexagonal
+ * ring by hexagonal ring; inside a ring, the sites are sorted by distance from
+ * the central site and then by angle (counter-clockwise from the x-axis).
+ *
+ * The UEs are dropped in the cells in round robin (UE i is in cell i modulo the
+ * number of cells), uniformly in a disc centered on the cell hexagon.
  */
 class HexagonalGridScenarioHelper : public NodeDistributionScenarioInterface
 {
 public:
+  /**
+   * \brief Format of the topology file written by CreateScenario
+   */
+  enum TopologyFileFormat
+  {
+    NO_FILE,      //!< Do not write the topology
+    GNUPLOT_FILE, //!< Gnuplot script that plots the deployment (hexagonal-topology.gnuplot)
+    CSV_FILE,     //!< One line "type,id,x,y,z" per site, cell center and UE (hexagonal-topology.csv)
+    BINARY_FILE   //!< For the sites, the cell centers and the UEs: number of positions (uint32_t), then x, y, z of each (double) (hexagonal-topology.bin)
+  };
 
   /**
    * \brief HexagonalGridScenarioHelper
@@ -47,33 +64,62 @@ public:
   /**
    * \brief Sets the number of outer rings of sites around the central site
    *
-   * Relation between the number of rings and the number of rings.
-   *
-   * 0 rings = 1 + 6 * 0 = 1 site
-   * 1 rings = 1 + 6 * 1 = 7 sites
-   * 2 rings = 1 + 6 * 2 = 13 sites
-   * 3 rings = 1 + 6 * 3 = 19 sites
-   * 4 rings = 1 + 6 * 4 = 31 sites
-   * 5 rings = 1 + 6 * 5 = 37 sites
+   * An outer ring is a group of sites at the same distance from the central
+   * site, inside the same hexagonal ring. The first outer rings are:
    *
-   * 0 rings = (1 + 6 * 0 ) * 3 = 3 gNBs
-   * 1 rings = (1 + 6 * 1 ) * 3 = 21 gNBs
-   * 2 rings = (1 + 6 * 2 ) * 3 = 39 gNBs
-   * 3 rings = (1 + 6 * 3 ) * 3 = 57 gNBs
-   * 4 rings = (1 + 6 * 5 ) * 3 = 93 gNBs
-   * 5 rings = (1 + 6 * 6 ) * 3 = 111 gNBs
+   * 0 rings = 1 site
+   * 1 rings = 1 + 6 = 7 sites (distance ISD)
+   * 2 rings = 7 + 6 = 13 sites (distance sqrt(3) * ISD)
+   * 3 rings = 13 + 6 = 19 sites (distance 2 * ISD)
+   * 4 rings = 19 + 12 = 31 sites (distance sqrt(7) * ISD)
+   * 5 rings = 31 + 6 = 37 sites (distance 3 * ISD)
+   * 6 rings = 37 + 6 = 43 sites (distance sqrt(12) * ISD)
+   * 7 rings = 43 + 12 = 55 sites (distance sqrt(13) * ISD)
+   * 8 rings = 55 + 6 = 61 sites (distance 4 * ISD)
    *
-   * If 10 UEs per gNB:
+   * and so on, with no upper limit. 1, 3, 5, 8, ... outer rings complete
+   * the first 1, 2, 3, 4, ... hexagonal rings (1 + 3 * n * (n + 1) sites).
    *
-   * 0 rings = (1 + 6 * 0 ) * 3 * 10 = 30 UEs
-   * 1 rings = (1 + 6 * 1 ) * 3 * 10 = 210 UEs
-   * 2 rings = (1 + 6 * 2 ) * 3 * 10 = 390 UEs
-   * 3 rings = (1 + 6 * 3 ) * 3 * 10 = 570 UEs
-   * 4 rings = (1 + 6 * 5 ) * 3 * 10 = 930 UEs
-   * 5 rings = (1 + 6 * 6 ) * 3 * 10  = 1110 UEs
+   * With 3 sectors there are 3 gNBs per site, e.g., 111 gNBs with 5 rings;
+   * with 10 UEs per gNB, 1110 UEs.
    */
   void SetNumRings (uint8_t numRings);
 
+  /**
+   * \brief Get the position of the sites
+   * \return The position of each of the GetNumSites () sites, at height
+   * m_bsHeight
+   */
+  std::vector<Vector> GetSitePositions () const;
+
+  /**
+   * \brief Get the offsets of the 6 copies of the deployment used for the
+   * wrap-around
+   *
+   * The sites must complete n hexagonal rings, i.e., there must be
+   * 1 + 3 * n * (n + 1) sites. The offsets are computed at the first call,
+   * and again only when the number of sites or the ISD change.
+   *
+   * \return The offsets in meters, with z = 0
+   */
+  const std::array<Vector, 6> & GetWrapAroundOffsets () const;
+
+  /**
+   * \brief Get the wrap-around position of a node w.r.t. a reference position
+   * \param pos The position of the node
+   * \param refPos The reference position (e.g., of a UE)
+   * \return The position closest (in the xy plane) to refPos among pos and its
+   * copies in the 6 wrap-around deployments
+   */
+  Vector GetWrapAroundPosition (const Vector &pos, const Vector &refPos) const;
+
+  /**
+   * \brief Set the format of the topology file written by CreateScenario and
+   * CreateScenarioWithMobility
+   * \param format The format of the file (default: GNUPLOT_FILE)
+   */
+  void SetTopologyFileFormat (TopologyFileFormat format);
+
   /**
    * \brief Gets the radius of the hexagonal cell
    * \returns Cell radius in meters
@@ -111,12 +157,40 @@ public:
   int64_t AssignStreams (int64_t stream);
 
 private:
+  /**
+   * \brief Compute the positions of the sites, of the gNBs and of the cell
+   * centers
+   * \param sitePos The position of each site
+   * \param bsPos The position of each gNB
+   * \param cellCenterPos The center of the hexagon of each cell
+   */
+  void CreateBsPositions (std::vector<Vector> &sitePos, std::vector<Vector> &bsPos,
+                          std::vector<Vector> &cellCenterPos) const;
+  /**
+   * \brief Drop the UEs in the cells
+   * \param cellCenterPos The center of the hexagon of each cell
+   * \param utPos The position of each UE, at height m_utHeight
+   */
+  void CreateUtPositions (const std::vector<Vector> &cellCenterPos,
+                          std::vector<Vector> &utPos) const;
+  /**
+   * \brief Write the topology file, in the configured format
+   * \param sitePos The position of each site
+   * \param cellCenterPos The center of the hexagon of each cell
+   * \param utPos The position of each UE
+   */
+  void WriteTopology (const std::vector<Vector> &sitePos,
+                      const std::vector<Vector> &cellCenterPos,
+                      const std::vector<Vector> &utPos) const;
+
   uint8_t m_numRings {0};  //!< Number of outer rings of sites around the central site
   Vector m_centralPos {Vector (0,0,0)};     //!< Central site position
   double m_hexagonalRadius {0.0};  //!< Cell radius
+  TopologyFileFormat m_topologyFileFormat {GNUPLOT_FILE}; //!< Format of the topology file
 
-  static std::vector<double> siteDistances;
-  static std::vector<double> siteAngles;
+  mutable std::array<Vector, 6> m_wrapAroundOffsets; //!< Offsets of the wrap-around copies, for m_wrapAroundNumSites sites
+  mutable std::size_t m_wrapAroundNumSites {0}; //!< Number of sites of m_wrapAroundOffsets, 0 if not computed
+  mutable double m_wrapAroundIsd {0.0}; //!< ISD of m_wrapAroundOffsets
 
   Ptr<UniformRandomVariable> m_r; //!< random variable used for the random generation of the radius
   Ptr<UniformRandomVariable> m_theta; //!< random variable used for the generation of angle
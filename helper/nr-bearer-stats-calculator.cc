@@ -28,10 +28,12 @@
 
 #include "nr-bearer-stats-calculator.h"
 #include "ns3/string.h"
+#include "ns3/boolean.h"
 #include "ns3/nstime.h"
 #include <ns3/log.h>
 #include <vector>
 #include <algorithm>
+#include <cmath>
 
 namespace ns3 {
 
@@ -98,6 +100,12 @@ NrBearerStatsCalculator::GetTypeId (void)
                    StringValue ("NrUlPdcpStatsE2E.txt"),
                    MakeStringAccessor (&NrBearerStatsCalculator::m_ulPdcpOutputFilename),
                    MakeStringChecker ())
+    .AddAttribute ("DelayHistogram",
+                   "If true, keep a fixed-size histogram of the delay of each bearer "
+                   "and add its 95th and 99th percentiles to the output files.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NrBearerStatsCalculator::m_delayHistogram),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -138,18 +146,134 @@ NrBearerStatsCalculator::GetEpoch () const
   return m_epochDuration;
 }
 
+void
+NrBearerStatsCalculator::SampleStats::Update (double v)
+{
+  ++m_count;
+  if (m_count == 1)
+    {
+      m_min = v;
+      m_max = v;
+      m_mean = v;
+      m_s = 0.0;
+      return;
+    }
+  m_min = std::min (m_min, v);
+  m_max = std::max (m_max, v);
+  double prevMean = m_mean;
+  m_mean = prevMean + (v - prevMean) / m_count;
+  m_s += (v - prevMean) * (v - m_mean);
+}
+
+double
+NrBearerStatsCalculator::SampleStats::GetStddev () const
+{
+  return m_count > 1 ? std::sqrt (m_s / (m_count - 1)) : 0.0;
+}
+
+constexpr uint32_t NrBearerStatsCalculator::DelayHistogram::SUB_BUCKET_BITS;
+constexpr uint32_t NrBearerStatsCalculator::DelayHistogram::SUB_BUCKETS;
+constexpr uint32_t NrBearerStatsCalculator::DelayHistogram::NUM_BUCKETS;
+
+uint32_t
+NrBearerStatsCalculator::DelayHistogram::GetBucket (uint64_t v)
+{
+  // Shift the value until it fits in [SUB_BUCKETS, 2 * SUB_BUCKETS); the
+  // number of shifts gives the power of two, the rest the linear bucket
+  uint32_t shift = 0;
+  while ((v >> shift) >= 2 * SUB_BUCKETS)
+    {
+      ++shift;
+    }
+  return shift * SUB_BUCKETS + static_cast<uint32_t> (v >> shift);
+}
+
+uint64_t
+NrBearerStatsCalculator::DelayHistogram::GetBucketUpperBound (uint32_t bucket)
+{
+  if (bucket < 2 * SUB_BUCKETS)
+    {
+      return bucket;
+    }
+  uint32_t shift = bucket / SUB_BUCKETS - 1;
+  uint64_t mantissa = bucket - shift * SUB_BUCKETS;
+  return ((mantissa + 1) << shift) - 1;
+}
+
+void
+NrBearerStatsCalculator::DelayHistogram::Update (uint64_t v)
+{
+  if (m_counts.empty ())
+    {
+      m_counts.resize (NUM_BUCKETS, 0);
+    }
+  ++m_counts[GetBucket (v)];
+  ++m_total;
+  m_max = std::max (m_max, v);
+}
+
+void
+NrBearerStatsCalculator::DelayHistogram::Reset ()
+{
+  if (m_total > 0)
+    {
+      std::fill (m_counts.begin (), m_counts.end (), 0);
+      m_total = 0;
+      m_max = 0;
+    }
+}
+
+uint64_t
+NrBearerStatsCalculator::DelayHistogram::GetQuantile (double q) const
+{
+  if (m_total == 0)
+    {
+      return 0;
+    }
+  uint64_t rank = static_cast<uint64_t> (std::ceil (std::min (std::max (q, 0.0), 1.0) * m_total));
+  rank = std::max<uint64_t> (rank, 1);
+  uint64_t seen = 0;
+  for (uint32_t bucket = 0; bucket < m_counts.size (); ++bucket)
+    {
+      seen += m_counts[bucket];
+      if (seen >= rank)
+        {
+          return std::min (GetBucketUpperBound (bucket), m_max);
+        }
+    }
+  return m_max;
+}
+
+std::size_t
+NrBearerStatsCalculator::DelayHistogram::GetMemoryUsage () const
+{
+  return m_counts.capacity () * sizeof (uint32_t);
+}
+
+void
+NrBearerStatsCalculator::DirectionStats::Reset ()
+{
+  m_txPackets = 0;
+  m_rxPackets = 0;
+  m_txData = 0;
+  m_rxData = 0;
+  m_delay = SampleStats ();
+  m_pduSize = SampleStats ();
+  m_delayHistogram.Reset ();
+}
+
 void
 NrBearerStatsCalculator::UlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, uint32_t packetSize)
 {
   NS_LOG_FUNCTION (this);
 
-  ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_ulCellId[p] = cellId;
-      m_flowId[p] = LteFlowId_t (rnti, lcid);
-      m_ulTxPackets[p]++;
-      m_ulTxData[p] += packetSize;
+      BearerStats &bearer = m_bearerStats[ImsiLcidPair_t (imsi, lcid)];
+      bearer.m_flowId = LteFlowId_t (rnti, lcid);
+      bearer.m_ul.m_cellId = cellId;
+      bearer.m_ul.m_txPackets++;
+      bearer.m_ul.m_txData += packetSize;
     }
   m_pendingOutput = true;
 }
@@ -159,13 +283,13 @@ NrBearerStatsCalculator::DlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti,
 {
   NS_LOG_FUNCTION (this);
 
-  ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_dlCellId[p] = cellId;
-      m_flowId[p] = LteFlowId_t (rnti, lcid);
-      m_dlTxPackets[p]++;
-      m_dlTxData[p] += packetSize;
+      BearerStats &bearer = m_bearerStats[ImsiLcidPair_t (imsi, lcid)];
+      bearer.m_flowId = LteFlowId_t (rnti, lcid);
+      bearer.m_dl.m_cellId = cellId;
+      bearer.m_dl.m_txPackets++;
+      bearer.m_dl.m_txData += packetSize;
     }
   m_pendingOutput = true;
 }
@@ -176,22 +300,18 @@ NrBearerStatsCalculator::UlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti,
 {
   NS_LOG_FUNCTION (this);
 
-  ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_ulCellId[p] = cellId;
-      m_ulRxPackets[p]++;
-      m_ulRxData[p] += packetSize;
-
-      Uint64StatsMap::iterator it = m_ulDelay.find (p);
-      if (it == m_ulDelay.end ())
+      DirectionStats &ul = m_bearerStats[ImsiLcidPair_t (imsi, lcid)].m_ul;
+      ul.m_cellId = cellId;
+      ul.m_rxPackets++;
+      ul.m_rxData += packetSize;
+      ul.m_delay.Update (delay);
+      ul.m_pduSize.Update (packetSize);
+      if (m_delayHistogram)
         {
-          NS_LOG_DEBUG (this << " Creating UL stats calculators for IMSI " << p.m_imsi << " and LCID " << (uint32_t) p.m_lcId);
-          m_ulDelay[p] = CreateObject<MinMaxAvgTotalCalculator<uint64_t> > ();
-          m_ulPduSize[p] = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
+          ul.m_delayHistogram.Update (delay);
         }
-      m_ulDelay[p]->Update (delay);
-      m_ulPduSize[p]->Update (packetSize);
     }
   m_pendingOutput = true;
 }
@@ -201,22 +321,18 @@ NrBearerStatsCalculator::DlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti,
 {
   NS_LOG_FUNCTION (this);
 
-  ImsiLcidPair_t p (imsi, lcid);
   if (Simulator::Now () >= m_startTime)
     {
-      m_dlCellId[p] = cellId;
-      m_dlRxPackets[p]++;
-      m_dlRxData[p] += packetSize;
-
-      Uint64StatsMap::iterator it = m_dlDelay.find (p);
-      if (it == m_dlDelay.end ())
+      DirectionStats &dl = m_bearerStats[ImsiLcidPair_t (imsi, lcid)].m_dl;
+      dl.m_cellId = cellId;
+      dl.m_rxPackets++;
+      dl.m_rxData += packetSize;
+      dl.m_delay.Update (delay);
+      dl.m_pduSize.Update (packetSize);
+      if (m_delayHistogram)
         {
-          NS_LOG_DEBUG (this << " Creating DL stats calculators for IMSI " << p.m_imsi << " and LCID " << (uint32_t) p.m_lcId);
-          m_dlDelay[p] = CreateObject<MinMaxAvgTotalCalculator<uint64_t> > ();
-          m_dlPduSize[p] = CreateObject<MinMaxAvgTotalCalculator<uint32_t> > ();
+          dl.m_delayHistogram.Update (delay);
         }
-      m_dlDelay[p]->Update (delay);
-      m_dlPduSize[p]->Update (packetSize);
     }
   m_pendingOutput = true;
 }
@@ -249,10 +365,18 @@ NrBearerStatsCalculator::ShowResults (void)
       ulOutFile << "% start(s)\tend(s)\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
       ulOutFile << "delay(s)\tstdDev(s)\tmin(s)\tmax(s)\t";
       ulOutFile << "PduSize\tstdDev\tmin\tmax";
+      if (m_delayHistogram)
+        {
+          ulOutFile << "\tdelayP95(s)\tdelayP99(s)";
+        }
       ulOutFile << std::endl;
       dlOutFile << "% start(s)\tend(s)\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
       dlOutFile << "delay(s)\tstdDev(s)\tmin(s)\tmax(s)\t";
       dlOutFile << "PduSize\tstdDev\tmin\tmax";
+      if (m_delayHistogram)
+        {
+          dlOutFile << "\tdelayP95(s)\tdelayP99(s)";
+        }
       dlOutFile << std::endl;
     }
   else
@@ -282,86 +406,75 @@ void
 NrBearerStatsCalculator::WriteUlResults (std::ofstream& outFile)
 {
   NS_LOG_FUNCTION (this);
-
-  // Get the unique IMSI / LCID list
-
-  std::vector < ImsiLcidPair_t > pairVector;
-  for (Uint32Map::iterator it = m_ulTxPackets.begin (); it != m_ulTxPackets.end (); ++it)
-    {
-      if (find (pairVector.begin (), pairVector.end (), (*it).first) == pairVector.end ())
-        {
-          pairVector.push_back ((*it).first);
-        }
-    }
-
-  Time endTime = m_startTime + m_epochDuration;
-  for (std::vector<ImsiLcidPair_t>::iterator it = pairVector.begin (); it != pairVector.end (); ++it)
-    {
-      ImsiLcidPair_t p = *it;
-      outFile << m_startTime.GetSeconds () << "\t";
-      outFile << endTime.GetSeconds () << "\t";
-      outFile << GetUlCellId (p.m_imsi, p.m_lcId) << "\t";
-      outFile << p.m_imsi << "\t";
-      outFile << m_flowId[p].m_rnti << "\t";
-      outFile << (uint32_t) m_flowId[p].m_lcId << "\t";
-      outFile << GetUlTxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlTxData (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlRxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetUlRxData (p.m_imsi, p.m_lcId) << "\t";
-      std::vector<double> stats = GetUlDelayStats (p.m_imsi, p.m_lcId);
-      for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
-        {
-          outFile << (*it) * 1e-9 << "\t";
-        }
-      stats = GetUlPduSizeStats (p.m_imsi, p.m_lcId);
-      for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
-        {
-          outFile << (*it) << "\t";
-        }
-      outFile << std::endl;
-    }
-
-  outFile.close ();
+  WriteResults (outFile, false);
 }
 
 void
 NrBearerStatsCalculator::WriteDlResults (std::ofstream& outFile)
 {
   NS_LOG_FUNCTION (this);
+  WriteResults (outFile, true);
+}
+
+void
+NrBearerStatsCalculator::WriteResults (std::ofstream& outFile, bool dl)
+{
+  NS_LOG_FUNCTION (this << dl);
 
-  // Get the unique IMSI list
-  std::vector < ImsiLcidPair_t > pairVector;
-  for (Uint32Map::iterator it = m_dlTxPackets.begin (); it != m_dlTxPackets.end (); ++it)
+  // Bearers that transmitted in this epoch, in (IMSI, LCID) order as the
+  // previous std::map based output
+  std::vector<std::pair<ImsiLcidPair_t, const BearerStats *> > bearers;
+  bearers.reserve (m_bearerStats.size ());
+  for (const auto &it : m_bearerStats)
     {
-      if (find (pairVector.begin (), pairVector.end (), (*it).first) == pairVector.end ())
+      const DirectionStats &dir = dl ? it.second.m_dl : it.second.m_ul;
+      if (dir.m_txPackets > 0)
         {
-          pairVector.push_back ((*it).first);
+          bearers.emplace_back (it.first, &it.second);
         }
     }
+  std::sort (bearers.begin (), bearers.end (),
+             [] (const std::pair<ImsiLcidPair_t, const BearerStats *> &a,
+                 const std::pair<ImsiLcidPair_t, const BearerStats *> &b)
+             {
+               return a.first < b.first;
+             });
 
   Time endTime = m_startTime + m_epochDuration;
-  for (std::vector<ImsiLcidPair_t>::iterator pair = pairVector.begin (); pair != pairVector.end (); ++pair)
+  for (const auto &it : bearers)
     {
-      ImsiLcidPair_t p = *pair;
+      const ImsiLcidPair_t &p = it.first;
+      const BearerStats &bearer = *it.second;
+      const DirectionStats &dir = dl ? bearer.m_dl : bearer.m_ul;
       outFile << m_startTime.GetSeconds () << "\t";
       outFile << endTime.GetSeconds () << "\t";
-      outFile << GetDlCellId (p.m_imsi, p.m_lcId) << "\t";
+      outFile << dir.m_cellId << "\t";
       outFile << p.m_imsi << "\t";
-      outFile << m_flowId[p].m_rnti << "\t";
-      outFile << (uint32_t) m_flowId[p].m_lcId << "\t";
-      outFile << GetDlTxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlTxData (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlRxPackets (p.m_imsi, p.m_lcId) << "\t";
-      outFile << GetDlRxData (p.m_imsi, p.m_lcId) << "\t";
-      std::vector<double> stats = GetDlDelayStats (p.m_imsi, p.m_lcId);
-      for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
+      outFile << bearer.m_flowId.m_rnti << "\t";
+      outFile << (uint32_t) bearer.m_flowId.m_lcId << "\t";
+      outFile << dir.m_txPackets << "\t";
+      outFile << dir.m_txData << "\t";
+      outFile << dir.m_rxPackets << "\t";
+      outFile << dir.m_rxData << "\t";
+      if (dir.m_delay.m_count > 0)
         {
-          outFile << (*it) * 1e-9 << "\t";
+          outFile << dir.m_delay.m_mean * 1e-9 << "\t";
+          outFile << dir.m_delay.GetStddev () * 1e-9 << "\t";
+          outFile << dir.m_delay.m_min * 1e-9 << "\t";
+          outFile << dir.m_delay.m_max * 1e-9 << "\t";
+          outFile << dir.m_pduSize.m_mean << "\t";
+          outFile << dir.m_pduSize.GetStddev () << "\t";
+          outFile << dir.m_pduSize.m_min << "\t";
+          outFile << dir.m_pduSize.m_max << "\t";
         }
-      stats = GetDlPduSizeStats (p.m_imsi, p.m_lcId);
-      for (std::vector<double>::iterator it = stats.begin (); it != stats.end (); ++it)
+      else
         {
-          outFile << (*it) << "\t";
+          outFile << "0\t0\t0\t0\t0\t0\t0\t0\t";
+        }
+      if (m_delayHistogram)
+        {
+          outFile << dir.m_delayHistogram.GetQuantile (0.95) * 1e-9 << "\t";
+          outFile << dir.m_delayHistogram.GetQuantile (0.99) * 1e-9 << "\t";
         }
       outFile << std::endl;
     }
@@ -374,19 +487,11 @@ NrBearerStatsCalculator::ResetResults (void)
 {
   NS_LOG_FUNCTION (this);
 
-  m_ulTxPackets.erase (m_ulTxPackets.begin (), m_ulTxPackets.end ());
-  m_ulRxPackets.erase (m_ulRxPackets.begin (), m_ulRxPackets.end ());
-  m_ulRxData.erase (m_ulRxData.begin (), m_ulRxData.end ());
-  m_ulTxData.erase (m_ulTxData.begin (), m_ulTxData.end ());
-  m_ulDelay.erase (m_ulDelay.begin (), m_ulDelay.end ());
-  m_ulPduSize.erase (m_ulPduSize.begin (), m_ulPduSize.end ());
-
-  m_dlTxPackets.erase (m_dlTxPackets.begin (), m_dlTxPackets.end ());
-  m_dlRxPackets.erase (m_dlRxPackets.begin (), m_dlRxPackets.end ());
-  m_dlRxData.erase (m_dlRxData.begin (), m_dlRxData.end ());
-  m_dlTxData.erase (m_dlTxData.begin (), m_dlTxData.end ());
-  m_dlDelay.erase (m_dlDelay.begin (), m_dlDelay.end ());
-  m_dlPduSize.erase (m_dlPduSize.begin (), m_dlPduSize.end ());
+  for (auto &it : m_bearerStats)
+    {
+      it.second.m_ul.Reset ();
+      it.second.m_dl.Reset ();
+    }
 }
 
 void
@@ -408,205 +513,194 @@ NrBearerStatsCalculator::EndEpoch (void)
   m_endEpochEvent = Simulator::Schedule (m_epochDuration, &NrBearerStatsCalculator::EndEpoch, this);
 }
 
+const NrBearerStatsCalculator::BearerStats *
+NrBearerStatsCalculator::FindBearer (uint64_t imsi, uint8_t lcid) const
+{
+  auto it = m_bearerStats.find (ImsiLcidPair_t (imsi, lcid));
+  return it == m_bearerStats.end () ? nullptr : &it->second;
+}
+
 uint32_t
 NrBearerStatsCalculator::GetUlTxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulTxPackets[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->m_ul.m_txPackets : 0;
 }
 
 uint32_t
 NrBearerStatsCalculator::GetUlRxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulRxPackets[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->m_ul.m_rxPackets : 0;
 }
 
 uint64_t
 NrBearerStatsCalculator::GetUlTxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulTxData[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->m_ul.m_txData : 0;
 }
 
 uint64_t
 NrBearerStatsCalculator::GetUlRxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulRxData[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->m_ul.m_rxData : 0;
 }
 
 double
 NrBearerStatsCalculator::GetUlDelay (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  Uint64StatsMap::iterator it = m_ulDelay.find (p);
-  if (it == m_ulDelay.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->m_ul.m_delay.m_count == 0)
     {
       NS_LOG_ERROR ("UL delay for " << imsi << " - " << (uint16_t) lcid << " not found");
       return 0;
 
     }
-  return m_ulDelay[p]->getMean ();
+  return bearer->m_ul.m_delay.m_mean;
 }
 
 std::vector<double>
 NrBearerStatsCalculator::GetUlDelayStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  std::vector<double> stats;
-  Uint64StatsMap::iterator it = m_ulDelay.find (p);
-  if (it == m_ulDelay.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->m_ul.m_delay.m_count == 0)
     {
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      return stats;
-
+      return std::vector<double> (4, 0.0);
     }
-  stats.push_back (m_ulDelay[p]->getMean ());
-  stats.push_back (m_ulDelay[p]->getStddev ());
-  stats.push_back (m_ulDelay[p]->getMin ());
-  stats.push_back (m_ulDelay[p]->getMax ());
-  return stats;
+  const SampleStats &s = bearer->m_ul.m_delay;
+  return {s.m_mean, s.GetStddev (), s.m_min, s.m_max};
 }
 
 std::vector<double>
 NrBearerStatsCalculator::GetUlPduSizeStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  std::vector<double> stats;
-  Uint32StatsMap::iterator it = m_ulPduSize.find (p);
-  if (it == m_ulPduSize.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->m_ul.m_pduSize.m_count == 0)
     {
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      return stats;
-
+      return std::vector<double> (4, 0.0);
     }
-  stats.push_back (m_ulPduSize[p]->getMean ());
-  stats.push_back (m_ulPduSize[p]->getStddev ());
-  stats.push_back (m_ulPduSize[p]->getMin ());
-  stats.push_back (m_ulPduSize[p]->getMax ());
-  return stats;
+  const SampleStats &s = bearer->m_ul.m_pduSize;
+  return {s.m_mean, s.GetStddev (), s.m_min, s.m_max};
 }
 
 uint32_t
 NrBearerStatsCalculator::GetDlTxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlTxPackets[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->m_dl.m_txPackets : 0;
 }
 
 uint32_t
 NrBearerStatsCalculator::GetDlRxPackets (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlRxPackets[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->m_dl.m_rxPackets : 0;
 }
 
 uint64_t
 NrBearerStatsCalculator::GetDlTxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlTxData[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->m_dl.m_txData : 0;
 }
 
 uint64_t
 NrBearerStatsCalculator::GetDlRxData (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlRxData[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->m_dl.m_rxData : 0;
 }
 
 uint32_t
 NrBearerStatsCalculator::GetUlCellId (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_ulCellId[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->m_ul.m_cellId : 0;
 }
 
 uint32_t
 NrBearerStatsCalculator::GetDlCellId (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  return m_dlCellId[p];
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  return bearer != nullptr ? bearer->m_dl.m_cellId : 0;
 }
 
 double
 NrBearerStatsCalculator::GetDlDelay (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  Uint64StatsMap::iterator it = m_dlDelay.find (p);
-  if (it == m_dlDelay.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->m_dl.m_delay.m_count == 0)
     {
       NS_LOG_ERROR ("DL delay for " << imsi << " not found");
       return 0;
     }
-  return m_dlDelay[p]->getMean ();
+  return bearer->m_dl.m_delay.m_mean;
 }
 
 std::vector<double>
 NrBearerStatsCalculator::GetDlDelayStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  std::vector<double> stats;
-  Uint64StatsMap::iterator it = m_dlDelay.find (p);
-  if (it == m_dlDelay.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->m_dl.m_delay.m_count == 0)
     {
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      return stats;
-
+      return std::vector<double> (4, 0.0);
     }
-  stats.push_back (m_dlDelay[p]->getMean ());
-  stats.push_back (m_dlDelay[p]->getStddev ());
-  stats.push_back (m_dlDelay[p]->getMin ());
-  stats.push_back (m_dlDelay[p]->getMax ());
-  return stats;
+  const SampleStats &s = bearer->m_dl.m_delay;
+  return {s.m_mean, s.GetStddev (), s.m_min, s.m_max};
 }
 
 std::vector<double>
 NrBearerStatsCalculator::GetDlPduSizeStats (uint64_t imsi, uint8_t lcid)
 {
   NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid);
-  ImsiLcidPair_t p (imsi, lcid);
-  std::vector<double> stats;
-  Uint32StatsMap::iterator it = m_dlPduSize.find (p);
-  if (it == m_dlPduSize.end ())
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr || bearer->m_dl.m_pduSize.m_count == 0)
     {
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      stats.push_back (0.0);
-      return stats;
+      return std::vector<double> (4, 0.0);
+    }
+  const SampleStats &s = bearer->m_dl.m_pduSize;
+  return {s.m_mean, s.GetStddev (), s.m_min, s.m_max};
+}
 
+double
+NrBearerStatsCalculator::GetUlDelayQuantile (uint64_t imsi, uint8_t lcid, double q)
+{
+  NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid << q);
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr)
+    {
+      return 0.0;
+    }
+  return bearer->m_ul.m_delayHistogram.GetQuantile (q) * 1e-9;
+}
+
+double
+NrBearerStatsCalculator::GetDlDelayQuantile (uint64_t imsi, uint8_t lcid, double q)
+{
+  NS_LOG_FUNCTION (this << imsi << (uint16_t) lcid << q);
+  const BearerStats *bearer = FindBearer (imsi, lcid);
+  if (bearer == nullptr)
+    {
+      return 0.0;
     }
-  stats.push_back (m_dlPduSize[p]->getMean ());
-  stats.push_back (m_dlPduSize[p]->getStddev ());
-  stats.push_back (m_dlPduSize[p]->getMin ());
-  stats.push_back (m_dlPduSize[p]->getMax ());
-  return stats;
+  return bearer->m_dl.m_delayHistogram.GetQuantile (q) * 1e-9;
 }
 
 
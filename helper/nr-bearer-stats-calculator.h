@@ -36,6 +36,8 @@
 #include "ns3/lte-common.h"
 #include <string>
 #include <map>
+#include <vector>
+#include <unordered_map>
 #include <fstream>
 #include "nr-bearer-stats-simple.h"
 
@@ -266,6 +268,24 @@ public:
    * @return PDU size statistics average, min, max and standard deviation in seconds
    */
   std::vector<double> GetDlPduSizeStats (uint64_t imsi, uint8_t lcid);
+  /**
+   * Gets a quantile of the uplink RLC to RLC delay of the current epoch,
+   * estimated from the delay histogram (see the DelayHistogram attribute).
+   * @param imsi IMSI of the UE
+   * @param lcid LCID
+   * @param q the quantile, in [0, 1]
+   * @return the delay quantile in seconds, or 0 if not available
+   */
+  double GetUlDelayQuantile (uint64_t imsi, uint8_t lcid, double q);
+  /**
+   * Gets a quantile of the downlink RLC to RLC delay of the current epoch,
+   * estimated from the delay histogram (see the DelayHistogram attribute).
+   * @param imsi IMSI of the UE
+   * @param lcid LCID
+   * @param q the quantile, in [0, 1]
+   * @return the delay quantile in seconds, or 0 if not available
+   */
+  double GetDlDelayQuantile (uint64_t imsi, uint8_t lcid, double q);
   /**
    * \return UL output file name
    */
@@ -275,6 +295,61 @@ public:
    */
   std::string GetDlOutputFilename (void);
 
+  /**
+   * \brief Log-bucketed histogram of non-negative integer values
+   *
+   * Values below 2 * SUB_BUCKETS have their own bucket; above that, every
+   * power of two is split into SUB_BUCKETS linear buckets, so that the
+   * relative error of a quantile is below 1 / SUB_BUCKETS whatever the
+   * magnitude of the values. The memory is fixed and allocated at the
+   * first update.
+   */
+  class DelayHistogram
+  {
+  public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 4; //!< log2 of the buckets per power of two
+    static constexpr uint32_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS; //!< Buckets per power of two
+    static constexpr uint32_t NUM_BUCKETS = (65 - SUB_BUCKET_BITS) * SUB_BUCKETS; //!< Buckets to cover uint64_t
+
+    /**
+     * \brief Add a value
+     * \param v the value
+     */
+    void Update (uint64_t v);
+    /**
+     * \brief Empty the histogram, keeping its memory
+     */
+    void Reset ();
+    /**
+     * \brief Estimate a quantile
+     * \param q the quantile, in [0, 1]
+     * \return the upper bound of the bucket that holds the quantile (at most
+     * the largest value), or 0 if empty
+     */
+    uint64_t GetQuantile (double q) const;
+    /**
+     * \return the bytes allocated for the buckets, which do not depend on
+     * the number or the magnitude of the values
+     */
+    std::size_t GetMemoryUsage () const;
+
+  private:
+    /**
+     * \param v a value
+     * \return the bucket of the value
+     */
+    static uint32_t GetBucket (uint64_t v);
+    /**
+     * \param bucket a bucket
+     * \return the highest value that goes in the bucket
+     */
+    static uint64_t GetBucketUpperBound (uint32_t bucket);
+
+    std::vector<uint32_t> m_counts; //!< Number of values per bucket
+    uint64_t m_total {0};           //!< Number of values
+    uint64_t m_max {0};             //!< Largest value
+  };
+
 private:
   /**
    * Called after each epoch to write collected
@@ -311,22 +386,99 @@ private:
    */
   void EndEpoch (void);
 
+  /**
+   * \brief Running min, max, mean and standard deviation of a sample
+   *
+   * Gives the same figures as MinMaxAvgTotalCalculator (Welford's method,
+   * sample variance) but lives inline in the bearer entry instead of being
+   * a separate Object.
+   */
+  struct SampleStats
+  {
+    /**
+     * \brief Add a value to the sample
+     * \param v the value
+     */
+    void Update (double v);
+    /**
+     * \return the sample standard deviation
+     */
+    double GetStddev () const;
+
+    uint32_t m_count {0}; //!< Number of values
+    double m_min {0.0};   //!< Minimum value
+    double m_max {0.0};   //!< Maximum value
+    double m_mean {0.0};  //!< Running mean
+    double m_s {0.0};     //!< Running sum of squared differences from the mean
+  };
+
+
+  /**
+   * \brief Per-direction counters of a bearer
+   */
+  struct DirectionStats
+  {
+    /**
+     * \brief Clear the counters of the epoch; the cell id is kept
+     */
+    void Reset ();
+
+    uint32_t m_cellId {0};    //!< CellId of the last PDU
+    uint32_t m_txPackets {0}; //!< Number of TX PDUs
+    uint32_t m_rxPackets {0}; //!< Number of RX PDUs
+    uint64_t m_txData {0};    //!< Amount of TX bytes
+    uint64_t m_rxData {0};    //!< Amount of RX bytes
+    SampleStats m_delay;      //!< Delay of the RX PDUs
+    SampleStats m_pduSize;    //!< Size of the RX PDUs
+    DelayHistogram m_delayHistogram; //!< Delay of the RX PDUs, if enabled
+  };
+
+  /**
+   * \brief All the statistics of a (IMSI, LCID) pair
+   */
+  struct BearerStats
+  {
+    LteFlowId_t m_flowId;  //!< (RNTI, LCID) of the bearer
+    DirectionStats m_dl;   //!< DL counters
+    DirectionStats m_ul;   //!< UL counters
+  };
+
+  /**
+   * \brief Hash of an (IMSI, LCID) pair
+   */
+  struct ImsiLcidHash
+  {
+    /**
+     * \param p the pair
+     * \return the hash of the pair
+     */
+    std::size_t operator() (const ImsiLcidPair_t &p) const
+    {
+      return std::hash<uint64_t> () ((p.m_imsi << 8) | p.m_lcId);
+    }
+  };
+
+  /**
+   * \brief Find the statistics of a bearer
+   * \param imsi IMSI of the UE
+   * \param lcid LCID
+   * \return a pointer to the statistics, or nullptr if the bearer is unknown
+   */
+  const BearerStats * FindBearer (uint64_t imsi, uint8_t lcid) const;
+  /**
+   * \brief Write the rows of one direction
+   * \param outFile ofstream for the statistics
+   * \param dl true for the DL counters, false for the UL ones
+   */
+  void WriteResults (std::ofstream& outFile, bool dl);
+
   EventId m_endEpochEvent; //!< Event id for next end epoch event
-  FlowIdMap m_flowId; //!< List of FlowIds, ie. (RNTI, LCID) by (IMSI, LCID) pair
-  Uint32Map m_dlCellId; //!< List of DL CellIds by (IMSI, LCID) pair
-  Uint32Map m_dlTxPackets; //!< Number of DL TX Packets by (IMSI, LCID) pair
-  Uint32Map m_dlRxPackets; //!< Number of DL RX Packets by (IMSI, LCID) pair
-  Uint64Map m_dlTxData; //!< Amount of DL TX Data by (IMSI, LCID) pair
-  Uint64Map m_dlRxData; //!< Amount of DL RX Data by (IMSI, LCID) pair
-  Uint64StatsMap m_dlDelay; //!< DL delay by (IMSI, LCID) pair
-  Uint32StatsMap m_dlPduSize; //!< DL PDU Size by (IMSI, LCID) pair
-  Uint32Map m_ulCellId; //!< List of UL CellIds by (IMSI, LCID) pair
-  Uint32Map m_ulTxPackets; //!< Number of UL TX Packets by (IMSI, LCID) pair
-  Uint32Map m_ulRxPackets; //!< Number of UL RX Packets by (IMSI, LCID) pair
-  Uint64Map m_ulTxData; //!< Amount of UL TX Data by (IMSI, LCID) pair
-  Uint64Map m_ulRxData; //!< Amount of UL RX Data by (IMSI, LCID) pair
-  Uint64StatsMap m_ulDelay; //!< UL delay by (IMSI, LCID) pair
-  Uint32StatsMap m_ulPduSize; //!< UL PDU Size by (IMSI, LCID) pair
+  /**
+   * Statistics by (IMSI, LCID) pair. Entries stay across epochs (only the
+   * counters are cleared), so that cell id and flow id are remembered as
+   * they were with the per-counter maps.
+   */
+  std::unordered_map<ImsiLcidPair_t, BearerStats, ImsiLcidHash> m_bearerStats;
   /**
    * Start time of the on going epoch
    */
@@ -343,6 +495,11 @@ private:
    * true if any output is pending
    */
   bool m_pendingOutput;
+  /**
+   * true if the delay of each bearer goes also in a histogram, to
+   * report the 95th and 99th percentiles
+   */
+  bool m_delayHistogram {false};
   /**
    * Protocol type, by default RLC
    */
@@ -67,49 +67,46 @@ public:
 /**
  * Callback function for DL TX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
  */
 void
-DlTxPduCallback (Ptr<NrBoundCallbackArgument> arg, std::string path,
+DlTxPduCallback (Ptr<NrBoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize)
 {
-  NS_LOG_FUNCTION (path << rnti << (uint16_t)lcid << packetSize);
+  NS_LOG_FUNCTION (rnti << (uint16_t)lcid << packetSize);
   arg->stats->DlTxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize);
 }
 
 /**
  * Callback function for DL RX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
  * /param delay
  */
 void
-DlRxPduCallback (Ptr<NrBoundCallbackArgument> arg, std::string path,
+DlRxPduCallback (Ptr<NrBoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize, uint64_t delay)
 {
-  NS_LOG_FUNCTION (path << rnti << (uint16_t)lcid << packetSize << delay);
+  NS_LOG_FUNCTION (rnti << (uint16_t)lcid << packetSize << delay);
   arg->stats->DlRxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize, delay);
 }
 
 /**
  * Callback function for UL TX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
  */
 void
-UlTxPduCallback (Ptr<NrBoundCallbackArgument> arg, std::string path,
+UlTxPduCallback (Ptr<NrBoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize)
 {
-  NS_LOG_FUNCTION (path << rnti << (uint16_t)lcid << packetSize);
+  NS_LOG_FUNCTION (rnti << (uint16_t)lcid << packetSize);
 
   arg->stats->UlTxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize);
 }
@@ -117,17 +114,16 @@ UlTxPduCallback (Ptr<NrBoundCallbackArgument> arg, std::string path,
 /**
  * Callback function for UL RX statistics for both RLC and PDCP
  * /param arg
- * /param path
  * /param rnti
  * /param lcid
  * /param packetSize
  * /param delay
  */
 void
-UlRxPduCallback (Ptr<NrBoundCallbackArgument> arg, std::string path,
+UlRxPduCallback (Ptr<NrBoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize, uint64_t delay)
 {
-  NS_LOG_FUNCTION (path << rnti << (uint16_t)lcid << packetSize << delay);
+  NS_LOG_FUNCTION (rnti << (uint16_t)lcid << packetSize << delay);
 
   arg->stats->UlRxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize, delay);
 }
@@ -267,30 +263,30 @@ NrBearerStatsConnector::ConnectSrb0Traces (std::string context, uint64_t imsi, u
       arg->stats = m_rlcStats;
 
       // diconnect eventually previously connected SRB0 both at UE and eNB
-      Config::Disconnect (ueRrcPath + "/Srb0/LteRlc/TxPDU",
-                          MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Disconnect (ueRrcPath + "/Srb0/LteRlc/RxPDU",
-                          MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Disconnect (ueManagerPath + "/Srb0/LteRlc/TxPDU",
-                          MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Disconnect (ueManagerPath + "/Srb0/LteRlc/RxPDU",
-                          MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::DisconnectWithoutContext (ueRrcPath + "/Srb0/LteRlc/TxPDU",
+                                        MakeBoundCallback (&UlTxPduCallback, arg));
+      Config::DisconnectWithoutContext (ueRrcPath + "/Srb0/LteRlc/RxPDU",
+                                        MakeBoundCallback (&DlRxPduCallback, arg));
+      Config::DisconnectWithoutContext (ueManagerPath + "/Srb0/LteRlc/TxPDU",
+                                        MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::DisconnectWithoutContext (ueManagerPath + "/Srb0/LteRlc/RxPDU",
+                                        MakeBoundCallback (&UlRxPduCallback, arg));
 
       // connect SRB0 both at UE and eNB
-      Config::Connect (ueRrcPath + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::ConnectWithoutContext (ueRrcPath + "/Srb0/LteRlc/TxPDU",
+                                     MakeBoundCallback (&UlTxPduCallback, arg));
+      Config::ConnectWithoutContext (ueRrcPath + "/Srb0/LteRlc/RxPDU",
+                                     MakeBoundCallback (&DlRxPduCallback, arg));
+      Config::ConnectWithoutContext (ueManagerPath + "/Srb0/LteRlc/TxPDU",
+                                     MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::ConnectWithoutContext (ueManagerPath + "/Srb0/LteRlc/RxPDU",
+                                     MakeBoundCallback (&UlRxPduCallback, arg));
 
       // connect SRB1 at eNB only (at UE SRB1 will be setup later)
-      Config::Connect (ueManagerPath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::ConnectWithoutContext (ueManagerPath + "/Srb1/LteRlc/TxPDU",
+                                     MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::ConnectWithoutContext (ueManagerPath + "/Srb1/LteRlc/RxPDU",
+                                     MakeBoundCallback (&UlRxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -300,10 +296,10 @@ NrBearerStatsConnector::ConnectSrb0Traces (std::string context, uint64_t imsi, u
       arg->stats = m_pdcpStats;
 
       // connect SRB1 at eNB only (at UE SRB1 will be setup later)
-      Config::Connect (ueManagerPath + "/Srb1/LtePdcp/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LtePdcp/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::ConnectWithoutContext (ueManagerPath + "/Srb1/LtePdcp/RxPDU",
+                                     MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::ConnectWithoutContext (ueManagerPath + "/Srb1/LtePdcp/TxPDU",
+                                     MakeBoundCallback (&DlTxPduCallback, arg));
     }
 }
 
@@ -317,10 +313,10 @@ NrBearerStatsConnector::ConnectSrb1TracesUe (std::string ueRrcPath, uint64_t ims
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_rlcStats;
-      Config::Connect (ueRrcPath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
+      Config::ConnectWithoutContext (ueRrcPath + "/Srb1/LteRlc/TxPDU",
+                                     MakeBoundCallback (&UlTxPduCallback, arg));
+      Config::ConnectWithoutContext (ueRrcPath + "/Srb1/LteRlc/RxPDU",
+                                     MakeBoundCallback (&DlRxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -328,10 +324,10 @@ NrBearerStatsConnector::ConnectSrb1TracesUe (std::string ueRrcPath, uint64_t ims
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_pdcpStats;
-      Config::Connect (ueRrcPath + "/Srb1/LtePdcp/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb1/LtePdcp/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
+      Config::ConnectWithoutContext (ueRrcPath + "/Srb1/LtePdcp/RxPDU",
+                                     MakeBoundCallback (&DlRxPduCallback, arg));
+      Config::ConnectWithoutContext (ueRrcPath + "/Srb1/LtePdcp/TxPDU",
+                                     MakeBoundCallback (&UlTxPduCallback, arg));
     }
 }
 
@@ -369,14 +365,14 @@ NrBearerStatsConnector::ConnectTracesUe (std::string context, uint64_t imsi, uin
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_rlcStats;
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath + "/DataRadioBearerMap/*/LteRlc/TxPDU",
+                                     MakeBoundCallback (&UlTxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath + "/DataRadioBearerMap/*/LteRlc/RxPDU",
+                                     MakeBoundCallback (&DlRxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath + "/Srb1/LteRlc/TxPDU",
+                                     MakeBoundCallback (&UlTxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath + "/Srb1/LteRlc/RxPDU",
+                                     MakeBoundCallback (&DlRxPduCallback, arg));
 
     }
   if (m_pdcpStats)
@@ -385,14 +381,14 @@ NrBearerStatsConnector::ConnectTracesUe (std::string context, uint64_t imsi, uin
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_pdcpStats;
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LtePdcp/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (basePath + "/Srb1/LtePdcp/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
+                                     MakeBoundCallback (&DlRxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
+                                     MakeBoundCallback (&UlTxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath + "/Srb1/LtePdcp/RxPDU",
+                                     MakeBoundCallback (&DlRxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath + "/Srb1/LtePdcp/TxPDU",
+                                     MakeBoundCallback (&UlTxPduCallback, arg));
     }
 }
 
@@ -409,18 +405,18 @@ NrBearerStatsConnector::ConnectTracesEnb (std::string context, uint64_t imsi, ui
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_rlcStats;
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath.str () + "/DataRadioBearerMap/*/LteRlc/RxPDU",
+                                     MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath.str () + "/DataRadioBearerMap/*/LteRlc/TxPDU",
+                                     MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath.str () + "/Srb0/LteRlc/RxPDU",
+                                     MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath.str () + "/Srb0/LteRlc/TxPDU",
+                                     MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath.str () + "/Srb1/LteRlc/RxPDU",
+                                     MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath.str () + "/Srb1/LteRlc/TxPDU",
+                                     MakeBoundCallback (&DlTxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -428,14 +424,14 @@ NrBearerStatsConnector::ConnectTracesEnb (std::string context, uint64_t imsi, ui
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_pdcpStats;
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LtePdcp/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath.str () + "/Srb1/LtePdcp/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/TxPDU",
+                                     MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath.str () + "/DataRadioBearerMap/*/LtePdcp/RxPDU",
+                                     MakeBoundCallback (&UlRxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath.str () + "/Srb1/LtePdcp/TxPDU",
+                                     MakeBoundCallback (&DlTxPduCallback, arg));
+      Config::ConnectWithoutContext (basePath.str () + "/Srb1/LtePdcp/RxPDU",
+                                     MakeBoundCallback (&UlRxPduCallback, arg));
     }
 }
 
@@ -128,11 +128,48 @@ NrBearerStatsSimple::DoDispose ()
   NrBearerStatsBase::DoDispose ();
 }
 
+void
+NrBearerStatsSimple::SetStatsSink (const Ptr<NrStatsSink> &sink)
+{
+  NS_LOG_FUNCTION (this << sink);
+  m_statsSink = sink;
+  const std::string protocol = m_protocolType == "RLC" ? "Rlc" : "Pdcp";
+  const std::vector<NrStatsSink::Column> txColumns = {{"Time", NrStatsSink::REAL},
+                                                      {"CellId", NrStatsSink::INTEGER},
+                                                      {"Rnti", NrStatsSink::INTEGER},
+                                                      {"Lcid", NrStatsSink::INTEGER},
+                                                      {"PacketSize", NrStatsSink::INTEGER}};
+  std::vector<NrStatsSink::Column> rxColumns = txColumns;
+  rxColumns.push_back ({"Delay", NrStatsSink::REAL});
+  m_dlTxTable = sink->AddTable (protocol + "DlTx", txColumns);
+  m_dlRxTable = sink->AddTable (protocol + "DlRx", rxColumns);
+  m_ulTxTable = sink->AddTable (protocol + "UlTx", txColumns);
+  m_ulRxTable = sink->AddTable (protocol + "UlRx", rxColumns);
+}
+
+void
+NrBearerStatsSimple::BeginSinkRow (uint32_t table, uint16_t cellId, uint16_t rnti, uint8_t lcid, uint32_t packetSize)
+{
+  m_statsSink->BeginRow (table);
+  m_statsSink->Put (Simulator::Now ().GetSeconds ());
+  m_statsSink->Put (cellId);
+  m_statsSink->Put (rnti);
+  m_statsSink->Put (lcid);
+  m_statsSink->Put (packetSize);
+}
+
 void
 NrBearerStatsSimple::UlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, uint32_t packetSize)
 {
   NS_LOG_FUNCTION (this << cellId << imsi << rnti << (uint32_t) lcid << packetSize);
 
+  if (m_statsSink != nullptr)
+    {
+      BeginSinkRow (m_ulTxTable, cellId, rnti, lcid, packetSize);
+      m_statsSink->EndRow ();
+      return;
+    }
+
   if (!m_ulTxOutFile.is_open ())
     {
       m_ulTxOutFile.open (GetUlTxOutputFilename ().c_str ());
@@ -147,6 +184,13 @@ NrBearerStatsSimple::DlTxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uin
 {
   NS_LOG_FUNCTION (this << cellId << imsi << rnti << (uint32_t) lcid << packetSize);
 
+  if (m_statsSink != nullptr)
+    {
+      BeginSinkRow (m_dlTxTable, cellId, rnti, lcid, packetSize);
+      m_statsSink->EndRow ();
+      return;
+    }
+
   if (!m_dlTxOutFile.is_open ())
     {
       m_dlTxOutFile.open (GetDlTxOutputFilename ().c_str ());
@@ -162,6 +206,14 @@ NrBearerStatsSimple::UlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uin
 {
   NS_LOG_FUNCTION (this << cellId << imsi << rnti << (uint32_t) lcid << packetSize << delay);
 
+  if (m_statsSink != nullptr)
+    {
+      BeginSinkRow (m_ulRxTable, cellId, rnti, lcid, packetSize);
+      m_statsSink->Put (delay * 1e-9);
+      m_statsSink->EndRow ();
+      return;
+    }
+
   if (!m_ulRxOutFile.is_open ())
     {
       m_ulRxOutFile.open (GetUlRxOutputFilename ().c_str ());
@@ -176,6 +228,14 @@ NrBearerStatsSimple::DlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uin
 {
   NS_LOG_FUNCTION (this << cellId << imsi << rnti << (uint32_t) lcid << packetSize << delay);
 
+  if (m_statsSink != nullptr)
+    {
+      BeginSinkRow (m_dlRxTable, cellId, rnti, lcid, packetSize);
+      m_statsSink->Put (delay * 1e-9);
+      m_statsSink->EndRow ();
+      return;
+    }
+
   if (!m_dlRxOutFile.is_open ())
     {
       m_dlRxOutFile.open (GetDlRxOutputFilename ().c_str ());
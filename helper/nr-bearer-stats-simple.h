@@ -26,6 +26,7 @@
 #include "ns3/object.h"
 #include "ns3/basic-data-calculators.h"
 #include "ns3/lte-common.h"
+#include "nr-stats-sink.h"
 #include <string>
 #include <map>
 #include <fstream>
@@ -151,6 +152,17 @@ public:
    */
   std::string GetDlRxOutputFilename (void);
 
+  /**
+   * \brief Store the statistics in a NrStatsSink instead of the text files
+   * \param sink the (already open) sink
+   *
+   * The rows go in the tables "<Protocol>DlTx", "<Protocol>DlRx",
+   * "<Protocol>UlTx" and "<Protocol>UlRx", where <Protocol> is "Rlc" or
+   * "Pdcp". They have the columns of the text files; the delay of the RX
+   * tables is in seconds.
+   */
+  void SetStatsSink (const Ptr<NrStatsSink> &sink);
+
   /**
    * Notifies the stats calculator that an uplink transmission has occurred.
    * @param cellId CellId of the attached Enb
@@ -194,6 +206,15 @@ public:
   virtual void DlRxPdu (uint16_t cellId, uint64_t imsi, uint16_t rnti, uint8_t lcid, uint32_t packetSize, uint64_t delay) override;
 
 private:
+  /**
+   * \brief Start a row in the stats sink, and set the columns common to TX and RX
+   * \param table the table of the row
+   * \param cellId CellId of the attached Enb
+   * \param rnti C-RNTI of the UE
+   * \param lcid LCID of the PDU
+   * \param packetSize size of the PDU in bytes
+   */
+  void BeginSinkRow (uint32_t table, uint16_t cellId, uint16_t rnti, uint8_t lcid, uint32_t packetSize);
 
   /**
    * Protocol type, by default RLC
@@ -211,6 +232,11 @@ private:
   std::ofstream m_dlRxOutFile; //!< Output file strem to which DL RLC RX stats will be written
   std::ofstream m_ulTxOutFile; //!< Output file strem to which UL RLC TX stats will be written
   std::ofstream m_ulRxOutFile; //!< Output file strem to which UL RLC RX stats will be written
+  Ptr<NrStatsSink> m_statsSink; //!< Sink of the statistics, if any
+  uint32_t m_dlTxTable {0}; //!< Table of the DL TX statistics in the sink
+  uint32_t m_dlRxTable {0}; //!< Table of the DL RX statistics in the sink
+  uint32_t m_ulTxTable {0}; //!< Table of the UL TX statistics in the sink
+  uint32_t m_ulRxTable {0}; //!< Table of the UL RX statistics in the sink
 
 };
 
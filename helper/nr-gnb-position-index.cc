@@ -0,0 +1,148 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "nr-gnb-position-index.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrGnbPositionIndex");
+
+static double
+GetCoordinate (const Vector &v, uint8_t axis)
+{
+  return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+void
+NrGnbPositionIndex::Build (const std::vector<Vector> &positions)
+{
+  NS_LOG_FUNCTION (this << positions.size ());
+  m_positions = positions;
+  m_nodes.clear ();
+  m_nodes.reserve (positions.size ());
+
+  std::vector<uint32_t> indexes (positions.size ());
+  std::iota (indexes.begin (), indexes.end (), 0);
+  m_root = Build (indexes.begin (), indexes.end (), 0);
+}
+
+int32_t
+NrGnbPositionIndex::Build (std::vector<uint32_t>::iterator first,
+                           std::vector<uint32_t>::iterator last, uint32_t depth)
+{
+  if (first == last)
+    {
+      return -1;
+    }
+
+  uint8_t axis = depth % 3;
+  auto median = first + (last - first) / 2;
+  std::nth_element (first, median, last, [this, axis] (uint32_t a, uint32_t b)
+    {
+      return GetCoordinate (m_positions[a], axis) < GetCoordinate (m_positions[b], axis);
+    });
+
+  int32_t node = static_cast<int32_t> (m_nodes.size ());
+  m_nodes.emplace_back ();
+  m_nodes[node].m_index = *median;
+  m_nodes[node].m_axis = axis;
+
+  // Build both sides before writing the children: emplace_back may move m_nodes
+  int32_t left = Build (first, median, depth + 1);
+  int32_t right = Build (median + 1, last, depth + 1);
+  m_nodes[node].m_left = left;
+  m_nodes[node].m_right = right;
+  return node;
+}
+
+uint32_t
+NrGnbPositionIndex::GetN () const
+{
+  return static_cast<uint32_t> (m_positions.size ());
+}
+
+uint32_t
+NrGnbPositionIndex::FindClosest (const Vector &pos) const
+{
+  NS_ASSERT_MSG (!m_positions.empty (), "No position indexed");
+  return FindKClosest (pos, 1).front ();
+}
+
+std::vector<uint32_t>
+NrGnbPositionIndex::FindKClosest (const Vector &pos, uint32_t k) const
+{
+  NS_LOG_FUNCTION (this << pos << k);
+
+  std::vector<std::pair<double, uint32_t>> best;
+  best.reserve (k);
+  if (k > 0)
+    {
+      Search (m_root, pos, k, &best);
+    }
+
+  std::sort_heap (best.begin (), best.end ());
+  std::vector<uint32_t> ret;
+  ret.reserve (best.size ());
+  for (const auto & b : best)
+    {
+      ret.push_back (b.second);
+    }
+  return ret;
+}
+
+void
+NrGnbPositionIndex::Search (int32_t node, const Vector &pos, uint32_t k,
+                            std::vector<std::pair<double, uint32_t>> *best) const
+{
+  if (node < 0)
+    {
+      return;
+    }
+
+  const KdNode &n = m_nodes[node];
+  std::pair<double, uint32_t> candidate (CalculateDistance (pos, m_positions[n.m_index]), n.m_index);
+  if (best->size () < k)
+    {
+      best->push_back (candidate);
+      std::push_heap (best->begin (), best->end ());
+    }
+  else if (candidate < best->front ())
+    {
+      std::pop_heap (best->begin (), best->end ());
+      best->back () = candidate;
+      std::push_heap (best->begin (), best->end ());
+    }
+
+  double diff = GetCoordinate (pos, n.m_axis) - GetCoordinate (m_positions[n.m_index], n.m_axis);
+  int32_t nearSide = diff < 0 ? n.m_left : n.m_right;
+  int32_t farSide = diff < 0 ? n.m_right : n.m_left;
+
+  Search (nearSide, pos, k, best);
+
+  // The far side is at least |diff| away. Visit it also when that equals the
+  // worst distance found, as a smaller index wins a tie.
+  if (best->size () < k || std::abs (diff) <= best->front ().first)
+    {
+      Search (farSide, pos, k, best);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,108 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef NR_GNB_POSITION_INDEX_H
+#define NR_GNB_POSITION_INDEX_H
+
+#include <ns3/vector.h>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+namespace ns3 {
+
+/**
+ * \ingroup helper
+ * \brief K-d tree over a fixed set of positions (e.g., the gNBs)
+ *
+ * Used by the NrHelper to attach the UEs: finding the closest (or the k
+ * closest) positions costs O(log n) on average, instead of O(n).
+ *
+ * The positions are identified by their index in the vector passed to
+ * Build(). The distance is the one of CalculateDistance(); equal distances
+ * are ordered by index, so the closest position is the same that a linear
+ * search over the vector would find.
+ */
+class NrGnbPositionIndex
+{
+public:
+  /**
+   * \brief Build the tree
+   * \param positions the positions to index
+   */
+  void Build (const std::vector<Vector> &positions);
+
+  /**
+   * \brief Get the number of indexed positions
+   * \return the number of positions
+   */
+  uint32_t GetN () const;
+
+  /**
+   * \brief Find the closest position
+   * \param pos the position to search from
+   * \return the index of the closest position
+   */
+  uint32_t FindClosest (const Vector &pos) const;
+
+  /**
+   * \brief Find the k closest positions
+   * \param pos the position to search from
+   * \param k the number of positions to find
+   * \return the indexes of the min (k, GetN ()) closest positions, the closest first
+   */
+  std::vector<uint32_t> FindKClosest (const Vector &pos, uint32_t k) const;
+
+private:
+  /**
+   * \brief A node of the tree
+   */
+  struct KdNode
+  {
+    uint32_t m_index {0};  //!< Index of the position
+    uint8_t m_axis {0};    //!< Splitting axis (0: x, 1: y, 2: z)
+    int32_t m_left {-1};   //!< Subtree with smaller coordinate on the axis
+    int32_t m_right {-1};  //!< Subtree with larger or equal coordinate on the axis
+  };
+
+  /**
+   * \brief Build the subtree of the positions in [first, last)
+   * \param first first index
+   * \param last past-the-end index
+   * \param depth depth of the subtree root
+   * \return the node of the subtree root, or -1 if empty
+   */
+  int32_t Build (std::vector<uint32_t>::iterator first, std::vector<uint32_t>::iterator last,
+                 uint32_t depth);
+
+  /**
+   * \brief Search the k closest positions in a subtree
+   * \param node the subtree root
+   * \param pos the position to search from
+   * \param k the number of positions to find
+   * \param best max-heap of the (distance, index) found so far
+   */
+  void Search (int32_t node, const Vector &pos, uint32_t k,
+               std::vector<std::pair<double, uint32_t>> *best) const;
+
+  std::vector<Vector> m_positions; //!< Indexed positions
+  std::vector<KdNode> m_nodes;     //!< Tree nodes
+  int32_t m_root {-1};             //!< Root node
+};
+
+} // namespace ns3
+
+#endif // NR_GNB_POSITION_INDEX_H
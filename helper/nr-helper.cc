@@ -25,6 +25,7 @@
 #include <ns3/lte-chunk-processor.h>
 #include <ns3/epc-ue-nas.h>
 #include <ns3/names.h>
+#include <ns3/node-list.h>
 #include <ns3/nr-rrc-protocol-ideal.h>
 #include <ns3/nr-gnb-mac.h>
 #include <ns3/nr-gnb-phy.h>
@@ -42,7 +43,10 @@
 #include <ns3/epc-x2.h>
 #include <ns3/nr-phy-rx-trace.h>
 #include <ns3/nr-mac-rx-trace.h>
+#include <ns3/nr-stats-sink.h>
+#include "nr-bearer-stats-simple.h"
 #include "nr-bearer-stats-calculator.h"
+#include "nr-gnb-position-index.h"
 #include <ns3/bandwidth-part-ue.h>
 #include <ns3/beam-manager.h>
 #include <ns3/three-gpp-propagation-loss-model.h>
@@ -54,8 +58,13 @@
 #include <ns3/three-gpp-v2v-propagation-loss-model.h>
 #include <ns3/three-gpp-v2v-channel-condition-model.h>
 #include <ns3/uniform-planar-array.h>
+#include <ns3/angles.h>
+#include <ns3/distance-based-three-gpp-spectrum-propagation-loss-model.h>
 
 #include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
 
 namespace ns3 {
 
@@ -99,6 +108,7 @@ NrHelper::NrHelper (void)
   Config::SetDefault ("ns3::EpsBearer::Release", UintegerValue (15));
 
   m_phyStats = CreateObject<NrPhyRxTrace> ();
+  m_macStats = CreateObject<NrMacRxTrace> ();
   m_macSchedStats = CreateObject <NrMacSchedulingStats> ();
 }
 
@@ -120,6 +130,22 @@ NrHelper::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&NrHelper::m_harqEnabled),
                    MakeBooleanChecker ())
+    .AddAttribute ("PreResolvedStatsContext",
+                   "If true, the MAC scheduling stats sinks are connected directly to "
+                   "the gNBs installed when the traces are enabled, with the cell ID "
+                   "and IMSI resolved at connection time instead of from the trace "
+                   "path at every event",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NrHelper::m_preResolvedStatsContext),
+                   MakeBooleanChecker ())
+    .AddAttribute ("StatsSink",
+                   "The (already open) sink where the PHY RX packet trace, the MAC "
+                   "control message traces and the RLC and PDCP simple traces are "
+                   "stored instead of their text files",
+                   PointerValue (),
+                   MakePointerAccessor (&NrHelper::SetStatsSink,
+                                        &NrHelper::GetStatsSink),
+                   MakePointerChecker<NrStatsSink> ())
     ;
   return tid;
 }
@@ -320,6 +346,12 @@ NrHelper::InitializeOperationBand (OperationBandInfo *band, uint8_t flags)
               bwp->m_channel = m_channelFactory.Create<SpectrumChannel> ();
               bwp->m_channel->AddPropagationLossModel (bwp->m_propagation);
               bwp->m_channel->AddPhasedArraySpectrumPropagationLossModel (bwp->m_3gppChannel);
+
+              auto distanceBased = DynamicCast<DistanceBasedThreeGppSpectrumPropagationLossModel> (bwp->m_3gppChannel);
+              if (distanceBased != nullptr)
+                {
+                  distanceBased->ConfigureChannel (bwp->m_channel);
+                }
             }
         }
     }
@@ -463,10 +495,11 @@ NrHelper::InstallUeDevice (const NodeContainer &c,
   NS_LOG_FUNCTION (this);
   Initialize ();    // Run DoInitialize (), if necessary
   NetDeviceContainer devices;
+  const UeInstallBatch batch = PrepareUeInstall (allBwps);
   for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
     {
       Ptr<Node> node = *i;
-      Ptr<NetDevice> device = InstallSingleUeDevice (node, allBwps, numberOfStreams);
+      Ptr<NetDevice> device = InstallSingleUeDevice (node, batch, numberOfStreams);
       device->SetAddress (Mac48Address::Allocate ());
       devices.Add (device);
     }
@@ -482,16 +515,196 @@ NrHelper::InstallGnbDevice (const NodeContainer & c,
   NS_LOG_FUNCTION (this);
   Initialize ();    // Run DoInitialize (), if necessary
   NetDeviceContainer devices;
+  const GnbInstallBatch batch = PrepareGnbInstall (allBwps);
   for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
     {
       Ptr<Node> node = *i;
-      Ptr<NetDevice> device = InstallSingleGnbDevice (node, allBwps, numberOfStreams);
+      Ptr<NetDevice> device = InstallSingleGnbDevice (node, batch, numberOfStreams);
       device->SetAddress (Mac48Address::Allocate ());
       devices.Add (device);
     }
   return devices;
 }
 
+/**
+ * \brief Abort if a factory does not create objects of a given type
+ * \param factory the factory
+ * \param base the expected type
+ */
+static void
+CheckInstallFactory (const ObjectFactory &factory, TypeId base)
+{
+  TypeId tid = factory.GetTypeId ();
+  NS_ABORT_MSG_UNLESS (tid == base || tid.IsChildOf (base),
+                       "The factory creates " << tid.GetName () << ", not a " << base.GetName ());
+}
+
+NrHelper::UeInstallBatch
+NrHelper::PrepareUeInstall (const std::vector<std::reference_wrapper<BandwidthPartInfoPtr> > &allBwps) const
+{
+  NS_LOG_FUNCTION (this);
+  CheckInstallFactory (m_ueNetDeviceFactory, NrUeNetDevice::GetTypeId ());
+  CheckInstallFactory (m_ueMacFactory, NrUeMac::GetTypeId ());
+  CheckInstallFactory (m_uePhyFactory, NrUePhy::GetTypeId ());
+  CheckInstallFactory (m_ueSpectrumFactory, NrSpectrumPhy::GetTypeId ());
+  CheckInstallFactory (m_ueChannelAccessManagerFactory, NrChAccessManager::GetTypeId ());
+  CheckInstallFactory (m_ueAntennaFactory, UniformPlanarArray::GetTypeId ());
+  CheckInstallFactory (m_ueBeamManagerFactory, BeamManager::GetTypeId ());
+  CheckInstallFactory (m_bwpManagerFactory, BwpManagerUe::GetTypeId ());
+  CheckInstallFactory (m_ueBwpManagerAlgoFactory, BwpManagerAlgorithm::GetTypeId ());
+
+  UeInstallBatch batch;
+  batch.m_bwps = ResolveBwps (allBwps);
+  TypeId tid = m_ueNetDeviceFactory.GetTypeId ();
+  batch.m_imsi = ResolveDeviceAttribute (tid, "Imsi");
+  batch.m_rrc = ResolveDeviceAttribute (tid, "nrUeRrc");
+  batch.m_nas = ResolveDeviceAttribute (tid, "EpcUeNas");
+  batch.m_ccm = ResolveDeviceAttribute (tid, "LteUeComponentCarrierManager");
+  return batch;
+}
+
+NrHelper::GnbInstallBatch
+NrHelper::PrepareGnbInstall (const std::vector<std::reference_wrapper<BandwidthPartInfoPtr> > &allBwps) const
+{
+  NS_LOG_FUNCTION (this);
+  CheckInstallFactory (m_gnbNetDeviceFactory, NrGnbNetDevice::GetTypeId ());
+  CheckInstallFactory (m_gnbMacFactory, NrGnbMac::GetTypeId ());
+  CheckInstallFactory (m_gnbPhyFactory, NrGnbPhy::GetTypeId ());
+  CheckInstallFactory (m_gnbSpectrumFactory, NrSpectrumPhy::GetTypeId ());
+  CheckInstallFactory (m_gnbChannelAccessManagerFactory, NrChAccessManager::GetTypeId ());
+  CheckInstallFactory (m_gnbAntennaFactory, UniformPlanarArray::GetTypeId ());
+  CheckInstallFactory (m_gnbBeamManagerFactory, BeamManager::GetTypeId ());
+  CheckInstallFactory (m_schedFactory, NrMacSchedulerNs3::GetTypeId ());
+  CheckInstallFactory (m_gnbDlAmcFactory, NrAmc::GetTypeId ());
+  CheckInstallFactory (m_gnbUlAmcFactory, NrAmc::GetTypeId ());
+  CheckInstallFactory (m_gnbBwpManagerAlgoFactory, BwpManagerAlgorithm::GetTypeId ());
+
+  GnbInstallBatch batch;
+  batch.m_bwps = ResolveBwps (allBwps);
+  TypeId tid = m_gnbNetDeviceFactory.GetTypeId ();
+  batch.m_rrc = ResolveDeviceAttribute (tid, "LteEnbRrc");
+  batch.m_ccm = ResolveDeviceAttribute (tid, "LteEnbComponentCarrierManager");
+  return batch;
+}
+
+std::vector<NrHelper::BwpInstallConfig>
+NrHelper::ResolveBwps (const std::vector<std::reference_wrapper<BandwidthPartInfoPtr> > &allBwps)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  std::vector<BwpInstallConfig> bwps;
+  bwps.reserve (allBwps.size ());
+  for (const auto & bwp : allBwps)
+    {
+      BwpInstallConfig config;
+      DoubleValue frequency;
+      bool res = bwp.get ()->m_propagation->GetAttributeFailSafe ("Frequency", frequency);
+      NS_ASSERT_MSG (res, "Propagation model without Frequency attribute");
+      config.m_centralFrequency = frequency.Get ();
+
+      double bwInKhz = bwp.get ()->m_channelBandwidth / 1000.0;
+      NS_ABORT_MSG_IF (bwInKhz/100.0 > 65535.0, "A bandwidth of " << bwInKhz/100.0 << " kHz cannot be represented");
+      config.m_bandwidth = static_cast<uint16_t> (bwInKhz / 100);
+
+      NS_ASSERT (bwp.get ()->m_channel != nullptr);
+      config.m_channel = bwp.get ()->m_channel;
+      bwps.push_back (config);
+    }
+  return bwps;
+}
+
+NrHelper::DeviceAttribute
+NrHelper::ResolveDeviceAttribute (TypeId tid, const std::string &name)
+{
+  NS_LOG_FUNCTION (tid << name);
+  struct TypeId::AttributeInformation info;
+  bool found = tid.LookupAttributeByName (name, &info);
+  NS_ABORT_MSG_UNLESS (found, tid.GetName () << " has no attribute " << name);
+  NS_ABORT_MSG_UNLESS (info.flags & TypeId::ATTR_SET, "Attribute " << name << " can not be set");
+  return {info.accessor, info.checker};
+}
+
+void
+NrHelper::SetDeviceAttribute (const Ptr<NetDevice> &device, const DeviceAttribute &attribute,
+                              const AttributeValue &value)
+{
+  NS_ASSERT (attribute.m_checker->Check (value));
+  bool ok = attribute.m_accessor->Set (PeekPointer (device), value);
+  NS_ABORT_UNLESS (ok);
+}
+
+void
+NrHelper::SetInstallAllocationCounter (const std::function<uint64_t ()> &counter)
+{
+  NS_LOG_FUNCTION (this);
+  m_allocationCounter = counter;
+}
+
+NrHelper::InstallPhaseStart
+NrHelper::StartInstallPhase () const
+{
+  InstallPhaseStart start;
+  start.m_time = std::chrono::steady_clock::now ();
+  if (m_allocationCounter)
+    {
+      start.m_allocations = m_allocationCounter ();
+    }
+  return start;
+}
+
+NrHelper::InstallPhaseStart
+NrHelper::ProfileInstallPhase (InstallPhase phase, const InstallPhaseStart &start)
+{
+  InstallPhaseStart now = StartInstallPhase ();
+  m_installProfile[phase].m_time += now.m_time - start.m_time;
+  m_installProfile[phase].m_allocations += now.m_allocations - start.m_allocations;
+  m_installProfile[phase].m_count++;
+  return now;
+}
+
+void
+NrHelper::PrintInstallProfile (std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this);
+  static const std::array<std::string, INSTALL_PHASES> names =
+  {
+    "UE PHY", "UE MAC", "UE RRC", "UE EPC", "UE init",
+    "gNB PHY", "gNB MAC", "gNB RRC", "gNB init", "gNB EPC"
+  };
+
+  std::chrono::steady_clock::duration total = std::chrono::steady_clock::duration::zero ();
+  uint64_t totalAllocations = 0;
+  for (const auto & phase : m_installProfile)
+    {
+      total += phase.m_time;
+      totalAllocations += phase.m_allocations;
+    }
+
+  os << "Device installation time, per phase:" << std::endl;
+  for (uint8_t i = 0; i < INSTALL_PHASES; ++i)
+    {
+      const InstallPhaseStats &phase = m_installProfile[i];
+      if (phase.m_count == 0)
+        {
+          continue;
+        }
+      double ms = std::chrono::duration<double, std::milli> (phase.m_time).count ();
+      os << "  " << names[i] << ": " << ms << " ms over " << phase.m_count << " runs ("
+         << 1000.0 * ms / phase.m_count << " us each)";
+      if (m_allocationCounter)
+        {
+          os << ", " << phase.m_allocations << " allocations ("
+             << static_cast<double> (phase.m_allocations) / phase.m_count << " each)";
+        }
+      os << std::endl;
+    }
+  os << "  Total: " << std::chrono::duration<double, std::milli> (total).count () << " ms";
+  if (m_allocationCounter)
+    {
+      os << ", " << totalAllocations << " allocations";
+    }
+  os << std::endl;
+}
+
 Ptr<NrUeMac>
 NrHelper::CreateUeMac () const
 {
@@ -501,7 +714,7 @@ NrHelper::CreateUeMac () const
 }
 
 Ptr<NrUePhy>
-NrHelper::CreateUePhy (const Ptr<Node> &n, const std::unique_ptr<BandwidthPartInfo> &bwp,
+NrHelper::CreateUePhy (const Ptr<Node> &n, const BwpInstallConfig &bwp,
                            const Ptr<NrUeNetDevice> &dev,
                            const NrSpectrumPhy::NrPhyRxCtrlEndOkCallback &phyRxCtrlCallback,
                            uint8_t numberOfStreams)
@@ -510,12 +723,7 @@ NrHelper::CreateUePhy (const Ptr<Node> &n, const std::unique_ptr<BandwidthPartIn
 
   Ptr<NrUePhy> phy = m_uePhyFactory.Create <NrUePhy> ();
 
-  NS_ASSERT (bwp->m_channel != nullptr);
-
-  DoubleValue frequency;
-  bool res = bwp->m_propagation->GetAttributeFailSafe ("Frequency", frequency);
-  NS_ASSERT_MSG (res, "Propagation model without Frequency attribute");
-  phy->InstallCentralFrequency (frequency.Get ());
+  phy->InstallCentralFrequency (bwp.m_centralFrequency);
 
   phy->ScheduleStartEventLoop (n->GetId (), 0, 0, 0);
 
@@ -559,7 +767,7 @@ NrHelper::CreateUePhy (const Ptr<Node> &n, const std::unique_ptr<BandwidthPartIn
       pSinr->AddCallback (MakeCallback (&NrSpectrumPhy::ReportDlCtrlSinr, channelPhy));
       channelPhy->AddDlCtrlSinrChunkProcessor (pSinr);
 
-      channelPhy->SetChannel (bwp->m_channel);
+      channelPhy->SetChannel (bwp.m_channel);
       channelPhy->InstallPhy (phy);
       channelPhy->SetMobility (mm);
       channelPhy->SetPhyRxDataEndOkCallback (MakeCallback (&NrUePhy::PhyDataPacketReceived, phy));
@@ -574,11 +782,11 @@ NrHelper::CreateUePhy (const Ptr<Node> &n, const std::unique_ptr<BandwidthPartIn
 }
 
 Ptr<NetDevice>
-NrHelper::InstallSingleUeDevice (const Ptr<Node> &n,
-                                     const std::vector<std::reference_wrapper<BandwidthPartInfoPtr> > allBwps,
+NrHelper::InstallSingleUeDevice (const Ptr<Node> &n, const UeInstallBatch &batch,
                                      uint8_t numberOfStreams)
 {
   NS_LOG_FUNCTION (this);
+  InstallPhaseStart phaseStart = StartInstallPhase ();
 
   Ptr<NrUeNetDevice> dev = m_ueNetDeviceFactory.Create<NrUeNetDevice> ();
   dev->SetNode (n);
@@ -586,20 +794,20 @@ NrHelper::InstallSingleUeDevice (const Ptr<Node> &n,
   std::map<uint8_t, Ptr<BandwidthPartUe> > ueCcMap;
 
   // Create, for each ue, its bandwidth parts
-  for (uint32_t bwpId = 0; bwpId < allBwps.size (); ++bwpId)
+  for (uint32_t bwpId = 0; bwpId < batch.m_bwps.size (); ++bwpId)
     {
       Ptr <BandwidthPartUe> cc =  CreateObject<BandwidthPartUe> ();
-      double bwInKhz = allBwps[bwpId].get()->m_channelBandwidth / 1000.0;
-      NS_ABORT_MSG_IF (bwInKhz/100.0 > 65535.0, "A bandwidth of " << bwInKhz/100.0 << " kHz cannot be represented");
-      cc->SetUlBandwidth (static_cast<uint16_t> (bwInKhz / 100));
-      cc->SetDlBandwidth (static_cast<uint16_t> (bwInKhz / 100));
+      cc->SetUlBandwidth (batch.m_bwps[bwpId].m_bandwidth);
+      cc->SetDlBandwidth (batch.m_bwps[bwpId].m_bandwidth);
       cc->SetDlEarfcn (0); // Used for nothing..
       cc->SetUlEarfcn (0); // Used for nothing..
 
       auto mac = CreateUeMac ();
       cc->SetMac (mac);
+      phaseStart = ProfileInstallPhase (UE_MAC, phaseStart);
 
-      auto phy = CreateUePhy (n, allBwps[bwpId].get(), dev, std::bind (&NrUeNetDevice::RouteIngoingCtrlMsgs, dev,
+      auto phy = CreateUePhy (n, batch.m_bwps[bwpId], dev,
+                              std::bind (&NrUeNetDevice::RouteIngoingCtrlMsgs, dev,
                                          std::placeholders::_1, bwpId), numberOfStreams);
 
       if (m_harqEnabled)
@@ -620,6 +828,7 @@ NrHelper::InstallSingleUeDevice (const Ptr<Node> &n,
         }
 
       ueCcMap.insert (std::make_pair (bwpId, cc));
+      phaseStart = ProfileInstallPhase (UE_PHY, phaseStart);
     }
 
   Ptr<LteUeComponentCarrierManager> ccmUe = DynamicCast<LteUeComponentCarrierManager> (m_bwpManagerFactory.Create ());
@@ -692,27 +901,29 @@ NrHelper::InstallSingleUeDevice (const Ptr<Node> &n,
   NS_ABORT_MSG_IF (m_imsiCounter >= 0xFFFFFFFF, "max num UEs exceeded");
   uint64_t imsi = ++m_imsiCounter;
 
-  dev->SetAttribute ("Imsi", UintegerValue (imsi));
+  SetDeviceAttribute (dev, batch.m_imsi, UintegerValue (imsi));
   dev->SetCcMap (ueCcMap);
-  dev->SetAttribute ("nrUeRrc", PointerValue (rrc));
-  dev->SetAttribute ("EpcUeNas", PointerValue (nas));
-  dev->SetAttribute ("LteUeComponentCarrierManager", PointerValue (ccmUe));
+  SetDeviceAttribute (dev, batch.m_rrc, PointerValue (rrc));
+  SetDeviceAttribute (dev, batch.m_nas, PointerValue (nas));
+  SetDeviceAttribute (dev, batch.m_ccm, PointerValue (ccmUe));
 
   n->AddDevice (dev);
-
+  phaseStart = ProfileInstallPhase (UE_RRC, phaseStart);
 
   if (m_epcHelper != nullptr)
     {
       m_epcHelper->AddUe (dev, dev->GetImsi ());
+      phaseStart = ProfileInstallPhase (UE_EPC, phaseStart);
     }
 
   dev->Initialize ();
+  ProfileInstallPhase (UE_INIT, phaseStart);
 
   return dev;
 }
 
 Ptr<NrGnbPhy>
-NrHelper::CreateGnbPhy (const Ptr<Node> &n, const std::unique_ptr<BandwidthPartInfo> &bwp,
+NrHelper::CreateGnbPhy (const Ptr<Node> &n, const BwpInstallConfig &bwp,
                            const Ptr<NrGnbNetDevice> &dev,
                            const NrSpectrumPhy::NrPhyRxCtrlEndOkCallback &phyEndCtrlCallback,
                            uint8_t numberOfStreams)
@@ -721,10 +932,7 @@ NrHelper::CreateGnbPhy (const Ptr<Node> &n, const std::unique_ptr<BandwidthPartI
 
   Ptr<NrGnbPhy> phy = m_gnbPhyFactory.Create <NrGnbPhy> ();
 
-  DoubleValue frequency;
-  bool res = bwp->m_propagation->GetAttributeFailSafe ("Frequency", frequency);
-  NS_ASSERT_MSG (res, "Propagation model without Frequency attribute");
-  phy->InstallCentralFrequency (frequency.Get ());
+  phy->InstallCentralFrequency (bwp.m_centralFrequency);
 
   phy->ScheduleStartEventLoop (n->GetId (), 0, 0, 0);
 
@@ -750,7 +958,7 @@ NrHelper::CreateGnbPhy (const Ptr<Node> &n, const std::unique_ptr<BandwidthPartI
 
       channelPhy->InstallHarqPhyModule (Create<NrHarqPhy> ()); // there should be one HARQ instance per NrSpectrumPhy
       channelPhy->SetDevice (dev); // each NrSpectrumPhy should have a pointer to device
-      channelPhy->SetChannel (bwp->m_channel); // each NrSpectrumPhy needs to have a pointer to the SpectrumChannel object of the corresponding spectrum part
+      channelPhy->SetChannel (bwp.m_channel); // each NrSpectrumPhy needs to have a pointer to the SpectrumChannel object of the corresponding spectrum part
       channelPhy->InstallPhy (phy); // each NrSpectrumPhy should have a pointer to its NrPhy device, in this case NrGnbPhy
       channelPhy->SetStreamId (streamIndex);
 
@@ -805,11 +1013,11 @@ NrHelper::CreateGnbSched ()
 }
 
 Ptr<NetDevice>
-NrHelper::InstallSingleGnbDevice (const Ptr<Node> &n,
-                                      const std::vector<std::reference_wrapper<BandwidthPartInfoPtr> > allBwps,
+NrHelper::InstallSingleGnbDevice (const Ptr<Node> &n, const GnbInstallBatch &batch,
                                       uint8_t numberOfStreams)
 {
   NS_ABORT_MSG_IF (m_cellIdCounter == 65535, "max num gNBs exceeded");
+  InstallPhaseStart phaseStart = StartInstallPhase ();
 
   Ptr<NrGnbNetDevice> dev = m_gnbNetDeviceFactory.Create<NrGnbNetDevice> ();
 
@@ -822,24 +1030,23 @@ NrHelper::InstallSingleGnbDevice (const Ptr<Node> &n,
   // create component carrier map for this gNB device
   std::map<uint8_t,Ptr<BandwidthPartGnb> > ccMap;
 
-  for (uint32_t bwpId = 0; bwpId < allBwps.size (); ++bwpId)
+  for (uint32_t bwpId = 0; bwpId < batch.m_bwps.size (); ++bwpId)
     {
       NS_LOG_DEBUG ("Creating BandwidthPart, id = " << bwpId);
       Ptr <BandwidthPartGnb> cc =  CreateObject<BandwidthPartGnb> ();
-      double bwInKhz = allBwps[bwpId].get()->m_channelBandwidth / 1000.0;
-      NS_ABORT_MSG_IF (bwInKhz/100.0 > 65535.0, "A bandwidth of " << bwInKhz/100.0 << " kHz cannot be represented");
 
-      cc->SetUlBandwidth (static_cast<uint16_t> (bwInKhz / 100));
-      cc->SetDlBandwidth (static_cast<uint16_t> (bwInKhz / 100));
+      cc->SetUlBandwidth (batch.m_bwps[bwpId].m_bandwidth);
+      cc->SetDlBandwidth (batch.m_bwps[bwpId].m_bandwidth);
       cc->SetDlEarfcn (0); // Argh... handover not working
       cc->SetUlEarfcn (0); // Argh... handover not working
       cc->SetCellId (m_cellIdCounter++);
 
-      auto phy = CreateGnbPhy (n, allBwps[bwpId].get(), dev,
+      auto phy = CreateGnbPhy (n, batch.m_bwps[bwpId], dev,
                                std::bind (&NrGnbNetDevice::RouteIngoingCtrlMsgs,
                                           dev, std::placeholders::_1, bwpId), numberOfStreams);
       phy->SetBwpId (bwpId);
       cc->SetPhy (phy);
+      phaseStart = ProfileInstallPhase (GNB_PHY, phaseStart);
 
       auto mac = CreateGnbMac ();
       cc->SetMac (mac);
@@ -847,6 +1054,7 @@ NrHelper::InstallSingleGnbDevice (const Ptr<Node> &n,
 
       auto sched = CreateGnbSched ();
       cc->SetNrMacScheduler (sched);
+      phaseStart = ProfileInstallPhase (GNB_MAC, phaseStart);
 
       if (bwpId == 0)
         {
@@ -951,10 +1159,12 @@ NrHelper::InstallSingleGnbDevice (const Ptr<Node> &n,
     }
 
 
-  dev->SetAttribute ("LteEnbComponentCarrierManager", PointerValue (ccmEnbManager));
+  SetDeviceAttribute (dev, batch.m_ccm, PointerValue (ccmEnbManager));
   dev->SetCcMap (ccMap);
-  dev->SetAttribute ("LteEnbRrc", PointerValue (rrc));
+  SetDeviceAttribute (dev, batch.m_rrc, PointerValue (rrc));
+  phaseStart = ProfileInstallPhase (GNB_RRC, phaseStart);
   dev->Initialize ();
+  phaseStart = ProfileInstallPhase (GNB_INIT, phaseStart);
 
   n->AddDevice (dev);
 
@@ -973,6 +1183,7 @@ NrHelper::InstallSingleGnbDevice (const Ptr<Node> &n,
       Ptr<EpcX2> x2 = n->GetObject<EpcX2> ();
       x2->SetEpcX2SapUser (rrc->GetEpcX2SapUser ());
       rrc->SetEpcX2SapProvider (x2->GetEpcX2SapProvider ());
+      ProfileInstallPhase (GNB_EPC, phaseStart);
     }
 
   return dev;
@@ -982,11 +1193,102 @@ void
 NrHelper::AttachToClosestEnb (NetDeviceContainer ueDevices, NetDeviceContainer enbDevices)
 {
   NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (enbDevices.GetN () > 0, "empty enb device container");
+
+  NrGnbPositionIndex index = BuildGnbPositionIndex (enbDevices);
+  for (NetDeviceContainer::Iterator i = ueDevices.Begin (); i != ueDevices.End (); i++)
+    {
+      Vector uePos = (*i)->GetNode ()->GetObject<MobilityModel> ()->GetPosition ();
+      AttachToEnb (*i, enbDevices.Get (index.FindClosest (uePos)));
+    }
+}
+
+void
+NrHelper::AttachToMaxRsrpEnb (NetDeviceContainer ueDevices, NetDeviceContainer enbDevices,
+                              uint32_t candidates)
+{
+  NS_LOG_FUNCTION (this << candidates);
+  NS_ASSERT_MSG (enbDevices.GetN () > 0, "empty enb device container");
+  NS_ABORT_MSG_IF (candidates == 0, "At least one candidate site is needed");
+
+  // The sectors of a site are co-located: index the sites, and evaluate all
+  // the sectors of the closest ones
+  std::vector<Vector> sitePositions;
+  std::vector<std::vector<uint32_t> > siteSectors;
+  std::map<std::tuple<double, double, double>, uint32_t> siteOfPosition;
+  for (uint32_t enbIndex = 0; enbIndex < enbDevices.GetN (); ++enbIndex)
+    {
+      Vector pos = enbDevices.Get (enbIndex)->GetNode ()->GetObject<MobilityModel> ()->GetPosition ();
+      auto site = siteOfPosition.emplace (std::make_tuple (pos.x, pos.y, pos.z), sitePositions.size ());
+      if (site.second)
+        {
+          sitePositions.push_back (pos);
+          siteSectors.emplace_back ();
+        }
+      siteSectors.at (site.first->second).push_back (enbIndex);
+    }
+  NrGnbPositionIndex index;
+  index.Build (sitePositions);
 
   for (NetDeviceContainer::Iterator i = ueDevices.Begin (); i != ueDevices.End (); i++)
     {
-      AttachToClosestEnb (*i, enbDevices);
+      Ptr<MobilityModel> ueMm = (*i)->GetNode ()->GetObject<MobilityModel> ();
+      double maxRxPower = -std::numeric_limits<double>::infinity ();
+      Ptr<NetDevice> bestEnbDevice;
+
+      for (uint32_t siteIndex : index.FindKClosest (ueMm->GetPosition (), candidates))
+        {
+          for (uint32_t enbIndex : siteSectors.at (siteIndex))
+            {
+              Ptr<NetDevice> enbDevice = enbDevices.Get (enbIndex);
+              Ptr<NrGnbPhy> enbPhy = GetGnbPhy (enbDevice, 0);
+              Ptr<NrSpectrumPhy> enbSpectrumPhy = enbPhy->GetSpectrumPhy ();
+              Ptr<PropagationLossModel> loss = enbSpectrumPhy->GetSpectrumChannel ()->GetPropagationLossModel ();
+              Ptr<MobilityModel> enbMm = enbDevice->GetNode ()->GetObject<MobilityModel> ();
+
+              // Gain of the antenna element toward the UE, which depends on
+              // the orientation of the sector
+              double txPower = enbPhy->GetTxPower ();
+              Ptr<PhasedArrayModel> antenna = enbSpectrumPhy->GetAntenna ()->GetObject<PhasedArrayModel> ();
+              if (antenna != nullptr)
+                {
+                  std::pair<double, double> field = antenna->GetElementFieldPattern (Angles (ueMm->GetPosition (),
+                                                                                             enbMm->GetPosition ()));
+                  txPower += 10 * std::log10 (field.first * field.first + field.second * field.second);
+                }
+
+              double rxPower = loss != nullptr ? loss->CalcRxPower (txPower, enbMm, ueMm) : txPower;
+              NS_LOG_DEBUG ("UE " << (*i)->GetNode ()->GetId () << " receives " << rxPower <<
+                            " dBm from GNB " << enbDevice->GetNode ()->GetId ());
+
+              // Sites come closest first: on equal power, the closest wins
+              if (rxPower > maxRxPower)
+                {
+                  maxRxPower = rxPower;
+                  bestEnbDevice = enbDevice;
+                }
+            }
+        }
+
+      NS_ASSERT (bestEnbDevice != nullptr);
+      AttachToEnb (*i, bestEnbDevice);
+    }
+}
+
+NrGnbPositionIndex
+NrHelper::BuildGnbPositionIndex (const NetDeviceContainer &enbDevices)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  std::vector<Vector> positions;
+  positions.reserve (enbDevices.GetN ());
+  for (NetDeviceContainer::Iterator i = enbDevices.Begin (); i != enbDevices.End (); ++i)
+    {
+      positions.push_back ((*i)->GetNode ()->GetObject<MobilityModel> ()->GetPosition ());
     }
+
+  NrGnbPositionIndex index;
+  index.Build (positions);
+  return index;
 }
 
 void
@@ -1520,6 +1822,35 @@ NrHelper::GetPhyRxTrace (void)
   return m_phyStats;
 }
 
+void
+NrHelper::SetStatsSink (const Ptr<NrStatsSink> &sink)
+{
+  NS_LOG_FUNCTION (this << sink);
+  NS_ABORT_MSG_IF (m_statsSink != nullptr, "The stats sink can be set only once");
+  m_statsSink = sink;
+  if (sink == nullptr)
+    {
+      return;
+    }
+  m_phyStats->SetStatsSink (sink);
+  m_macStats->SetStatsSink (sink);
+  for (const auto & stats : {m_radioBearerStatsConnectorSimpleTraces.GetRlcStats (),
+                             m_radioBearerStatsConnectorSimpleTraces.GetPdcpStats ()})
+    {
+      Ptr<NrBearerStatsSimple> simpleStats = DynamicCast<NrBearerStatsSimple> (stats);
+      if (simpleStats != nullptr)
+        {
+          simpleStats->SetStatsSink (sink);
+        }
+    }
+}
+
+Ptr<NrStatsSink>
+NrHelper::GetStatsSink () const
+{
+  return m_statsSink;
+}
+
 void
 NrHelper::EnableDlDataPhyTraces (void)
 {
@@ -1620,6 +1951,10 @@ void
 NrHelper::EnableRlcSimpleTraces (void)
 {
   Ptr<NrBearerStatsSimple> rlcStats = CreateObject<NrBearerStatsSimple> ("RLC");
+  if (m_statsSink != nullptr)
+    {
+      rlcStats->SetStatsSink (m_statsSink);
+    }
   m_radioBearerStatsConnectorSimpleTraces.EnableRlcStats (rlcStats);
 }
 
@@ -1627,6 +1962,10 @@ void
 NrHelper::EnablePdcpSimpleTraces (void)
 {
   Ptr<NrBearerStatsSimple> pdcpStats = CreateObject<NrBearerStatsSimple> ("PDCP");
+  if (m_statsSink != nullptr)
+    {
+      pdcpStats->SetStatsSink (m_statsSink);
+    }
   m_radioBearerStatsConnectorSimpleTraces.EnablePdcpStats (pdcpStats);
 }
 
@@ -1659,10 +1998,40 @@ NrHelper::GetPdcpStatsCalculator (void)
   return DynamicCast<NrBearerStatsCalculator> (m_radioBearerStatsConnectorCalculator.GetPdcpStats ());
 }
 
+/**
+ * \brief Get all the gNB devices installed so far
+ * \return the gNB devices
+ */
+static std::vector<Ptr<NrGnbNetDevice> >
+GetInstalledGnbDevices ()
+{
+  std::vector<Ptr<NrGnbNetDevice> > gnbs;
+  for (auto it = NodeList::Begin (); it != NodeList::End (); ++it)
+    {
+      for (uint32_t i = 0; i < (*it)->GetNDevices (); ++i)
+        {
+          Ptr<NrGnbNetDevice> gnb = DynamicCast<NrGnbNetDevice> ((*it)->GetDevice (i));
+          if (gnb != nullptr)
+            {
+              gnbs.push_back (gnb);
+            }
+        }
+    }
+  return gnbs;
+}
+
 void
 NrHelper::EnableDlMacSchedTraces ()
 {
   NS_LOG_FUNCTION_NOARGS ();
+  if (m_preResolvedStatsContext)
+    {
+      for (const auto & gnb : GetInstalledGnbDevices ())
+        {
+          m_macSchedStats->ConnectDlSchedulingTrace (gnb);
+        }
+      return;
+    }
   Config::Connect ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/DlScheduling",
                    MakeBoundCallback (&NrMacSchedulingStats::DlSchedulingCallback, m_macSchedStats));
 }
@@ -1671,6 +2040,14 @@ void
 NrHelper::EnableUlMacSchedTraces ()
 {
   NS_LOG_FUNCTION_NOARGS ();
+  if (m_preResolvedStatsContext)
+    {
+      for (const auto & gnb : GetInstalledGnbDevices ())
+        {
+          m_macSchedStats->ConnectUlSchedulingTrace (gnb);
+        }
+      return;
+    }
   Config::Connect ("/NodeList/*/DeviceList/*/BandwidthPartMap/*/NrGnbMac/UlScheduling",
                    MakeBoundCallback (&NrMacSchedulingStats::UlSchedulingCallback, m_macSchedStats));
 }
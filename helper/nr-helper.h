@@ -33,6 +33,11 @@
 #include "ideal-beamforming-helper.h"
 #include "cc-bwp-helper.h"
 #include "nr-mac-scheduling-stats.h"
+#include "nr-gnb-position-index.h"
+#include <array>
+#include <chrono>
+#include <functional>
+#include <ostream>
 
 namespace ns3 {
 
@@ -45,6 +50,7 @@ class EpcHelper;
 class EpcTft;
 class NrBearerStatsCalculator;
 class NrMacRxTrace;
+class NrStatsSink;
 class NrPhyRxTrace;
 class ComponentCarrierEnb;
 class ComponentCarrier;
@@ -198,9 +204,10 @@ class BwpManagerUe;
  *
  * \section helper_attachment Attachment of UEs to GNBs
  *
- * We provide two methods to attach a set of UE to a GNB: AttachToClosestEnb()
- * and AttachToEnb(). Through these function, you will manually attach one or
- * more UEs to a specified GNB.
+ * We provide three methods to attach a set of UE to a GNB: AttachToClosestEnb(),
+ * AttachToMaxRsrpEnb() and AttachToEnb(). Through these function, you will
+ * manually attach one or more UEs to a specified GNB. The first two index the
+ * GNB positions in a k-d tree, so they scale to large deployments.
  *
  * \section helper_Traces Traces
  *
@@ -251,6 +258,29 @@ public:
                                        const std::vector<std::reference_wrapper<BandwidthPartInfoPtr>> allBwps,
                                        uint8_t numberOfPanels = 1);
 
+  /**
+   * \brief Print the wall-clock time spent installing the devices
+   * \param os the output stream
+   *
+   * The time is split by installation phase (PHY, MAC, RRC, EPC, ...), and
+   * accumulated over all the InstallUeDevice() and InstallGnbDevice() calls
+   * made on this helper. If an allocation counter was set with
+   * SetInstallAllocationCounter(), the number of heap allocations of each
+   * phase is printed as well.
+   */
+  void PrintInstallProfile (std::ostream &os) const;
+
+  /**
+   * \brief Set the function that counts the heap allocations of the program
+   * \param counter a function that returns the number of allocations made so
+   * far; it must not allocate
+   *
+   * The helper can not count the allocations by itself: the program has to
+   * replace the global operator new, and provide its counter here before
+   * installing the devices. See cttc-nr-install-benchmark.cc.
+   */
+  void SetInstallAllocationCounter (const std::function<uint64_t ()> &counter);
+
   /**
    * \brief Get the number of configured BWP for a specific GNB NetDevice
    * \param gnbDevice The GNB NetDevice, obtained from InstallGnbDevice()
@@ -311,6 +341,23 @@ public:
    * \param enbDevices GNB devices from which the algorithm has to select the closest
    */
   void AttachToClosestEnb (NetDeviceContainer ueDevices, NetDeviceContainer enbDevices);
+
+  /**
+   * \brief Attach each UE to the GNB from which it receives the highest power
+   * \param ueDevices UE devices to attach
+   * \param enbDevices GNB devices among which the algorithm has to select
+   * \param candidates number of closest sites evaluated for each UE
+   *
+   * The GNBs at the same position are the sectors of a site. For each UE, the
+   * received power is evaluated for all the sectors of the closest candidates
+   * sites only, with the TX power, the gain of the antenna element toward the
+   * UE (which depends on the orientation of the sector) and the propagation
+   * loss model (pathloss, shadowing, channel condition) of the channel of
+   * their first BWP. The beamforming gain is not included, as the beams are
+   * configured only after the attachment.
+   */
+  void AttachToMaxRsrpEnb (NetDeviceContainer ueDevices, NetDeviceContainer enbDevices,
+                           uint32_t candidates = 3);
   /**
    * \brief Attach a UE to a particular GNB
    * \param ueDevice the UE device
@@ -739,6 +786,23 @@ public:
    */
   Ptr<NrPhyRxTrace> GetPhyRxTrace (void);
 
+  /**
+   * \brief Store the traces in a NrStatsSink instead of the text files
+   * \param sink the (already open) sink
+   *
+   * It applies to the PHY RX packet trace, to the MAC control message traces
+   * and to the RLC and PDCP simple traces, whether they are enabled before or
+   * after this call. The other traces still go to their text files. It can
+   * be set also through the `StatsSink` attribute, once the sink is open.
+   */
+  void SetStatsSink (const Ptr<NrStatsSink> &sink);
+
+  /**
+   * \brief Get the sink of the traces
+   * \return the sink set with SetStatsSink (), or nullptr
+   */
+  Ptr<NrStatsSink> GetStatsSink () const;
+
   /**
    * \brief Enable gNB packet count trace
    */
@@ -815,11 +879,17 @@ public:
 
   /**
    * Enable trace sinks for DL MAC layer scheduling.
+   *
+   * If the attribute PreResolvedStatsContext is true, the sinks are
+   * connected to the gNBs installed so far with the cell ID and the RRC
+   * already resolved, instead of through a Config path.
    */
   void EnableDlMacSchedTraces (void);
 
   /**
    * Enable trace sinks for UL MAC layer scheduling.
+   *
+   * \see EnableDlMacSchedTraces
    */
   void EnableUlMacSchedTraces (void);
 
@@ -872,7 +942,93 @@ private:
    */
   void DoDeActivateDedicatedEpsBearer (Ptr<NetDevice> ueDevice, Ptr<NetDevice> enbDevice, uint8_t bearerId);
 
-  Ptr<NrGnbPhy> CreateGnbPhy (const Ptr<Node> &n, const std::unique_ptr<BandwidthPartInfo> &bwp,
+  /**
+   * \brief Parameters of a BWP, resolved once per InstallUeDevice() or
+   * InstallGnbDevice() call, instead of once per device
+   */
+  struct BwpInstallConfig
+  {
+    double m_centralFrequency {0.0};  //!< Central frequency, from the propagation model
+    uint16_t m_bandwidth {0};         //!< Bandwidth, in multiples of 100 kHz
+    Ptr<SpectrumChannel> m_channel;   //!< Channel of the BWP
+  };
+
+  /**
+   * \brief Attribute of the devices, looked up once per install call
+   */
+  struct DeviceAttribute
+  {
+    Ptr<const AttributeAccessor> m_accessor; //!< Accessor of the attribute
+    Ptr<const AttributeChecker> m_checker;   //!< Checker of the attribute
+  };
+
+  /**
+   * \brief What InstallSingleUeDevice() needs, resolved once per batch of UEs
+   */
+  struct UeInstallBatch
+  {
+    std::vector<BwpInstallConfig> m_bwps; //!< The BWPs
+    DeviceAttribute m_imsi;               //!< The "Imsi" attribute
+    DeviceAttribute m_rrc;                //!< The "nrUeRrc" attribute
+    DeviceAttribute m_nas;                //!< The "EpcUeNas" attribute
+    DeviceAttribute m_ccm;                //!< The "LteUeComponentCarrierManager" attribute
+  };
+
+  /**
+   * \brief What InstallSingleGnbDevice() needs, resolved once per batch of gNBs
+   */
+  struct GnbInstallBatch
+  {
+    std::vector<BwpInstallConfig> m_bwps; //!< The BWPs
+    DeviceAttribute m_rrc;                //!< The "LteEnbRrc" attribute
+    DeviceAttribute m_ccm;                //!< The "LteEnbComponentCarrierManager" attribute
+  };
+
+  /**
+   * \brief Prepare the installation of a batch of UEs
+   * \param allBwps the BWPs
+   * \return the BWP parameters and the device attributes
+   *
+   * It also checks, once for the whole batch, that the factories used by
+   * InstallSingleUeDevice() create objects of the expected types.
+   */
+  UeInstallBatch PrepareUeInstall (const std::vector<std::reference_wrapper<BandwidthPartInfoPtr>> &allBwps) const;
+
+  /**
+   * \brief Prepare the installation of a batch of gNBs
+   * \param allBwps the BWPs
+   * \return the BWP parameters and the device attributes
+   *
+   * It also checks, once for the whole batch, that the factories used by
+   * InstallSingleGnbDevice() create objects of the expected types.
+   */
+  GnbInstallBatch PrepareGnbInstall (const std::vector<std::reference_wrapper<BandwidthPartInfoPtr>> &allBwps) const;
+
+  /**
+   * \brief Read the central frequency, the bandwidth and the channel of each BWP
+   * \param allBwps the BWPs
+   * \return the parameters of each BWP, in the same order
+   */
+  static std::vector<BwpInstallConfig> ResolveBwps (const std::vector<std::reference_wrapper<BandwidthPartInfoPtr>> &allBwps);
+
+  /**
+   * \brief Look up an attribute of the devices
+   * \param tid the TypeId of the devices
+   * \param name the name of the attribute
+   * \return the accessor and the checker of the attribute
+   */
+  static DeviceAttribute ResolveDeviceAttribute (TypeId tid, const std::string &name);
+
+  /**
+   * \brief Set an attribute already looked up with ResolveDeviceAttribute()
+   * \param device the device
+   * \param attribute the attribute
+   * \param value the value
+   */
+  static void SetDeviceAttribute (const Ptr<NetDevice> &device, const DeviceAttribute &attribute,
+                                  const AttributeValue &value);
+
+  Ptr<NrGnbPhy> CreateGnbPhy (const Ptr<Node> &n, const BwpInstallConfig &bwp,
                                   const Ptr<NrGnbNetDevice> &dev,
                                   const NrSpectrumPhy::NrPhyRxCtrlEndOkCallback &phyEndCtrlCallback,
                                   uint8_t numberOfPanels);
@@ -880,19 +1036,77 @@ private:
   Ptr<NrGnbMac> CreateGnbMac ();
 
   Ptr<NrUeMac> CreateUeMac () const;
-  Ptr<NrUePhy> CreateUePhy (const Ptr<Node> &n, const std::unique_ptr<BandwidthPartInfo> &bwp,
+  Ptr<NrUePhy> CreateUePhy (const Ptr<Node> &n, const BwpInstallConfig &bwp,
                                 const Ptr<NrUeNetDevice> &dev,
                                 const NrSpectrumPhy::NrPhyRxCtrlEndOkCallback &phyRxCtrlCallback,
                                 uint8_t numberOfPanels);
 
-  Ptr<NetDevice> InstallSingleUeDevice (const Ptr<Node> &n,
-                                        const std::vector<std::reference_wrapper<BandwidthPartInfoPtr>> allBwps,
+  Ptr<NetDevice> InstallSingleUeDevice (const Ptr<Node> &n, const UeInstallBatch &batch,
                                         uint8_t numberOfPanels);
-  Ptr<NetDevice> InstallSingleGnbDevice (const Ptr<Node> &n,
-                                         const std::vector<std::reference_wrapper<BandwidthPartInfoPtr>> allBwps,
+  Ptr<NetDevice> InstallSingleGnbDevice (const Ptr<Node> &n, const GnbInstallBatch &batch,
                                          uint8_t numberOfPanels);
+
+  /**
+   * \brief Phases of the device installation, see PrintInstallProfile()
+   */
+  enum InstallPhase : uint8_t
+  {
+    UE_PHY,        //!< UE PHY, spectrum PHYs, antennas and beam managers (per BWP)
+    UE_MAC,        //!< UE device, BWP and MAC (per BWP)
+    UE_RRC,        //!< UE BWP manager, RRC, NAS and SAP connections
+    UE_EPC,        //!< Registration of the UE in the EPC
+    UE_INIT,       //!< Initialization of the UE device
+    GNB_PHY,       //!< gNB device, BWP, PHY, spectrum PHYs, antennas and beam managers (per BWP)
+    GNB_MAC,       //!< gNB MAC, scheduler and AMCs (per BWP)
+    GNB_RRC,       //!< gNB BWP manager, RRC and SAP connections
+    GNB_INIT,      //!< Initialization of the gNB device
+    GNB_EPC,       //!< Registration of the gNB in the EPC
+    INSTALL_PHASES //!< Number of phases
+  };
+
+  /**
+   * \brief Wall-clock time and allocations of an installation phase
+   */
+  struct InstallPhaseStats
+  {
+    std::chrono::steady_clock::duration m_time {std::chrono::steady_clock::duration::zero ()}; //!< Total time
+    uint64_t m_allocations {0}; //!< Total heap allocations, if counted
+    uint64_t m_count {0}; //!< Number of times the phase was run
+  };
+
+  /**
+   * \brief Start of an installation phase
+   */
+  struct InstallPhaseStart
+  {
+    std::chrono::steady_clock::time_point m_time; //!< Wall-clock time
+    uint64_t m_allocations {0};                  //!< Allocations made so far, if counted
+  };
+
+  /**
+   * \brief Take the time and the allocation count at the start of a phase
+   * \return the start of the phase
+   */
+  InstallPhaseStart StartInstallPhase () const;
+
+  /**
+   * \brief Account the time and the allocations since start to a phase
+   * \param phase the installation phase
+   * \param start when the phase started
+   * \return the current time and allocation count, that can be used as
+   * start of the next phase
+   */
+  InstallPhaseStart ProfileInstallPhase (InstallPhase phase, const InstallPhaseStart &start);
+
   void AttachToClosestEnb (Ptr<NetDevice> ueDevice, NetDeviceContainer enbDevices);
 
+  /**
+   * \brief Index the positions of the GNBs
+   * \param enbDevices the GNB devices
+   * \return the index; the position i is the one of enbDevices.Get (i)
+   */
+  static NrGnbPositionIndex BuildGnbPositionIndex (const NetDeviceContainer &enbDevices);
+
   std::map<uint8_t, ComponentCarrier> GetBandwidthPartMap ();
 
   ObjectFactory m_gnbNetDeviceFactory;  //!< NetDevice factory for gnb
@@ -927,14 +1141,18 @@ private:
 
   bool m_harqEnabled {false};
   bool m_snrTest {false};
+  bool m_preResolvedStatsContext {false}; //!< Connect the stats sinks with a pre-resolved context (attribute)
 
   Ptr<NrPhyRxTrace> m_phyStats; //!< Pointer to the PhyRx stats
   Ptr<NrMacRxTrace> m_macStats; //!< Pointer to the MacRx stats
+  Ptr<NrStatsSink> m_statsSink; //!< Sink of the traces, if any (attribute)
 
   NrBearerStatsConnector m_radioBearerStatsConnectorSimpleTraces; //!< RLC and PDCP statistics connector for simple file statistics
   NrBearerStatsConnector m_radioBearerStatsConnectorCalculator; //!< RLC and PDCP statistics connector for complex calculator statistics
 
   std::map<uint8_t, ComponentCarrier> m_componentCarrierPhyParams; //!< component carrier map
+  std::array<InstallPhaseStats, INSTALL_PHASES> m_installProfile; //!< Time spent in each installation phase
+  std::function<uint64_t ()> m_allocationCounter; //!< Counter of the heap allocations, if set
   std::vector< Ptr <Object> > m_channelObjectsWithAssignedStreams; //!< channel and propagation objects to which NrHelper has assigned streams in order to avoid double assignments
   Ptr<NrMacSchedulingStats> m_macSchedStats; //!<< Pointer to NrMacStatsCalculator
 
@@ -77,10 +77,77 @@ NrMacRxTrace::GetTypeId (void)
 }
 
 void
-NrMacRxTrace::RxedGnbMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, std::string path,
-                                              SfnSf sfn, uint16_t nodeId, uint16_t rnti,
-                                              uint8_t bwpId, Ptr<const NrControlMessage> msg)
+NrMacRxTrace::SetStatsSink (const Ptr<NrStatsSink> &sink)
 {
+  NS_LOG_FUNCTION (this << sink);
+  m_statsSink = sink;
+  const std::vector<NrStatsSink::Column> columns = {{"Time", NrStatsSink::REAL},
+                                                    {"Entity", NrStatsSink::TEXT},
+                                                    {"Frame", NrStatsSink::INTEGER},
+                                                    {"SubFrame", NrStatsSink::INTEGER},
+                                                    {"Slot", NrStatsSink::INTEGER},
+                                                    {"NodeId", NrStatsSink::INTEGER},
+                                                    {"Rnti", NrStatsSink::INTEGER},
+                                                    {"BwpId", NrStatsSink::INTEGER},
+                                                    {"MsgType", NrStatsSink::TEXT}};
+  m_rxedGnbMacCtrlMsgsTable = sink->AddTable ("RxedGnbMacCtrlMsgs", columns);
+  m_txedGnbMacCtrlMsgsTable = sink->AddTable ("TxedGnbMacCtrlMsgs", columns);
+  m_rxedUeMacCtrlMsgsTable = sink->AddTable ("RxedUeMacCtrlMsgs", columns);
+  m_txedUeMacCtrlMsgsTable = sink->AddTable ("TxedUeMacCtrlMsgs", columns);
+}
+
+void
+NrMacRxTrace::WriteCtrlMsgRow (uint32_t table, const std::string &entity, const SfnSf &sfn,
+                               uint16_t nodeId, uint16_t rnti, uint8_t bwpId,
+                               const std::string &msgType)
+{
+  m_statsSink->BeginRow (table);
+  m_statsSink->Put (Simulator::Now ().GetSeconds ());
+  m_statsSink->Put (entity);
+  m_statsSink->Put (sfn.GetFrame ());
+  m_statsSink->Put (sfn.GetSubframe ());
+  m_statsSink->Put (sfn.GetSlot ());
+  m_statsSink->Put (nodeId);
+  m_statsSink->Put (rnti);
+  m_statsSink->Put (bwpId);
+  m_statsSink->Put (msgType);
+  m_statsSink->EndRow ();
+}
+
+void
+NrMacRxTrace::RxedGnbMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, [[maybe_unused]] std::string path,
+                                          SfnSf sfn, uint16_t nodeId, uint16_t rnti,
+                                          uint8_t bwpId, Ptr<const NrControlMessage> msg)
+{
+  std::string msgType = "Other";
+  if (msg->GetMessageType () == NrControlMessage::SR)
+    {
+      msgType = "SR";
+    }
+  else if (msg->GetMessageType () == NrControlMessage::DL_CQI)
+    {
+      msgType = "DL_CQI";
+    }
+  else if (msg->GetMessageType () == NrControlMessage::BSR)
+    {
+      msgType = "BSR";
+    }
+  else if (msg->GetMessageType () == NrControlMessage::DL_HARQ)
+    {
+      msgType = "DL_HARQ";
+    }
+  else if (msg->GetMessageType () == NrControlMessage::RACH_PREAMBLE)
+    {
+      msgType = "RACH_PREAMBLE";
+    }
+
+  if (macStats != nullptr && macStats->m_statsSink != nullptr)
+    {
+      macStats->WriteCtrlMsgRow (macStats->m_rxedGnbMacCtrlMsgsTable, "ENB MAC Rxed",
+                                 sfn, nodeId, rnti, bwpId, msgType);
+      return;
+    }
+
   if (!m_rxedGnbMacCtrlMsgsFile.is_open ())
       {
         m_rxedGnbMacCtrlMsgsFileName = "RxedGnbMacCtrlMsgsTrace.txt";
@@ -98,44 +165,35 @@ NrMacRxTrace::RxedGnbMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, std::strin
       }
 
   m_rxedGnbMacCtrlMsgsFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 <<
-                              "\t" << "ENB MAC Rxed"  << "\t" << sfn.GetFrame () <<
+                              "\t" << "ENB MAC Rxed" << "\t" << sfn.GetFrame () <<
                               "\t" << static_cast<uint32_t> (sfn.GetSubframe ()) <<
                               "\t" << static_cast<uint32_t> (sfn.GetSlot ()) <<
                               "\t" << nodeId << "\t" << rnti <<
-                              "\t" << static_cast<uint32_t> (bwpId) << "\t";
+                              "\t" << static_cast<uint32_t> (bwpId) << "\t" << msgType << std::endl;
+}
 
-  if (msg->GetMessageType () == NrControlMessage::SR)
+void
+NrMacRxTrace::TxedGnbMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, [[maybe_unused]] std::string path,
+                                          SfnSf sfn, uint16_t nodeId, uint16_t rnti,
+                                          uint8_t bwpId, Ptr<const NrControlMessage> msg)
+{
+  std::string msgType = "Other";
+  if (msg->GetMessageType () == NrControlMessage::RAR)
     {
-      m_rxedGnbMacCtrlMsgsFile << "SR";
+      msgType = "RAR";
     }
   else if (msg->GetMessageType () == NrControlMessage::DL_CQI)
     {
-      m_rxedGnbMacCtrlMsgsFile << "DL_CQI";
+      msgType = "DL_CQI";
     }
-  else if (msg->GetMessageType () == NrControlMessage::BSR)
-    {
-      m_rxedGnbMacCtrlMsgsFile << "BSR";
-    }
-  else if (msg->GetMessageType () == NrControlMessage::DL_HARQ)
-    {
-      m_rxedGnbMacCtrlMsgsFile << "DL_HARQ";
-    }
-  else if (msg->GetMessageType () == NrControlMessage::RACH_PREAMBLE)
-    {
-      m_rxedGnbMacCtrlMsgsFile << "RACH_PREAMBLE";
-    }
-  else
+
+  if (macStats != nullptr && macStats->m_statsSink != nullptr)
     {
-      m_rxedGnbMacCtrlMsgsFile << "Other";
+      macStats->WriteCtrlMsgRow (macStats->m_txedGnbMacCtrlMsgsTable, "ENB MAC Txed",
+                                 sfn, nodeId, rnti, bwpId, msgType);
+      return;
     }
-  m_rxedGnbMacCtrlMsgsFile << std::endl;
-}
 
-void
-NrMacRxTrace::TxedGnbMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, std::string path,
-                                              SfnSf sfn, uint16_t nodeId, uint16_t rnti,
-                                              uint8_t bwpId, Ptr<const NrControlMessage> msg)
-{
   if (!m_txedGnbMacCtrlMsgsFile.is_open ())
       {
         m_txedGnbMacCtrlMsgsFileName = "TxedGnbMacCtrlMsgsTrace.txt";
@@ -153,33 +211,39 @@ NrMacRxTrace::TxedGnbMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, std::strin
       }
 
   m_txedGnbMacCtrlMsgsFile << Simulator::Now ().GetNanoSeconds () / (double) 1e9 <<
-                              "\t" << "ENB MAC Txed"  << "\t" << sfn.GetFrame () <<
+                              "\t" << "ENB MAC Txed" << "\t" << sfn.GetFrame () <<
                               "\t" << static_cast<uint32_t> (sfn.GetSubframe ()) <<
                               "\t" << static_cast<uint32_t> (sfn.GetSlot ()) <<
                               "\t" << nodeId << "\t" << rnti <<
-                              "\t" << static_cast<uint32_t> (bwpId) << "\t";
+                              "\t" << static_cast<uint32_t> (bwpId) << "\t" << msgType << std::endl;
+}
 
-  if (msg->GetMessageType () == NrControlMessage::RAR)
+void
+NrMacRxTrace::RxedUeMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, [[maybe_unused]] std::string path,
+                                         SfnSf sfn, uint16_t nodeId, uint16_t rnti,
+                                         uint8_t bwpId, Ptr<const NrControlMessage> msg)
+{
+  std::string msgType = "Other";
+  if (msg->GetMessageType () == NrControlMessage::UL_DCI)
     {
-      m_txedGnbMacCtrlMsgsFile << "RAR";
+      msgType = "UL_DCI";
     }
-  else if (msg->GetMessageType () == NrControlMessage::DL_CQI)
+  else if (msg->GetMessageType () == NrControlMessage::DL_DCI)
     {
-      m_txedGnbMacCtrlMsgsFile << "DL_CQI";
+      msgType = "DL_DCI";
     }
-  else
+  else if (msg->GetMessageType () == NrControlMessage::RAR)
     {
-      m_txedGnbMacCtrlMsgsFile << "Other";
+      msgType = "RAR";
     }
 
-  m_txedGnbMacCtrlMsgsFile << std::endl;
-}
+  if (macStats != nullptr && macStats->m_statsSink != nullptr)
+    {
+      macStats->WriteCtrlMsgRow (macStats->m_rxedUeMacCtrlMsgsTable, "UE  MAC Rxed",
+                                 sfn, nodeId, rnti, bwpId, msgType);
+      return;
+    }
 
-void
-NrMacRxTrace::RxedUeMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, std::string path,
-                                             SfnSf sfn, uint16_t nodeId, uint16_t rnti,
-                                             uint8_t bwpId, Ptr<const NrControlMessage> msg)
-{
   if (!m_rxedUeMacCtrlMsgsFile.is_open ())
       {
         m_rxedUeMacCtrlMsgsFileName = "RxedUeMacCtrlMsgsTrace.txt";
@@ -201,32 +265,35 @@ NrMacRxTrace::RxedUeMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, std::string
                              "\t" << static_cast<uint32_t> (sfn.GetSubframe ()) <<
                              "\t" << static_cast<uint32_t> (sfn.GetSlot ()) <<
                              "\t" << nodeId << "\t" << rnti <<
-                             "\t" << static_cast<uint32_t> (bwpId) << "\t";
+                             "\t" << static_cast<uint32_t> (bwpId) << "\t" << msgType << std::endl;
+}
 
-  if (msg->GetMessageType () == NrControlMessage::UL_DCI)
+void
+NrMacRxTrace::TxedUeMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, [[maybe_unused]] std::string path,
+                                         SfnSf sfn, uint16_t nodeId, uint16_t rnti,
+                                         uint8_t bwpId, Ptr<const NrControlMessage> msg)
+{
+  std::string msgType = "Other";
+  if (msg->GetMessageType () == NrControlMessage::BSR)
     {
-      m_rxedUeMacCtrlMsgsFile << "UL_DCI";
+      msgType = "BSR";
     }
-  else if (msg->GetMessageType () == NrControlMessage::DL_DCI)
+  else if (msg->GetMessageType () == NrControlMessage::SR)
     {
-      m_rxedUeMacCtrlMsgsFile << "DL_DCI";
+      msgType = "SR";
     }
-  else if (msg->GetMessageType () == NrControlMessage::RAR)
+  else if (msg->GetMessageType () == NrControlMessage::RACH_PREAMBLE)
     {
-      m_rxedUeMacCtrlMsgsFile << "RAR";
+      msgType = "RACH_PREAMBLE";
     }
-  else
+
+  if (macStats != nullptr && macStats->m_statsSink != nullptr)
     {
-      m_rxedUeMacCtrlMsgsFile << "Other";
+      macStats->WriteCtrlMsgRow (macStats->m_txedUeMacCtrlMsgsTable, "UE  MAC Txed",
+                                 sfn, nodeId, rnti, bwpId, msgType);
+      return;
     }
-  m_rxedUeMacCtrlMsgsFile << std::endl;
-}
 
-void
-NrMacRxTrace::TxedUeMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, std::string path,
-                                             SfnSf sfn, uint16_t nodeId, uint16_t rnti,
-                                             uint8_t bwpId, Ptr<const NrControlMessage> msg)
-{
   if (!m_txedUeMacCtrlMsgsFile.is_open ())
       {
         m_txedUeMacCtrlMsgsFileName = "TxedUeMacCtrlMsgsTrace.txt";
@@ -249,25 +316,7 @@ NrMacRxTrace::TxedUeMacCtrlMsgsCallback (Ptr<NrMacRxTrace> macStats, std::string
                              "\t" << static_cast<uint32_t> (sfn.GetSubframe ()) <<
                              "\t" << static_cast<uint32_t> (sfn.GetSlot ()) <<
                              "\t" << nodeId << "\t" << rnti <<
-                             "\t" << static_cast<uint32_t> (bwpId) << "\t";
-
-  if (msg->GetMessageType () == NrControlMessage::BSR)
-    {
-      m_txedUeMacCtrlMsgsFile << "BSR";
-    }
-  else if (msg->GetMessageType () == NrControlMessage::SR)
-    {
-      m_txedUeMacCtrlMsgsFile << "SR";
-    }
-  else if (msg->GetMessageType () == NrControlMessage::RACH_PREAMBLE)
-    {
-      m_txedUeMacCtrlMsgsFile << "RACH_PREAMBLE";
-    }
-  else
-    {
-      m_txedUeMacCtrlMsgsFile << "Other";
-    }
-  m_txedUeMacCtrlMsgsFile << std::endl;
+                             "\t" << static_cast<uint32_t> (bwpId) << "\t" << msgType << std::endl;
 }
 
 } /* namespace ns3 */
@@ -25,6 +25,7 @@
 #include <ns3/nr-phy-mac-common.h>
 #include <ns3/nr-control-messages.h>
 #include <ns3/nr-gnb-mac.h>
+#include "nr-stats-sink.h"
 #include <iostream>
 
 namespace ns3 {
@@ -36,6 +37,17 @@ public:
   virtual ~NrMacRxTrace ();
   static TypeId GetTypeId (void);
 
+  /**
+   * \brief Store the MAC control message traces in a NrStatsSink instead of
+   * the text files
+   * \param sink the (already open) sink
+   *
+   * The rows go in the tables "RxedGnbMacCtrlMsgs", "TxedGnbMacCtrlMsgs",
+   * "RxedUeMacCtrlMsgs" and "TxedUeMacCtrlMsgs", which have the columns of
+   * the text files, without the (always empty) VarTTI.
+   */
+  void SetStatsSink (const Ptr<NrStatsSink> &sink);
+
   /**
    *  Trace sink for Enb Mac Received Control Messages.
    *
@@ -101,6 +113,25 @@ public:
                                          uint8_t bwpId, Ptr<const NrControlMessage> msg);
 
 private:
+  /**
+   * \brief Write a row of a control message trace in the stats sink
+   * \param table the table of the trace in the sink
+   * \param entity the entity column
+   * \param sfn the SfnSf of the message
+   * \param nodeId the node id
+   * \param rnti the RNTI
+   * \param bwpId the BWP id
+   * \param msgType the name of the message type
+   */
+  void WriteCtrlMsgRow (uint32_t table, const std::string &entity, const SfnSf &sfn,
+                        uint16_t nodeId, uint16_t rnti, uint8_t bwpId,
+                        const std::string &msgType);
+
+  Ptr<NrStatsSink> m_statsSink;          //!< Sink of the control message traces, if any
+  uint32_t m_rxedGnbMacCtrlMsgsTable {0}; //!< Table of the gNB RX trace in the sink
+  uint32_t m_txedGnbMacCtrlMsgsTable {0}; //!< Table of the gNB TX trace in the sink
+  uint32_t m_rxedUeMacCtrlMsgsTable {0};  //!< Table of the UE RX trace in the sink
+  uint32_t m_txedUeMacCtrlMsgsTable {0};  //!< Table of the UE TX trace in the sink
 
   static std::ofstream m_rxedGnbMacCtrlMsgsFile;
   static std::string m_rxedGnbMacCtrlMsgsFileName;
@@ -21,6 +21,7 @@
 #include "ns3/string.h"
 #include <ns3/simulator.h>
 #include <ns3/log.h>
+#include <ns3/nr-gnb-net-device.h>
 #include "nr-mac-scheduling-stats.h"
 
 namespace ns3 {
@@ -250,4 +251,68 @@ NrMacSchedulingStats::UlSchedulingCallback (Ptr<NrMacSchedulingStats> macStats,
 }
 
 
+uint64_t
+NrMacSchedulingStats::GnbTraceContext::GetImsi (uint16_t rnti)
+{
+  auto it = m_imsiByRnti.find (rnti);
+  if (it != m_imsiByRnti.end ())
+    {
+      return it->second;
+    }
+
+  NS_ABORT_MSG_IF (!m_rrc->HasUeManager (rnti),
+                   "No UE with RNTI " << rnti << " in cell " << m_cellId);
+  uint64_t imsi = m_rrc->GetUeManager (rnti)->GetImsi ();
+  m_imsiByRnti.emplace (rnti, imsi);
+  return imsi;
+}
+
+Ptr<NrMacSchedulingStats::GnbTraceContext>
+NrMacSchedulingStats::CreateGnbTraceContext (const Ptr<NrGnbNetDevice> &gnb)
+{
+  NS_LOG_FUNCTION (this << gnb);
+  Ptr<GnbTraceContext> ctx = Create<GnbTraceContext> ();
+  ctx->m_stats = this;
+  ctx->m_rrc = gnb->GetRrc ();
+  ctx->m_cellId = gnb->GetCellId ();
+  return ctx;
+}
+
+void
+NrMacSchedulingStats::ConnectDlSchedulingTrace (const Ptr<NrGnbNetDevice> &gnb)
+{
+  NS_LOG_FUNCTION (this << gnb);
+  Ptr<GnbTraceContext> ctx = CreateGnbTraceContext (gnb);
+  for (uint32_t bwp = 0; bwp < gnb->GetCcMapSize (); ++bwp)
+    {
+      gnb->GetMac (bwp)->TraceConnectWithoutContext ("DlScheduling",
+                                                     MakeBoundCallback (&NrMacSchedulingStats::DlSchedulingCallbackWithCtx, ctx));
+    }
+}
+
+void
+NrMacSchedulingStats::ConnectUlSchedulingTrace (const Ptr<NrGnbNetDevice> &gnb)
+{
+  NS_LOG_FUNCTION (this << gnb);
+  Ptr<GnbTraceContext> ctx = CreateGnbTraceContext (gnb);
+  for (uint32_t bwp = 0; bwp < gnb->GetCcMapSize (); ++bwp)
+    {
+      gnb->GetMac (bwp)->TraceConnectWithoutContext ("UlScheduling",
+                                                     MakeBoundCallback (&NrMacSchedulingStats::UlSchedulingCallbackWithCtx, ctx));
+    }
+}
+
+void
+NrMacSchedulingStats::DlSchedulingCallbackWithCtx (Ptr<GnbTraceContext> ctx, NrSchedulingCallbackInfo traceInfo)
+{
+  ctx->m_stats->DlScheduling (ctx->m_cellId, ctx->GetImsi (traceInfo.m_rnti), traceInfo);
+}
+
+void
+NrMacSchedulingStats::UlSchedulingCallbackWithCtx (Ptr<GnbTraceContext> ctx, NrSchedulingCallbackInfo traceInfo)
+{
+  ctx->m_stats->UlScheduling (ctx->m_cellId, ctx->GetImsi (traceInfo.m_rnti), traceInfo);
+}
+
+
 } // namespace ns3
@@ -26,10 +26,14 @@
 #include "ns3/uinteger.h"
 #include <string>
 #include <fstream>
+#include <unordered_map>
 #include "ns3/nr-gnb-mac.h"
+#include "ns3/lte-enb-rrc.h"
 
 namespace ns3 {
 
+class NrGnbNetDevice;
+
 /**
  * \ingroup nr
  *
@@ -45,6 +49,13 @@ namespace ns3 {
  *   - Stream id
  *   - MCS
  *   - Size of transport block
+ *
+ * The sinks DlSchedulingCallback and UlSchedulingCallback are meant to be
+ * connected through Config::Connect, and they find the IMSI and the cell ID
+ * from the trace path at every event. As an alternative, ConnectDlSchedulingTrace
+ * and ConnectUlSchedulingTrace connect the sinks directly to the MACs of a gNB,
+ * bound to a GnbTraceContext that is resolved at connection time. In that case,
+ * the only per-event work is a lookup of the RNTI in a small hash table.
  */
 class NrMacSchedulingStats : public NrStatsCalculator
 {
@@ -130,7 +141,64 @@ public:
    */
   static void UlSchedulingCallback (Ptr<NrMacSchedulingStats> macStats, std::string path, NrSchedulingCallbackInfo traceInfo);
 
+  /**
+   * \brief Information about a gNB, resolved when the sinks are connected
+   */
+  struct GnbTraceContext : public SimpleRefCount<GnbTraceContext>
+  {
+    /**
+     * \brief Get the IMSI of a UE attached to the gNB
+     * \param rnti the RNTI of the UE
+     * \return the IMSI of the UE
+     *
+     * The IMSI is asked to the RRC only the first time a RNTI is seen.
+     */
+    uint64_t GetImsi (uint16_t rnti);
+
+    Ptr<NrMacSchedulingStats> m_stats;                //!< The stats calculator
+    Ptr<LteEnbRrc> m_rrc;                             //!< The RRC of the gNB
+    uint16_t m_cellId {0};                            //!< The cell ID of the gNB
+    std::unordered_map<uint16_t, uint64_t> m_imsiByRnti; //!< IMSI of the RNTI already seen
+  };
+
+  /**
+   * \brief Connect the DlScheduling trace of all the MACs of a gNB, without
+   * context string
+   * \param gnb the gNB device
+   */
+  void ConnectDlSchedulingTrace (const Ptr<NrGnbNetDevice> &gnb);
+
+  /**
+   * \brief Connect the UlScheduling trace of all the MACs of a gNB, without
+   * context string
+   * \param gnb the gNB device
+   */
+  void ConnectUlSchedulingTrace (const Ptr<NrGnbNetDevice> &gnb);
+
+  /**
+   * \brief Trace sink for the ns3::NrGnbMac::DlScheduling trace source,
+   * connected through ConnectDlSchedulingTrace
+   * \param ctx the gNB context
+   * \param traceInfo the scheduling information
+   */
+  static void DlSchedulingCallbackWithCtx (Ptr<GnbTraceContext> ctx, NrSchedulingCallbackInfo traceInfo);
+
+  /**
+   * \brief Trace sink for the ns3::NrGnbMac::UlScheduling trace source,
+   * connected through ConnectUlSchedulingTrace
+   * \param ctx the gNB context
+   * \param traceInfo the scheduling information
+   */
+  static void UlSchedulingCallbackWithCtx (Ptr<GnbTraceContext> ctx, NrSchedulingCallbackInfo traceInfo);
+
 private:
+  /**
+   * \brief Build the context of a gNB
+   * \param gnb the gNB device
+   * \return the context, to be shared by the MACs of the gNB
+   */
+  Ptr<GnbTraceContext> CreateGnbTraceContext (const Ptr<NrGnbNetDevice> &gnb);
+
   /**
    * When writing DL MAC statistics first time to file,
    * columns description is added. Then next lines are
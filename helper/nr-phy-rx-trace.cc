@@ -148,6 +148,58 @@ NrPhyRxTrace::SetSimTag (const std::string &simTag)
   m_simTag = simTag;
 }
 
+void
+NrPhyRxTrace::SetStatsSink (const Ptr<NrStatsSink> &sink)
+{
+  NS_LOG_FUNCTION (this << sink);
+  m_statsSink = sink;
+  m_rxPacketTraceTable = sink->AddTable ("RxPacketTrace",
+                                         {{"Time", NrStatsSink::REAL},
+                                          {"Direction", NrStatsSink::TEXT},
+                                          {"Frame", NrStatsSink::INTEGER},
+                                          {"SubFrame", NrStatsSink::INTEGER},
+                                          {"Slot", NrStatsSink::INTEGER},
+                                          {"SymStart", NrStatsSink::INTEGER},
+                                          {"NumSym", NrStatsSink::INTEGER},
+                                          {"CellId", NrStatsSink::INTEGER},
+                                          {"BwpId", NrStatsSink::INTEGER},
+                                          {"StreamId", NrStatsSink::INTEGER},
+                                          {"Rnti", NrStatsSink::INTEGER},
+                                          {"TbSize", NrStatsSink::INTEGER},
+                                          {"Mcs", NrStatsSink::INTEGER},
+                                          {"Rv", NrStatsSink::INTEGER},
+                                          {"SinrDb", NrStatsSink::REAL},
+                                          {"Cqi", NrStatsSink::INTEGER},
+                                          {"Corrupt", NrStatsSink::INTEGER},
+                                          {"TbLer", NrStatsSink::REAL}});
+}
+
+void
+NrPhyRxTrace::WriteRxPacketTraceRow (const std::string &direction,
+                                     const RxPacketTraceParams &params, int64_t cqi)
+{
+  m_statsSink->BeginRow (m_rxPacketTraceTable);
+  m_statsSink->Put (Simulator::Now ().GetSeconds ());
+  m_statsSink->Put (direction);
+  m_statsSink->Put (params.m_frameNum);
+  m_statsSink->Put (params.m_subframeNum);
+  m_statsSink->Put (params.m_slotNum);
+  m_statsSink->Put (params.m_symStart);
+  m_statsSink->Put (params.m_numSym);
+  m_statsSink->Put (params.m_cellId);
+  m_statsSink->Put (params.m_bwpId);
+  m_statsSink->Put (params.m_streamId);
+  m_statsSink->Put (params.m_rnti);
+  m_statsSink->Put (params.m_tbSize);
+  m_statsSink->Put (params.m_mcs);
+  m_statsSink->Put (params.m_rv);
+  m_statsSink->Put (10 * log10 (params.m_sinr));
+  m_statsSink->Put (cqi);
+  m_statsSink->Put (params.m_corrupt);
+  m_statsSink->Put (params.m_tbler);
+  m_statsSink->EndRow ();
+}
+
 void
 NrPhyRxTrace::DlDataSinrCallback ([[maybe_unused]]Ptr<NrPhyRxTrace> phyStats, [[maybe_unused]] std::string path,
                                   uint16_t cellId, uint16_t rnti, double avgSinr, uint16_t bwpId, uint8_t streamId)
@@ -653,6 +705,12 @@ NrPhyRxTrace::ReportDLTbSize (uint64_t imsi, uint64_t tbSize)
 void
 NrPhyRxTrace::RxPacketTraceUeCallback (Ptr<NrPhyRxTrace> phyStats, std::string path, RxPacketTraceParams params)
 {
+  if (phyStats->m_statsSink != nullptr)
+    {
+      phyStats->WriteRxPacketTraceRow ("DL", params, params.m_cqi);
+      return;
+    }
+
   if (!m_rxPacketTraceFile.is_open ())
     {
       std::ostringstream oss;
@@ -715,6 +773,12 @@ NrPhyRxTrace::RxPacketTraceUeCallback (Ptr<NrPhyRxTrace> phyStats, std::string p
 void
 NrPhyRxTrace::RxPacketTraceEnbCallback (Ptr<NrPhyRxTrace> phyStats, std::string path, RxPacketTraceParams params)
 {
+  if (phyStats->m_statsSink != nullptr)
+    {
+      phyStats->WriteRxPacketTraceRow ("UL", params, -1);
+      return;
+    }
+
   if (!m_rxPacketTraceFile.is_open ())
     {
       std::ostringstream oss;
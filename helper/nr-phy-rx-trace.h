@@ -35,6 +35,7 @@
 #include <ns3/nr-control-messages.h>
 #include <ns3/nr-spectrum-phy.h>
 #include <ns3/spectrum-phy.h>
+#include "nr-stats-sink.h"
 #include <fstream>
 #include <iostream>
 
@@ -54,6 +55,16 @@ public:
    */
   void SetSimTag (const std::string &simTag);
 
+  /**
+   * \brief Store the RX packet trace in a NrStatsSink instead of the
+   * RxPacketTrace text file
+   * \param sink the (already open) sink
+   *
+   * The rows go in the table "RxPacketTrace", which has the columns of the
+   * text file. The CQI column is -1 for the UL.
+   */
+  void SetStatsSink (const Ptr<NrStatsSink> &sink);
+
   /**
    * \brief Trace sink for DL Average SINR of DATA (in dB).
    * \param [in] phyStats NrPhyRxTrace object
@@ -202,6 +213,14 @@ private:
   void ReportPacketCountUe (UePhyPacketCountParameter param);
   void ReportPacketCountEnb (GnbPhyPacketCountParameter param);
   void ReportDLTbSize (uint64_t imsi, uint64_t tbSize);
+  /**
+   * \brief Write a row of the RX packet trace in the stats sink
+   * \param direction "DL" or "UL"
+   * \param params the trace parameters
+   * \param cqi the CQI, or -1 if not applicable
+   */
+  void WriteRxPacketTraceRow (const std::string &direction,
+                              const RxPacketTraceParams &params, int64_t cqi);
   /**
    * \brief Write DL pathloss values in a file
    *
@@ -225,6 +244,8 @@ private:
 
 
   static std::string m_simTag;   //!< The `SimTag` attribute.
+  Ptr<NrStatsSink> m_statsSink;  //!< Sink of the RX packet trace, if any
+  uint32_t m_rxPacketTraceTable {0}; //!< Table of the RX packet trace in the sink
 
   static std::ofstream m_dlDataSinrFile;
   static std::string m_dlDataSinrFileName;
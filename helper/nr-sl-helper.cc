@@ -31,6 +31,7 @@
 #include <ns3/nr-sl-chunk-processor.h>
 #include <ns3/lte-rrc-sap.h>
 #include <ns3/nr-sl-ue-rrc.h>
+#include <ns3/nr-sl-ue-prose.h>
 #include <ns3/lte-ue-rrc.h>
 #include <ns3/lte-sl-tft.h>
 
@@ -352,6 +353,15 @@ NrSlHelper::AssignStreams (NetDeviceContainer c, int64_t stream)
                     currentStream += sched->AssignStreams (currentStream);
                   }
               }
+            //ProSe layer, if PrepareUesForProse of NrSlProseHelper was called
+            if (nrUeDev->GetSlUeService () != nullptr)
+              {
+                Ptr<NrSlUeProse> prose = nrUeDev->GetSlUeService ()->GetObject<NrSlUeProse> ();
+                if (prose != nullptr)
+                  {
+                    currentStream += prose->AssignStreams (currentStream);
+                  }
+              }
           }
       }
 
@@ -147,7 +147,9 @@ public:
     * \brief Assign a fixed random variable stream number to the random variables used.
     *
     * The InstallUeDevice and PrepareUeForSidelink method should have previously
-    * been called by the user on the given devices.
+    * been called by the user on the given devices. The streams of the ProSe
+    * layer are assigned too if PrepareUesForProse of NrSlProseHelper was
+    * called before.
     *
     *
     * \param c NetDeviceContainer of the NR SL UE NetDevices for which
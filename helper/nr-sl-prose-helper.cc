@@ -332,5 +332,26 @@ NrSlProseHelper::EnableDiscoveryTraces (void)
   Config::Connect ("/NodeList/*/DeviceList/*/$ns3::NrUeNetDevice/NrSlService/$ns3::NrSlUeProse/DiscoveryTrace", MakeBoundCallback (&NrSlDiscoveryTrace::DiscoveryTraceCallback, m_discoveryTrace));
 }
 
+int64_t
+NrSlProseHelper::AssignStreams (NetDeviceContainer c, int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  int64_t currentStream = stream;
+  for (NetDeviceContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Ptr<NrUeNetDevice> nrUeDev = DynamicCast<NrUeNetDevice> (*i);
+      if (nrUeDev == nullptr || nrUeDev->GetSlUeService () == nullptr)
+        {
+          continue;
+        }
+      Ptr<NrSlUeProse> prose = nrUeDev->GetSlUeService ()->GetObject<NrSlUeProse> ();
+      if (prose != nullptr)
+        {
+          currentStream += prose->AssignStreams (currentStream);
+        }
+    }
+  return (currentStream - stream);
+}
+
 } // namespace ns3
 
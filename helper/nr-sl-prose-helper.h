@@ -223,6 +223,19 @@ public:
    */
   void EnableDiscoveryTraces (void);
 
+  /**
+   * \brief Assign a fixed random variable stream number to the random
+   *        variables of the ProSe layer of the devices
+   *
+   * PrepareUesForProse should have previously been called on the given
+   * devices.
+   *
+   * \param c NetDeviceContainer of the NR SL UE NetDevices
+   * \param stream first stream index to use
+   * \return the number of stream indices (possibly zero) that have been assigned
+   */
+  int64_t AssignStreams (NetDeviceContainer c, int64_t stream);
+
 protected:
   /**
    * \brief \c DoDispose method inherited from \c Object
@@ -0,0 +1,445 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "nr-stats-sink.h"
+
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/boolean.h>
+#include <ns3/uinteger.h>
+
+#ifdef HAVE_SQLITE3
+#include <ns3/sqlite-output.h>
+#endif
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrStatsSink");
+NS_OBJECT_ENSURE_REGISTERED (NrStatsSink);
+
+NrStatsSink::NrStatsSink ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+NrStatsSink::~NrStatsSink ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+TypeId
+NrStatsSink::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::NrStatsSink")
+    .SetParent<Object> ()
+    .SetGroupName ("nr")
+    .AddConstructor<NrStatsSink> ()
+    .AddAttribute ("BatchSize",
+                   "Number of rows of a table that are cached before writing "
+                   "them to the output file",
+                   UintegerValue (10000),
+                   MakeUintegerAccessor (&NrStatsSink::m_batchSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MemoryCap",
+                   "Approximate size, in bytes, of the cached values of all the "
+                   "tables, above which all the cached rows are written",
+                   UintegerValue (4000000),
+                   MakeUintegerAccessor (&NrStatsSink::m_memoryCap),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("UseSqlite",
+                   "If true, and the simulator is built with SQLite, write a "
+                   "SQLite database; otherwise, write the binary columnar file",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&NrStatsSink::m_useSqlite),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+
+void
+NrStatsSink::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+  Object::DoDispose ();
+}
+
+void
+NrStatsSink::Open (const std::string &fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  NS_ABORT_MSG_IF (m_db != nullptr || m_file.is_open (), "The output is already open");
+  NS_ABORT_MSG_IF (!m_tables.empty (), "Open the output before adding the tables");
+
+#ifdef HAVE_SQLITE3
+  if (m_useSqlite)
+    {
+      m_db = new SQLiteOutput (fileName);
+      return;
+    }
+#endif
+
+  m_file.open (fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  NS_ABORT_MSG_IF (!m_file.is_open (), "Could not open " << fileName);
+  m_file.write ("NRSTATS1", 8);
+}
+
+bool
+NrStatsSink::IsSqlite () const
+{
+  return m_db != nullptr;
+}
+
+uint32_t
+NrStatsSink::AddTable (const std::string &name, const std::vector<Column> &columns)
+{
+  NS_LOG_FUNCTION (this << name << columns.size ());
+  NS_ABORT_MSG_IF (m_db == nullptr && !m_file.is_open (), "Open the output before adding the tables");
+  NS_ABORT_MSG_IF (columns.empty (), "Table " << name << " has no columns");
+
+  uint32_t tableId = static_cast<uint32_t> (m_tables.size ());
+  m_tables.emplace_back ();
+  Table &table = m_tables.back ();
+  table.m_name = name;
+  table.m_columns = columns;
+
+  for (const auto & column : columns)
+    {
+      switch (column.m_type)
+        {
+        case INTEGER:
+          table.m_slot.push_back (static_cast<uint32_t> (table.m_integers.size ()));
+          table.m_integers.emplace_back ();
+          break;
+        case REAL:
+          table.m_slot.push_back (static_cast<uint32_t> (table.m_reals.size ()));
+          table.m_reals.emplace_back ();
+          break;
+        case TEXT:
+          table.m_slot.push_back (static_cast<uint32_t> (table.m_texts.size ()));
+          table.m_texts.emplace_back ();
+          break;
+        default:
+          NS_FATAL_ERROR ("Unknown column type");
+        }
+    }
+
+#ifdef HAVE_SQLITE3
+  if (m_db != nullptr)
+    {
+      static const char *typeNames[] = {"INTEGER", "REAL", "TEXT"};
+      std::string create = "CREATE TABLE IF NOT EXISTS \"" + name + "\" (";
+      std::string insert = "INSERT INTO \"" + name + "\" VALUES (";
+      for (uint32_t i = 0; i < columns.size (); ++i)
+        {
+          create += (i > 0 ? ", " : "") + columns.at (i).m_name + " " +
+            typeNames[columns.at (i).m_type] + " NOT NULL";
+          insert += (i > 0 ? ",?" : "?");
+        }
+      bool ret = m_db->SpinExec (create + ");");
+      NS_ABORT_MSG_IF (!ret, "Could not create table " << name);
+      ret = m_db->SpinPrepare (&table.m_insert, insert + ");");
+      NS_ABORT_MSG_IF (!ret, "Could not prepare the insertion in table " << name);
+      return tableId;
+    }
+#endif
+
+  m_file.put ('T');
+  m_file.write (reinterpret_cast<const char*> (&tableId), sizeof (tableId));
+  WriteString (name);
+  uint32_t numColumns = static_cast<uint32_t> (columns.size ());
+  m_file.write (reinterpret_cast<const char*> (&numColumns), sizeof (numColumns));
+  for (const auto & column : columns)
+    {
+      m_file.put (static_cast<char> (column.m_type));
+      WriteString (column.m_name);
+    }
+
+  return tableId;
+}
+
+void
+NrStatsSink::DeleteWhere (uint32_t tableId, [[maybe_unused]] int64_t seed,
+                          [[maybe_unused]] int64_t run)
+{
+  NS_LOG_FUNCTION (this << tableId << seed << run);
+  NS_ASSERT_MSG (tableId < m_tables.size (), "Unknown table " << tableId);
+
+#ifdef HAVE_SQLITE3
+  if (m_db != nullptr)
+    {
+      const std::string &name = m_tables[tableId].m_name;
+      sqlite3_stmt *stmt;
+      bool ret = m_db->SpinPrepare (&stmt, "DELETE FROM \"" + name + "\" WHERE SEED = ? AND RUN = ?;");
+      NS_ABORT_MSG_IF (!ret, "Could not prepare the deletion in table " << name);
+      NS_ABORT_MSG_IF (sqlite3_bind_int64 (stmt, 1, seed) != SQLITE_OK, "Could not bind the seed");
+      NS_ABORT_MSG_IF (sqlite3_bind_int64 (stmt, 2, run) != SQLITE_OK, "Could not bind the run");
+      ret = m_db->SpinExec (stmt);
+      NS_ABORT_MSG_IF (!ret, "Could not delete the rows of table " << name);
+    }
+#endif
+}
+
+void
+NrStatsSink::BeginRow (uint32_t tableId)
+{
+  NS_ASSERT_MSG (tableId < m_tables.size (), "Unknown table " << tableId);
+  NS_ASSERT_MSG (m_currentTable == UINT32_MAX, "The previous row was not ended");
+  m_currentTable = tableId;
+  m_currentColumn = 0;
+}
+
+NrStatsSink::Table &
+NrStatsSink::NextColumn (ColumnType type)
+{
+  NS_ASSERT_MSG (m_currentTable != UINT32_MAX, "Put () outside BeginRow ()/EndRow ()");
+  Table &table = m_tables[m_currentTable];
+  NS_ASSERT_MSG (m_currentColumn < table.m_columns.size (),
+                 "Too many values for table " << table.m_name);
+  NS_ASSERT_MSG (table.m_columns[m_currentColumn].m_type == type,
+                 "Wrong type for column " << table.m_columns[m_currentColumn].m_name <<
+                 " of table " << table.m_name);
+  return table;
+}
+
+void
+NrStatsSink::Put (int64_t value)
+{
+  Table &table = NextColumn (INTEGER);
+  table.m_integers[table.m_slot[m_currentColumn++]].push_back (value);
+  uint64_t bytes = sizeof (value);
+  table.m_bytes += bytes;
+  m_cachedBytes += bytes;
+}
+
+void
+NrStatsSink::Put (double value)
+{
+  Table &table = NextColumn (REAL);
+  table.m_reals[table.m_slot[m_currentColumn++]].push_back (value);
+  uint64_t bytes = sizeof (value);
+  table.m_bytes += bytes;
+  m_cachedBytes += bytes;
+}
+
+void
+NrStatsSink::Put (const std::string &value)
+{
+  Table &table = NextColumn (TEXT);
+  table.m_texts[table.m_slot[m_currentColumn++]].push_back (value);
+  uint64_t bytes = sizeof (std::string) + value.size ();
+  table.m_bytes += bytes;
+  m_cachedBytes += bytes;
+}
+
+void
+NrStatsSink::EndRow ()
+{
+  NS_ASSERT_MSG (m_currentTable != UINT32_MAX, "EndRow () without BeginRow ()");
+  uint32_t tableId = m_currentTable;
+  Table &table = m_tables[tableId];
+  NS_ASSERT_MSG (m_currentColumn == table.m_columns.size (),
+                 "Missing values for table " << table.m_name);
+  m_currentTable = UINT32_MAX;
+  ++table.m_rows;
+
+  if (table.m_rows >= m_batchSize)
+    {
+      WriteTable (table, tableId);
+    }
+
+  if (m_cachedBytes >= m_memoryCap)
+    {
+      Flush ();
+    }
+}
+
+void
+NrStatsSink::Flush ()
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t tableId = 0; tableId < m_tables.size (); ++tableId)
+    {
+      WriteTable (m_tables[tableId], tableId);
+    }
+  if (m_file.is_open ())
+    {
+      m_file.flush ();
+    }
+}
+
+uint64_t
+NrStatsSink::GetWrittenRows () const
+{
+  return m_writtenRows;
+}
+
+void
+NrStatsSink::WriteTable (Table &table, uint32_t tableId)
+{
+  if (table.m_rows == 0)
+    {
+      return;
+    }
+
+  NS_LOG_INFO ("Writing " << table.m_rows << " rows of table " << table.m_name);
+  if (m_db != nullptr)
+    {
+      WriteSqlite (table);
+    }
+  else
+    {
+      WriteColumnar (table, tableId);
+    }
+
+  m_writtenRows += table.m_rows;
+  table.m_rows = 0;
+  m_cachedBytes -= table.m_bytes;
+  table.m_bytes = 0;
+  // clear () keeps the capacity, so the next batch does not reallocate
+  for (auto & column : table.m_integers)
+    {
+      column.clear ();
+    }
+  for (auto & column : table.m_reals)
+    {
+      column.clear ();
+    }
+  for (auto & column : table.m_texts)
+    {
+      column.clear ();
+    }
+}
+
+void
+NrStatsSink::WriteSqlite ([[maybe_unused]] Table &table)
+{
+#ifdef HAVE_SQLITE3
+  bool ret = m_db->SpinExec ("BEGIN TRANSACTION;");
+  NS_ABORT_MSG_IF (!ret, "Could not begin the transaction");
+
+  sqlite3_stmt *stmt = table.m_insert;
+  for (uint32_t row = 0; row < table.m_rows; ++row)
+    {
+      for (uint32_t col = 0; col < table.m_columns.size (); ++col)
+        {
+          uint32_t slot = table.m_slot[col];
+          int rc = SQLITE_OK;
+          switch (table.m_columns[col].m_type)
+            {
+            case INTEGER:
+              rc = sqlite3_bind_int64 (stmt, col + 1, table.m_integers[slot][row]);
+              break;
+            case REAL:
+              rc = sqlite3_bind_double (stmt, col + 1, table.m_reals[slot][row]);
+              break;
+            case TEXT:
+              rc = sqlite3_bind_text (stmt, col + 1, table.m_texts[slot][row].c_str (),
+                                      static_cast<int> (table.m_texts[slot][row].size ()),
+                                      SQLITE_STATIC);
+              break;
+            }
+          NS_ABORT_MSG_IF (rc != SQLITE_OK, "Could not bind column " << table.m_columns[col].m_name);
+        }
+
+      int rc;
+      do
+        {
+          rc = sqlite3_step (stmt);
+        }
+      while (rc == SQLITE_BUSY || rc == SQLITE_LOCKED);
+      NS_ABORT_MSG_IF (rc != SQLITE_DONE, "Could not insert in table " << table.m_name);
+      sqlite3_reset (stmt);
+    }
+
+  ret = m_db->SpinExec ("END TRANSACTION;");
+  NS_ABORT_MSG_IF (!ret, "Could not end the transaction");
+#else
+  NS_FATAL_ERROR ("The simulator is not built with SQLite");
+#endif
+}
+
+void
+NrStatsSink::WriteColumnar (const Table &table, uint32_t tableId)
+{
+  m_file.put ('B');
+  m_file.write (reinterpret_cast<const char*> (&tableId), sizeof (tableId));
+  m_file.write (reinterpret_cast<const char*> (&table.m_rows), sizeof (table.m_rows));
+
+  for (uint32_t col = 0; col < table.m_columns.size (); ++col)
+    {
+      uint32_t slot = table.m_slot[col];
+      switch (table.m_columns[col].m_type)
+        {
+        case INTEGER:
+          m_file.write (reinterpret_cast<const char*> (table.m_integers[slot].data ()),
+                        table.m_rows * sizeof (int64_t));
+          break;
+        case REAL:
+          m_file.write (reinterpret_cast<const char*> (table.m_reals[slot].data ()),
+                        table.m_rows * sizeof (double));
+          break;
+        case TEXT:
+          for (const auto & value : table.m_texts[slot])
+            {
+              WriteString (value);
+            }
+          break;
+        }
+    }
+  NS_ABORT_MSG_IF (!m_file.good (), "Could not write table " << table.m_name);
+}
+
+void
+NrStatsSink::WriteString (const std::string &value)
+{
+  uint32_t length = static_cast<uint32_t> (value.size ());
+  m_file.write (reinterpret_cast<const char*> (&length), sizeof (length));
+  m_file.write (value.data (), length);
+}
+
+void
+NrStatsSink::Close ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_db == nullptr && !m_file.is_open ())
+    {
+      return;
+    }
+
+  Flush ();
+
+#ifdef HAVE_SQLITE3
+  for (auto & table : m_tables)
+    {
+      if (table.m_insert != nullptr)
+        {
+          sqlite3_finalize (table.m_insert);
+          table.m_insert = nullptr;
+        }
+    }
+  delete m_db;
+  m_db = nullptr;
+#endif
+
+  if (m_file.is_open ())
+    {
+      m_file.close ();
+    }
+}
+
+} // namespace ns3
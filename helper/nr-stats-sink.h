@@ -0,0 +1,270 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef NR_STATS_SINK_H
+#define NR_STATS_SINK_H
+
+#include <ns3/object.h>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+struct sqlite3_stmt;
+
+namespace ns3 {
+
+class SQLiteOutput;
+
+/**
+ * \ingroup nr
+ * \brief Batched, typed output for trace sinks
+ *
+ * The class stores the rows of one or more tables, column by column, and
+ * writes them in batches. Each table is declared once with AddTable (), and
+ * each row is then added with BeginRow (), one Put () per column (in the
+ * declaration order) and EndRow (). A batch is written when the number of
+ * cached rows reaches the `BatchSize` attribute, or when the cached values
+ * reach the `MemoryCap` attribute, whichever comes first; the remaining rows
+ * are written by Flush () and when the object is disposed.
+ *
+ * If the simulator is built with SQLite, and the `UseSqlite` attribute is
+ * true, the output file is a database with a table for each table added; a
+ * batch is written inside a single transaction, through an INSERT statement
+ * prepared when the table is added. Otherwise, the output file is a plain
+ * binary file, made of records that start with one byte:
+ *
+ * - 'T': table declaration: table id (uint32_t), name, number of columns
+ *   (uint32_t), then, for each column, its ColumnType (uint8_t) and its name;
+ * - 'B': batch: table id (uint32_t), number of rows (uint32_t), then, for each
+ *   column, all its values: int64_t for INTEGER, double for REAL, and a string
+ *   for TEXT.
+ *
+ * Strings are stored as their length (uint32_t) followed by their characters,
+ * and all the values are in host byte order. The file starts with the
+ * eight characters "NRSTATS1".
+ *
+ * A trace sink that wants to store its values in the sink owns the
+ * table id returned by AddTable (); see NrPhyRxTrace::SetStatsSink () for
+ * an example.
+ */
+class NrStatsSink : public Object
+{
+public:
+  /**
+   * \brief Type of a column
+   */
+  enum ColumnType : uint8_t
+  {
+    INTEGER = 0,  //!< Signed integer, stored as int64_t
+    REAL = 1,     //!< Floating point, stored as double
+    TEXT = 2      //!< String
+  };
+
+  /**
+   * \brief Declaration of a column
+   */
+  struct Column
+  {
+    std::string m_name;   //!< Column name
+    ColumnType m_type;    //!< Column type
+  };
+
+  /**
+   * \brief NrStatsSink constructor
+   */
+  NrStatsSink ();
+
+  /**
+   * \brief ~NrStatsSink
+   */
+  ~NrStatsSink () override;
+
+  /**
+   * \brief GetTypeId
+   * \return the TypeId of the object
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Open the output file
+   * \param fileName name of the output file
+   *
+   * It must be called before adding any table. If the output is a
+   * database that already contains a table with the same name of a table
+   * added later, the new rows are appended to it.
+   */
+  void Open (const std::string &fileName);
+
+  /**
+   * \brief Check if the rows are written to a SQLite database
+   * \return true if the output is a database, false if it is the columnar file
+   */
+  bool IsSqlite () const;
+
+  /**
+   * \brief Declare a table
+   * \param name table name
+   * \param columns the columns of the table, in the order of the Put () calls
+   * \return the id of the table, to be used in BeginRow ()
+   */
+  uint32_t AddTable (const std::string &name, const std::vector<Column> &columns);
+
+  /**
+   * \brief Delete the rows of a simulation already written in a table
+   * \param tableId the id returned by AddTable ()
+   * \param seed the value of the SEED column of the rows to delete
+   * \param run the value of the RUN column of the rows to delete
+   *
+   * The table must have a SEED and a RUN INTEGER column. It is meant to be
+   * called right after AddTable (), so that running again a simulation with
+   * the same seed and run on the same database replaces its rows instead of
+   * duplicating them. The rows still cached are not affected. The columnar
+   * file is truncated by Open (), so there is nothing to delete in it.
+   */
+  void DeleteWhere (uint32_t tableId, int64_t seed, int64_t run);
+
+  /**
+   * \brief Start a new row
+   * \param tableId the id returned by AddTable ()
+   */
+  void BeginRow (uint32_t tableId);
+
+  /**
+   * \brief Set the value of the next INTEGER column of the current row
+   * \param value the value
+   */
+  void Put (int64_t value);
+
+  /**
+   * \brief Set the value of the next REAL column of the current row
+   * \param value the value
+   */
+  void Put (double value);
+
+  /**
+   * \brief Set the value of the next TEXT column of the current row
+   * \param value the value
+   */
+  void Put (const std::string &value);
+
+  /**
+   * \brief Set the value of the next INTEGER column from any integer type
+   * \param value the value
+   *
+   * It avoids an ambiguous call between the int64_t and double overloads
+   * when the value is, e.g., a uint16_t.
+   */
+  template <typename T>
+  typename std::enable_if<std::is_integral<T>::value>::type
+  Put (T value)
+  {
+    Put (static_cast<int64_t> (value));
+  }
+
+  /**
+   * \brief End the current row
+   *
+   * All the columns of the table must have been set. It may trigger the
+   * write of a batch.
+   */
+  void EndRow ();
+
+  /**
+   * \brief Write all the cached rows to the output file
+   */
+  void Flush ();
+
+  /**
+   * \brief Get the number of rows written to the output file
+   * \return the number of rows written so far
+   */
+  uint64_t GetWrittenRows () const;
+
+protected:
+  void DoDispose () override;
+
+private:
+  /**
+   * \brief Cached rows of a table, column by column
+   */
+  struct Table
+  {
+    std::string m_name;                              //!< Table name
+    std::vector<Column> m_columns;                   //!< Column declarations
+    std::vector<uint32_t> m_slot;                    //!< Index of each column in the vector of its type
+    std::vector<std::vector<int64_t>> m_integers;    //!< INTEGER columns
+    std::vector<std::vector<double>> m_reals;        //!< REAL columns
+    std::vector<std::vector<std::string>> m_texts;   //!< TEXT columns
+    uint32_t m_rows {0};                             //!< Number of cached rows
+    uint64_t m_bytes {0};                            //!< Approximate size of the cached values
+    sqlite3_stmt *m_insert {nullptr};                //!< Prepared INSERT statement
+  };
+
+  /**
+   * \brief Check the type of the next column of the current row
+   * \param type the type of the value being put
+   * \return the table of the current row
+   */
+  Table & NextColumn (ColumnType type);
+
+  /**
+   * \brief Write the cached rows of a table, and clear them
+   * \param table the table
+   * \param tableId the table id
+   */
+  void WriteTable (Table &table, uint32_t tableId);
+
+  /**
+   * \brief Write the cached rows of a table in the SQLite database
+   * \param table the table
+   */
+  void WriteSqlite (Table &table);
+
+  /**
+   * \brief Write the cached rows of a table in the columnar file
+   * \param table the table
+   * \param tableId the table id
+   */
+  void WriteColumnar (const Table &table, uint32_t tableId);
+
+  /**
+   * \brief Write a string in the columnar file
+   * \param value the string
+   */
+  void WriteString (const std::string &value);
+
+  /**
+   * \brief Close the output
+   */
+  void Close ();
+
+  uint32_t m_batchSize {10000};       //!< The `BatchSize` attribute
+  uint32_t m_memoryCap {4000000};     //!< The `MemoryCap` attribute
+  bool m_useSqlite {true};            //!< The `UseSqlite` attribute
+
+  SQLiteOutput *m_db {nullptr};       //!< Database, if SQLite is used
+  std::ofstream m_file;               //!< Columnar file, if SQLite is not used
+  std::vector<Table> m_tables;        //!< Declared tables
+  uint32_t m_currentTable {UINT32_MAX};  //!< Table of the row being added
+  uint32_t m_currentColumn {0};       //!< Next column of the row being added
+  uint64_t m_cachedBytes {0};         //!< Approximate size of the cached values of all the tables
+  uint64_t m_writtenRows {0};         //!< Number of rows written
+};
+
+} // namespace ns3
+
+#endif // NR_STATS_SINK_H
@@ -0,0 +1,405 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "nr-v2x-kpi-accumulator.h"
+
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/boolean.h>
+#include <ns3/double.h>
+#include <ns3/simulator.h>
+#include <ns3/rng-seed-manager.h>
+#include <ns3/ipv4-address.h>
+#include <ns3/ipv6-address.h>
+#include <ns3/inet-socket-address.h>
+#include <ns3/inet6-socket-address.h>
+#include <sstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrV2xKpiAccumulator");
+NS_OBJECT_ENSURE_REGISTERED (NrV2xKpiAccumulator);
+
+NrV2xKpiAccumulator::NrV2xKpiAccumulator ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+NrV2xKpiAccumulator::~NrV2xKpiAccumulator ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+NrV2xKpiAccumulator::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::NrV2xKpiAccumulator")
+    .SetParent<Object> ()
+    .SetGroupName ("nr")
+    .AddConstructor<NrV2xKpiAccumulator> ()
+    .AddAttribute ("Range",
+                   "The inter-node distance (in m) considered by the PIR and PRR. "
+                   "If zero, every pair of nodes is considered",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&NrV2xKpiAccumulator::m_range),
+                   MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("TxAppDuration",
+                   "The duration of the transmitting applications, used to "
+                   "compute the throughput",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&NrV2xKpiAccumulator::m_txAppDuration),
+                   MakeTimeChecker ())
+    .AddAttribute ("ConsiderAllTx",
+                   "Report a zero throughput for the transmitters a node did "
+                   "not receive anything from",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&NrV2xKpiAccumulator::m_considerAllTx),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+
+Address
+NrV2xKpiAccumulator::GetIp (const Address &address)
+{
+  if (InetSocketAddress::IsMatchingType (address))
+    {
+      return InetSocketAddress::ConvertFrom (address).GetIpv4 ();
+    }
+  if (Inet6SocketAddress::IsMatchingType (address))
+    {
+      return Inet6SocketAddress::ConvertFrom (address).GetIpv6 ();
+    }
+  NS_ABORT_MSG_UNLESS (Ipv4Address::IsMatchingType (address) || Ipv6Address::IsMatchingType (address),
+                       "Address " << address << " is not an IP address");
+  return address;
+}
+
+void
+NrV2xKpiAccumulator::AddNode (uint32_t nodeId, uint64_t imsi, const Address &ip, const Vector &position)
+{
+  NS_LOG_FUNCTION (this << nodeId << imsi << ip << position);
+
+  Node node;
+  node.m_nodeId = nodeId;
+  node.m_imsi = imsi;
+  node.m_position = position;
+
+  Address key = GetIp (ip);
+  std::ostringstream oss;
+  if (Ipv4Address::IsMatchingType (key))
+    {
+      oss << Ipv4Address::ConvertFrom (key);
+    }
+  else
+    {
+      oss << Ipv6Address::ConvertFrom (key);
+    }
+  node.m_ip = oss.str ();
+
+  uint32_t index = static_cast<uint32_t> (m_nodes.size ());
+  bool inserted = m_indexPerNodeId.emplace (nodeId, index).second;
+  NS_ABORT_MSG_IF (!inserted, "Node " << nodeId << " already registered");
+  inserted = m_indexPerIp.emplace (key, index).second;
+  NS_ABORT_MSG_IF (!inserted, "IP " << node.m_ip << " already registered");
+  m_nodes.push_back (std::move (node));
+}
+
+uint32_t
+NrV2xKpiAccumulator::GetNodeIndex (uint32_t nodeId) const
+{
+  auto it = m_indexPerNodeId.find (nodeId);
+  NS_ABORT_MSG_IF (it == m_indexPerNodeId.end (), "Node " << nodeId << " is not registered");
+  return it->second;
+}
+
+double
+NrV2xKpiAccumulator::GetDistance (uint32_t a, uint32_t b) const
+{
+  return CalculateDistance (m_nodes.at (a).m_position, m_nodes.at (b).m_position);
+}
+
+void
+NrV2xKpiAccumulator::NotifyTx (uint32_t txNodeId, [[maybe_unused]] uint32_t pktSize, uint32_t seq)
+{
+  NS_LOG_FUNCTION (this << txNodeId << pktSize << seq);
+  Node &node = m_nodes[GetNodeIndex (txNodeId)];
+
+  if (node.m_txPkts++ == 0)
+    {
+      ++m_numTxNodes;
+    }
+  if (seq >= node.m_txPerSeq.size ())
+    {
+      node.m_txPerSeq.resize (seq + 1, 0);
+    }
+  ++node.m_txPerSeq[seq];
+}
+
+void
+NrV2xKpiAccumulator::NotifyRx (uint32_t rxNodeId, const Address &from, uint32_t pktSize, uint32_t seq)
+{
+  NS_LOG_FUNCTION (this << rxNodeId << from << pktSize << seq);
+  uint32_t rxIndex = GetNodeIndex (rxNodeId);
+  auto txIt = m_indexPerIp.find (GetIp (from));
+  NS_ABORT_MSG_IF (txIt == m_indexPerIp.end (), "Transmitter " << from << " is not registered");
+
+  Link &link = m_links[rxIndex][txIt->second];
+  double now = Simulator::Now ().GetNanoSeconds () / (double) 1e9;
+
+  // Same accumulation (and same first-packet condition) of V2xKpi::ComputeAvrgPir,
+  // so that the averages are the same to the last bit
+  if (link.m_pirCount == 0 && link.m_lastRxTime == 0.0)
+    {
+      link.m_lastRxTime = now;
+    }
+  else
+    {
+      link.m_pirSum = link.m_pirSum + (now - link.m_lastRxTime);
+      link.m_lastRxTime = now;
+      ++link.m_pirCount;
+    }
+
+  link.m_rxBytes += pktSize;
+  ++link.m_rxPkts;
+  if (seq >= link.m_rxSeq.size ())
+    {
+      link.m_rxSeq.resize (seq + 1, false);
+    }
+  link.m_rxSeq[seq] = true;
+}
+
+std::vector<NrV2xKpiAccumulator::PirKpi>
+NrV2xKpiAccumulator::ComputePir () const
+{
+  std::vector<PirKpi> result;
+  for (const auto & rx : m_links)
+    {
+      for (const auto & tx : rx.second)
+        {
+          PirKpi kpi;
+          kpi.m_rxNodeId = m_nodes.at (rx.first).m_nodeId;
+          kpi.m_txNodeId = m_nodes.at (tx.first).m_nodeId;
+          if (m_range > 0)
+            {
+              kpi.m_distance = GetDistance (rx.first, tx.first);
+              if (kpi.m_distance > m_range)
+                {
+                  continue;
+                }
+            }
+          if (tx.second.m_pirCount == 0)
+            {
+              // A single packet received: the PIR can not be computed
+              continue;
+            }
+          kpi.m_avrgPirSec = tx.second.m_pirSum / tx.second.m_pirCount;
+          result.push_back (kpi);
+        }
+    }
+  return result;
+}
+
+std::vector<NrV2xKpiAccumulator::ThputKpi>
+NrV2xKpiAccumulator::ComputeThput () const
+{
+  NS_ABORT_MSG_IF (m_txAppDuration.IsZero (), "Can not compute throughput with a zero TX app duration");
+  double duration = m_txAppDuration.GetSeconds ();
+
+  std::vector<ThputKpi> result;
+  for (const auto & rx : m_links)
+    {
+      const Node &rxNode = m_nodes.at (rx.first);
+      for (const auto & tx : rx.second)
+        {
+          ThputKpi kpi;
+          kpi.m_rxNodeId = rxNode.m_nodeId;
+          kpi.m_txNodeId = m_nodes.at (tx.first).m_nodeId;
+          kpi.m_txPkts = m_nodes.at (tx.first).m_txPkts;
+          kpi.m_rxPkts = tx.second.m_rxPkts;
+          kpi.m_thputKbps = (tx.second.m_rxBytes * 8) / duration / 1000.0;
+          result.push_back (kpi);
+        }
+
+      uint32_t numTx = rxNode.m_txPkts > 0 ? m_numTxNodes - 1 : m_numTxNodes;
+      if (!m_considerAllTx || rx.second.size () >= numTx)
+        {
+          continue;
+        }
+      for (uint32_t txIndex = 0; txIndex < m_nodes.size (); ++txIndex)
+        {
+          const Node &txNode = m_nodes[txIndex];
+          if (txNode.m_txPkts == 0 || txIndex == rx.first
+              || rx.second.find (txIndex) != rx.second.end ())
+            {
+              continue;
+            }
+          ThputKpi kpi;
+          kpi.m_rxNodeId = rxNode.m_nodeId;
+          kpi.m_txNodeId = txNode.m_nodeId;
+          kpi.m_txPkts = txNode.m_txPkts;
+          result.push_back (kpi);
+        }
+    }
+  return result;
+}
+
+std::vector<NrV2xKpiAccumulator::PrrKpi>
+NrV2xKpiAccumulator::ComputePrr () const
+{
+  std::vector<PrrKpi> result;
+  for (uint32_t txIndex = 0; txIndex < m_nodes.size (); ++txIndex)
+    {
+      const Node &txNode = m_nodes[txIndex];
+      if (txNode.m_txPkts == 0)
+        {
+          continue;
+        }
+
+      // Every node that received anything, and is in range, is a neighbor,
+      // even if it did not receive anything from this transmitter
+      uint32_t numNeighbors = 0;
+      uint64_t pktRxCount = 0;
+      for (const auto & rx : m_links)
+        {
+          if (m_range > 0 && GetDistance (rx.first, txIndex) > m_range)
+            {
+              continue;
+            }
+          ++numNeighbors;
+          auto linkIt = rx.second.find (txIndex);
+          if (linkIt == rx.second.end ())
+            {
+              continue;
+            }
+          const std::vector<bool> &rxSeq = linkIt->second.m_rxSeq;
+          for (uint32_t seq = 0; seq < rxSeq.size () && seq < txNode.m_txPerSeq.size (); ++seq)
+            {
+              if (rxSeq[seq])
+                {
+                  pktRxCount += txNode.m_txPerSeq[seq];
+                }
+            }
+        }
+
+      if (numNeighbors == 0)
+        {
+          continue;
+        }
+
+      PrrKpi kpi;
+      kpi.m_txNodeId = txNode.m_nodeId;
+      kpi.m_numNeighbors = numNeighbors;
+      if (pktRxCount > 0)
+        {
+          kpi.m_avrgPrr = static_cast<double> (pktRxCount) / (txNode.m_txPkts * numNeighbors);
+        }
+      result.push_back (kpi);
+    }
+  return result;
+}
+
+void
+NrV2xKpiAccumulator::WriteKpis (const Ptr<NrStatsSink> &sink) const
+{
+  NS_LOG_FUNCTION (this << sink);
+  int64_t seed = RngSeedManager::GetSeed ();
+  int64_t run = static_cast<int64_t> (RngSeedManager::GetRun ());
+
+  uint32_t table = sink->AddTable ("avrgPir", {{"txRx", NrStatsSink::TEXT},
+                                               {"nodeId", NrStatsSink::INTEGER},
+                                               {"imsi", NrStatsSink::INTEGER},
+                                               {"srcIp", NrStatsSink::TEXT},
+                                               {"dstIp", NrStatsSink::TEXT},
+                                               {"avrgPirSec", NrStatsSink::REAL},
+                                               {"TxRxDistance", NrStatsSink::REAL},
+                                               {"SEED", NrStatsSink::INTEGER},
+                                               {"RUN", NrStatsSink::INTEGER}});
+  sink->DeleteWhere (table, seed, run);
+  for (const auto & kpi : ComputePir ())
+    {
+      const Node &rxNode = m_nodes.at (GetNodeIndex (kpi.m_rxNodeId));
+      sink->BeginRow (table);
+      sink->Put (std::string ("rx"));
+      sink->Put (rxNode.m_nodeId);
+      sink->Put (rxNode.m_imsi);
+      sink->Put (m_nodes.at (GetNodeIndex (kpi.m_txNodeId)).m_ip);
+      sink->Put (rxNode.m_ip);
+      sink->Put (kpi.m_avrgPirSec);
+      sink->Put (kpi.m_distance);
+      sink->Put (seed);
+      sink->Put (run);
+      sink->EndRow ();
+    }
+
+  table = sink->AddTable ("thput", {{"txRx", NrStatsSink::TEXT},
+                                    {"nodeId", NrStatsSink::INTEGER},
+                                    {"imsi", NrStatsSink::INTEGER},
+                                    {"srcIp", NrStatsSink::TEXT},
+                                    {"totalPktTxed", NrStatsSink::INTEGER},
+                                    {"dstIp", NrStatsSink::TEXT},
+                                    {"totalPktRxed", NrStatsSink::INTEGER},
+                                    {"thputKbps", NrStatsSink::REAL},
+                                    {"SEED", NrStatsSink::INTEGER},
+                                    {"RUN", NrStatsSink::INTEGER}});
+  sink->DeleteWhere (table, seed, run);
+  for (const auto & kpi : ComputeThput ())
+    {
+      const Node &rxNode = m_nodes.at (GetNodeIndex (kpi.m_rxNodeId));
+      sink->BeginRow (table);
+      sink->Put (std::string ("rx"));
+      sink->Put (rxNode.m_nodeId);
+      sink->Put (rxNode.m_imsi);
+      sink->Put (m_nodes.at (GetNodeIndex (kpi.m_txNodeId)).m_ip);
+      sink->Put (kpi.m_txPkts);
+      sink->Put (rxNode.m_ip);
+      sink->Put (kpi.m_rxPkts);
+      sink->Put (kpi.m_thputKbps);
+      sink->Put (seed);
+      sink->Put (run);
+      sink->EndRow ();
+    }
+
+  table = sink->AddTable ("avrgPrr", {{"txRx", NrStatsSink::TEXT},
+                                      {"nodeId", NrStatsSink::INTEGER},
+                                      {"imsi", NrStatsSink::INTEGER},
+                                      {"Ip", NrStatsSink::TEXT},
+                                      {"range", NrStatsSink::REAL},
+                                      {"numNieb", NrStatsSink::INTEGER},
+                                      {"avrgPrr", NrStatsSink::REAL},
+                                      {"SEED", NrStatsSink::INTEGER},
+                                      {"RUN", NrStatsSink::INTEGER}});
+  sink->DeleteWhere (table, seed, run);
+  for (const auto & kpi : ComputePrr ())
+    {
+      const Node &txNode = m_nodes.at (GetNodeIndex (kpi.m_txNodeId));
+      sink->BeginRow (table);
+      sink->Put (std::string ("tx"));
+      sink->Put (txNode.m_nodeId);
+      sink->Put (txNode.m_imsi);
+      sink->Put (txNode.m_ip);
+      sink->Put (m_range);
+      sink->Put (kpi.m_numNeighbors);
+      sink->Put (kpi.m_avrgPrr);
+      sink->Put (seed);
+      sink->Put (run);
+      sink->EndRow ();
+    }
+
+  sink->Flush ();
+}
+
+} // namespace ns3
@@ -0,0 +1,224 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef NR_V2X_KPI_ACCUMULATOR_H
+#define NR_V2X_KPI_ACCUMULATOR_H
+
+#include <ns3/object.h>
+#include <ns3/address.h>
+#include <ns3/vector.h>
+#include <ns3/nstime.h>
+#include "nr-stats-sink.h"
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup nr
+ * \brief Online computation of the application-level V2X KPIs
+ *
+ * The class computes the same PIR (Packet Inter-Reception time), throughput
+ * and range-based PRR (Packet Reception Ratio) of the V2xKpi class of the V2X
+ * examples. It does not read the packet traces back from a database: it is
+ * fed directly by the application TX and RX traces (NotifyTx () and
+ * NotifyRx ()), and keeps, for each pair (RX node, TX node), only the
+ * counters needed by the KPIs and a bitmap of the received sequence numbers.
+ *
+ * The nodes must be registered with AddNode () before the first packet, with
+ * the position to be used for the range-based KPIs (as V2xKpi, the range is
+ * only meaningful when the inter-node distances do not change). At the end of
+ * the simulation, the KPIs can be obtained with ComputePir (), ComputeThput ()
+ * and ComputePrr (), or written with WriteKpis () in the tables "avrgPir",
+ * "thput" and "avrgPrr", which have the columns of the V2xKpi tables.
+ */
+class NrV2xKpiAccumulator : public Object
+{
+public:
+  /**
+   * \brief Average PIR of a pair of nodes
+   */
+  struct PirKpi
+  {
+    uint32_t m_rxNodeId {0};     //!< RX node id
+    uint32_t m_txNodeId {0};     //!< TX node id
+    double m_avrgPirSec {0.0};   //!< Average PIR, in seconds
+    double m_distance {0.0};     //!< TX-RX distance (0 if the range is not set)
+  };
+
+  /**
+   * \brief Throughput of a pair of nodes
+   */
+  struct ThputKpi
+  {
+    uint32_t m_rxNodeId {0};     //!< RX node id
+    uint32_t m_txNodeId {0};     //!< TX node id
+    uint64_t m_txPkts {0};       //!< Packets transmitted by the TX node
+    uint64_t m_rxPkts {0};       //!< Packets received from the TX node
+    double m_thputKbps {0.0};    //!< Throughput, in kbps
+  };
+
+  /**
+   * \brief Average PRR of a transmitter
+   */
+  struct PrrKpi
+  {
+    uint32_t m_txNodeId {0};     //!< TX node id
+    uint32_t m_numNeighbors {0}; //!< Nodes in range that received any packet
+    double m_avrgPrr {0.0};      //!< Average PRR
+  };
+
+  /**
+   * \brief NrV2xKpiAccumulator constructor
+   */
+  NrV2xKpiAccumulator ();
+
+  /**
+   * \brief ~NrV2xKpiAccumulator
+   */
+  ~NrV2xKpiAccumulator () override;
+
+  /**
+   * \brief GetTypeId
+   * \return the TypeId of the object
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Register a node
+   * \param nodeId the node id
+   * \param imsi the IMSI of the UE of the node
+   * \param ip the IPv4 or IPv6 address of the node
+   * \param position the position used for the range-based KPIs
+   */
+  void AddNode (uint32_t nodeId, uint64_t imsi, const Address &ip, const Vector &position);
+
+  /**
+   * \brief Account a packet transmitted by the application of a node
+   * \param txNodeId the node id of the transmitter
+   * \param pktSize the packet size, in bytes
+   * \param seq the packet sequence number
+   */
+  void NotifyTx (uint32_t txNodeId, uint32_t pktSize, uint32_t seq);
+
+  /**
+   * \brief Account a packet received by the application of a node
+   * \param rxNodeId the node id of the receiver
+   * \param from the address of the transmitter (an IP address, or an
+   * InetSocketAddress / Inet6SocketAddress)
+   * \param pktSize the packet size, in bytes
+   * \param seq the packet sequence number
+   */
+  void NotifyRx (uint32_t rxNodeId, const Address &from, uint32_t pktSize, uint32_t seq);
+
+  /**
+   * \brief Compute the average PIR of each pair (RX node, TX node)
+   * \return the PIR of the pairs with at least two received packets, and
+   * within the range, if the range is set
+   */
+  std::vector<PirKpi> ComputePir () const;
+
+  /**
+   * \brief Compute the throughput of each pair (RX node, TX node)
+   * \return the throughput of the pairs with at least one received packet,
+   * and, if `ConsiderAllTx` is true, a zero throughput for every other
+   * transmitter of a node that received anything
+   */
+  std::vector<ThputKpi> ComputeThput () const;
+
+  /**
+   * \brief Compute the average PRR of each transmitter
+   * \return the PRR of the transmitters with at least one neighbor
+   */
+  std::vector<PrrKpi> ComputePrr () const;
+
+  /**
+   * \brief Write the KPIs in the "avrgPir", "thput" and "avrgPrr" tables
+   * \param sink the (already open) sink
+   *
+   * The rows are appended to the tables, if they exist, after deleting the
+   * rows with the current SEED and RUN, as V2xKpi does.
+   */
+  void WriteKpis (const Ptr<NrStatsSink> &sink) const;
+
+private:
+  /**
+   * \brief Registered node
+   */
+  struct Node
+  {
+    uint32_t m_nodeId {0};                //!< Node id
+    uint64_t m_imsi {0};                  //!< IMSI
+    std::string m_ip;                     //!< IP address, as text, for the output
+    Vector m_position;                    //!< Position for the range-based KPIs
+    uint64_t m_txPkts {0};                //!< Transmitted packets
+    std::vector<uint32_t> m_txPerSeq;     //!< Transmissions of each sequence number
+  };
+
+  /**
+   * \brief Counters of the packets received by a node from a transmitter
+   */
+  struct Link
+  {
+    double m_lastRxTime {0.0};            //!< Time of the last reception
+    double m_pirSum {0.0};                //!< Sum of the inter-reception times
+    uint64_t m_pirCount {0};              //!< Number of inter-reception times
+    uint64_t m_rxBytes {0};               //!< Received bytes
+    uint64_t m_rxPkts {0};                //!< Received packets
+    std::vector<bool> m_rxSeq;            //!< Received sequence numbers
+  };
+
+  /**
+   * \brief Get the index of a registered node
+   * \param nodeId the node id
+   * \return the index of the node in m_nodes
+   */
+  uint32_t GetNodeIndex (uint32_t nodeId) const;
+
+  /**
+   * \brief Normalize an address to the IP address it contains
+   * \param address an IP address, or an Inet(6)SocketAddress
+   * \return the IP address
+   */
+  static Address GetIp (const Address &address);
+
+  /**
+   * \brief Get the distance between two nodes
+   * \param a index of the first node
+   * \param b index of the second node
+   * \return the distance between the registered positions
+   */
+  double GetDistance (uint32_t a, uint32_t b) const;
+
+  double m_range {0.0};                   //!< The `Range` attribute
+  Time m_txAppDuration;                   //!< The `TxAppDuration` attribute
+  bool m_considerAllTx {true};            //!< The `ConsiderAllTx` attribute
+
+  std::vector<Node> m_nodes;                              //!< Registered nodes
+  std::unordered_map<uint32_t, uint32_t> m_indexPerNodeId; //!< Node id -> index in m_nodes
+  std::map<Address, uint32_t> m_indexPerIp;                //!< IP address -> index in m_nodes
+  /**
+   * RX node index -> TX node index -> counters. Only the nodes that received
+   * something are present.
+   */
+  std::map<uint32_t, std::map<uint32_t, Link>> m_links;
+  uint32_t m_numTxNodes {0};              //!< Nodes that transmitted at least one packet
+};
+
+} // namespace ns3
+
+#endif // NR_V2X_KPI_ACCUMULATOR_H
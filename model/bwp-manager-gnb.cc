@@ -24,6 +24,8 @@
 #include <ns3/uinteger.h>
 #include <ns3/object-map.h>
 
+#include <algorithm>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("BwpManagerGnb");
@@ -78,22 +80,109 @@ BwpManagerGnb::DoSetupDataRadioBearer (EpsBearer bearer, uint8_t bearerId, uint1
   NS_LOG_FUNCTION (this);
 
   std::vector<LteCcmRrcSapProvider::LcsConfig> lcsConfig = RrComponentCarrierManager::DoSetupDataRadioBearer (bearer, bearerId, rnti, lcid, lcGroup, msu);
+  UpdateUeRoute (rnti);
   return lcsConfig;
 }
 
-uint8_t
-BwpManagerGnb::GetBwpIndex (uint16_t rnti, uint8_t lcid)
+void
+BwpManagerGnb::DoAddUe (uint16_t rnti, uint8_t state)
 {
   NS_LOG_FUNCTION (this);
-  NS_ASSERT (m_algorithm != nullptr);
-  NS_ASSERT_MSG (m_ueInfo.find (rnti) != m_ueInfo.end (), "Unknown UE");
-  NS_ASSERT_MSG (m_ueInfo.at (rnti).m_rlcLcInstantiated.find (lcid) != m_ueInfo.at (rnti).m_rlcLcInstantiated.end (), "Unknown logical channel of UE");
+  RrComponentCarrierManager::DoAddUe (rnti, state);
+  UpdateUeRoute (rnti);
+}
 
-  uint8_t qci = m_ueInfo[rnti].m_rlcLcInstantiated [lcid].qci;
+void
+BwpManagerGnb::DoAddLc (LteEnbCmacSapProvider::LcInfo lcInfo, LteMacSapUser* msu)
+{
+  NS_LOG_FUNCTION (this);
+  RrComponentCarrierManager::DoAddLc (lcInfo, msu);
+  UpdateUeRoute (lcInfo.rnti);
+}
 
-  // Force a conversion between the uint8_t type that comes from the LcInfo
-  // struct (yeah, using the EpsBearer::Qci type was too hard ...)
-  return m_algorithm->GetBwpForEpsBearer (static_cast<EpsBearer::Qci> (qci));
+void
+BwpManagerGnb::DoRemoveUe (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this);
+  RrComponentCarrierManager::DoRemoveUe (rnti);
+  UpdateUeRoute (rnti);
+}
+
+std::vector<uint8_t>
+BwpManagerGnb::DoReleaseDataRadioBearer (uint16_t rnti, uint8_t lcid)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<uint8_t> res = RrComponentCarrierManager::DoReleaseDataRadioBearer (rnti, lcid);
+  UpdateUeRoute (rnti);
+  return res;
+}
+
+LteMacSapUser*
+BwpManagerGnb::DoConfigureSignalBearer (LteEnbCmacSapProvider::LcInfo lcinfo, LteMacSapUser* msu)
+{
+  NS_LOG_FUNCTION (this);
+  LteMacSapUser* sapUser = RrComponentCarrierManager::DoConfigureSignalBearer (lcinfo, msu);
+  UpdateUeRoute (lcinfo.rnti);
+  return sapUser;
+}
+
+void
+BwpManagerGnb::UpdateUeRoute (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+
+  if (rnti >= m_ueRoutes.size ())
+    {
+      m_ueRoutes.resize (rnti + 1);
+    }
+  UeRoute &ueRoute = m_ueRoutes[rnti];
+  ueRoute.m_lcRoutes.clear ();
+
+  auto ueIt = m_ueInfo.find (rnti);
+  ueRoute.m_isKnown = ueIt != m_ueInfo.end ();
+  if (!ueRoute.m_isKnown)
+    {
+      return;
+    }
+
+  // The maps are ordered, so their last element has the highest LCID
+  uint32_t numLcs = 0;
+  if (!ueIt->second.m_ueAttached.empty ())
+    {
+      numLcs = ueIt->second.m_ueAttached.rbegin ()->first + 1u;
+    }
+  if (!ueIt->second.m_rlcLcInstantiated.empty ())
+    {
+      numLcs = std::max (numLcs, ueIt->second.m_rlcLcInstantiated.rbegin ()->first + 1u);
+    }
+  ueRoute.m_lcRoutes.resize (numLcs);
+
+  for (const auto &attached : ueIt->second.m_ueAttached)
+    {
+      ueRoute.m_lcRoutes[attached.first].m_macSapUser = attached.second;
+    }
+  for (const auto &lc : ueIt->second.m_rlcLcInstantiated)
+    {
+      ueRoute.m_lcRoutes[lc.first].m_qci = lc.second.qci;
+      ueRoute.m_lcRoutes[lc.first].m_hasLcInfo = true;
+    }
+}
+
+const BwpManagerGnb::LcRoute *
+BwpManagerGnb::GetLcRoute (uint16_t rnti, uint8_t lcid) const
+{
+  if (rnti >= m_ueRoutes.size () || lcid >= m_ueRoutes[rnti].m_lcRoutes.size ())
+    {
+      return nullptr;
+    }
+  return &m_ueRoutes[rnti].m_lcRoutes[lcid];
+}
+
+uint8_t
+BwpManagerGnb::GetBwpIndex (uint16_t rnti, uint8_t lcid)
+{
+  NS_LOG_FUNCTION (this);
+  return PeekBwpIndex (rnti, lcid);
 }
 
 uint8_t
@@ -102,10 +191,11 @@ BwpManagerGnb::PeekBwpIndex (uint16_t rnti, uint8_t lcid) const
   NS_LOG_FUNCTION (this);
   NS_ASSERT (m_algorithm != nullptr);
   // For the moment, Get and Peek are the same, but they'll change
-  NS_ASSERT_MSG (m_ueInfo.find (rnti) != m_ueInfo.end (), "Unknown UE");
-  NS_ASSERT_MSG (m_ueInfo.at (rnti).m_rlcLcInstantiated.find (lcid) != m_ueInfo.at (rnti).m_rlcLcInstantiated.end (), "Unknown logical channel of UE");
+  NS_ASSERT_MSG (rnti < m_ueRoutes.size () && m_ueRoutes[rnti].m_isKnown, "Unknown UE");
+  const LcRoute *lcRoute = GetLcRoute (rnti, lcid);
+  NS_ABORT_MSG_IF (lcRoute == nullptr || !lcRoute->m_hasLcInfo, "Unknown logical channel " << +lcid << " of UE " << rnti);
 
-  uint8_t qci = m_ueInfo.at(rnti).m_rlcLcInstantiated.at (lcid).qci;
+  uint8_t qci = lcRoute->m_qci;
 
   // Force a conversion between the uint8_t type that comes from the LcInfo
   // struct (yeah, using the EpsBearer::Qci type was too hard ...)
@@ -134,28 +224,30 @@ BwpManagerGnb::RouteOutgoingCtrlMsg (const Ptr<NrControlMessage> &msg,
   NS_LOG_INFO ("Msg type " << msg->GetMessageType () << " from bwp " <<
                +sourceBwpId << " that wants to go out from gnb");
 
-  if (m_outputLinks.empty ())
-    {
-      NS_LOG_INFO ("No linked BWP, routing outgoing msg to the source: " << +sourceBwpId);
-      return sourceBwpId;
-    }
-
-  auto it = m_outputLinks.find (sourceBwpId);
-  if (it == m_outputLinks.end ())
+  if (sourceBwpId >= m_outputLinks.size () || m_outputLinks[sourceBwpId] == UINT32_MAX)
     {
       NS_LOG_INFO ("Source BWP not in the map, routing outgoing msg to itself: " << +sourceBwpId);
       return sourceBwpId;
     }
 
-  NS_LOG_INFO ("routing outgoing msg to bwp: " << +it->second);
-  return it->second;
+  NS_LOG_INFO ("routing outgoing msg to bwp: " << m_outputLinks[sourceBwpId]);
+  return m_outputLinks[sourceBwpId];
 }
 
 void
 BwpManagerGnb::SetOutputLink(uint32_t sourceBwp, uint32_t outputBwp)
 {
   NS_LOG_FUNCTION (this);
-  m_outputLinks.insert (std::make_pair (sourceBwp, outputBwp));
+  NS_ABORT_MSG_IF (outputBwp == UINT32_MAX, "Invalid output BWP " << outputBwp);
+  if (sourceBwp >= m_outputLinks.size ())
+    {
+      m_outputLinks.resize (sourceBwp + 1, UINT32_MAX);
+    }
+  // As the former map insert, the first mapping of a source BWP is kept
+  if (m_outputLinks[sourceBwp] == UINT32_MAX)
+    {
+      m_outputLinks[sourceBwp] = outputBwp;
+    }
 }
 
 void
@@ -180,13 +272,14 @@ void
 BwpManagerGnb::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpParams)
 {
   NS_LOG_FUNCTION (this);
-  std::map <uint16_t, UeInfo >::iterator rntiIt = m_ueInfo.find (txOpParams.rnti);
-  NS_ASSERT_MSG (rntiIt != m_ueInfo.end (), "could not find RNTI" << txOpParams.rnti);
+  NS_ASSERT_MSG (txOpParams.rnti < m_ueRoutes.size () && m_ueRoutes[txOpParams.rnti].m_isKnown,
+                 "could not find RNTI" << txOpParams.rnti);
 
-  std::map<uint8_t, LteMacSapUser*>::iterator lcidIt = rntiIt->second.m_ueAttached.find (txOpParams.lcid);
-  NS_ASSERT_MSG (lcidIt != rntiIt->second.m_ueAttached.end (), "could not find LCID " << (uint16_t) txOpParams.lcid);
+  const LcRoute *lcRoute = GetLcRoute (txOpParams.rnti, txOpParams.lcid);
+  NS_ASSERT_MSG (lcRoute != nullptr && lcRoute->m_macSapUser != nullptr,
+                 "could not find LCID " << (uint16_t) txOpParams.lcid);
 
-  (*lcidIt).second->NotifyTxOpportunity (txOpParams);
+  lcRoute->m_macSapUser->NotifyTxOpportunity (txOpParams);
 }
 
 
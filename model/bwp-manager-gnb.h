@@ -25,7 +25,7 @@
 #include <ns3/lte-rrc-sap.h>
 #include <ns3/lte-rlc.h>
 #include <ns3/eps-bearer.h>
-#include <unordered_map>
+#include <vector>
 
 namespace ns3 {
 class UeManager;
@@ -137,15 +137,58 @@ protected:
    */
   virtual std::vector<LteCcmRrcSapProvider::LcsConfig> DoSetupDataRadioBearer (EpsBearer bearer, uint8_t bearerId, uint16_t rnti, uint8_t lcid, uint8_t lcGroup, LteMacSapUser* msu) override;
 
+  // The following overrides only keep the routing table up to date
+  virtual void DoAddUe (uint16_t rnti, uint8_t state) override;
+  virtual void DoAddLc (LteEnbCmacSapProvider::LcInfo lcInfo, LteMacSapUser* msu) override;
+  virtual void DoRemoveUe (uint16_t rnti) override;
+  virtual std::vector<uint8_t> DoReleaseDataRadioBearer (uint16_t rnti, uint8_t lcid) override;
+  virtual LteMacSapUser* DoConfigureSignalBearer (LteEnbCmacSapProvider::LcInfo lcinfo, LteMacSapUser* msu) override;
+
 private:
+  /**
+   * \brief Routing information of a logical channel of a UE
+   */
+  struct LcRoute
+  {
+    LteMacSapUser *m_macSapUser {nullptr}; //!< MAC SAP user of the LC, nullptr if the LC is not attached
+    uint8_t m_qci {0};                     //!< QCI of the LC
+    bool m_hasLcInfo {false};              //!< True if the LC is instantiated (m_qci is valid)
+  };
+
+  /**
+   * \brief Routing information of a UE
+   */
+  struct UeRoute
+  {
+    bool m_isKnown {false};           //!< True if the UE is in m_ueInfo
+    std::vector<LcRoute> m_lcRoutes;  //!< Routing information, indexed by LCID
+  };
+
   /**
    * \brief Checks if the flow is is GBR.
    */
   bool IsGbr (LteMacSapProvider::ReportBufferStatusParameters params);
 
+  /**
+   * \brief Copy the logical channels of a UE from m_ueInfo into the routing table
+   * \param rnti The RNTI of the UE
+   *
+   * To call every time the base class changes the entry of the UE in m_ueInfo.
+   */
+  void UpdateUeRoute (uint16_t rnti);
+
+  /**
+   * \brief Get the routing information of a logical channel of a UE
+   * \param rnti The RNTI of the UE
+   * \param lcid The LCID
+   * \return the routing information, or nullptr if the UE does not have the LC
+   */
+  const LcRoute * GetLcRoute (uint16_t rnti, uint8_t lcid) const;
+
   Ptr<BwpManagerAlgorithm> m_algorithm; //!< The BWP selection algorithm.
 
-  std::unordered_map <uint32_t, uint32_t> m_outputLinks; //!< Mapping between BWP.
+  std::vector<uint32_t> m_outputLinks; //!< Mapping between BWP, indexed by the source BWP (UINT32_MAX if not mapped)
+  std::vector<UeRoute> m_ueRoutes;     //!< Routing table built from m_ueInfo, indexed by RNTI
 };
 
 } // end of namespace ns3
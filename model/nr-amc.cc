@@ -32,6 +32,8 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("NrAmc");
 NS_OBJECT_ENSURE_REGISTERED (NrAmc);
 
+const uint32_t NrAmc::m_tbSizeNotCached;
+
 NrAmc::NrAmc ()
 {
   NS_LOG_INFO ("Initialze AMC module");
@@ -46,6 +48,7 @@ NrAmc::SetDlMode ()
 {
   NS_LOG_FUNCTION (this);
   m_emMode = NrErrorModel::DL;
+  m_tbSizeCache.clear ();
 }
 
 void
@@ -53,6 +56,7 @@ NrAmc::SetUlMode ()
 {
   NS_LOG_FUNCTION (this);
   m_emMode = NrErrorModel::UL;
+  m_tbSizeCache.clear ();
 }
 
 TypeId
@@ -122,6 +126,7 @@ void NrAmc::SetNumRefScPerRb(uint8_t nref)
 {
   NS_LOG_FUNCTION (this);
   m_numRefScPerRb = nref;
+  m_tbSizeCache.clear ();
 }
 
 uint32_t
@@ -132,6 +137,30 @@ NrAmc::CalculateTbSize (uint8_t mcs, uint32_t nprb) const
   NS_ASSERT_MSG (mcs <= m_errorModel->GetMaxMcs (), "MCS=" << static_cast<uint32_t> (mcs) <<
                  " while maximum MCS is " << static_cast<uint32_t> (m_errorModel->GetMaxMcs ()));
 
+  if (nprb > m_maxCachedNprb)
+    {
+      return ComputeTbSize (mcs, nprb);
+    }
+
+  if (mcs >= m_tbSizeCache.size ())
+    {
+      m_tbSizeCache.resize (mcs + 1);
+    }
+  std::vector<uint32_t> &tbSizeByNprb = m_tbSizeCache[mcs];
+  if (nprb >= tbSizeByNprb.size ())
+    {
+      tbSizeByNprb.resize (nprb + 1, m_tbSizeNotCached);
+    }
+  if (tbSizeByNprb[nprb] == m_tbSizeNotCached)
+    {
+      tbSizeByNprb[nprb] = ComputeTbSize (mcs, nprb);
+    }
+  return tbSizeByNprb[nprb];
+}
+
+uint32_t
+NrAmc::ComputeTbSize (uint8_t mcs, uint32_t nprb) const
+{
   uint32_t payloadSize = GetPayloadSize (mcs, nprb);
   uint32_t tbSize = payloadSize;
 
@@ -333,6 +362,7 @@ NrAmc::SetErrorModelType (const TypeId &type)
   factory.SetTypeId (m_errorModelType);
   m_errorModel = DynamicCast<NrErrorModel> (factory.Create ());
   NS_ASSERT (m_errorModel != nullptr);
+  m_tbSizeCache.clear ();
 }
 
 TypeId
@@ -183,6 +183,11 @@ public:
    * It depends on the error model and the "mode" configured with SetMode().
    * Please note that this function expects in input the RB, not the RBG of the transmission.
    *
+   * The values are memoized per (MCS, nprb), as the schedulers ask for the
+   * same ones for every UE and every slot, up to the RB of a whole slot of
+   * the largest BWP. The cache is emptied when the mode, the error model
+   * type or the number of reference subcarriers change.
+   *
    * \param mcs the MCS of the transmission
    * \param nprb The number of physical resource blocks used in the transmission
    * \return the TBS in bytes
@@ -203,6 +208,14 @@ private:
    */
   double GetBer () const;
 
+  /**
+   * \brief Compute the TB size, without looking in the cache
+   * \param mcs the MCS of the transmission
+   * \param nprb The number of physical resource blocks used in the transmission
+   * \return the TBS in bytes
+   */
+  uint32_t ComputeTbSize (uint8_t mcs, uint32_t nprb) const;
+
 private:
   AmcModel m_amcModel;             //!< Type of the CQI feedback model
   Ptr<NrErrorModel> m_errorModel;  //!< Pointer to an instance of ErrorModel
@@ -210,6 +223,16 @@ private:
   uint8_t m_numRefScPerRb {1};     //!< number of reference subcarriers per RB
   NrErrorModel::Mode m_emMode {NrErrorModel::DL}; //!< Error model mode
   static const unsigned int m_crcLen = 24 / 8; //!< CRC length (in bytes)
+  static const uint32_t m_maxRbPerBwp = 275;     //!< Maximum number of RB of a BWP (TS 38.101-1, Table 5.3.2-1)
+  static const uint32_t m_maxSymPerSlot = 14;    //!< Maximum number of OFDM symbols of a slot
+  /**
+   * The schedulers pass the RB of all the assigned symbols, so a request can
+   * not go beyond a whole slot of the largest BWP. Requests with more RB are
+   * not memoized.
+   */
+  static const uint32_t m_maxCachedNprb = m_maxRbPerBwp * m_maxSymPerSlot;
+  static const uint32_t m_tbSizeNotCached = UINT32_MAX; //!< Marker of an empty cache entry
+  mutable std::vector<std::vector<uint32_t> > m_tbSizeCache; //!< TB size by MCS and number of RB
 };
 
 } // end namespace ns3
@@ -506,9 +506,13 @@ NrGnbMac::GetUlCtrlSyms() const
 void
 NrGnbMac::ReceiveRachPreamble (uint32_t raId)
 {
-  Ptr<NrRachPreambleMessage> rachMsg = Create<NrRachPreambleMessage> ();
-  rachMsg->SetSourceBwp (GetBwpId ());
-  m_macRxedCtrlMsgsTrace (m_currentSlot, GetCellId (), raId, GetBwpId (), rachMsg);
+  // The message is built only for the trace, so skip it if nobody listens
+  if (!m_macRxedCtrlMsgsTrace.IsEmpty ())
+    {
+      Ptr<NrRachPreambleMessage> rachMsg = Create<NrRachPreambleMessage> ();
+      rachMsg->SetSourceBwp (GetBwpId ());
+      m_macRxedCtrlMsgsTrace (m_currentSlot, GetCellId (), raId, GetBwpId (), rachMsg);
+    }
 
   ++m_receivedRachPreambleCount[raId];
 }
@@ -568,11 +572,14 @@ NrGnbMac::DoSlotDlIndication (const SfnSf &sfnSf, LteNrTddSlotType type)
 
     m_macSchedSapProvider->SchedDlCqiInfoReq (dlCqiInfoReq);
 
-    for (const auto & v : dlCqiInfoReq.m_cqiList)
+    if (!m_macRxedCtrlMsgsTrace.IsEmpty ())
       {
-        Ptr<NrDlCqiMessage> msg = Create<NrDlCqiMessage> ();
-        msg->SetDlCqi (v);
-        m_macRxedCtrlMsgsTrace (m_currentSlot, GetCellId (), v.m_rnti, GetBwpId (), msg);
+        for (const auto & v : dlCqiInfoReq.m_cqiList)
+          {
+            Ptr<NrDlCqiMessage> msg = Create<NrDlCqiMessage> ();
+            msg->SetDlCqi (v);
+            m_macRxedCtrlMsgsTrace (m_currentSlot, GetCellId (), v.m_rnti, GetBwpId (), msg);
+          }
       }
   }
 
@@ -612,11 +619,14 @@ NrGnbMac::DoSlotDlIndication (const SfnSf &sfnSf, LteNrTddSlotType type)
       // empty local buffer
       m_dlHarqInfoReceived.clear ();
 
-      for (const auto & v : dlParams.m_dlHarqInfoList)
+      if (!m_macRxedCtrlMsgsTrace.IsEmpty ())
         {
-          Ptr<NrDlHarqFeedbackMessage> msg = Create <NrDlHarqFeedbackMessage> ();
-          msg->SetDlHarqFeedback (v);
-          m_macRxedCtrlMsgsTrace (m_currentSlot, GetCellId (), v.m_rnti, GetBwpId (), msg);
+          for (const auto & v : dlParams.m_dlHarqInfoList)
+            {
+              Ptr<NrDlHarqFeedbackMessage> msg = Create <NrDlHarqFeedbackMessage> ();
+              msg->SetDlHarqFeedback (v);
+              m_macRxedCtrlMsgsTrace (m_currentSlot, GetCellId (), v.m_rnti, GetBwpId (), msg);
+            }
         }
     }
 
@@ -658,11 +668,14 @@ NrGnbMac::DoSlotUlIndication (const SfnSf &sfnSf, LteNrTddSlotType type)
 
     m_macSchedSapProvider->SchedUlSrInfoReq (params);
 
-    for (const auto & v : params.m_srList)
+    if (!m_macRxedCtrlMsgsTrace.IsEmpty ())
       {
-        Ptr<NrSRMessage> msg =  Create<NrSRMessage> ();
-        msg->SetRNTI (v);
-        m_macRxedCtrlMsgsTrace (m_currentSlot, GetCellId (), v, GetBwpId (), msg);
+        for (const auto & v : params.m_srList)
+          {
+            Ptr<NrSRMessage> msg =  Create<NrSRMessage> ();
+            msg->SetRNTI (v);
+            m_macRxedCtrlMsgsTrace (m_currentSlot, GetCellId (), v, GetBwpId (), msg);
+          }
       }
   }
 
@@ -675,11 +688,14 @@ NrGnbMac::DoSlotUlIndication (const SfnSf &sfnSf, LteNrTddSlotType type)
       m_ulCeReceived.erase (m_ulCeReceived.begin (), m_ulCeReceived.end ());
       m_macSchedSapProvider->SchedUlMacCtrlInfoReq (ulMacReq);
 
-      for (const auto & v : ulMacReq.m_macCeList)
+      if (!m_macRxedCtrlMsgsTrace.IsEmpty ())
         {
-          Ptr<NrBsrMessage> msg = Create<NrBsrMessage> ();
-          msg->SetBsr (v);
-          m_macRxedCtrlMsgsTrace (m_currentSlot, GetCellId (), v.m_rnti, GetBwpId (), msg);
+          for (const auto & v : ulMacReq.m_macCeList)
+            {
+              Ptr<NrBsrMessage> msg = Create<NrBsrMessage> ();
+              msg->SetBsr (v);
+              m_macRxedCtrlMsgsTrace (m_currentSlot, GetCellId (), v.m_rnti, GetBwpId (), msg);
+            }
         }
     }
 
@@ -1282,9 +1298,9 @@ NrGnbMac::GetDlCtrlDci () const
   NS_ASSERT (bwInRbg > 0);
   std::vector<uint8_t> rbgBitmask (bwInRbg , 1);
 
-  return std::make_shared<DciInfoElementTdma> (0, m_macSchedSapProvider->GetDlCtrlSyms (),
-                                               DciInfoElementTdma::DL, DciInfoElementTdma::CTRL,
-                                               rbgBitmask);
+  return m_dciPool.Create (0, m_macSchedSapProvider->GetDlCtrlSyms (),
+                           DciInfoElementTdma::DL, DciInfoElementTdma::CTRL,
+                           rbgBitmask);
 }
 
 std::shared_ptr<DciInfoElementTdma>
@@ -1295,9 +1311,9 @@ NrGnbMac::GetUlCtrlDci () const
   NS_ASSERT (m_bandwidthInRbg > 0);
   std::vector<uint8_t> rbgBitmask (m_bandwidthInRbg , 1);
 
-  return std::make_shared<DciInfoElementTdma> (0, m_macSchedSapProvider->GetUlCtrlSyms (),
-                                               DciInfoElementTdma::UL, DciInfoElementTdma::CTRL,
-                                               rbgBitmask);
+  return m_dciPool.Create (0, m_macSchedSapProvider->GetUlCtrlSyms (),
+                           DciInfoElementTdma::UL, DciInfoElementTdma::CTRL,
+                           rbgBitmask);
 }
 
 void
@@ -402,6 +402,8 @@ private:
 
   SfnSf m_currentSlot;
 
+  NrDciPool m_dciPool; //!< Pool of the CTRL DCIs
+
   /**
    * Trace information regarding ENB MAC Received Control Messages
    * Frame number, Subframe number, slot, VarTtti, nodeId, rnti,
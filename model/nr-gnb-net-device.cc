@@ -95,9 +95,10 @@ NrGnbNetDevice::RouteIngoingCtrlMsgs (const std::list<Ptr<NrControlMessage> > &m
 {
   NS_LOG_FUNCTION (this);
 
+  Ptr<BwpManagerGnb> bwpManager = GetBwpManager ();
   for (const auto & msg : msgList)
     {
-      uint8_t bwpId = DynamicCast<BwpManagerGnb> (m_componentCarrierManager)->RouteIngoingCtrlMsgs (msg, sourceBwpId);
+      uint8_t bwpId = bwpManager->RouteIngoingCtrlMsgs (msg, sourceBwpId);
       m_ccMap.at (bwpId)->GetPhy ()->PhyCtrlMessagesReceived (msg);
     }
 }
@@ -108,9 +109,10 @@ NrGnbNetDevice::RouteOutgoingCtrlMsgs (const std::list<Ptr<NrControlMessage> > &
 {
   NS_LOG_FUNCTION (this);
 
+  Ptr<BwpManagerGnb> bwpManager = GetBwpManager ();
   for (const auto & msg : msgList)
     {
-      uint8_t bwpId = DynamicCast<BwpManagerGnb> (m_componentCarrierManager)->RouteOutgoingCtrlMsg (msg, sourceBwpId);
+      uint8_t bwpId = bwpManager->RouteOutgoingCtrlMsg (msg, sourceBwpId);
       NS_ASSERT_MSG (m_ccMap.size () > bwpId, "Returned bwp " << +bwpId << " is not present. Check your configuration");
       NS_ASSERT_MSG (m_ccMap.at (bwpId)->GetPhy ()->HasDlSlot (),
                      "Returned bwp " << +bwpId << " has no DL slot, so the message can't go out. Check your configuration");
@@ -1201,10 +1201,12 @@ NrGnbPhy::DlCtrl (const std::shared_ptr<DciInfoElementTdma> &dci)
                     " start " << Simulator::Now () <<
                     " end " << Simulator::Now () + varTtiPeriod - NanoSeconds (1.0));
 
-      for (auto ctrlIt = m_ctrlMsgs.begin (); ctrlIt != m_ctrlMsgs.end (); ++ctrlIt)
+      if (!m_phyTxedCtrlMsgsTrace.IsEmpty ())
         {
-          Ptr<NrControlMessage> msg = (*ctrlIt);
-          m_phyTxedCtrlMsgsTrace (m_currentSlot, GetCellId (), dci->m_rnti, GetBwpId (), msg);
+          for (const auto & msg : m_ctrlMsgs)
+            {
+              m_phyTxedCtrlMsgsTrace (m_currentSlot, GetCellId (), dci->m_rnti, GetBwpId (), msg);
+            }
         }
 
       SendCtrlChannels (varTtiPeriod - NanoSeconds (1.0)); // -1 ns ensures control ends before data period
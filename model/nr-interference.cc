@@ -99,8 +99,15 @@ NrInterference::EndRx ()
     }
   else
     {
-      SpectrumValue snr = (*m_rxSignal) / (*m_noise);
-      double avgSnr = Sum (snr) /(snr.GetSpectrumModel ()->GetNumBands ());
+      // Same as Sum ((*m_rxSignal) / (*m_noise)), without the temporary
+      double snrSum = 0.0;
+      Values::const_iterator noise = m_noise->ConstValuesBegin ();
+      for (Values::const_iterator rx = m_rxSignal->ConstValuesBegin ();
+           rx != m_rxSignal->ConstValuesEnd (); ++rx, ++noise)
+        {
+          snrSum += (*rx) / (*noise);
+        }
+      double avgSnr = snrSum / (m_rxSignal->GetSpectrumModel ()->GetNumBands ());
       m_snrPerProcessedChunk (avgSnr);
 
       NrInterference::ConditionallyEvaluateChunk ();
@@ -133,10 +140,23 @@ NrInterference::ConditionallyEvaluateChunk ()
   if (m_receiving && (Now () > m_lastChangeTime))
     {
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
-      SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
-      SpectrumValue sinr = (*m_rxSignal) / interf;
       double rbWidth = (*m_rxSignal).GetSpectrumModel ()->Begin ()->fh - (*m_rxSignal).GetSpectrumModel ()->Begin ()->fl;
-      double rssidBm = 10 * log10 (Sum ((*m_noise + *m_allSignals) * rbWidth) * 1000);
+
+      // One pass over the RBs computes the interference, the SINR (in the
+      // reused buffer), and the RSSI, with the same operations (and order) of
+      // the SpectrumValue expressions they replace:
+      // sinr = rx / (all - rx + noise), rssi = Sum ((noise + all) * rbWidth)
+      SpectrumValue &sinr = GetSinrBuffer ();
+      double rssiW = 0.0;
+      Values::const_iterator rx = m_rxSignal->ConstValuesBegin ();
+      Values::const_iterator all = m_allSignals->ConstValuesBegin ();
+      Values::const_iterator noise = m_noise->ConstValuesBegin ();
+      for (Values::iterator out = sinr.ValuesBegin (); out != sinr.ValuesEnd (); ++out, ++rx, ++all, ++noise)
+        {
+          *out = (*rx) / ((*all) - (*rx) + (*noise));
+          rssiW += ((*noise) + (*all)) * rbWidth;
+        }
+      double rssidBm = 10 * log10 (rssiW * 1000);
       m_rssiPerProcessedChunk(rssidBm);
 
       NS_LOG_DEBUG ("All signals: " << (*m_allSignals)[0] << ", rxSingal:" << (*m_rxSignal)[0] << " , noise:" << (*m_noise)[0]);
@@ -154,6 +174,17 @@ NrInterference::ConditionallyEvaluateChunk ()
     }
 }
 
+SpectrumValue &
+NrInterference::GetSinrBuffer ()
+{
+  if (m_sinr == nullptr
+      || m_sinr->GetSpectrumModelUid () != m_rxSignal->GetSpectrumModelUid ())
+    {
+      m_sinr = Create<SpectrumValue> (m_rxSignal->GetSpectrumModel ());
+    }
+  return *m_sinr;
+}
+
 /****************************************************************
  *       Class which records SNIR change events for a
  *       short period of time.
@@ -220,7 +251,7 @@ NrInterference::GetEnergyDuration (double energyW)
 
   NS_LOG_INFO("First power: " << m_firstPower);
 
-  for (NiChanges::const_iterator i = m_niChanges.begin (); i != m_niChanges.end (); i++)
+  for (NiChanges::const_iterator i = m_niChanges.begin () + m_niChangesHead; i != m_niChanges.end (); i++)
     {
       noiseInterferenceW += i->GetDelta ();
       end = i->GetTime ();
@@ -255,13 +286,14 @@ void
 NrInterference::EraseEvents (void)
 {
   m_niChanges.clear ();
+  m_niChangesHead = 0;
   m_firstPower = 0.0;
 }
 
 NrInterference::NiChanges::iterator
 NrInterference::GetPosition (Time moment)
 {
-  return std::upper_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (moment, 0));
+  return std::upper_bound (m_niChanges.begin () + m_niChangesHead, m_niChanges.end (), NiChange (moment, 0));
 }
 
 void
@@ -281,14 +313,29 @@ NrInterference::AppendEvent (Time startTime, Time endTime, double rxPowerW)
       // We empty the list until the current moment. To do so we 
       // first we sum all the energies until the current moment 
       // and save it in m_firstPower.
-      for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
+      for (NiChanges::iterator i = m_niChanges.begin () + m_niChangesHead; i != nowIterator; i++)
         {
           m_firstPower += i->GetDelta ();
         }
-      // then we remove all the events up to the current moment
-      m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      // we create an event that represents the new energy
-      m_niChanges.insert (m_niChanges.begin (), NiChange (startTime, rxPowerW));
+      // then we drop all the events up to the current moment, by moving
+      // the head of the list after them, and we create an event that
+      // represents the new energy in the slot just before the new head,
+      // so that the events are not shifted
+      m_niChangesHead = static_cast<NiChanges::size_type> (nowIterator - m_niChanges.begin ());
+      if (m_niChangesHead > 0)
+        {
+          m_niChanges[--m_niChangesHead] = NiChange (startTime, rxPowerW);
+        }
+      else
+        {
+          m_niChanges.insert (m_niChanges.begin (), NiChange (startTime, rxPowerW));
+        }
+      // the dropped events are removed only when they are the majority
+      if (m_niChangesHead > m_niChanges.size () / 2)
+        {
+          m_niChanges.erase (m_niChanges.begin (), m_niChanges.begin () + m_niChangesHead);
+          m_niChangesHead = 0;
+        }
     }
   else
     {
@@ -169,6 +169,18 @@ private:
    */
   void AddNiChangeEvent (NiChange change);
 
+  /**
+   * \brief Get the buffer for the SINR of a chunk
+   *
+   * The buffer is created again only when the spectrum model of the
+   * received signal changes.
+   *
+   * \return the SINR buffer, with the spectrum model of the received signal
+   */
+  SpectrumValue & GetSinrBuffer ();
+
+  Ptr<SpectrumValue> m_sinr; //!< SINR of the last evaluated chunk, reused across the chunks
+
 protected:
 
   /**
@@ -181,6 +193,7 @@ protected:
 
   /// Used for energy duration calculation, inspired by wifi/model/interference-helper implementation
   NiChanges m_niChanges; //!< List of events in which there is some change in the energy
+  NiChanges::size_type m_niChangesHead {0}; //!< Index of the first event of m_niChanges still in use
   double m_firstPower; //!< This contains the accumulated sum of the energy events until the certain moment it has been calculated
 
 
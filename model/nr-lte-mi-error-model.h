@@ -54,6 +54,8 @@ struct NrLteMiErrorModelOutput : public NrErrorModelOutput
   double m_miTotal  {0.0};    //!< Acumulated Mutual Information
   uint32_t m_infoBits {0};    //!< number of info bits
   uint32_t m_codeBits {0};    //!< number of code bits
+  uint32_t m_codeBitsSum {0}; //!< number of code bits of this and the previous transmissions of the TB
+  double m_miSum {0.0};       //!< sum of m_mi * m_codeBits of this and the previous transmissions of the TB
 };
 
 /**
@@ -127,7 +129,17 @@ public:
   virtual uint32_t GetMaxCbSize (uint32_t tbSize, uint8_t mcs) const override;
   virtual uint8_t GetMaxMcs () const override;
 
+  /**
+   * \brief Get the effective code rate (ECR) of an MCS
+   * \param mcs the MCS
+   * \return the ECR of the MCS, i.e., the info bits per code bit of a first
+   * transmission
+   */
+  static double GetMcsEcr (uint8_t mcs);
+
 private:
+  friend class NrLteMiErrorModelHarqTestCase;
+
   /**
    * \brief Get an output for the decodification error probability of a given
    * transport block, assuming the MIESM method, LTE TC coding and block
@@ -167,6 +179,19 @@ private:
    * \return the code block error rate
    */
   static double MappingMiBler (double mib, uint8_t ecrId, uint32_t cbSize);
+
+  /**
+   * \brief Get the TBLER of a TB, from its effective MI and code rate,
+   * according to its segmentation in CBs as per TS 36.212 Sect. 5.1.2
+   *
+   * \param mi the effective MI of the TB, combined over its transmissions
+   * \param reff the effective code rate of the TB; ignored if harq is false
+   * \param mcs the MCS of the TB
+   * \param size the size of the TB (bit)
+   * \param harq true if the TB is a retransmission
+   * \return the TBLER
+   */
+  static double GetTbler (double mi, double reff, uint8_t mcs, uint32_t size, bool harq);
 };
 
 
@@ -69,7 +69,8 @@ struct HarqProcess
     m_status (other.m_status),
     m_timer (other.m_timer),
     m_dciElement (other.m_dciElement),
-    m_rlcPduInfo (other.m_rlcPduInfo)
+    m_rlcPduInfo (other.m_rlcPduInfo),
+    m_rbgCount (other.m_rbgCount)
   {
   }
 
@@ -98,6 +99,7 @@ struct HarqProcess
     m_timer = 0;
     m_dciElement.reset ();
     m_rlcPduInfo.clear ();
+    m_rbgCount = 0;
   }
 
   bool m_active                         {false};       //!< False indicate that the process is not active
@@ -106,6 +108,7 @@ struct HarqProcess
   std::shared_ptr<DciInfoElementTdma> m_dciElement {}; //!< DCI element
   std::vector<std::vector<RlcPduInfo> > m_rlcPduInfo {};            //!< vector of RLC PDU
   std::vector <uint8_t> nackStreamIndexes; //!< vector holding the stream indexes for which gNB received NACK
+  uint16_t m_rbgCount {0}; //!< Number of RBGs set in the bitmask of m_dciElement, 0 if not counted yet
 };
 
 /**
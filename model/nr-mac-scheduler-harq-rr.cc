@@ -82,6 +82,7 @@ uint8_t NrMacSchedulerHarqRr::ScheduleDlHarq (NrMacSchedulerNs3::PointInFTPlane
   NS_ASSERT (startingPoint->m_rbg == 0);
   uint8_t usedSym = 0;
   uint8_t symPerBeam = symAvail / activeDlHarq.size ();
+  const uint16_t bwInRbg = GetBandwidthInRbg ();
 
   NS_LOG_INFO ("We have " << activeDlHarq.size () <<
                " beams with data to RETX, each beam has " <<
@@ -89,7 +90,7 @@ uint8_t NrMacSchedulerHarqRr::ScheduleDlHarq (NrMacSchedulerNs3::PointInFTPlane
 
   for (const auto & beam : activeDlHarq)
     {
-      std::vector<uint16_t> allocatedUe;
+      ResetAllocatedUes ();
       NS_LOG_INFO (" Try to assign HARQ resource for BeamConfId: " << beam.first <<
                    " # HARQ to Retx=" << beam.second.size ());
 
@@ -105,9 +106,13 @@ uint8_t NrMacSchedulerHarqRr::ScheduleDlHarq (NrMacSchedulerNs3::PointInFTPlane
 
           auto & dciInfoReTx = harqProcess.m_dciElement;
 
-          long rbgAssigned = std::count (dciInfoReTx->m_rbgBitmask.begin (),
-                                         dciInfoReTx->m_rbgBitmask.end (), 1) * dciInfoReTx->m_numSym;
-          uint32_t rbgAvail = (GetBandwidthInRbg () - startingPoint->m_rbg) * symPerBeam;
+          if (harqProcess.m_rbgCount == 0)
+            {
+              harqProcess.m_rbgCount = std::count (dciInfoReTx->m_rbgBitmask.begin (),
+                                                   dciInfoReTx->m_rbgBitmask.end (), 1);
+            }
+          long rbgAssigned = harqProcess.m_rbgCount * dciInfoReTx->m_numSym;
+          uint32_t rbgAvail = (bwInRbg - startingPoint->m_rbg) * symPerBeam;
 
           NS_LOG_INFO ("Evaluating space to retransmit HARQ PID=" <<
                        static_cast<uint32_t> (dciInfoReTx->m_harqProcess) <<
@@ -117,7 +122,7 @@ uint8_t NrMacSchedulerHarqRr::ScheduleDlHarq (NrMacSchedulerNs3::PointInFTPlane
                        " SYM avail for this beam=" << static_cast<uint32_t> (symPerBeam) <<
                        " RBG avail for this beam=" << rbgAvail);
 
-          if (std::find (allocatedUe.begin (), allocatedUe.end (), dciInfoReTx->m_rnti) != allocatedUe.end ())
+          if (IsUeAllocated (dciInfoReTx->m_rnti))
             {
               NS_LOG_INFO ("UE " << dciInfoReTx->m_rnti <<
                            " already has an HARQ allocated, buffer this HARQ process" <<
@@ -134,23 +139,24 @@ uint8_t NrMacSchedulerHarqRr::ScheduleDlHarq (NrMacSchedulerNs3::PointInFTPlane
               continue;
             }
 
-          allocatedUe.push_back (dciInfoReTx->m_rnti);
+          SetUeAllocated (dciInfoReTx->m_rnti);
 
           NS_ASSERT (dciInfoReTx->m_format == DciInfoElementTdma::DL);
 
-          std::vector<uint32_t> tbSize;
-          tbSize.resize (dciInfoReTx->m_tbSize.size ());
-          std::vector<uint8_t> ndi;
-          ndi.resize (dciInfoReTx->m_ndi.size ());
-          std::vector<uint8_t> rv;
-          rv.resize (dciInfoReTx->m_rv.size ());
-          std::vector<uint8_t> mcs;
-          mcs.resize (dciInfoReTx->m_mcs.size ());
+          NrStreamArray<uint32_t> tbSize (dciInfoReTx->m_tbSize.size ());
+          NrStreamArray<uint8_t> ndi (dciInfoReTx->m_ndi.size ());
+          NrStreamArray<uint8_t> rv (dciInfoReTx->m_rv.size ());
+          NrStreamArray<uint8_t> mcs (dciInfoReTx->m_mcs.size ());
+
+          uint32_t nackStreams = 0; // bit i set if the stream i was NACKed
+          for (uint8_t stream : harqProcess.nackStreamIndexes)
+            {
+              nackStreams |= (1u << stream);
+            }
 
           for (uint8_t stream = 0; stream < dciInfoReTx->m_tbSize.size (); stream++)
             {
-              auto it = std::find (harqProcess.nackStreamIndexes.begin (), harqProcess.nackStreamIndexes.end (), stream);
-              if (it != harqProcess.nackStreamIndexes.end ())
+              if (nackStreams & (1u << stream))
                 {
                   //if stream index is in nackStreamIndexes that means
                   //we received NACK for it. Therefore, we need to use the same
@@ -172,10 +178,10 @@ uint8_t NrMacSchedulerHarqRr::ScheduleDlHarq (NrMacSchedulerNs3::PointInFTPlane
 
             }
 
-          auto dci = std::make_shared<DciInfoElementTdma> (dciInfoReTx->m_rnti, dciInfoReTx->m_format,
-                                                           startingPoint->m_sym, symPerBeam,
-                                                           mcs, tbSize, ndi, rv, DciInfoElementTdma::DATA,
-                                                           dciInfoReTx->m_bwpIndex, dciInfoReTx->m_tpc);
+          auto dci = m_dciPool.Create (dciInfoReTx->m_rnti, dciInfoReTx->m_format,
+                                       startingPoint->m_sym, symPerBeam,
+                                       mcs, tbSize, ndi, rv, DciInfoElementTdma::DATA,
+                                       dciInfoReTx->m_bwpIndex, dciInfoReTx->m_tpc);
 
           dci->m_rbgBitmask = harqProcess.m_dciElement->m_rbgBitmask;
           dci->m_harqProcess = dciInfoReTx->m_harqProcess;
@@ -206,6 +212,7 @@ uint8_t NrMacSchedulerHarqRr::ScheduleDlHarq (NrMacSchedulerNs3::PointInFTPlane
                   dciInfoReTx->m_rbgBitmask.at (i) = 0;
                 }
             }
+          harqProcess.m_rbgCount = static_cast<uint16_t> (rbgAssigned);
 
           startingPoint->m_rbg += rbgAssigned;
 
@@ -240,7 +247,7 @@ uint8_t NrMacSchedulerHarqRr::ScheduleDlHarq (NrMacSchedulerNs3::PointInFTPlane
           ueMap.find (dciInfoReTx->m_rnti)->second->m_dlMRBRetx = dciInfoReTx->m_numSym * rbgAssigned;
         }
 
-      if (allocatedUe.size () > 0)
+      if (m_allocatedUes.size () > 0)
         {
           startingPoint->m_sym += symPerBeam;
           startingPoint->m_rbg = 0;
@@ -280,6 +287,7 @@ NrMacSchedulerHarqRr::ScheduleUlHarq (NrMacSchedulerNs3::PointInFTPlane *startin
 {
   NS_LOG_FUNCTION (this);
   uint8_t symUsed = 0;
+  const uint16_t bwInRbg = GetBandwidthInRbg ();
   NS_ASSERT (startingPoint->m_rbg == 0);
 
   NS_LOG_INFO ("Scheduling UL HARQ starting from sym " << +startingPoint->m_sym <<
@@ -315,15 +323,15 @@ NrMacSchedulerHarqRr::ScheduleUlHarq (NrMacSchedulerNs3::PointInFTPlane *startin
           NS_ASSERT_MSG (harqProcess.nackStreamIndexes.size () == 1, "MIMO is not supported for UL yet");
 
           uint8_t rvIndex = dciInfoReTx->m_rv.at (0) + 1;
-          std::vector<uint8_t> rv {rvIndex};
-          std::vector<uint8_t> ndi {0};
-
-          auto dci = std::make_shared<DciInfoElementTdma> (dciInfoReTx->m_rnti, dciInfoReTx->m_format,
-                                                           startingPoint->m_sym - dciInfoReTx->m_numSym,
-                                                           dciInfoReTx->m_numSym,
-                                                           dciInfoReTx->m_mcs, dciInfoReTx->m_tbSize,
-                                                           ndi, rv, DciInfoElementTdma::DATA,
-                                                           dciInfoReTx->m_bwpIndex, dciInfoReTx->m_tpc);
+          NrStreamArray<uint8_t> rv {rvIndex};
+          NrStreamArray<uint8_t> ndi {0};
+
+          auto dci = m_dciPool.Create (dciInfoReTx->m_rnti, dciInfoReTx->m_format,
+                                       startingPoint->m_sym - dciInfoReTx->m_numSym,
+                                       dciInfoReTx->m_numSym,
+                                       dciInfoReTx->m_mcs, dciInfoReTx->m_tbSize,
+                                       ndi, rv, DciInfoElementTdma::DATA,
+                                       dciInfoReTx->m_bwpIndex, dciInfoReTx->m_tpc);
           dci->m_rbgBitmask = harqProcess.m_dciElement->m_rbgBitmask;
           dci->m_harqProcess = harqId;
           harqProcess.m_dciElement = dci;
@@ -345,7 +353,7 @@ NrMacSchedulerHarqRr::ScheduleUlHarq (NrMacSchedulerNs3::PointInFTPlane *startin
           slotAlloc->m_varTtiAllocInfo.push_front (slotInfo);
           slotAlloc->m_numSymAlloc += dciInfoReTx->m_numSym;
 
-          ueMap.find (rnti)->second->m_ulMRBRetx = dciInfoReTx->m_numSym * GetBandwidthInRbg ();
+          ueMap.find (rnti)->second->m_ulMRBRetx = dciInfoReTx->m_numSym * bwInRbg;
         }
       else
         {
@@ -441,4 +449,31 @@ NrMacSchedulerHarqRr::GetBandwidthInRbg() const
   return m_getBwInRbg ();
 }
 
+bool
+NrMacSchedulerHarqRr::IsUeAllocated (uint16_t rnti) const
+{
+  return rnti < m_isUeAllocated.size () && m_isUeAllocated[rnti];
+}
+
+void
+NrMacSchedulerHarqRr::SetUeAllocated (uint16_t rnti) const
+{
+  if (rnti >= m_isUeAllocated.size ())
+    {
+      m_isUeAllocated.resize (rnti + 1, false);
+    }
+  m_isUeAllocated[rnti] = true;
+  m_allocatedUes.push_back (rnti);
+}
+
+void
+NrMacSchedulerHarqRr::ResetAllocatedUes () const
+{
+  for (uint16_t rnti : m_allocatedUes)
+    {
+      m_isUeAllocated[rnti] = false;
+    }
+  m_allocatedUes.clear ();
+}
+
 } // namespace ns3
@@ -106,9 +106,33 @@ protected:
   uint16_t GetBandwidthInRbg () const;
 
 private:
+  /**
+   * \brief Check if a UE already has a retransmission in the current beam
+   * \param rnti the RNTI of the UE
+   * \return true if SetUeAllocated () was called for the UE after the last
+   * ResetAllocatedUes ()
+   */
+  bool IsUeAllocated (uint16_t rnti) const;
+  /**
+   * \brief Mark a UE as having a retransmission in the current beam
+   * \param rnti the RNTI of the UE
+   */
+  void SetUeAllocated (uint16_t rnti) const;
+  /**
+   * \brief Unmark all the UEs marked with SetUeAllocated ()
+   */
+  void ResetAllocatedUes () const;
+
   std::function<uint16_t ()> m_getBwpId;  //!< Function to retrieve bwp id
   std::function<uint16_t ()> m_getCellId; //!< Function to retrieve cell id
   std::function<uint16_t ()> m_getBwInRbg; //!< Function to retrieve bw in rbg
+  NrDciPool m_dciPool; //!< Pool of the DCIs created for the retransmissions
+  /**
+   * Scratch space of ScheduleDlHarq, reused across slots: m_isUeAllocated
+   * is indexed by RNTI, m_allocatedUes lists the RNTIs set, to reset them.
+   */
+  mutable std::vector<bool> m_isUeAllocated;
+  mutable std::vector<uint16_t> m_allocatedUes; //!< RNTIs set in m_isUeAllocated
 };
 
 } // namespace ns3
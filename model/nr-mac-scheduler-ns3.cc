@@ -993,8 +993,7 @@ NrMacSchedulerNs3::ProcessHARQFeedbacks (std::vector<T> *harqInfo,
         }
       NS_ABORT_IF (ueProcess.m_dciElement == nullptr);
 
-      std::vector<uint8_t>::const_iterator rvIt;
-      rvIt = std::max_element (ueProcess.m_dciElement->m_rv.begin(), ueProcess.m_dciElement->m_rv.end());
+      auto rvIt = std::max_element (ueProcess.m_dciElement->m_rv.begin(), ueProcess.m_dciElement->m_rv.end());
       //RV number should not be greater than 3. An unscheduled stream should
       //be assigned RV = 0 in MIMO.
       NS_ASSERT (*rvIt < 4);
@@ -1090,7 +1089,7 @@ NrMacSchedulerNs3::PrependCtrlSym (uint8_t symStart, uint8_t numSymToAllocate,
 
   for (uint8_t sym = symStart; sym < symStart + numSymToAllocate; ++sym)
     {
-      allocations->emplace_front (VarTtiAllocInfo (std::make_shared<DciInfoElementTdma> (sym, 1, mode, DciInfoElementTdma::CTRL, rbgBitmask)));
+      allocations->emplace_front (VarTtiAllocInfo (m_dciPool.Create (sym, 1, mode, DciInfoElementTdma::CTRL, rbgBitmask)));
       NS_LOG_INFO ("Allocating CTRL symbol, type" << mode <<
                    " in TDMA. numSym=1, symStart=" <<
                    static_cast<uint32_t> (sym) <<
@@ -1123,7 +1122,7 @@ NrMacSchedulerNs3::AppendCtrlSym (uint8_t symStart, uint8_t numSymToAllocate,
 
   for (uint8_t sym = symStart; sym < symStart + numSymToAllocate; ++sym)
     {
-      allocations->emplace_back (VarTtiAllocInfo (std::make_shared<DciInfoElementTdma> (sym, 1, mode, DciInfoElementTdma::CTRL, rbgBitmask)));
+      allocations->emplace_back (VarTtiAllocInfo (m_dciPool.Create (sym, 1, mode, DciInfoElementTdma::CTRL, rbgBitmask)));
       NS_LOG_INFO ("Allocating CTRL symbol, type" << mode <<
                    " in TDMA. numSym=1, symStart=" <<
                    static_cast<uint32_t> (sym) <<
@@ -2181,11 +2180,11 @@ NrMacSchedulerNs3::DoScheduleSrs (PointInFTPlane *spoint, SlotAllocInfo *allocIn
       std::vector<uint8_t> ndi = {1};
       std::vector<uint8_t> rv = {0};
 
-      auto dci = std::make_shared<DciInfoElementTdma> (rnti, DciInfoElementTdma::UL,
-                                                       spoint->m_sym, 1, mcs, tbs,
-                                                       ndi, rv,
-                                                       DciInfoElementTdma::SRS,
-                                                       GetBwpId(), GetTpc ());
+      auto dci = m_dciPool.Create (rnti, DciInfoElementTdma::UL,
+                                   spoint->m_sym, 1, mcs, tbs,
+                                   ndi, rv,
+                                   DciInfoElementTdma::SRS,
+                                   GetBwpId(), GetTpc ());
       dci->m_rbgBitmask = rbgBitmask;
 
       allocInfo->m_numSymAlloc += 1;
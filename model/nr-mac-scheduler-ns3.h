@@ -880,6 +880,8 @@ protected:
    */
   uint16_t GetBandwidthInRbg () const;
 
+  NrDciPool m_dciPool; //!< Pool of the DCIs created by the scheduler
+
 private:
   std::unordered_map<uint16_t, std::shared_ptr<NrMacSchedulerUeInfo> > m_ueMap; //!< The map of between RNTI and their data
 
@@ -506,7 +506,7 @@ NrMacSchedulerOfdma::CreateDlDci (NrMacSchedulerNs3::PointInFTPlane *spoint,
                oss.str () << " for " << static_cast<uint32_t> (maxSym) << " SYM.");
 
 
-  std::shared_ptr<DciInfoElementTdma> dci = std::make_shared<DciInfoElementTdma>
+  std::shared_ptr<DciInfoElementTdma> dci = m_dciPool.Create
       (ueInfo->m_rnti, DciInfoElementTdma::DL, spoint->m_sym, maxSym, ueInfo->m_dlMcs,
        ueInfo->m_dlTbSize, ndi, rv, DciInfoElementTdma::DATA, GetBwpId (), GetTpc());
 
@@ -586,7 +586,7 @@ NrMacSchedulerOfdma::CreateUlDci (PointInFTPlane *spoint,
   std::vector<uint8_t> rv = {0};
 
   NS_ASSERT (spoint->m_sym >= maxSym);
-  std::shared_ptr<DciInfoElementTdma> dci = std::make_shared<DciInfoElementTdma>
+  std::shared_ptr<DciInfoElementTdma> dci = m_dciPool.Create
       (ueInfo->m_rnti, DciInfoElementTdma::UL, spoint->m_sym - maxSym, maxSym, ulMcs,
        ulTbs, ndi, rv, DciInfoElementTdma::DATA, GetBwpId (), GetTpc());
 
@@ -505,7 +505,7 @@ NrMacSchedulerTdma::CreateDci (NrMacSchedulerNs3::PointInFTPlane *spoint,
   NS_ASSERT (sumTbSize > 0);
   NS_ASSERT (numSym > 0);
 
-  std::shared_ptr<DciInfoElementTdma> dci = std::make_shared<DciInfoElementTdma>
+  std::shared_ptr<DciInfoElementTdma> dci = m_dciPool.Create
       (ueInfo->m_rnti, fmt, spoint->m_sym, numSym, mcs, tbs, ndi, rv, DciInfoElementTdma::DATA,
        GetBwpId (), GetTpc());
 
@@ -226,6 +226,66 @@ std::ostream &operator<<(std::ostream &os, const SlotAllocInfo::AllocationType &
   return os;
 }
 
+uint64_t NrDciPool::s_created = 0;
+uint64_t NrDciPool::s_heapAllocations = 0;
+
+NrDciPool::NrDciPool ()
+  : m_storage (std::make_shared<Storage> ())
+{
+}
+
+uint64_t
+NrDciPool::GetTotalCreated ()
+{
+  return s_created;
+}
+
+uint64_t
+NrDciPool::GetTotalHeapAllocations ()
+{
+  return s_heapAllocations;
+}
+
+NrDciPool::Storage::~Storage ()
+{
+  for (auto p : m_free)
+    {
+      ::operator delete (p);
+    }
+}
+
+void *
+NrDciPool::Storage::Get (std::size_t size)
+{
+  if (m_blockSize == 0)
+    {
+      m_blockSize = size;
+    }
+
+  if (size == m_blockSize && ! m_free.empty ())
+    {
+      void *p = m_free.back ();
+      m_free.pop_back ();
+      return p;
+    }
+
+  ++s_heapAllocations;
+  return ::operator new (size);
+}
+
+void
+NrDciPool::Storage::Put (void *p, std::size_t size)
+{
+  if (size == m_blockSize)
+    {
+      m_free.push_back (p);
+    }
+  else
+    {
+      ::operator delete (p);
+    }
+}
+
 std::ostream &operator<< (std::ostream &os, const DciInfoElementTdma &item)
 {
   os << "RNTI=" << item.m_rnti << "|" << item.m_format << "|SYM=" << +item.m_symStart
@@ -23,6 +23,9 @@
 #define SRC_NR_MODEL_NR_PHY_MAC_COMMON_H
 
 #include <vector>
+#include <array>
+#include <algorithm>
+#include <initializer_list>
 #include <list>
 #include <map>
 #include <unordered_map>
@@ -34,6 +37,7 @@
 #include <ns3/simulator.h>
 #include <ns3/component-carrier.h>
 #include <ns3/enum.h>
+#include <ns3/abort.h>
 #include <memory>
 #include <ns3/string.h>
 
@@ -136,6 +140,163 @@ struct TbInfoElement
   uint8_t m_harqProcess;
 };
 
+/**
+ * \ingroup utils
+ * \brief Fixed-capacity, inline storage for per-stream DCI values
+ *
+ * The DCI carries one MCS, TB size, NDI and RV value per stream, and the
+ * number of streams is at most NrStreamArray::MAX_STREAMS. Storing them
+ * inline avoids a heap allocation for each of these fields every time a DCI
+ * is built. The class mimics the subset of the std::vector interface used
+ * by the module, and it converts implicitly from and to std::vector, so
+ * the code that builds a DCI from vectors does not need to change.
+ */
+template <typename T>
+class NrStreamArray
+{
+public:
+  static constexpr uint8_t MAX_STREAMS = 2; //!< Maximum number of streams
+
+  using value_type = T;               //!< Value type
+  using size_type = std::size_t;      //!< Size type
+  using iterator = T*;                //!< Iterator
+  using const_iterator = const T*;    //!< Const iterator
+
+  /**
+   * \brief Empty array
+   */
+  NrStreamArray () = default;
+
+  /**
+   * \brief Array of n elements with value v
+   * \param n number of elements
+   * \param v value of the elements
+   */
+  explicit NrStreamArray (size_type n, const T &v = T ())
+  {
+    resize (n, v);
+  }
+
+  /**
+   * \brief Build the array from a vector (implicit on purpose)
+   * \param v the vector, of size at most MAX_STREAMS
+   */
+  NrStreamArray (const std::vector<T> &v)
+  {
+    NS_ABORT_MSG_IF (v.size () > MAX_STREAMS, "More than " << +MAX_STREAMS << " streams");
+    std::copy (v.begin (), v.end (), m_values.begin ());
+    m_size = static_cast<uint8_t> (v.size ());
+  }
+
+  /**
+   * \brief Build the array from an initializer list
+   * \param l the list, of size at most MAX_STREAMS
+   */
+  NrStreamArray (std::initializer_list<T> l)
+  {
+    NS_ABORT_MSG_IF (l.size () > MAX_STREAMS, "More than " << +MAX_STREAMS << " streams");
+    std::copy (l.begin (), l.end (), m_values.begin ());
+    m_size = static_cast<uint8_t> (l.size ());
+  }
+
+  /**
+   * \brief Convert the array into a vector
+   */
+  operator std::vector<T> () const
+  {
+    return std::vector<T> (begin (), end ());
+  }
+
+  size_type size () const { return m_size; }    //!< \return the number of elements
+  bool empty () const { return m_size == 0; }   //!< \return true if empty
+
+  iterator begin () { return m_values.data (); }                        //!< \return begin
+  iterator end () { return m_values.data () + m_size; }                 //!< \return end
+  const_iterator begin () const { return m_values.data (); }            //!< \return begin
+  const_iterator end () const { return m_values.data () + m_size; }     //!< \return end
+
+  /**
+   * \brief Bound-checked access
+   * \param i index
+   * \return a reference to the element i
+   */
+  T & at (size_type i)
+  {
+    NS_ABORT_MSG_IF (i >= m_size, "Stream index " << i << " out of range");
+    return m_values[i];
+  }
+  /**
+   * \brief Bound-checked access
+   * \param i index
+   * \return a const reference to the element i
+   */
+  const T & at (size_type i) const
+  {
+    NS_ABORT_MSG_IF (i >= m_size, "Stream index " << i << " out of range");
+    return m_values[i];
+  }
+
+  T & operator[] (size_type i) { return m_values[i]; }                //!< unchecked access
+  const T & operator[] (size_type i) const { return m_values[i]; }    //!< unchecked access
+
+  /**
+   * \brief Append an element
+   * \param v the value
+   */
+  void push_back (const T &v)
+  {
+    NS_ABORT_MSG_IF (m_size >= MAX_STREAMS, "More than " << +MAX_STREAMS << " streams");
+    m_values[m_size++] = v;
+  }
+
+  /**
+   * \brief Resize the array
+   * \param n new size
+   * \param v value of the added elements
+   */
+  void resize (size_type n, const T &v = T ())
+  {
+    NS_ABORT_MSG_IF (n > MAX_STREAMS, "More than " << +MAX_STREAMS << " streams");
+    for (size_type i = m_size; i < n; ++i)
+      {
+        m_values[i] = v;
+      }
+    m_size = static_cast<uint8_t> (n);
+  }
+
+  /**
+   * \brief Remove all the elements
+   */
+  void clear ()
+  {
+    m_size = 0;
+  }
+
+  /**
+   * \brief Element-wise comparison
+   * \param o other array
+   * \return true if the two arrays have the same size and values
+   */
+  bool operator== (const NrStreamArray<T> &o) const
+  {
+    return m_size == o.m_size && std::equal (begin (), end (), o.begin ());
+  }
+
+  /**
+   * \brief Element-wise comparison
+   * \param o other array
+   * \return true if the two arrays differ
+   */
+  bool operator!= (const NrStreamArray<T> &o) const
+  {
+    return ! (*this == o);
+  }
+
+private:
+  std::array<T, MAX_STREAMS> m_values {}; //!< Inline storage
+  uint8_t m_size {0};                     //!< Number of valid elements
+};
+
 /**
  * \ingroup utils
  * \brief Scheduling information. Despite the name, it is not TDMA.
@@ -191,9 +352,9 @@ struct DciInfoElementTdma
    * \param rv Redundancy Version per stream
    */
   DciInfoElementTdma (uint16_t rnti, DciFormat format, uint8_t symStart,
-                      uint8_t numSym, std::vector<uint8_t> mcs,
-                      std::vector<uint32_t> tbs, std::vector<uint8_t> ndi,
-                      std::vector<uint8_t> rv, VarTtiType type,
+                      uint8_t numSym, const NrStreamArray<uint8_t> &mcs,
+                      const NrStreamArray<uint32_t> &tbs, const NrStreamArray<uint8_t> &ndi,
+                      const NrStreamArray<uint8_t> &rv, VarTtiType type,
                       uint8_t bwpIndex, uint8_t tpc)
     : m_rnti (rnti), m_format (format), m_symStart (symStart),
     m_numSym (numSym), m_mcs (mcs), m_tbSize (tbs), m_ndi (ndi), m_rv (rv),
@@ -210,8 +371,8 @@ struct DciInfoElementTdma
    * \param rv Retransmission value
    * \param o Other object from which copy all that is not specified as parameter
    */
-  DciInfoElementTdma (uint8_t symStart, uint8_t numSym, std::vector<uint8_t> ndi,
-                      std::vector<uint8_t> rv, const DciInfoElementTdma &o)
+  DciInfoElementTdma (uint8_t symStart, uint8_t numSym, const NrStreamArray<uint8_t> &ndi,
+                      const NrStreamArray<uint8_t> &rv, const DciInfoElementTdma &o)
     : m_rnti (o.m_rnti),
       m_format (o.m_format),
       m_symStart (symStart),
@@ -232,10 +393,10 @@ struct DciInfoElementTdma
   const DciFormat m_format    {DL}; //!< DCI format
   const uint8_t m_symStart    {0}; //!< starting symbol index for flexible TTI scheme
   const uint8_t m_numSym      {0}; //!< number of symbols for flexible TTI scheme
-  const std::vector<uint8_t> m_mcs; //!< MCS per stream
-  const std::vector<uint32_t> m_tbSize; //!< TB size per stream
-  const std::vector<uint8_t> m_ndi; //!< New Data Indicator per stream (Old comment: By default is retransmission. Zoraze to check if it has any effect)
-  const std::vector<uint8_t> m_rv; //!< Redundancy Version per stream (Old comment: // not used for UL DCI. Zoraze to check why?)
+  const NrStreamArray<uint8_t> m_mcs; //!< MCS per stream
+  const NrStreamArray<uint32_t> m_tbSize; //!< TB size per stream
+  const NrStreamArray<uint8_t> m_ndi; //!< New Data Indicator per stream (Old comment: By default is retransmission. Zoraze to check if it has any effect)
+  const NrStreamArray<uint8_t> m_rv; //!< Redundancy Version per stream (Old comment: // not used for UL DCI. Zoraze to check why?)
   const VarTtiType m_type     {SRS}; //!< Var TTI type
   const uint8_t m_bwpIndex    {0}; //!< BWP Index to identify to which BWP this DCI applies to.
   uint8_t m_harqProcess       {0}; //!< HARQ process id
@@ -243,6 +404,143 @@ struct DciInfoElementTdma
   const uint8_t m_tpc         {0}; //!< Tx power control command
 };
 
+/**
+ * \ingroup utils
+ * \brief Recycling pool for DciInfoElementTdma
+ *
+ * A DCI is created for every DL/UL/CTRL/SRS allocation of every slot. The
+ * pool hands out std::shared_ptr<DciInfoElementTdma> whose memory block
+ * (object and reference counter) is taken from a free list, and put back
+ * in the list when the last reference goes away. Each entity that creates
+ * DCIs (UE PHY, gNB MAC, scheduler) owns its own pool; copies of a pool
+ * share the same free list. The memory is released when the pool and
+ * all the DCIs created through it are gone.
+ *
+ * The class keeps global counters of the created DCIs and of the memory
+ * blocks requested to the system, to evaluate the efficiency of the pool
+ * (e.g., see cttc-nr-demo).
+ */
+class NrDciPool
+{
+public:
+  /**
+   * \brief NrDciPool constructor
+   */
+  NrDciPool ();
+
+  /**
+   * \brief Create a DCI, forwarding the arguments to its constructor
+   * \param args the arguments of one of the DciInfoElementTdma constructors
+   * \return a pointer to the new DCI
+   */
+  template <typename... Args>
+  std::shared_ptr<DciInfoElementTdma> Create (Args&&... args) const
+  {
+    ++s_created;
+    return std::allocate_shared<DciInfoElementTdma> (Allocator<DciInfoElementTdma> (m_storage),
+                                                     std::forward<Args> (args)...);
+  }
+
+  /**
+   * \return the number of DCIs created through any pool since the start
+   */
+  static uint64_t GetTotalCreated ();
+
+  /**
+   * \return the number of memory blocks requested to the system by any pool
+   * since the start
+   */
+  static uint64_t GetTotalHeapAllocations ();
+
+private:
+  /**
+   * \brief Free list of memory blocks of the same size
+   */
+  class Storage
+  {
+  public:
+    /**
+     * \brief ~Storage: release the free blocks
+     */
+    ~Storage ();
+    /**
+     * \brief Get a block of the specified size
+     * \param size the size in bytes
+     * \return a pointer to the block
+     */
+    void * Get (std::size_t size);
+    /**
+     * \brief Give back a block obtained with Get ()
+     * \param p the block
+     * \param size its size in bytes
+     */
+    void Put (void *p, std::size_t size);
+
+  private:
+    std::vector<void*> m_free;    //!< Free blocks
+    std::size_t m_blockSize {0};  //!< Size of the pooled blocks
+  };
+
+  /**
+   * \brief Minimal allocator over Storage, used by std::allocate_shared
+   */
+  template <typename T>
+  class Allocator
+  {
+  public:
+    using value_type = T; //!< Value type
+
+    /**
+     * \brief Allocator constructor
+     * \param storage the storage
+     */
+    explicit Allocator (const std::shared_ptr<Storage> &storage) : m_storage (storage)
+    {
+    }
+
+    /**
+     * \brief Rebind constructor
+     * \param o the other allocator
+     */
+    template <typename U>
+    Allocator (const Allocator<U> &o) : m_storage (o.m_storage)
+    {
+    }
+
+    /**
+     * \brief Allocate memory for n objects
+     * \param n number of objects
+     * \return the memory
+     */
+    T * allocate (std::size_t n)
+    {
+      return static_cast<T*> (m_storage->Get (n * sizeof (T)));
+    }
+
+    /**
+     * \brief Deallocate memory
+     * \param p the memory
+     * \param n number of objects
+     */
+    void deallocate (T *p, std::size_t n)
+    {
+      m_storage->Put (p, n * sizeof (T));
+    }
+
+    template <typename U>
+    bool operator== (const Allocator<U> &o) const { return m_storage == o.m_storage; } //!< equality
+    template <typename U>
+    bool operator!= (const Allocator<U> &o) const { return m_storage != o.m_storage; } //!< inequality
+
+    std::shared_ptr<Storage> m_storage; //!< The storage
+  };
+
+  std::shared_ptr<Storage> m_storage; //!< The storage shared by the copies of this pool
+
+  static uint64_t s_created;          //!< Number of DCIs created
+  static uint64_t s_heapAllocations;  //!< Number of blocks requested to the system
+};
+
 /**
  * \ingroup utils
  * \brief The TbAllocInfo struct
@@ -146,6 +146,18 @@ public:
    */
   virtual uint32_t GetRbNum () const = 0;
 
+  /**
+   * \brief Tell the PHY that the MAC needs the next slot indication
+   *
+   * A UE PHY may stop its slot loop while it has nothing to do (see the
+   * NrUePhy attribute IdleSlotElision). The MAC calls this method when it
+   * has some work for the next slot that the PHY cannot see (e.g., a
+   * scheduling request to send), so that the loop is restarted.
+   */
+  virtual void ResumeSlotIndications ()
+  {
+  }
+
 };
 
 /**
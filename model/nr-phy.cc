@@ -72,6 +72,8 @@ public:
 
   virtual uint32_t GetRbNum () const override;
 
+  virtual void ResumeSlotIndications () override;
+
 private:
   NrPhy* m_phy;
 };
@@ -154,6 +156,12 @@ NrMemberPhySapProvider::GetRbNum () const
   return m_phy->GetRbNum ();
 }
 
+void
+NrMemberPhySapProvider::ResumeSlotIndications ()
+{
+  m_phy->ResumeSlotLoop ();
+}
+
 /* ======= */
 
 TypeId
@@ -448,11 +456,18 @@ NrPhy::GetPowerAllocationType () const
   return m_powerAllocationType;
 }
 
+void
+NrPhy::ResumeSlotLoop ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
 void
 NrPhy::EnqueueCtrlMessage (const Ptr<NrControlMessage> &m)
 {
   NS_LOG_FUNCTION (this);
 
+  ResumeSlotLoop ();
   m_controlMessageQueue.at (m_controlMessageQueue.size () - 1).push_back (m);
 }
 
@@ -461,12 +476,14 @@ NrPhy::EnqueueCtrlMsgNow (const Ptr<NrControlMessage> &msg)
 {
   NS_LOG_FUNCTION (this);
 
+  ResumeSlotLoop ();
   m_controlMessageQueue.at (0).push_back (msg);
 }
 
 void
 NrPhy::EnqueueCtrlMsgNow (const std::list<Ptr<NrControlMessage> > &listOfMsgs)
 {
+  ResumeSlotLoop ();
   for (const auto & msg : listOfMsgs)
     {
       m_controlMessageQueue.at (0).push_back (msg);
@@ -862,6 +879,20 @@ NrPhy::IsCtrlMsgListEmpty() const
   return m_controlMessageQueue.empty () || m_controlMessageQueue.at (0).empty();
 }
 
+bool
+NrPhy::IsCtrlMsgQueueEmpty () const
+{
+  NS_LOG_FUNCTION (this);
+  for (const auto & msgs : m_controlMessageQueue)
+    {
+      if (!msgs.empty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
 Ptr<const SpectrumModel>
 NrPhy::GetSpectrumModel ()
 {
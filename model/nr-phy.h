@@ -142,6 +142,15 @@ public:
    */
   void NotifyConnectionSuccessful ();
 
+  /**
+   * \brief Restart the slot loop, if it was suspended
+   *
+   * Called before enqueueing a CTRL message and when the MAC asks for the
+   * next slot indication. The default implementation does nothing, as only
+   * the UE PHY can suspend its slot loop.
+   */
+  virtual void ResumeSlotLoop ();
+
   /**
    * \brief Configures TB decode latency
    * \param us decode latency
@@ -545,6 +554,12 @@ protected:
    */
   bool IsCtrlMsgListEmpty () const;
 
+  /**
+   * \brief Check if there are no control messages queued for any slot
+   * \return true if the whole CTRL message queue is empty
+   */
+  bool IsCtrlMsgQueueEmpty () const;
+
   /**
    * \brief Enqueue a CTRL message without considering L1L2CtrlLatency
    * \param msg The message to enqueue
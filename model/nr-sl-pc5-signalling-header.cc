@@ -38,6 +38,7 @@
 #include <ns3/buffer.h>
 #include "nr-sl-pc5-signalling-header.h"
 #include "ns3/uinteger.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -51,25 +52,25 @@ NS_OBJECT_ENSURE_REGISTERED (ProseDirectLinkEstablishmentReject);
 // Initialize static member
 uint8_t NrPc5SignallingHeaderSequenceNumber::s_seqNum = 0;
 
-/** Size of the Nonce field */
-static const uint8_t NonceSize = 16;
+const uint8_t ProseDirectLinkEstablishmentRequest::MaxProseAppIds;
+const uint8_t ProseDirectLinkEstablishmentRequest::MaxSecCapabilitiesSize;
+const uint8_t ProseDirectLinkEstablishmentRequest::NonceSize;
+const uint8_t ProseDirectLinkEstablishmentAccept::LinkLocalIpv6AddressSize;
 
-/** Size of the link local IPv6 address field */
-static const uint8_t LinkLocalIpv6AddressSize = 16;
-
-/** Map message type value to acronym */
-static const std::vector<std::string> s_acronyms
+/** Acronym and name of a message type */
+struct Pc5SignallingMessageInfo
 {
-  "None", "PDL-Es-Rq", "PDL-Es-Ac", "PDL-Es-Rj"
+  const char *acronym; ///< Message acronym
+  const char *name;    ///< Message name
 };
 
-/** Map message type value to string name */
-static const std::vector<std::string> s_names
+/** Map message type value to acronym and name */
+static const Pc5SignallingMessageInfo s_messageInfo [NrSlPc5SignallingMessageType::NumMessageTypes] =
 {
-  "None",
-  "PROSE DIRECT LINK ESTABLISHMENT REQUEST",
-  "PROSE DIRECT LINK ESTABLISHMENT ACCEPT",
-  "PROSE DIRECT LINK ESTABLISHMENT REJECT"
+  {"None", "None"},
+  {"PDL-Es-Rq", "PROSE DIRECT LINK ESTABLISHMENT REQUEST"},
+  {"PDL-Es-Ac", "PROSE DIRECT LINK ESTABLISHMENT ACCEPT"},
+  {"PDL-Es-Rj", "PROSE DIRECT LINK ESTABLISHMENT REJECT"}
 };
 
 /*****     NrSlPc5SignallingMessageType : To peek at the first byte of the received message and identify the type       *****/
@@ -137,13 +138,15 @@ NrSlPc5SignallingMessageType::GetMessageType ()
 std::string
 NrSlPc5SignallingMessageType::GetMessageAcronym (void) const
 {
-  return s_acronyms[m_msgType];
+  NS_ASSERT_MSG (m_msgType < NumMessageTypes, "Unknown message type " << +m_msgType);
+  return s_messageInfo[m_msgType].acronym;
 }
 
 std::string
 NrSlPc5SignallingMessageType::GetMessageName (void) const
 {
-  return s_names[m_msgType];
+  NS_ASSERT_MSG (m_msgType < NumMessageTypes, "Unknown message type " << +m_msgType);
+  return s_messageInfo[m_msgType].name;
 }
 
 void
@@ -172,16 +175,15 @@ ProseDirectLinkEstablishmentRequest::ProseDirectLinkEstablishmentRequest ()
 {
   m_msgId = 1;
   m_seqNum = 0;
-  m_proseAppIds.clear ();
-  m_proseAppIds.assign (1, 0);
+  m_proseAppIds.fill (0);
+  m_numProseAppIds = 1;
   m_srcUserInfo = 0;
-  m_secCapabilities.clear ();
-  m_secCapabilities.assign (2, 0);
+  m_secCapabilities.fill (0);
+  m_secCapabilitiesSize = 2;
   m_ueSigSecPolicy = 0;
   m_keyEsInfoContainer = 0;
   m_hasKeyEsInfoContainer = false;
-  m_nonce1.clear ();
-  m_nonce1.assign (NonceSize, 0);
+  m_nonce1.fill (0);
   m_hasNonce1 = false;
   m_msb = 0;
   m_hasMsb = false;
@@ -219,15 +221,15 @@ ProseDirectLinkEstablishmentRequest::Print (std::ostream &os) const
   os << "msgId: " << (uint16_t) m_msgId << " "
      << "seqNum: " << +m_seqNum << " ";
   os << " proseAppIds: ";
-  for (std::vector<uint32_t>::const_iterator it = m_proseAppIds.begin (); it != m_proseAppIds.end (); ++it)
+  for (uint8_t index = 0; index < m_numProseAppIds; index++)
     {
-      os << (*it) << " ";
+      os << m_proseAppIds[index] << " ";
     }
   os << "srcUserInfo: " << m_srcUserInfo << " ";
   os << "secCapabilities: ";
-  for (std::vector<uint8_t>::const_iterator it = m_secCapabilities.begin (); it != m_secCapabilities.end (); ++it)
+  for (uint8_t index = 0; index < m_secCapabilitiesSize; index++)
     {
-      os << +(*it) << " ";
+      os << +m_secCapabilities[index] << " ";
     }
   os << "ueSigSecPolicy: " << +m_ueSigSecPolicy << " ";
   if (m_hasKeyEsInfoContainer)
@@ -237,9 +239,9 @@ ProseDirectLinkEstablishmentRequest::Print (std::ostream &os) const
   if (m_hasNonce1)
     {
       os << " nonce1: ";
-      for (std::vector<uint8_t>::const_iterator it = m_nonce1.begin (); it != m_nonce1.end (); ++it)
+      for (uint8_t octet : m_nonce1)
         {
-          os << +(*it) << " ";
+          os << +octet << " ";
         }
     }
   if (m_hasMsb)
@@ -269,13 +271,13 @@ ProseDirectLinkEstablishmentRequest::GetSerializedSize (void) const
     + sizeof (m_seqNum)
     + 1   // ProSe application identifier IEI octet
     + 1   // Length of ProSe application identifier content octet
-    + m_proseAppIds.size () * sizeof (uint32_t)  //ProSe application identifier contents
+    + m_numProseAppIds * sizeof (uint32_t)  //ProSe application identifier contents
     + 1   // Application layer ID IEI octet (Source user info)
     + 1   // Length of Application layer ID content octet (Source user info)
     + sizeof (m_srcUserInfo)   // Application layer ID contents (Source user info)
     + 1   // UE security capabilities  IEI octet
     + 1   // Length of UE security capabilities  content octet
-    + m_secCapabilities.size () * sizeof (uint8_t)  //UE security capabilities contents
+    + m_secCapabilitiesSize  //UE security capabilities contents
     + 1   // UE PC5 unicast signalling security policy IEI octet
     + sizeof (m_ueSigSecPolicy);   // UE PC5 unicast signalling security policy
   if (m_hasKeyEsInfoContainer)
@@ -328,12 +330,12 @@ ProseDirectLinkEstablishmentRequest::Serialize (Buffer::Iterator start) const
   i.WriteU8 (m_seqNum);
 
   i.WriteU8 (0); // ProSe application identifier IEI octet //TODO: Not defined in the standard ATM
-  i.WriteU8 (m_proseAppIds.size () * sizeof (uint32_t)); // Length of ProSe application identifier content octet
+  i.WriteU8 (m_numProseAppIds * sizeof (uint32_t)); // Length of ProSe application identifier content octet
 
   // ProSe application identifier content:
-  for (std::vector<uint32_t>::const_iterator it = m_proseAppIds.begin (); it != m_proseAppIds.end (); ++it)
+  for (uint8_t index = 0; index < m_numProseAppIds; index++)
     {
-      i.WriteU32 (*it);
+      i.WriteU32 (m_proseAppIds[index]);
     }
 
   i.WriteU8 (0); // Application layer ID IEI octet (Source user info) //TODO: Not defined in the standard ATM
@@ -341,13 +343,8 @@ ProseDirectLinkEstablishmentRequest::Serialize (Buffer::Iterator start) const
   i.WriteU32 (m_srcUserInfo); // Application layer ID contents (Source user info)
 
   i.WriteU8 (0); // UE security capabilities  IEI octet //TODO: Not defined in the standard ATM
-  i.WriteU8 (m_secCapabilities.size () * sizeof (uint8_t)); // Length of UE security capabilities  content octet
-
-  //UE security capabilities contents:
-  for (std::vector<uint8_t>::const_iterator it = m_secCapabilities.begin (); it != m_secCapabilities.end (); ++it)
-    {
-      i.WriteU8 (*it);
-    }
+  i.WriteU8 (m_secCapabilitiesSize); // Length of UE security capabilities  content octet
+  i.Write (m_secCapabilities.data (), m_secCapabilitiesSize); //UE security capabilities contents
 
   i.WriteU8 (0); // UE PC5 unicast signalling security policy IEI octet //TODO: Not defined in the standard ATM
   i.WriteU8 (m_ueSigSecPolicy); // UE PC5 unicast signalling security policy
@@ -361,11 +358,7 @@ ProseDirectLinkEstablishmentRequest::Serialize (Buffer::Iterator start) const
   if (m_hasNonce1)
     {
       i.WriteU8 (53); // Nonce IEI octet
-      // // Nonce IEI contents:
-      for (std::vector<uint8_t>::const_iterator it = m_nonce1.begin (); it != m_nonce1.end (); ++it)
-        {
-          i.WriteU8 (*it);
-        }
+      i.Write (m_nonce1.data (), NonceSize); // Nonce IEI contents
     }
   if (m_hasMsb)
     {
@@ -404,8 +397,9 @@ ProseDirectLinkEstablishmentRequest::Deserialize (Buffer::Iterator start)
 
   i.ReadU8 ();// ProSe application identifier IEI octet
   size_in_bytes = i.ReadU8 (); // Length of ProSe application identifier content octet
+  m_numProseAppIds = size_in_bytes / sizeof (uint32_t);
   // ProSe application identifier content:
-  for (uint8_t index = 0; index < (size_in_bytes / sizeof (uint32_t)); index++)
+  for (uint8_t index = 0; index < m_numProseAppIds; index++)
     {
       m_proseAppIds[index] = i.ReadU32 ();
     }
@@ -416,11 +410,10 @@ ProseDirectLinkEstablishmentRequest::Deserialize (Buffer::Iterator start)
 
   i.ReadU8 ();  // UE security capabilities  IEI octet
   size_in_bytes = i.ReadU8 ();  // Length of UE security capabilities content octet
-  // UE security capabilities contents:
-  for (uint8_t index = 0; index < size_in_bytes; index++)
-    {
-      m_secCapabilities[index] = i.ReadU8 ();
-    }
+  NS_ABORT_MSG_IF (size_in_bytes > MaxSecCapabilitiesSize,
+                   "Invalid UE security capabilities length " << +size_in_bytes);
+  m_secCapabilitiesSize = size_in_bytes;
+  i.Read (m_secCapabilities.data (), m_secCapabilitiesSize); // UE security capabilities contents
 
   i.ReadU8 ();// UE PC5 unicast signalling security policy IEI octet
   m_ueSigSecPolicy =  i.ReadU8 (); // UE PC5 unicast signalling security policy
@@ -439,10 +432,7 @@ ProseDirectLinkEstablishmentRequest::Deserialize (Buffer::Iterator start)
             m_hasKeyEsInfoContainer = true;
             break;
           case 53: // Nonce IEI
-            for (uint8_t index = 0; index < NonceSize; index++)
-              {
-                m_nonce1[index] = i.ReadU8 ();
-              }
+            i.Read (m_nonce1.data (), NonceSize);
             m_hasNonce1 = true;
             break;
           case 54: // Most significant bits of the KNRP-sess ID IEI
@@ -480,12 +470,12 @@ ProseDirectLinkEstablishmentRequest::Deserialize (Buffer::Iterator start)
 void
 ProseDirectLinkEstablishmentRequest::SetParameters (
   uint8_t seq,
-  std::vector<uint32_t> proseAppIds,
+  const std::vector<uint32_t> &proseAppIds,
   uint32_t srcUserInfo,
-  std::vector<uint8_t> secCapabilities,
+  const std::vector<uint8_t> &secCapabilities,
   uint8_t ueSigSecPolicy,
   uint8_t keyEsInfoContainer,
-  std::vector<uint8_t> nonce1,
+  const std::vector<uint8_t> &nonce1,
   uint8_t msb,
   uint32_t tgtUserInfo,
   uint32_t knrpId,
@@ -546,20 +536,18 @@ ProseDirectLinkEstablishmentRequest::SetSequenceNumber (uint8_t seq)
 }
 
 void
-ProseDirectLinkEstablishmentRequest::SetProseApplicationIds (std::vector<uint32_t> proseAppIds)
+ProseDirectLinkEstablishmentRequest::SetProseApplicationIds (const std::vector<uint32_t> &proseAppIds)
 {
-  m_proseAppIds.clear ();
-  m_proseAppIds.assign (proseAppIds.size (), 0);
-  for (uint16_t i = 0; i < proseAppIds.size (); i++)
-    {
-      m_proseAppIds[i] = proseAppIds[i];
-    }
+  NS_ABORT_MSG_IF (proseAppIds.size () > MaxProseAppIds,
+                   "At most " << +MaxProseAppIds << " ProSe application identifiers are supported");
+  std::copy (proseAppIds.begin (), proseAppIds.end (), m_proseAppIds.begin ());
+  m_numProseAppIds = static_cast<uint8_t> (proseAppIds.size ());
 }
 
 std::vector<uint32_t>
 ProseDirectLinkEstablishmentRequest::GetProseApplicationIds ()
 {
-  return m_proseAppIds;
+  return std::vector<uint32_t> (m_proseAppIds.begin (), m_proseAppIds.begin () + m_numProseAppIds);
 }
 
 void
@@ -575,20 +563,18 @@ ProseDirectLinkEstablishmentRequest::GetSourceUserInfo ()
 }
 
 void
-ProseDirectLinkEstablishmentRequest::SetUeSecurityCapabilities (std::vector<uint8_t> secCapabilities)
+ProseDirectLinkEstablishmentRequest::SetUeSecurityCapabilities (const std::vector<uint8_t> &secCapabilities)
 {
-  m_secCapabilities.clear ();
-  m_secCapabilities.assign (secCapabilities.size (), 0);
-  for (uint16_t i = 0; i < secCapabilities.size (); i++)
-    {
-      m_secCapabilities[i] = secCapabilities[i];
-    }
+  NS_ABORT_MSG_IF (secCapabilities.size () > MaxSecCapabilitiesSize,
+                   "The UE security capabilities are at most " << +MaxSecCapabilitiesSize << " octets");
+  std::copy (secCapabilities.begin (), secCapabilities.end (), m_secCapabilities.begin ());
+  m_secCapabilitiesSize = static_cast<uint8_t> (secCapabilities.size ());
 }
 
 std::vector<uint8_t>
 ProseDirectLinkEstablishmentRequest::GetUeSecurityCapabilities ()
 {
-  return m_secCapabilities;
+  return std::vector<uint8_t> (m_secCapabilities.begin (), m_secCapabilities.begin () + m_secCapabilitiesSize);
 }
 
 void
@@ -617,20 +603,18 @@ ProseDirectLinkEstablishmentRequest::GetKeyEstablishmentInfoContainer ()
 }
 
 void
-ProseDirectLinkEstablishmentRequest::SetNonce1 (std::vector<uint8_t> nonce1)
+ProseDirectLinkEstablishmentRequest::SetNonce1 (const std::vector<uint8_t> &nonce1)
 {
+  NS_ABORT_MSG_IF (nonce1.size () > NonceSize, "The nonce is " << +NonceSize << " octets");
   m_hasNonce1 = true;
-  m_nonce1.assign (NonceSize, 0);
-  for (uint16_t i = 0; i < nonce1.size (); i++)
-    {
-      m_nonce1[i] = nonce1[i];
-    }
+  m_nonce1.fill (0);
+  std::copy (nonce1.begin (), nonce1.end (), m_nonce1.begin ());
 }
 
 std::vector<uint8_t>
 ProseDirectLinkEstablishmentRequest::GetNonce1 ()
 {
-  return m_nonce1;
+  return std::vector<uint8_t> (m_nonce1.begin (), m_nonce1.end ());
 }
 
 void
@@ -700,8 +684,7 @@ ProseDirectLinkEstablishmentAccept::ProseDirectLinkEstablishmentAccept ()
   m_hasIpAddressConfig = false;
   m_ipAddressConfig = 0;
   m_hasLinkLocalIpv6Address = false;
-  m_linkLocalIpv6Address.clear ();
-  m_linkLocalIpv6Address.assign (LinkLocalIpv6AddressSize, 0);
+  m_linkLocalIpv6Address.fill (0);
 }
 
 ProseDirectLinkEstablishmentAccept::~ProseDirectLinkEstablishmentAccept ()
@@ -742,9 +725,9 @@ ProseDirectLinkEstablishmentAccept::Print (std::ostream &os) const
   if (m_hasLinkLocalIpv6Address)
     {
       os << " linkLocalIpv6Address: ";
-      for (std::vector<uint8_t>::const_iterator it = m_linkLocalIpv6Address.begin (); it != m_linkLocalIpv6Address.end (); ++it)
+      for (uint8_t octet : m_linkLocalIpv6Address)
         {
-          os << +(*it) << " ";
+          os << +octet << " ";
         }
     }
 }
@@ -794,12 +777,7 @@ ProseDirectLinkEstablishmentAccept::Serialize (Buffer::Iterator start) const
 
   i.WriteU8 (0); // PC5 QoS flow descriptions IEI //TODO: Not defined in the standard ATM
   i.WriteU16 (m_qosFlowDescriptions.size () * sizeof (uint8_t));// PC5 QoS flow descriptions contents length
-
-  //UE security capabilities contents:
-  for (std::vector<uint8_t>::const_iterator it = m_qosFlowDescriptions.begin (); it != m_qosFlowDescriptions.end (); ++it)
-    {
-      i.WriteU8 (*it);
-    }
+  i.Write (m_qosFlowDescriptions.data (), m_qosFlowDescriptions.size ()); // PC5 QoS flow descriptions contents
 
   i.WriteU8 (0); // Configuration of UE PC5 unicast user plane security protection IEI //TODO: Not defined in the standard ATM
   i.WriteU8 (m_userPlaneSecConfig); // Configuration of UE PC5 unicast user plane security protectio contents
@@ -812,10 +790,7 @@ ProseDirectLinkEstablishmentAccept::Serialize (Buffer::Iterator start) const
   if (m_hasLinkLocalIpv6Address)
     {
       i.WriteU8 (58);
-      for (std::vector<uint8_t>::const_iterator it = m_linkLocalIpv6Address.begin (); it != m_linkLocalIpv6Address.end (); ++it)
-        {
-          i.WriteU8 (*it);
-        }
+      i.Write (m_linkLocalIpv6Address.data (), LinkLocalIpv6AddressSize);
     }
 }
 
@@ -834,11 +809,8 @@ ProseDirectLinkEstablishmentAccept::Deserialize (Buffer::Iterator start)
 
   i.ReadU8 (); // PC5 QoS flow descriptions IEI
   uint16_t size_in_bytes = i.ReadU16 (); // PC5 QoS flow descriptions length
-  // PC5 QoS flow descriptions contents:
-  for (uint8_t index = 0; index < size_in_bytes; index++)
-    {
-      m_qosFlowDescriptions[index] = i.ReadU8 ();
-    }
+  m_qosFlowDescriptions.resize (size_in_bytes);
+  i.Read (m_qosFlowDescriptions.data (), size_in_bytes); // PC5 QoS flow descriptions contents
 
   i.ReadU8 (); // Configuration of UE PC5 unicast user plane security protection IEI
   m_userPlaneSecConfig = i.ReadU8 (); // Configuration of UE PC5 unicast user plane security protection contents
@@ -854,10 +826,7 @@ ProseDirectLinkEstablishmentAccept::Deserialize (Buffer::Iterator start)
             m_hasIpAddressConfig = true;
             break;
           case 58: // link-local IPv6 address IEI
-            for (uint8_t index = 0; index < LinkLocalIpv6AddressSize; index++)
-              {
-                m_linkLocalIpv6Address[index] = i.ReadU8 ();
-              }
+            i.Read (m_linkLocalIpv6Address.data (), LinkLocalIpv6AddressSize);
             m_hasLinkLocalIpv6Address = true;
             break;
           default:
@@ -872,10 +841,10 @@ void
 ProseDirectLinkEstablishmentAccept::SetParameters (
   uint8_t seq,
   uint32_t srcUserInfo,
-  std::vector<uint8_t> qosFlowDescriptions,
+  const std::vector<uint8_t> &qosFlowDescriptions,
   uint8_t userPlaneSecConfig,
   uint8_t ipAddressConfig,
-  std::vector<uint8_t> linkLocalIpv6Address)
+  const std::vector<uint8_t> &linkLocalIpv6Address)
 {
   SetSequenceNumber (seq);
   SetSourceUserInfo (srcUserInfo);
@@ -916,14 +885,9 @@ ProseDirectLinkEstablishmentAccept::GetSourceUserInfo ()
 }
 
 void
-ProseDirectLinkEstablishmentAccept::SetPc5QoSFlowDescriptions (std::vector<uint8_t> qosFlowDescriptions)
+ProseDirectLinkEstablishmentAccept::SetPc5QoSFlowDescriptions (const std::vector<uint8_t> &qosFlowDescriptions)
 {
-  m_qosFlowDescriptions.clear ();
-  m_qosFlowDescriptions.assign (qosFlowDescriptions.size (), 0);
-  for (uint16_t i = 0; i < qosFlowDescriptions.size (); i++)
-    {
-      m_qosFlowDescriptions[i] = qosFlowDescriptions[i];
-    }
+  m_qosFlowDescriptions = qosFlowDescriptions;
 }
 
 std::vector<uint8_t>
@@ -958,21 +922,19 @@ ProseDirectLinkEstablishmentAccept::GetIpAddressConfig ()
 }
 
 void
-ProseDirectLinkEstablishmentAccept::SetLinkLocalIpv6Address (std::vector<uint8_t> linkLocalIpv6Address)
+ProseDirectLinkEstablishmentAccept::SetLinkLocalIpv6Address (const std::vector<uint8_t> &linkLocalIpv6Address)
 {
+  NS_ABORT_MSG_IF (linkLocalIpv6Address.size () > LinkLocalIpv6AddressSize,
+                   "The link-local IPv6 address is " << +LinkLocalIpv6AddressSize << " octets");
   m_hasLinkLocalIpv6Address = true;
-  m_linkLocalIpv6Address.clear ();
-  m_linkLocalIpv6Address.assign (LinkLocalIpv6AddressSize,0);
-  for (uint16_t i = 0; i < linkLocalIpv6Address.size (); i++)
-    {
-      m_linkLocalIpv6Address[i] = linkLocalIpv6Address[i];
-    }
+  m_linkLocalIpv6Address.fill (0);
+  std::copy (linkLocalIpv6Address.begin (), linkLocalIpv6Address.end (), m_linkLocalIpv6Address.begin ());
 }
 
 std::vector<uint8_t>
 ProseDirectLinkEstablishmentAccept::GetLinkLocalIpv6Address ()
 {
-  return m_linkLocalIpv6Address;
+  return std::vector<uint8_t> (m_linkLocalIpv6Address.begin (), m_linkLocalIpv6Address.end ());
 }
 
 
@@ -38,6 +38,7 @@
 
 #include "ns3/header.h"
 #include <stdint.h>
+#include <array>
 #include <vector>
 #include "ns3/string.h"
 
@@ -142,7 +143,8 @@ public:
   {
     ProseDirectLinkEstablishmentRequest = 1,
     ProseDirectLinkEstablishmentAccept,
-    ProseDirectLinkEstablishmentReject
+    ProseDirectLinkEstablishmentReject,
+    NumMessageTypes  ///< Number of message types (None included), not a valid type
   };
 
 private:
@@ -187,6 +189,16 @@ public:
 class ProseDirectLinkEstablishmentRequest : public Header
 {
 public:
+  /**
+   * Maximum number of ProSe application identifiers, limited by the length
+   * octet of the IE (4 octets each ID)
+   */
+  static const uint8_t MaxProseAppIds = 63;
+  /// Maximum size of the UE security capabilities contents, in octets
+  static const uint8_t MaxSecCapabilitiesSize = 8;
+  /// Size of the Nonce_1 contents, in octets
+  static const uint8_t NonceSize = 16;
+
   /**
    * Default constructor
     */
@@ -257,9 +269,9 @@ public:
    * \param knrpId carries the identity of the Knrp of the target UE.
    * \param relayServiceCode parameter that identifies a connectivity service the UE-to-Network relay provides.
    */
-  void SetParameters (uint8_t seq, std::vector<uint32_t> proseAppIds, uint32_t srcUserInfo,
-                      std::vector<uint8_t> secCapabilities, uint8_t ueSigSecPolicy, uint8_t keyEsInfoContainer,
-                      std::vector<uint8_t> nonce1, uint8_t msb, uint32_t tgtUserInfo, uint32_t knrpId,
+  void SetParameters (uint8_t seq, const std::vector<uint32_t> &proseAppIds, uint32_t srcUserInfo,
+                      const std::vector<uint8_t> &secCapabilities, uint8_t ueSigSecPolicy, uint8_t keyEsInfoContainer,
+                      const std::vector<uint8_t> &nonce1, uint8_t msb, uint32_t tgtUserInfo, uint32_t knrpId,
                       uint32_t relayServiceCode);
 
   /**
@@ -287,7 +299,7 @@ public:
    *
    * \param proseAppIds the identifiers of the ProSe applications
    */
-  void SetProseApplicationIds (std::vector<uint32_t> proseAppIds);
+  void SetProseApplicationIds (const std::vector<uint32_t> &proseAppIds);
 
   /**
     * Get the identifiers of the ProSe application
@@ -315,7 +327,7 @@ public:
    *
    * \param secCapabilities the supported security algorithms
    */
-  void SetUeSecurityCapabilities ( std::vector<uint8_t> secCapabilities);
+  void SetUeSecurityCapabilities (const std::vector<uint8_t> &secCapabilities);
 
   /**
   * Get the supported security algorithms
@@ -359,7 +371,7 @@ public:
    *
    * \param nonce1 the nonce value
    */
-  void SetNonce1 (std::vector<uint8_t> nonce1);
+  void SetNonce1 (const std::vector<uint8_t> &nonce1);
 
   /**
   * Get the nonce1 value
@@ -432,15 +444,17 @@ private:
   // Mandatory IEs
   uint8_t m_msgId;   ///< Message identity
   uint8_t m_seqNum;  ///< Sequence number
-  std::vector<uint32_t> m_proseAppIds;   ///< ProSe application identifier contents (4 octets each ID, min 1 ID) No max defined in standard ATM
+  std::array<uint32_t, MaxProseAppIds> m_proseAppIds;   ///< ProSe application identifier contents (4 octets each ID, min 1 ID) No max defined in standard ATM
+  uint8_t m_numProseAppIds;  ///< Number of valid entries of m_proseAppIds
   uint32_t m_srcUserInfo;   ///< Source user info contents (Format 'Application layer ID', assumed with min 4 octets) No min defined in standard ATM
-  std::vector<uint8_t> m_secCapabilities;    ///< UE security capabilities contents (min 2 octets, max 8 octets)
+  std::array<uint8_t, MaxSecCapabilitiesSize> m_secCapabilities;    ///< UE security capabilities contents (min 2 octets, max 8 octets)
+  uint8_t m_secCapabilitiesSize;  ///< Number of valid octets of m_secCapabilities
   uint8_t m_ueSigSecPolicy; ///< UE PC5 unicast signalling security policy (1 octet)
 
   // Optional IEs
   uint8_t m_keyEsInfoContainer; ///< Key establishment information container contents (using min of 1 octets)
   bool m_hasKeyEsInfoContainer; ///< Flag indicating if the Key establishment information container is present
-  std::vector<uint8_t> m_nonce1; ///< Nonce_1 (128 bit = 16 octets)
+  std::array<uint8_t, NonceSize> m_nonce1; ///< Nonce_1 (128 bit = 16 octets)
   bool m_hasNonce1;  ///< Flag indicating if Nonce_1 is present
   uint8_t m_msb;  ///< Most significant bits of the KNRP-sess ID contents (1 octect)
   bool m_hasMsb;  ///< Flag indicating if the most significant bits of the KNRP-sess ID is present
@@ -463,6 +477,9 @@ private:
 class ProseDirectLinkEstablishmentAccept : public Header
 {
 public:
+  /// Size of the link-local IPv6 address contents, in octets
+  static const uint8_t LinkLocalIpv6AddressSize = 16;
+
   /**
    * Default constructor
    */
@@ -531,10 +548,10 @@ public:
   void SetParameters (
     uint8_t seq,
     uint32_t srcUserInfo,
-    std::vector<uint8_t> qosFlowDescriptions,
+    const std::vector<uint8_t> &qosFlowDescriptions,
     uint8_t userPlaneSecConfig,
     uint8_t ipAddressConfig,
-    std::vector<uint8_t> linkLocalIpv6Address);
+    const std::vector<uint8_t> &linkLocalIpv6Address);
 
   /**
    * Get the Message Identifier
@@ -575,7 +592,7 @@ public:
    *
    * \param qosFlowDescriptions PC5 QoS flow descriptions
    */
-  void SetPc5QoSFlowDescriptions (std::vector<uint8_t> qosFlowDescriptions);
+  void SetPc5QoSFlowDescriptions (const std::vector<uint8_t> &qosFlowDescriptions);
 
   /**
    * Get PC5 QoS flow descriptions
@@ -619,7 +636,7 @@ public:
    *
    * \param linkLocalIpv6Address link-local IPv6 address
    */
-  void SetLinkLocalIpv6Address (std::vector<uint8_t> linkLocalIpv6Address);
+  void SetLinkLocalIpv6Address (const std::vector<uint8_t> &linkLocalIpv6Address);
 
   /**
    * Get link-local IPv6 address
@@ -641,7 +658,7 @@ private:
   bool m_hasIpAddressConfig; ///< Flag indicating if the IP address configuration  is present
   uint8_t m_ipAddressConfig; ///< IP address configuration contents (1 octet)
   bool m_hasLinkLocalIpv6Address; ///< Flag indicating if the link-local IPv6 address is present
-  std::vector<uint8_t> m_linkLocalIpv6Address;  ///< link-local IPv6 address contents (16 octets)
+  std::array<uint8_t, LinkLocalIpv6AddressSize> m_linkLocalIpv6Address;  ///< link-local IPv6 address contents (16 octets)
 
 };
 
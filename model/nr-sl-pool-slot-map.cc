@@ -0,0 +1,123 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "nr-sl-pool-slot-map.h"
+
+#include <ns3/log.h>
+#include <ns3/assert.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("NrSlPoolSlotMap");
+
+NrSlPoolSlotMap::NrSlPoolSlotMap ()
+  : m_prefixCount (1, 0)
+{
+}
+
+NrSlPoolSlotMap::NrSlPoolSlotMap (const std::vector <std::bitset<1> > &phyPool)
+{
+  NS_LOG_FUNCTION (this << phyPool.size ());
+
+  m_bits.assign ((phyPool.size () + 63) / 64, 0);
+  m_prefixCount.reserve (phyPool.size () + 1);
+  m_prefixCount.push_back (0);
+  for (uint32_t i = 0; i < phyPool.size (); ++i)
+    {
+      if (phyPool [i] == 1)
+        {
+          m_bits [i / 64] |= (UINT64_C (1) << (i % 64));
+          m_slPositions.push_back (i);
+        }
+      m_prefixCount.push_back (static_cast<uint32_t> (m_slPositions.size ()));
+    }
+}
+
+uint32_t
+NrSlPoolSlotMap::GetPeriod () const
+{
+  return static_cast<uint32_t> (m_prefixCount.size () - 1);
+}
+
+uint32_t
+NrSlPoolSlotMap::GetNumSlSlotsPerPeriod () const
+{
+  return static_cast<uint32_t> (m_slPositions.size ());
+}
+
+bool
+NrSlPoolSlotMap::IsSidelinkSlot (uint64_t absSlotIndex) const
+{
+  if (m_slPositions.empty ())
+    {
+      return false;
+    }
+  uint32_t pos = static_cast<uint32_t> (absSlotIndex % GetPeriod ());
+  return (m_bits [pos / 64] >> (pos % 64)) & 1;
+}
+
+uint64_t
+NrSlPoolSlotMap::GetLogicalSlotIndex (uint64_t absSlotIndex) const
+{
+  if (m_slPositions.empty ())
+    {
+      return 0;
+    }
+  uint32_t period = GetPeriod ();
+  return (absSlotIndex / period) * m_slPositions.size ()
+         + m_prefixCount [absSlotIndex % period];
+}
+
+uint64_t
+NrSlPoolSlotMap::GetPhysicalSlotIndex (uint64_t logicalSlotIndex) const
+{
+  NS_ASSERT_MSG (!m_slPositions.empty (), "The pool does not have any sidelink slot");
+  return (logicalSlotIndex / m_slPositions.size ()) * GetPeriod ()
+         + m_slPositions [logicalSlotIndex % m_slPositions.size ()];
+}
+
+uint64_t
+NrSlPoolSlotMap::CountSlSlots (uint64_t firstSlot, uint64_t lastSlot) const
+{
+  if (lastSlot < firstSlot)
+    {
+      return 0;
+    }
+  return GetLogicalSlotIndex (lastSlot + 1) - GetLogicalSlotIndex (firstSlot);
+}
+
+void
+NrSlPoolSlotMap::GetSlSlotOffsets (uint64_t absSlotIndex, uint16_t t1, uint16_t t2,
+                                   std::vector<uint32_t> &slotOffsets) const
+{
+  NS_LOG_FUNCTION (this << absSlotIndex << t1 << t2);
+
+  slotOffsets.clear ();
+  if (m_slPositions.empty () || t2 < t1)
+    {
+      return;
+    }
+  uint64_t first = GetLogicalSlotIndex (absSlotIndex + t1);
+  uint64_t last = GetLogicalSlotIndex (absSlotIndex + t2 + 1);
+  slotOffsets.reserve (last - first);
+  for (uint64_t logical = first; logical < last; ++logical)
+    {
+      slotOffsets.push_back (static_cast<uint32_t> (GetPhysicalSlotIndex (logical) - absSlotIndex));
+    }
+}
+
+} // namespace ns3
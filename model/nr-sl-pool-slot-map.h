@@ -0,0 +1,117 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NR_SL_POOL_SLOT_MAP_H
+#define NR_SL_POOL_SLOT_MAP_H
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup MAC
+ * \brief Periodic map of the sidelink slots of a physical SL pool
+ *
+ * The physical SL pool of a BWP (the SL bitmap applied to the UL slots of
+ * the TDD pattern, as returned by NrSlCommResourcePool::GetNrSlPhyPool) is
+ * periodic: the absolute slot n is a sidelink slot if the bit
+ * n % period of the pool is set. This class expands the pool once into a
+ * packed bitset, the number of SL slots before each position of the period
+ * (prefix count), and the position of each SL slot in the period, so that:
+ *
+ * - checking if a slot is a sidelink slot is O(1);
+ * - converting a physical (absolute) slot index into a logical one, i.e.,
+ *   the number of SL slots before it, and back is O(1);
+ * - listing the SL slots in [n + T1, n + T2] is O(number of SL slots found).
+ *
+ * The absolute slot index is the one returned by SfnSf::Normalize ().
+ */
+class NrSlPoolSlotMap
+{
+public:
+  /**
+   * \brief Create an empty map, without any sidelink slot
+   */
+  NrSlPoolSlotMap ();
+  /**
+   * \brief Create the map of a physical SL pool
+   * \param phyPool The physical SL pool, one bit per slot of the period
+   */
+  explicit NrSlPoolSlotMap (const std::vector <std::bitset<1> > &phyPool);
+
+  /**
+   * \brief Get the period of the pool
+   * \return The number of physical slots of the period, 0 if the map is empty
+   */
+  uint32_t GetPeriod () const;
+  /**
+   * \brief Get the number of sidelink slots in a period
+   * \return The number of sidelink slots in a period
+   */
+  uint32_t GetNumSlSlotsPerPeriod () const;
+  /**
+   * \brief Check if a slot is a sidelink slot
+   * \param absSlotIndex The absolute slot index
+   * \return true if the slot belongs to the pool
+   */
+  bool IsSidelinkSlot (uint64_t absSlotIndex) const;
+  /**
+   * \brief Get the logical index of a physical slot
+   * \param absSlotIndex The absolute slot index
+   * \return The number of sidelink slots before absSlotIndex (i.e., the
+   *         logical index of absSlotIndex if it is a sidelink slot, or of the
+   *         next sidelink slot otherwise)
+   */
+  uint64_t GetLogicalSlotIndex (uint64_t absSlotIndex) const;
+  /**
+   * \brief Get the physical slot of a logical slot index
+   * \param logicalSlotIndex The logical slot index
+   * \return The absolute slot index of the sidelink slot
+   */
+  uint64_t GetPhysicalSlotIndex (uint64_t logicalSlotIndex) const;
+  /**
+   * \brief Count the sidelink slots in a window
+   * \param firstSlot The first absolute slot index of the window
+   * \param lastSlot The last absolute slot index of the window (included)
+   * \return The number of sidelink slots in [firstSlot, lastSlot]
+   */
+  uint64_t CountSlSlots (uint64_t firstSlot, uint64_t lastSlot) const;
+  /**
+   * \brief Get the sidelink slots of a selection window
+   *
+   * It returns the same slots of NrSlCommResourcePool::GetNrSlCommOpportunities.
+   *
+   * \param absSlotIndex The absolute slot index n of the current slot
+   * \param t1 The offset in slots of the start of the window
+   * \param t2 The offset in slots of the end of the window (included)
+   * \param slotOffsets The offsets from n of the sidelink slots in
+   *        [n + t1, n + t2], in increasing order. The vector is cleared first.
+   */
+  void GetSlSlotOffsets (uint64_t absSlotIndex, uint16_t t1, uint16_t t2,
+                         std::vector<uint32_t> &slotOffsets) const;
+
+private:
+  std::vector<uint64_t> m_bits; //!< Packed bits of the physical pool
+  std::vector<uint32_t> m_prefixCount; //!< Number of SL slots before each position of the period (size period + 1)
+  std::vector<uint32_t> m_slPositions; //!< Position in the period of each SL slot
+};
+
+} // namespace ns3
+
+#endif /* NR_SL_POOL_SLOT_MAP_H */
@@ -234,31 +234,26 @@ NrSlUeProseDirectLink::DoReceiveNrSlPc5Message (Ptr<Packet> packet)
 {
   NS_LOG_FUNCTION (this);
 
+  // Process function of each PC5 signalling message type (nullptr if not handled)
+  static void (NrSlUeProseDirectLink::*const processFunctions [NrSlPc5SignallingMessageType::NumMessageTypes]) (Ptr<Packet>) =
+  {
+    nullptr,
+    &NrSlUeProseDirectLink::ProcessDirectLinkEstablishmentRequest,
+    &NrSlUeProseDirectLink::ProcessDirectLinkEstablishmentAccept,
+    &NrSlUeProseDirectLink::ProcessDirectLinkEstablishmentReject
+  };
+
   NrSlPc5SignallingMessageType pc5smt;
   packet->PeekHeader (pc5smt);
 
-  switch (pc5smt.GetMessageType ())
+  uint8_t msgType = pc5smt.GetMessageType ();
+  if (msgType < NrSlPc5SignallingMessageType::NumMessageTypes && processFunctions[msgType] != nullptr)
     {
-      case NrSlPc5SignallingMessageType::ProseDirectLinkEstablishmentRequest:
-        ProcessDirectLinkEstablishmentRequest (packet);
-        break;
-
-
-      case NrSlPc5SignallingMessageType::ProseDirectLinkEstablishmentAccept:
-        ProcessDirectLinkEstablishmentAccept (packet);
-
-        break;
-
-
-      case NrSlPc5SignallingMessageType::ProseDirectLinkEstablishmentReject:
-        ProcessDirectLinkEstablishmentReject (packet);
-
-        break;
-
-      default:
-        NS_LOG_INFO ("Unknown message type. Size: " << packet->GetSize ());
-
-        break;
+      (this->*processFunctions[msgType]) (packet);
+    }
+  else
+    {
+      NS_LOG_INFO ("Unknown message type. Size: " << packet->GetSize ());
     }
 }
 
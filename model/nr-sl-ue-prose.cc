@@ -92,6 +92,18 @@ TypeId NrSlUeProse::GetTypeId (void)
                    TimeValue (Seconds (1)),
                    MakeTimeAccessor (&NrSlUeProse::m_discoveryInterval),
                    MakeTimeChecker ())
+    .AddAttribute ("DiscoveryJitter",
+                   "Maximum random delay added to each round of discovery messages. "
+                   "It must be lower than the discovery interval",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&NrSlUeProse::m_discoveryJitter),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxDiscoveryCodesPerPdu",
+                   "Maximum number of discovery messages of the same round and for the "
+                   "same destination that are aggregated in one PDU (1 to disable)",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&NrSlUeProse::m_maxDiscoveryCodesPerPdu),
+                   MakeUintegerChecker<uint32_t> (1))
     .AddTraceSource ("PC5SignallingPacketTrace",
                      "Trace fired upon transmission and reception of PC5 Signalling messages",
                      MakeTraceSourceAccessor (&NrSlUeProse::m_pc5SignallingPacketTrace),
@@ -124,6 +136,7 @@ void
 NrSlUeProse::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_discoveryEvent.Cancel ();
   delete m_nrSlUeSvcRrcSapUser;
   delete m_nrSlUeSvcNasSapUser;
   delete m_nrSlUeProseDirLnkSapUser;
@@ -368,7 +381,7 @@ NrSlUeProse::IsMonitoringApp (uint8_t msgType, uint32_t appCode)
 void
 NrSlUeProse::SendDiscovery (uint32_t appCode, uint32_t dstL2Id)
 {
-  NS_LOG_FUNCTION (this);
+  NS_LOG_FUNCTION (this << appCode << dstL2Id);
 
   std::map <uint32_t, DiscoveryInfo>::iterator it;
 
@@ -376,38 +389,19 @@ NrSlUeProse::SendDiscovery (uint32_t appCode, uint32_t dstL2Id)
 
   if (it != m_discoveryMap.end ())
   {
-    
-    NrSlDiscoveryHeader discHeader;
-
-    if (it->second.role == Announcing)
-    {
-      discHeader.SetOpenDiscoveryAnnounceParameters (appCode);
-    
-      //reschedule
-      Simulator::Schedule (m_discoveryInterval, &NrSlUeProse::SendDiscovery, this, appCode, dstL2Id);
-
-    }
-    else if (it->second.role == Discoverer)
+    if (IsPeriodicDiscovery (it->second, false))
     {
-      discHeader.SetRestrictedDiscoveryQueryParameters (appCode);
-    
-      //reschedule
-      Simulator::Schedule (m_discoveryInterval, &NrSlUeProse::SendDiscovery, this, appCode, dstL2Id);
+      //sent now, and repeated, by the discovery timer
+      it->second.nextTxTime = Simulator::Now ();
+      ScheduleDiscoveryTimer ();
     }
-
     else if (it->second.role == Discoveree)
     {
-      discHeader.SetRestrictedDiscoveryResponseParameters (appCode);
-
-      //no reschedule
+      //no reschedule, and nothing to aggregate the response with
+      std::map <uint32_t, Ptr<Packet> > pdus;
+      TransmitDiscoveryMessage (it->second, false, dstL2Id, pdus);
+      FlushDiscoveryPdus (pdus);
     }
-  
-    //build message to transmit
-    Ptr<Packet> discoveryPacket = Create<Packet>();
-    discoveryPacket->AddHeader (discHeader);
-
-    DoSendNrSlDiscovery (discoveryPacket, dstL2Id);   
-    m_discoveryTrace (m_l2Id, dstL2Id, true, discHeader); 
   }
 }
 
@@ -473,37 +467,226 @@ NrSlUeProse::SendRelayDiscovery (uint32_t relayCode, uint32_t dstL2Id)
   it = m_relayMap.find (relayCode);
   if (it != m_relayMap.end ())
   {
-    //build message to transmit
-    NrSlDiscoveryHeader discHeader;
-
-    if (it->second.model == ModelA && it->second.role == RelayUE)
-      {
-        discHeader.SetRelayAnnouncementParameters (relayCode, m_imsi, m_l2Id, 1);
-        //reschedule
-        Simulator::Schedule (m_discoveryInterval, &NrSlUeProse::SendRelayDiscovery, this, relayCode, dstL2Id);
-      }
-
-    else if (it->second.model == ModelB && it->second.role == RemoteUE)
+    if (IsPeriodicDiscovery (it->second, true))
       {
-        discHeader.SetRelaySoliciationParameters (relayCode, m_imsi, m_l2Id);
-        //reschedule
-        Simulator::Schedule (m_discoveryInterval, &NrSlUeProse::SendRelayDiscovery, this, relayCode, dstL2Id); 
+        //sent now, and repeated, by the discovery timer
+        it->second.nextTxTime = Simulator::Now ();
+        ScheduleDiscoveryTimer ();
       }
-        
     else if (it->second.model == ModelB && it->second.role == RelayUE)
       {
-        discHeader.SetRelayResponseParameters (relayCode, m_imsi, m_l2Id, 1);
-        //no reschedule
+        //no reschedule, and nothing to aggregate the response with
+        std::map <uint32_t, Ptr<Packet> > pdus;
+        TransmitDiscoveryMessage (it->second, true, dstL2Id, pdus);
+        FlushDiscoveryPdus (pdus);
       }
-      
-      //send
-      Ptr<Packet> discoveryPacket = Create<Packet>();
-      discoveryPacket->AddHeader (discHeader);
-      DoSendNrSlDiscovery (discoveryPacket, dstL2Id);   
-      m_discoveryTrace (m_l2Id, dstL2Id, true, discHeader);
   }
 }
 
+bool
+NrSlUeProse::IsPeriodicDiscovery (const DiscoveryInfo &info, bool isRelay) const
+{
+  if (isRelay)
+    {
+      return (info.model == ModelA && info.role == RelayUE) || (info.model == ModelB && info.role == RemoteUE);
+    }
+  return info.role == Announcing || info.role == Discoverer;
+}
+
+Ptr<const Packet>
+NrSlUeProse::GetDiscoveryPdu (DiscoveryInfo &info, bool isRelay)
+{
+  if (info.pdu != nullptr)
+    {
+      return info.pdu;
+    }
+
+  NS_LOG_FUNCTION (this << info.appCode << isRelay);
+  if (!isRelay)
+    {
+      if (info.role == Announcing)
+        {
+          info.header.SetOpenDiscoveryAnnounceParameters (info.appCode);
+        }
+      else if (info.role == Discoverer)
+        {
+          info.header.SetRestrictedDiscoveryQueryParameters (info.appCode);
+        }
+      else if (info.role == Discoveree)
+        {
+          info.header.SetRestrictedDiscoveryResponseParameters (info.appCode);
+        }
+    }
+  else
+    {
+      if (info.model == ModelA && info.role == RelayUE)
+        {
+          info.header.SetRelayAnnouncementParameters (info.appCode, m_imsi, m_l2Id, 1);
+        }
+      else if (info.model == ModelB && info.role == RemoteUE)
+        {
+          info.header.SetRelaySoliciationParameters (info.appCode, m_imsi, m_l2Id);
+        }
+      else if (info.model == ModelB && info.role == RelayUE)
+        {
+          info.header.SetRelayResponseParameters (info.appCode, m_imsi, m_l2Id, 1);
+        }
+    }
+  info.pdu = Create<Packet> ();
+  info.pdu->AddHeader (info.header);
+  return info.pdu;
+}
+
+void
+NrSlUeProse::TransmitDiscoveryMessage (DiscoveryInfo &info, bool isRelay, uint32_t dstL2Id,
+                                       std::map <uint32_t, Ptr<Packet> > &pdus)
+{
+  NS_LOG_FUNCTION (this << info.appCode << isRelay << dstL2Id);
+
+  Ptr<const Packet> codePdu = GetDiscoveryPdu (info, isRelay);
+  m_discoveryTrace (m_l2Id, dstL2Id, true, info.header);
+  if (m_maxDiscoveryCodesPerPdu <= 1)
+    {
+      DoSendNrSlDiscovery (codePdu->Copy (), dstL2Id);
+      return;
+    }
+
+  auto itPdu = pdus.find (dstL2Id);
+  if (itPdu == pdus.end ())
+    {
+      itPdu = pdus.emplace (dstL2Id, codePdu->Copy ()).first;
+    }
+  else
+    {
+      itPdu->second->AddAtEnd (codePdu);
+    }
+  //all the discovery messages have the same size
+  if (itPdu->second->GetSize () >= m_maxDiscoveryCodesPerPdu * codePdu->GetSize ())
+    {
+      DoSendNrSlDiscovery (itPdu->second, dstL2Id);
+      pdus.erase (itPdu);
+    }
+}
+
+void
+NrSlUeProse::ScheduleDiscoveryTimer ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (m_discoveryJitter >= m_discoveryInterval,
+                   "The discovery jitter must be lower than the discovery interval");
+
+  //each code keeps its own period, starting when it was added
+  bool anyPeriodic = false;
+  Time nextTime = Time::Max ();
+  for (const auto &it : m_discoveryMap)
+    {
+      if (IsPeriodicDiscovery (it.second, false))
+        {
+          anyPeriodic = true;
+          nextTime = std::min (nextTime, it.second.nextTxTime);
+        }
+    }
+  for (const auto &it : m_relayMap)
+    {
+      if (IsPeriodicDiscovery (it.second, true))
+        {
+          anyPeriodic = true;
+          nextTime = std::min (nextTime, it.second.nextTxTime);
+        }
+    }
+
+  if (!anyPeriodic)
+    {
+      NS_LOG_DEBUG ("No code to announce, stopping the discovery timer");
+      m_discoveryEvent.Cancel ();
+      return;
+    }
+  if (m_discoveryEvent.IsRunning () && m_nextDiscoveryTime <= nextTime)
+    {
+      return;
+    }
+  //a code added while the timer runs is sent before the next round
+  m_discoveryEvent.Cancel ();
+  m_nextDiscoveryTime = nextTime;
+  //a code added during the jitter of the previous round may be already due
+  Time delay = std::max (m_nextDiscoveryTime - Simulator::Now (), Seconds (0));
+  m_discoveryEvent = Simulator::Schedule (delay + GetDiscoveryJitter (),
+                                          &NrSlUeProse::DiscoveryTimerExpired, this);
+}
+
+void
+NrSlUeProse::DiscoveryTimerExpired ()
+{
+  NS_LOG_FUNCTION (this);
+
+  //the codes due at the same nominal time are aggregated
+  std::map <uint32_t, Ptr<Packet> > pdus;
+  for (auto &it : m_discoveryMap)
+    {
+      if (IsPeriodicDiscovery (it.second, false) && it.second.nextTxTime <= m_nextDiscoveryTime)
+        {
+          TransmitDiscoveryMessage (it.second, false, it.second.dstL2Id, pdus);
+          it.second.nextTxTime += m_discoveryInterval;
+        }
+    }
+  for (auto &it : m_relayMap)
+    {
+      if (IsPeriodicDiscovery (it.second, true) && it.second.nextTxTime <= m_nextDiscoveryTime)
+        {
+          TransmitDiscoveryMessage (it.second, true, it.second.dstL2Id, pdus);
+          it.second.nextTxTime += m_discoveryInterval;
+        }
+    }
+  FlushDiscoveryPdus (pdus);
+
+  ScheduleDiscoveryTimer ();
+}
+
+void
+NrSlUeProse::FlushDiscoveryPdus (std::map <uint32_t, Ptr<Packet> > &pdus)
+{
+  NS_LOG_FUNCTION (this << pdus.size ());
+  //PDUs not filled up to MaxDiscoveryCodesPerPdu
+  for (const auto &it : pdus)
+    {
+      DoSendNrSlDiscovery (it.second, it.first);
+    }
+  pdus.clear ();
+}
+
+Time
+NrSlUeProse::GetDiscoveryJitter ()
+{
+  if (m_discoveryJitter.IsZero ())
+    {
+      return Seconds (0);
+    }
+  if (m_discoveryJitterRv == nullptr)
+    {
+      m_discoveryJitterRv = CreateObject<UniformRandomVariable> ();
+      if (m_discoveryJitterStream >= 0)
+        {
+          m_discoveryJitterRv->SetStream (m_discoveryJitterStream);
+        }
+    }
+  return Seconds (m_discoveryJitterRv->GetValue (0, m_discoveryJitter.GetSeconds ()));
+}
+
+int64_t
+NrSlUeProse::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  //the random variable is created at the first jittered round; the stream
+  //is reserved anyway, so that the streams of the other models do not
+  //depend on DiscoveryJitter
+  m_discoveryJitterStream = stream;
+  if (m_discoveryJitterRv != nullptr)
+    {
+      m_discoveryJitterRv->SetStream (stream);
+    }
+  return 1;
+}
+
 void
 NrSlUeProse::DoSendNrSlDiscovery (Ptr<Packet> packet, uint32_t dstL2Id)
 {
@@ -530,7 +713,18 @@ NrSlUeProse::DoReceiveNrSlDiscovery (Ptr<Packet> packet, uint32_t srcL2Id)
 {
   NS_LOG_FUNCTION (this);
   NrSlDiscoveryHeader discHeader;
-  packet->RemoveHeader (discHeader);
+  //a PDU carries more than one message if MaxDiscoveryCodesPerPdu is greater than 1
+  while (packet->GetSize () >= discHeader.GetSerializedSize ())
+    {
+      packet->RemoveHeader (discHeader);
+      ReceiveNrSlDiscoveryMessage (discHeader, srcL2Id);
+    }
+}
+
+void
+NrSlUeProse::ReceiveNrSlDiscoveryMessage (const NrSlDiscoveryHeader &discHeader, uint32_t srcL2Id)
+{
+  NS_LOG_FUNCTION (this << srcL2Id);
 
   uint8_t msgType = discHeader.GetDiscoveryMsgType ();
 
@@ -753,6 +947,11 @@ NrSlUeProse::SetImsi (uint64_t imsi)
 {
   NS_LOG_FUNCTION (this << imsi);
   m_imsi = imsi;
+  //the relay discovery messages carry the IMSI
+  for (auto &it : m_relayMap)
+    {
+      it.second.pdu = nullptr;
+    }
 }
 
 void
@@ -760,6 +959,11 @@ NrSlUeProse::SetL2Id (uint32_t l2Id)
 {
   NS_LOG_FUNCTION (this << l2Id);
   m_l2Id = l2Id;
+  //the relay discovery messages carry the L2 ID
+  for (auto &it : m_relayMap)
+    {
+      it.second.pdu = nullptr;
+    }
 }
 
 void
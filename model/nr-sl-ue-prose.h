@@ -44,6 +44,9 @@
 #include <ns3/nr-sl-ue-prose-direct-link.h>
 #include <ns3/traced-callback.h>
 #include <ns3/nr-sl-discovery-header.h>
+#include <ns3/event-id.h>
+#include <ns3/packet.h>
+#include <ns3/random-variable-stream.h>
 
 
 namespace ns3 {
@@ -120,6 +123,9 @@ public:
     DiscoveryRole role; ///< role in the discovery 
     uint32_t appCode; ///< application code 
     uint32_t dstL2Id; ///< destination L2 ID
+    NrSlDiscoveryHeader header; ///< message sent for this code, if any
+    Ptr<Packet> pdu; ///< serialized message, built once and copied at each transmission
+    Time nextTxTime; ///< nominal time of the next periodic message of the code, without jitter
   };
 
 
@@ -301,6 +307,10 @@ public:
 
   /**
    * \brief Send discovery message
+   *
+   * The announcements and queries are sent now, and then periodically, by
+   * the discovery timer of the UE. The responses are sent immediately.
+   *
    * \param appCode Application code
    * \param dstL2Id destination L2 ID
    */
@@ -334,10 +344,25 @@ public:
 
   /**
    * \brief Initiate relay discovery
+   *
+   * The relay announcements and solicitations are sent now, and then
+   * periodically, by the discovery timer of the UE. The relay responses are
+   * sent immediately.
+   *
    * \param relayCode relay code to consider
    * \param dstL2Id destination layer 2 ID 
    */
   void SendRelayDiscovery (uint32_t relayCode, uint32_t dstL2Id);
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model. Return the number of streams (possibly zero) that
+   * have been assigned.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
   
   /**
    * Map to keep track of the active SL Discovery RBs. 
@@ -349,6 +374,12 @@ public:
   ///< Frequency of Discovery messages in seconds
   Time m_discoveryInterval;
 
+  ///< Maximum random delay of each discovery round
+  Time m_discoveryJitter;
+
+  ///< Maximum number of discovery messages for the same destination in one PDU
+  uint32_t m_maxDiscoveryCodesPerPdu;
+
 
 private:
   //NrSlUeSvcRrcSapUser methods
@@ -356,6 +387,65 @@ private:
   void DoNotifySvcNrSlDataRadioBearerActivated (uint32_t peerL2Id);
   void DoReceiveNrSlDiscovery (Ptr<Packet> packet, uint32_t srcL2Id);
 
+  /**
+   * \brief Process a discovery message received
+   * \param discHeader the discovery message
+   * \param srcL2Id the layer 2 ID of the sender
+   */
+  void ReceiveNrSlDiscoveryMessage (const NrSlDiscoveryHeader &discHeader, uint32_t srcL2Id);
+
+  /**
+   * \brief Check if the messages of a code are sent periodically
+   * \param info the discovery information of the code
+   * \param isRelay true if the code is a relay code
+   * \return true for announcements, queries and relay solicitations
+   */
+  bool IsPeriodicDiscovery (const DiscoveryInfo &info, bool isRelay) const;
+
+  /**
+   * \brief Get the serialized message of a code, building it the first time
+   * \param info the discovery information of the code
+   * \param isRelay true if the code is a relay code
+   * \return the message, which must be copied before being sent
+   */
+  Ptr<const Packet> GetDiscoveryPdu (DiscoveryInfo &info, bool isRelay);
+
+  /**
+   * \brief Send the message of a code, aggregating it to the PDU of its
+   *        destination if MaxDiscoveryCodesPerPdu is greater than 1
+   * \param info the discovery information of the code
+   * \param isRelay true if the code is a relay code
+   * \param dstL2Id the destination layer 2 ID
+   * \param pdus the PDUs being aggregated, per destination layer 2 ID
+   */
+  void TransmitDiscoveryMessage (DiscoveryInfo &info, bool isRelay, uint32_t dstL2Id,
+                                 std::map <uint32_t, Ptr<Packet> > &pdus);
+
+  /**
+   * \brief Send the PDUs that were not filled up to MaxDiscoveryCodesPerPdu
+   * \param pdus the PDUs being aggregated, per destination layer 2 ID; it
+   *        is empty on return
+   */
+  void FlushDiscoveryPdus (std::map <uint32_t, Ptr<Packet> > &pdus);
+
+  /**
+   * \brief Schedule the discovery timer at the earliest nominal time of the
+   *        periodic codes, plus a random jitter, or stop it if there is none
+   */
+  void ScheduleDiscoveryTimer ();
+
+  /**
+   * \brief Send the messages of the periodic codes due at the nominal time of
+   *        this round, and schedule the next round
+   */
+  void DiscoveryTimerExpired ();
+
+  /**
+   * \brief Get a random delay for a discovery round
+   * \return a delay in [0, DiscoveryJitter]
+   */
+  Time GetDiscoveryJitter ();
+
   //NrSlUeProseDirLnkSapUser methods
   void DoSendNrSlPc5SMessage (Ptr<Packet> packet, uint32_t dstL2Id,  uint8_t lcId);
   void DoNotifyChangeOfDirectLinkState (uint32_t peerL2Id, NrSlUeProseDirLnkSapUser::ChangeOfStateNotification info);
@@ -401,6 +491,11 @@ private:
   ///< List of relay codes 
   std::map <uint32_t, DiscoveryInfo> m_relayMap;
 
+  EventId m_discoveryEvent; ///< Next round of the discovery timer
+  Time m_nextDiscoveryTime; ///< Nominal time of the next discovery round, without jitter
+  Ptr<UniformRandomVariable> m_discoveryJitterRv; ///< Random variable for the jitter of the discovery rounds, created if DiscoveryJitter is not zero
+  int64_t m_discoveryJitterStream {-1}; ///< Stream of m_discoveryJitterRv, -1 if not assigned
+
   SidelinkInfo m_slSrbSlInfo; ///< Default values for traffic profile used for signaling radio bearers
 
   /**
@@ -1672,6 +1672,11 @@ NrSpectrumPhy::StartTxSlCtrlFrames (const Ptr<PacketBurst>& pb, Time duration)
         txParams->nodeId = GetDevice ()->GetNode ()->GetId ();
         txParams->packetBurst = pb;
 
+        // Decode the SCI stage 1 here once, for all the receivers
+        Ptr<NrSlSciDescriptor> sci = Create<NrSlSciDescriptor> ();
+        sci->hasSciF1a = pb->GetPackets ().front ()->PeekHeader (sci->sciF1a) > 0;
+        txParams->sci = sci;
+
         m_txCtrlTrace (duration);
 
         if (m_channel)
@@ -1724,6 +1729,21 @@ NrSpectrumPhy::StartTxSlDataFrames (const Ptr<PacketBurst>& pb, Time duration)
         txParams->nodeId = GetDevice ()->GetNode ()->GetId ();
         txParams->packetBurst = pb;
 
+        // Decode the SCI stage 2 here once, for all the receivers. The MAC
+        // puts it after the data packets, and it is the only packet of the
+        // burst without the radio bearer tag
+        Ptr<NrSlSciDescriptor> sci = Create<NrSlSciDescriptor> ();
+        LteRadioBearerTag tag;
+        if (pb->GetNPackets () > 0)
+          {
+            const Ptr<Packet> &sci2Pkt = *std::prev (pb->End ());
+            if (!sci2Pkt->PeekPacketTag (tag))
+              {
+                sci->hasSciF2a = sci2Pkt->PeekHeader (sci->sciF2a) == 5 /*5 bytes is the fixed size of SCI format 2a*/;
+              }
+          }
+        txParams->sci = sci;
+
         m_txDataTrace (duration);
 
         if (m_channel)
@@ -2019,7 +2039,15 @@ NrSpectrumPhy::RxSlPscch (std::vector<uint32_t> paramIndexes)
 
       //Add PSCCH trace.
       NrSlSciF1aHeader sciHeader;
-      packet->PeekHeader (sciHeader);
+      const Ptr<const NrSlSciDescriptor> &sci = m_slRxSigParamInfo.at (paramIndex).params->sci;
+      if (sci != nullptr && sci->hasSciF1a)
+        {
+          sciHeader = sci->sciF1a;
+        }
+      else
+        {
+          packet->PeekHeader (sciHeader);
+        }
       NrSlMacPduTag tag;
       bool tagFound = packet->PeekPacketTag (tag);
       NS_ABORT_MSG_IF (!tagFound, "Did not find NrSlMacPduTag");
@@ -2098,8 +2126,10 @@ NrSpectrumPhy::RxSlPssch (std::vector<uint32_t> paramIndexes)
       LteRadioBearerTag tag;
       if ((*j)->PeekPacketTag (tag) == false)
         {
+          const Ptr<const NrSlSciDescriptor> &sci = m_slRxSigParamInfo.at (pktIndex).params->sci;
           NrSlSciF2aHeader sciF2a;
-          if ((*j)->PeekHeader(sciF2a) != 5 /*5 bytes is the fixed size of SCI format 2a*/)
+          if ((sci == nullptr || !sci->hasSciF2a)
+              && (*j)->PeekHeader(sciF2a) != 5 /*5 bytes is the fixed size of SCI format 2a*/)
             {
               NS_FATAL_ERROR ("Invalid PSSCH packet type! I didn't find any radio bearer tag neither any NrSlSciF2aHeader");
             }
@@ -2161,9 +2191,17 @@ NrSpectrumPhy::RxSlPssch (std::vector<uint32_t> paramIndexes)
   for (auto &tbIt : m_slTransportBlocks)
     {
       NS_ABORT_MSG_IF (tbIt.second.sinrUpdated == false, "SINR not updated for the expected TB from RNTI " << tbIt.first);
-      Ptr<Packet> sci2Pkt = RetrieveSci2FromPktBurst (tbIt.second.pktIndex);
       NrSlSciF2aHeader sciF2a;
-      sci2Pkt->PeekHeader (sciF2a);
+      const Ptr<const NrSlSciDescriptor> &sci = m_slRxSigParamInfo.at (tbIt.second.pktIndex).params->sci;
+      if (sci != nullptr && sci->hasSciF2a)
+        {
+          sciF2a = sci->sciF2a;
+        }
+      else
+        {
+          Ptr<Packet> sci2Pkt = RetrieveSci2FromPktBurst (tbIt.second.pktIndex);
+          sci2Pkt->PeekHeader (sciF2a);
+        }
       if (sciF2a.GetNdi ())
         {
           NS_LOG_DEBUG ("RemovePrevDecoded: " << +sciF2a.GetHarqId () << " for the packets received from RNTI " << tbIt.first << " rv " << +sciF2a.GetRv ());
@@ -2374,23 +2412,13 @@ NrSpectrumPhy::RetrieveSci2FromPktBurst (uint32_t pktIndex)
 {
   NS_LOG_FUNCTION (this << pktIndex);
   Ptr<PacketBurst> pktBurst = m_slRxSigParamInfo.at (pktIndex).params->packetBurst;
-  std::list<Ptr<Packet> >::const_iterator it;
-  Ptr<Packet> sci2pkt;
-  for (it = pktBurst->Begin(); it != pktBurst->End (); it++)
-    {
-      LteRadioBearerTag tag;
-      if ((*it)->PeekPacketTag (tag) == false)
-        {
-          //SCI stage 2 is the only packet in the packet burst, which does
-          //not have the tag
-          sci2pkt = *it;
-          break;
-        }
-    }
-
-  NS_ABORT_MSG_IF (sci2pkt == nullptr, "Did not find SCI stage 2 in PSSCH packet burst");
+  //SCI stage 2 is the last packet in the packet burst, and the only one
+  //which does not have the tag
+  LteRadioBearerTag tag;
+  NS_ABORT_MSG_IF (pktBurst->GetNPackets () == 0 || (*std::prev (pktBurst->End ()))->PeekPacketTag (tag),
+                   "Did not find SCI stage 2 in PSSCH packet burst");
 
-  return sci2pkt;
+  return *std::prev (pktBurst->End ());
 }
 
 const NrSpectrumPhy::SinrStats
@@ -131,6 +131,7 @@ NrSpectrumSignalParametersSlFrame::NrSpectrumSignalParametersSlFrame (const NrSp
 {
   NS_LOG_FUNCTION (this << &p);
   nodeId = p.nodeId;
+  sci = p.sci;
   //slssId = p.slssId; //TODO
   if (p.packetBurst)
     {
@@ -161,12 +162,7 @@ NrSpectrumSignalParametersSlCtrlFrame::NrSpectrumSignalParametersSlCtrlFrame (co
   : NrSpectrumSignalParametersSlFrame (p)
 {
   NS_LOG_FUNCTION (this << &p);
-  nodeId = p.nodeId;
-  //slssId = p.slssId; //TODO
-  if (p.packetBurst)
-    {
-      packetBurst = p.packetBurst->Copy ();
-    }
+  // nodeId, sci and a copy of the packet burst are set by the base class
 }
 
 Ptr<SpectrumSignalParameters>
@@ -192,12 +188,7 @@ NrSpectrumSignalParametersSlDataFrame::NrSpectrumSignalParametersSlDataFrame (co
   : NrSpectrumSignalParametersSlFrame (p)
 {
   NS_LOG_FUNCTION (this << &p);
-  nodeId = p.nodeId;
-  //slssId = p.slssId; //TODO
-  if (p.packetBurst)
-    {
-      packetBurst = p.packetBurst->Copy ();
-    }
+  // nodeId, sci and a copy of the packet burst are set by the base class
 }
 
 Ptr<SpectrumSignalParameters>
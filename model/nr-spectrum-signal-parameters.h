@@ -23,6 +23,9 @@
 
 #include <list>
 #include <ns3/spectrum-signal-parameters.h>
+#include <ns3/simple-ref-count.h>
+#include "nr-sl-sci-f1a-header.h"
+#include "nr-sl-sci-f2a-header.h"
 
 namespace ns3 {
 
@@ -126,6 +129,24 @@ struct NrSpectrumSignalParametersUlCtrlFrame : public SpectrumSignalParameters
 
 // NR SL
 
+/**
+ * \ingroup ue-phy
+ *
+ * \brief SCI carried by a sidelink transmission, decoded by the transmitter
+ *
+ * The transmitting PHY decodes the SCI once and all the receivers of the
+ * signal share the result, instead of each one deserializing the same
+ * headers. The packets of the burst still carry the serialized SCI, for the
+ * upper layers and the traces.
+ */
+struct NrSlSciDescriptor : public SimpleRefCount<NrSlSciDescriptor>
+{
+  bool hasSciF1a {false};  //!< True if sciF1a is valid (PSCCH)
+  NrSlSciF1aHeader sciF1a; //!< SCI stage 1, format 1A
+  bool hasSciF2a {false};  //!< True if sciF2a is valid (PSSCH)
+  NrSlSciF2aHeader sciF2a; //!< SCI stage 2, format 2A
+};
+
 /**
  * \ingroup gnb-phy
  * \ingroup ue-phy
@@ -151,6 +172,7 @@ struct NrSpectrumSignalParametersSlFrame : public SpectrumSignalParameters
 
   Ptr<PacketBurst> packetBurst; //!< The packet burst being transmitted with this signal
   uint32_t nodeId {std::numeric_limits <uint32_t>::max ()}; //!< Node id
+  Ptr<const NrSlSciDescriptor> sci; //!< Decoded SCI, shared by all the receivers (may be null)
   //TODO
   //uint64_t slssId; //!< The Sidelink synchronization signal identifier of the transmitting UE
 
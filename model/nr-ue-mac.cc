@@ -575,6 +575,8 @@ NrUeMac::DoReportBufferStatus (LteMacSapProvider::ReportBufferStatusParameters p
   if (m_srState == INACTIVE)
     {
       NS_LOG_INFO ("INACTIVE -> TO_SEND, bufSize " << GetTotalBufSize ());
+      // The SR goes out with the next slot indication: make sure it comes
+      m_phySapProvider->ResumeSlotIndications ();
       m_srState = TO_SEND;
     }
 }
@@ -626,11 +628,14 @@ NrUeMac::SendReportBufferStatus (const SfnSf &dataSfn, uint8_t symStart)
   bsr.m_macCeValue.m_bufferStatus.push_back (NrMacShortBsrCe::FromBytesToLevel (queue.at (3)));
 
   // create the message. It is used only for tracing, but we don't send it...
-  Ptr<NrBsrMessage> msg = Create<NrBsrMessage> ();
-  msg->SetSourceBwp (GetBwpId ());
-  msg->SetBsr (bsr);
+  if (!m_macTxedCtrlMsgsTrace.IsEmpty ())
+    {
+      Ptr<NrBsrMessage> msg = Create<NrBsrMessage> ();
+      msg->SetSourceBwp (GetBwpId ());
+      msg->SetBsr (bsr);
 
-  m_macTxedCtrlMsgsTrace (m_currentSlot, GetCellId (), bsr.m_rnti, GetBwpId (), msg);
+      m_macTxedCtrlMsgsTrace (m_currentSlot, GetCellId (), bsr.m_rnti, GetBwpId (), msg);
+    }
 
   // Here we send the real SHORT_BSR, as a subpdu.
   Ptr<Packet> p = Create<Packet> ();
@@ -715,18 +720,18 @@ NrUeMac::DoSlotIndication (const SfnSf &sfn)
   bool isSidelinkSlot = false;
   if (m_slTxPool)
     {
-      isSidelinkSlot = m_slTxPool->IsSidelinkSlot (GetBwpId (), m_poolId, sfn.Normalize ());
+      if (m_slSubChSize == 0)
+        {
+          UpdateNrSlPoolParams (sfn);
+        }
+      isSidelinkSlot = m_slSlotMap->IsSidelinkSlot (sfn.Normalize ());
     }
   if (m_nrSlUeMacSchedSapProvider)
     {
       if (m_enableSensing)
         {
-          RemoveOldSensingData (sfn,
-            m_slTxPool->GetNrSlSensWindInSlots (GetBwpId (), m_poolId, m_nrSlUePhySapProvider->GetSlotPeriod ()),
-            m_sensingData, m_imsi);
-          RemoveOldTransmitHistory (sfn,
-            m_slTxPool->GetNrSlSensWindInSlots (GetBwpId (), m_poolId, m_nrSlUePhySapProvider->GetSlotPeriod ()),
-            m_transmitHistory, m_imsi);
+          RemoveOldSensingData (sfn, m_slSensWindInSlots, m_sensingData, m_imsi);
+          RemoveOldTransmitHistory (sfn, m_slSensWindInSlots, m_transmitHistory, m_imsi);
         }
 
       m_nrSlUeMacSchedSapProvider->SchedUeNrSlTriggerReq (sfn, m_nrSlHarq->GetAvailableHarqIds ());
@@ -1219,9 +1224,13 @@ NrUeMac::SendRaPreamble ([[maybe_unused]] bool contention)
   /*raRnti should be subframeNo -1 */
   m_raRnti = 1;
 
-  Ptr<NrRachPreambleMessage> rachMsg = Create<NrRachPreambleMessage> ();
-  rachMsg->SetSourceBwp (GetBwpId ());
-  m_macTxedCtrlMsgsTrace (m_currentSlot, GetCellId (), m_rnti, GetBwpId (), rachMsg);
+  // The message is built only for the trace, the PHY sends the preamble id
+  if (!m_macTxedCtrlMsgsTrace.IsEmpty ())
+    {
+      Ptr<NrRachPreambleMessage> rachMsg = Create<NrRachPreambleMessage> ();
+      rachMsg->SetSourceBwp (GetBwpId ());
+      m_macTxedCtrlMsgsTrace (m_currentSlot, GetCellId (), m_rnti, GetBwpId (), rachMsg);
+    }
 
   m_phySapProvider->SendRachPreamble (m_raPreambleId, m_raRnti);
 }
@@ -1274,28 +1283,63 @@ NrUeMac::AssignStreams (int64_t stream)
 //NR SL
 
 std::list <NrSlUeMacSchedSapProvider::NrSlSlotInfo>
-NrUeMac::GetNrSlCandidateResourcesFromSlots (const SfnSf& sfn, uint16_t lSubCh, uint16_t totalSubCh, std::list <NrSlCommResourcePool::SlotInfo> slotInfo) const
+NrUeMac::GetNrSlCandidateResourcesFromSlots (const SfnSf& sfn, uint16_t lSubCh, uint16_t totalSubCh,
+                                             const NrSlPoolCacheEntry& poolCache,
+                                             const std::vector<uint32_t>& slotOffsets) const
 {
-  NS_LOG_FUNCTION (this << sfn.Normalize () << lSubCh << totalSubCh << slotInfo.size ());
+  NS_LOG_FUNCTION (this << sfn.Normalize () << lSubCh << totalSubCh << slotOffsets.size ());
 
   std::list <NrSlUeMacSchedSapProvider::NrSlSlotInfo> nrSupportedList;
-  for (const auto& it:slotInfo)
+  for (const auto& itOffset : slotOffsets)
     {
+      SfnSf slotSfn = sfn.GetFutureSfnSf (itOffset);
       for (uint16_t i = 0; i + lSubCh <= totalSubCh; i++)
         {
-          NrSlUeMacSchedSapProvider::NrSlSlotInfo info (it.numSlPscchRbs, it.slPscchSymStart,
-                                                        it.slPscchSymLength, it.slPsschSymStart,
-                                                        it.slPsschSymLength, it.slSubchannelSize,
-                                                        it.slMaxNumPerReserve,
-                                                        sfn.GetFutureSfnSf (it.slotOffset),
-                                                        i, lSubCh);
-          nrSupportedList.emplace_back (info);
+          nrSupportedList.emplace_back (poolCache.m_numSlPscchRbs, poolCache.m_slPscchSymStart,
+                                        poolCache.m_slPscchSymLength, poolCache.m_slPsschSymStart,
+                                        poolCache.m_slPsschSymLength, poolCache.m_slSubchannelSize,
+                                        poolCache.m_slMaxNumPerReserve, slotSfn, i, lSubCh);
         }
     }
 
   return nrSupportedList;
 }
 
+const NrUeMac::NrSlPoolCacheEntry&
+NrUeMac::GetNrSlPoolCacheEntry (Ptr<const NrSlCommResourcePool> txPool, uint8_t bwpId,
+                                uint16_t poolId, uint16_t numerology, Time slotPeriod) const
+{
+  NrSlPoolCacheEntry &entry = m_slPoolCache [std::make_tuple (bwpId, poolId, numerology)];
+  if (entry.m_pool == txPool)
+    {
+      return entry;
+    }
+
+  NS_LOG_FUNCTION (this << txPool << +bwpId << poolId << numerology << slotPeriod);
+  entry.m_pool = txPool;
+  entry.m_slotMap = NrSlPoolSlotMap (txPool->GetNrSlPhyPool (bwpId, poolId));
+  entry.m_sensWindInSlots = txPool->GetNrSlSensWindInSlots (bwpId, poolId, slotPeriod);
+  if (entry.m_slotMap.GetNumSlSlotsPerPeriod () > 0)
+    {
+      //the slot parameters only depend on the pool, so we take them from
+      //the first sidelink slot of the pool
+      uint64_t firstSlSlot = entry.m_slotMap.GetPhysicalSlotIndex (0);
+      std::list <NrSlCommResourcePool::SlotInfo> slots = txPool->GetNrSlCommOpportunities (firstSlSlot, bwpId, numerology, poolId, 0, 0);
+      NS_ASSERT_MSG (slots.size () == 1, "The first sidelink slot of pool " << poolId << " is not a sidelink slot");
+      const auto &slot = slots.front ();
+      entry.m_numSlPscchRbs = slot.numSlPscchRbs;
+      entry.m_slPscchSymStart = slot.slPscchSymStart;
+      entry.m_slPscchSymLength = slot.slPscchSymLength;
+      entry.m_slPsschSymStart = slot.slPsschSymStart;
+      entry.m_slPsschSymLength = slot.slPsschSymLength;
+      entry.m_slSubchannelSize = slot.slSubchannelSize;
+      entry.m_slMaxNumPerReserve = slot.slMaxNumPerReserve;
+    }
+  NS_LOG_DEBUG ("Pool " << poolId << " of BWP " << +bwpId << ": period " << entry.m_slotMap.GetPeriod ()
+                << " slots, " << entry.m_slotMap.GetNumSlSlotsPerPeriod () << " sidelink slots");
+  return entry;
+}
+
 bool
 NrUeMac::OverlappedResource (uint8_t firstStart, uint8_t firstLength, uint8_t secondStart, uint8_t secondLength) const
 {
@@ -1371,33 +1415,23 @@ NrUeMac::FilterNrSlCandidateResources (std::list <NrSlUeMacSchedSapProvider::NrS
 {
   NS_LOG_FUNCTION (this);
 
-   if (candidateReso.empty () || m_slGrants.empty())
+   if (candidateReso.empty () || m_slGrantTimeline.empty ())
      {
        return candidateReso;
      }
 
-   NrSlSlotAlloc dummyAlloc;
-   for (const auto & itDst : m_slGrants)
+   //Currently the PHY doesn't handle multiple PSSCH transmissions in the same slot
+   //Thus, we need to remove all candidate resources belonging to the same slot than a granted resource
+   auto itCandReso = candidateReso.begin ();
+   while (itCandReso != candidateReso.end ())
      {
-       for (auto itGrantVector = itDst.second.begin () ; itGrantVector != itDst.second.end (); ++itGrantVector)
+       if (m_slGrantTimeline.find (itCandReso->sfn.Normalize ()) != m_slGrantTimeline.end ())
+         {
+           itCandReso = candidateReso.erase (itCandReso);
+         }
+       else
          {
-           for (auto itGrantAlloc = itGrantVector->slotAllocations.begin (); itGrantAlloc != itGrantVector->slotAllocations.end (); itGrantAlloc ++)
-             {
-               auto itCandReso = candidateReso.begin ();
-               while (itCandReso != candidateReso.end ())
-                 {
-                   //Currently the PHY doesn't handle multiple PSSCH transmissions in the same slot
-                   //Thus, we need to remove all candidate resources belonging to the same slot than a granted resource
-                   if (itGrantAlloc->sfn == itCandReso->sfn)
-                     {
-                       itCandReso = candidateReso.erase (itCandReso);
-                     }
-                   else
-                     {
-                       ++itCandReso;
-                     }
-                 }
-             }
+           ++itCandReso;
          }
      }
 
@@ -1436,7 +1470,8 @@ NrUeMac::GetNrSlCandidateResourcesPrivate (const SfnSf& sfn, const NrSlTransmiss
 
   SensingTraceReport report;  // for tracing
   report.m_sfn = sfn;
-  report.m_t0 = txPool->GetNrSlSensWindInSlots (bwpId, poolId, slotPeriod);
+  const NrSlPoolCacheEntry &poolCache = GetNrSlPoolCacheEntry (txPool, bwpId, poolId, sfn.GetNumerology (), slotPeriod);
+  report.m_t0 = poolCache.m_sensWindInSlots;
   report.m_tProc0 = m_tproc0;
   report.m_t1 = m_t1;
   report.m_t2 = m_t2;
@@ -1458,17 +1493,13 @@ NrUeMac::GetNrSlCandidateResourcesPrivate (const SfnSf& sfn, const NrSlTransmiss
   // TR 38.214 Section 8.1.4, return the set 'S_A' (candidate single slot
   // resources).  The size of this list is the algorithm parameter 'M_total'.
 
-  // In this code, the list of candidateSlots is taken from the resource pool,
-  // each SlotInfo doesn't have a list of subchannel (indices).
-  // The NrUeMac copies each resource to the candidateResources list,
-  // the only difference being that this NrSlUeMacSchedSapProvider::NrSlSlotInfo
-  // exists at the mac/scheduler API.  Consolidating these two nearly
-  // identical structures could be a topic of future work.
-
-  // Probably what is needed is that the list of all candidate resources
-  // should be passed from nr-sl-comm-resource-pool to begin with.
+  // In this code, the candidate slots are taken from the map of the
+  // sidelink slots of the pool, which gives the same slots of
+  // NrSlCommResourcePool::GetNrSlCommOpportunities without building a list
+  // of NrSlCommResourcePool::SlotInfo. Each slot is then expanded into
+  // NrSlUeMacSchedSapProvider::NrSlSlotInfo, one per subchannel index.
 
-  std::list <NrSlCommResourcePool::SlotInfo> candidateSlots; // candidate single slots
+  std::vector<uint32_t> candidateSlots; // offsets of the candidate single slots
   std::list <NrSlUeMacSchedSapProvider::NrSlSlotInfo> candidateResources;// S_A as per TS 38.214
 
   uint64_t absSlotIndex = sfn.Normalize ();
@@ -1482,7 +1513,7 @@ NrUeMac::GetNrSlCandidateResourcesPrivate (const SfnSf& sfn, const NrSlTransmiss
       "An error may be generated due to the fact that the resource selection window size is higher than the resource reservation period value. Make sure that (T2-T1+1) x (1/(2^numerology)) < reservation period. Modify the values of T1, T2, numerology, and reservation period accordingly.");
 
   //step 4 as per TS 38.214 sec 8.1.4
-  candidateSlots = txPool->GetNrSlCommOpportunities (absSlotIndex, bwpId, numerology, poolId, m_t1, m_t2);
+  poolCache.m_slotMap.GetSlSlotOffsets (absSlotIndex, m_t1, m_t2, candidateSlots);
   report.m_initialCandidateSlotsSize = candidateSlots.size ();
   if (candidateSlots.size () == 0)
     {
@@ -1490,10 +1521,10 @@ NrUeMac::GetNrSlCandidateResourcesPrivate (const SfnSf& sfn, const NrSlTransmiss
       //window are in terms of physical slots, it may happen that there are no
       //slots available for Sidelink, which depends on the TDD pattern and the
       //Sidelink bitmap.
-      return GetNrSlCandidateResourcesFromSlots (sfn, params.m_lSubch, totalSubCh, candidateSlots);
+      return candidateResources;
     }
 
-  candidateResources = GetNrSlCandidateResourcesFromSlots (sfn, params.m_lSubch, totalSubCh, candidateSlots);
+  candidateResources = GetNrSlCandidateResourcesFromSlots (sfn, params.m_lSubch, totalSubCh, poolCache, candidateSlots);
   uint32_t mTotal = candidateResources.size (); // total number of candidate single-slot resources
   report.m_initialCandidateResourcesSize = mTotal;
   if (!m_enableSensing)
@@ -1840,29 +1871,14 @@ NrUeMac::DoReceivePsschPhyPdu (Ptr<PacketBurst> pdu)
 {
   NS_LOG_FUNCTION (this << "Received Sidelink PDU from PHY");
 
+  //SCI stage 2 is the last packet of the packet burst, after the data
+  //packets, and the only one which does not have the tag
+  NS_ABORT_MSG_IF (pdu->GetNPackets () < 2, "Received PHY PDU without SCI stage 2 or data packets");
+  const auto dataEnd = std::prev (pdu->End ());
   LteRadioBearerTag tag;
+  NS_ABORT_MSG_IF ((*dataEnd)->PeekPacketTag (tag), "Did not find SCI stage 2 in PSSCH packet burst");
   NrSlSciF2aHeader sciF2a;
-  //Separate SCI stage 2 packet from data packets
-  std::list <Ptr<Packet> > dataPkts;
-  bool foundSci2 = false;
-  for (auto packet : pdu->GetPackets ())
-    {
-      LteRadioBearerTag tag;
-      if (packet->PeekPacketTag (tag) == false)
-        {
-          //SCI stage 2 is the only packet in the packet burst, which does
-          //not have the tag
-          packet->RemoveHeader (sciF2a);
-          foundSci2 = true;
-        }
-      else
-        {
-          dataPkts.push_back (packet);
-        }
-    }
-
-  NS_ABORT_MSG_IF (foundSci2 == false, "Did not find SCI stage 2 in PSSCH packet burst");
-  NS_ASSERT_MSG (dataPkts.size () > 0, "Received PHY PDU with not data packets");
+  (*dataEnd)->PeekHeader (sciF2a);
 
   //Perform L2 filtering.
   //Remember, all the packets in the packet burst are for the same
@@ -1875,36 +1891,47 @@ NrUeMac::DoReceivePsschPhyPdu (Ptr<PacketBurst> pdu)
       NS_FATAL_ERROR ("Received PHY PDU with unknown destination " << sciF2a.GetDstId ());
     }
 
-  for (auto &pktIt : dataPkts)
+  const bool traceRxPdu = !m_rxRlcPduWithTxRnti.IsEmpty ();
+  SidelinkLcIdentifier identifier;
+  identifier.srcL2Id = sciF2a.GetSrcId ();
+  identifier.dstL2Id = sciF2a.GetDstId ();
+  SlLcInfoUeMac *lcInfo = nullptr;
+  for (auto pktIt = pdu->Begin (); pktIt != dataEnd; ++pktIt)
     {
-      pktIt->RemovePacketTag (tag);
+      const Ptr<Packet> &packet = *pktIt;
+      bool hasTag = packet->RemovePacketTag (tag);
+      NS_ABORT_MSG_IF (!hasTag, "Data packet without LteRadioBearerTag in PSSCH packet burst");
       //Even though all the packets in the packet burst are for the same
       //destination, they can belong to different Logical Channels (LC),
       //therefore, we have to build the identifier and find the LC of the
-      //packet.
-      SidelinkLcIdentifier identifier;
-      identifier.lcId = tag.GetLcid ();
-      identifier.srcL2Id = sciF2a.GetSrcId ();
-      identifier.dstL2Id = sciF2a.GetDstId ();
-
-      std::map <SidelinkLcIdentifier, SlLcInfoUeMac>::iterator it = m_nrSlLcInfoMap.find (identifier);
-      if (it == m_nrSlLcInfoMap.end ())
+      //packet. Consecutive packets of the same LC share the lookup.
+      if (lcInfo == nullptr || identifier.lcId != tag.GetLcid ())
         {
-          //notify RRC to setup bearer
-          m_nrSlUeCmacSapUser->NotifySidelinkReception (tag.GetLcid (), identifier.srcL2Id, identifier.dstL2Id);
-
-          //should be setup now
-          it = m_nrSlLcInfoMap.find (identifier);
-          if (it == m_nrSlLcInfoMap.end ())
+          identifier.lcId = tag.GetLcid ();
+          auto itLc = m_nrSlLcInfoMap.find (identifier);
+          if (itLc == m_nrSlLcInfoMap.end ())
             {
-              NS_FATAL_ERROR ("Failure to setup Sidelink radio bearer for reception");
+              //notify RRC to setup bearer
+              m_nrSlUeCmacSapUser->NotifySidelinkReception (tag.GetLcid (), identifier.srcL2Id, identifier.dstL2Id);
+
+              //should be setup now
+              itLc = m_nrSlLcInfoMap.find (identifier);
+              if (itLc == m_nrSlLcInfoMap.end ())
+                {
+                  NS_FATAL_ERROR ("Failure to setup Sidelink radio bearer for reception");
+                }
             }
+          lcInfo = &itLc->second;
         }
-      NrSlMacSapUser::NrSlReceiveRlcPduParameters rxPduParams (pktIt, m_rnti, tag.GetLcid (),
+      NrSlMacSapUser::NrSlReceiveRlcPduParameters rxPduParams (packet, m_rnti, tag.GetLcid (),
                                                                identifier.srcL2Id, identifier.dstL2Id);
 
-      FireTraceSlRlcRxPduWithTxRnti (pktIt->Copy (), tag.GetLcid ());
-      it->second.macSapUser->ReceiveNrSlRlcPdu (rxPduParams);
+      if (traceRxPdu)
+        {
+          //The trace only reads the packet, before it is passed to RLC
+          FireTraceSlRlcRxPduWithTxRnti (packet, tag.GetLcid ());
+        }
+      lcInfo->macSapUser->ReceiveNrSlRlcPdu (rxPduParams);
     }
 }
 
@@ -1914,37 +1941,53 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
   NS_LOG_FUNCTION (this << " Frame " << sfn.GetFrame() << " Subframe " << +sfn.GetSubframe()
                         << " slot " << sfn.GetSlot () << " Normalized slot number " << sfn.Normalize ());
 
+  const uint64_t currentSlotNum = sfn.Normalize ();
+  //the slots are indicated in increasing order, thus the entries of the
+  //timeline before the current slot will never be looked up again
+  while (!m_slGrantTimeline.empty () && m_slGrantTimeline.begin ()->first < currentSlotNum)
+    {
+      m_slGrantTimeline.erase (m_slGrantTimeline.begin ());
+    }
+  auto itDue = m_slGrantTimeline.find (currentSlotNum);
+  if (itDue == m_slGrantTimeline.end ())
+    {
+      NS_LOG_LOGIC ("No grant allocated in this slot");
+      return;
+    }
+
   bool atLeastOneTransmissionInSlot = false;
   //check if we need to transmit PSCCH + PSSCH
   //We are starting with the transmission of data packets because if the buffer
   //at the RLC would be empty we just erase the grant of the current slot
   //without transmitting SCI 1 and SCI 2 message, and data. Therefore,
   //even we had the grant we will not put anything in the queues at the PHY.
-  for (auto &itGrantMap : m_slGrants)
+  //Only the destinations with an allocation in this slot are visited, in the
+  //same (increasing) order of m_slGrants.
+  for (const auto &itDueDst : itDue->second)
     {
-      if (itGrantMap.second.empty ())
-        {
-          continue;
-        }
-      for (auto itGrant =  itGrantMap.second.begin () ; itGrant != itGrantMap.second.end ();)
+      auto itGrantMap = m_slGrants.find (itDueDst.first);
+      NS_ASSERT_MSG (itGrantMap != m_slGrants.end (), "No grant for destination " << itDueDst.first << " in the timeline slot " << currentSlotNum);
+      for (auto itGrant =  itGrantMap->second.begin () ; itGrant != itGrantMap->second.end ();)
         {
           bool removeGrant = false;
-          NrSlUeMacSchedSapUser::NrSlGrant currentGrant = *itGrant;
+          const NrSlUeMacSchedSapUser::NrSlGrant &currentGrant = *itGrant;
 
           NS_ASSERT_MSG (itGrant->slotAllocations.size() > 0, "Empty grant in m_slGrants when iterated in NrUeMac::DoNrSlSlotIndication, harqId " << +itGrant->nrSlHarqId);
           auto currentSlotIt = itGrant->slotAllocations.begin ();
-          NrSlSlotAlloc currentSlot = *currentSlotIt;
-          if (currentGrant.slotAllocations.begin ()->sfn == sfn)
+          if (currentSlotIt->sfn == sfn)
             {
-              // Remove current slot allocation from this grant
+              // Remove current slot allocation from this grant. The timeline
+              // entry of this slot is erased once all the grants are served.
+              const NrSlSlotAlloc currentSlot = *currentSlotIt;
               itGrant->slotAllocations.erase (currentSlotIt);
+              //counter of the grant before this transmission
+              const uint8_t tbTxCounter = itGrant->tbTxCounter;
               NS_LOG_INFO ("Grant at : Frame = " << currentSlot.sfn.GetFrame ()
                            << " SF = " << +currentSlot.sfn.GetSubframe ()
                            << " slot = " << +currentSlot.sfn.GetSlot ());
               if (currentSlot.ndi)
                 {
-                  Ptr<PacketBurst> pb = CreateObject <PacketBurst> ();
-                  pb = m_nrSlHarq->GetPacketBurst (currentSlot.dstL2Id, currentGrant.nrSlHarqId);
+                  Ptr<PacketBurst> pb = m_nrSlHarq->GetPacketBurst (currentSlot.dstL2Id, currentGrant.nrSlHarqId);
                   if (pb->GetNPackets () > 0)
                     {
                       m_nrSlMacPduTxed = true;
@@ -1968,8 +2011,7 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
                   //buffer. I am not doing it at the moment as it might slow down
                   //the simulation.
                   itGrant->tbTxCounter++;
-                  Ptr<PacketBurst> pb = CreateObject <PacketBurst> ();
-                  pb = m_nrSlHarq->GetPacketBurst (currentSlot.dstL2Id, currentGrant.nrSlHarqId);
+                  Ptr<PacketBurst> pb = m_nrSlHarq->GetPacketBurst (currentSlot.dstL2Id, currentGrant.nrSlHarqId);
                   if (m_enableBlindReTx)
                     {
                       if (pb->GetNPackets () > 0)
@@ -1996,7 +2038,7 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
                       NS_FATAL_ERROR ("Feedback based retransmissions are not supported");
                     }
                 }
-              if (currentGrant.tbTxCounter == currentGrant.nSelected)
+              if (tbTxCounter == currentGrant.nSelected)
                 {
                   //generate fake feedback. It is important to clear the
                   //HARQ buffer, which make the HARQ id available again
@@ -2013,7 +2055,8 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
                   NS_LOG_DEBUG ("Grant wasted at : Frame = " << currentSlot.sfn.GetFrame () << " SF = " << +currentSlot.sfn.GetSubframe () << " slot = " << currentSlot.sfn.GetSlot ());
                   if (removeGrant)
                     {
-                      itGrant = itGrantMap.second.erase (itGrant);
+                      RemoveNrSlGrantFromTimeline (itGrantMap->first, *itGrant);
+                      itGrant = itGrantMap->second.erase (itGrant);
                     }
                   else
                     {
@@ -2045,8 +2088,8 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
               dataVarTtiInfo.symStart = currentSlot.slPsschSymStart;
               dataVarTtiInfo.symLength = currentSlot.slPsschSymLength;
               dataVarTtiInfo.symLength = 12;
-              dataVarTtiInfo.rbStart = currentSlot.slPsschSubChStart * m_slTxPool->GetNrSlSubChSize (GetBwpId (), m_poolId);
-              dataVarTtiInfo.rbLength = currentSlot.slPsschSubChLength * m_slTxPool->GetNrSlSubChSize (GetBwpId (), m_poolId);
+              dataVarTtiInfo.rbStart = currentSlot.slPsschSubChStart * m_slSubChSize;
+              dataVarTtiInfo.rbLength = currentSlot.slPsschSubChLength * m_slSubChSize;
               m_nrSlUePhySapProvider->SetNrSlVarTtiAllocInfo (sfn, dataVarTtiInfo);
 
               // Collect statistics for NR SL PSCCH UE MAC scheduling trace
@@ -2059,9 +2102,9 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
               psschStatsParams.slotNum = currentSlot.sfn.GetSlot ();
               psschStatsParams.symStart = currentSlot.slPsschSymStart;
               psschStatsParams.symLength = currentSlot.slPsschSymLength;
-              psschStatsParams.rbStart = currentSlot.slPsschSubChStart * m_slTxPool->GetNrSlSubChSize (GetBwpId (), m_poolId);
-              psschStatsParams.subChannelSize = m_slTxPool->GetNrSlSubChSize (GetBwpId (), m_poolId);
-              psschStatsParams.rbLength = currentSlot.slPsschSubChLength * m_slTxPool->GetNrSlSubChSize (GetBwpId (), m_poolId);
+              psschStatsParams.rbStart = currentSlot.slPsschSubChStart * m_slSubChSize;
+              psschStatsParams.subChannelSize = m_slSubChSize;
+              psschStatsParams.rbLength = currentSlot.slPsschSubChLength * m_slSubChSize;
               psschStatsParams.harqId = currentGrant.nrSlHarqId;
               psschStatsParams.ndi = currentSlot.ndi;
               psschStatsParams.rv = currentSlot.rv;
@@ -2085,7 +2128,7 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
                   sciF1a.SetMcs (currentSlot.mcs);
                   sciF1a.SetSciStage2Format (NrSlSciF1aHeader::SciFormat2A);
                   sciF1a.SetSlResourceReservePeriod (static_cast <uint16_t> (currentGrant.rri.GetMilliSeconds ()));
-                  sciF1a.SetTotalSubChannels (GetTotalSubCh (m_poolId));
+                  sciF1a.SetTotalSubChannels (m_slTotalSubCh);
                   sciF1a.SetIndexStartSubChannel (currentSlot.slPsschSubChStart);
                   sciF1a.SetLengthSubChannel (currentSlot.slPsschSubChLength);
                   sciF1a.SetSlMaxNumPerReserve (currentSlot.maxNumPerReserve);
@@ -2122,7 +2165,7 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
                   ctrlVarTtiInfo.SlVarTtiType = NrSlVarTtiAllocInfo::CTRL;
                   ctrlVarTtiInfo.symStart = currentSlot.slPscchSymStart;
                   ctrlVarTtiInfo.symLength = currentSlot.slPscchSymLength;
-                  ctrlVarTtiInfo.rbStart = currentSlot.slPsschSubChStart * m_slTxPool->GetNrSlSubChSize (GetBwpId (), m_poolId);
+                  ctrlVarTtiInfo.rbStart = currentSlot.slPsschSubChStart * m_slSubChSize;
                   ctrlVarTtiInfo.rbLength = currentSlot.numSlPscchRbs;
                   m_nrSlUePhySapProvider->SetNrSlVarTtiAllocInfo (sfn, ctrlVarTtiInfo);
 
@@ -2136,13 +2179,13 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
                   pscchStatsParams.slotNum = currentSlot.sfn.GetSlot ();
                   pscchStatsParams.symStart = currentSlot.slPscchSymStart;
                   pscchStatsParams.symLength = currentSlot.slPscchSymLength;
-                  pscchStatsParams.rbStart = currentSlot.slPsschSubChStart * m_slTxPool->GetNrSlSubChSize (GetBwpId (), m_poolId);
+                  pscchStatsParams.rbStart = currentSlot.slPsschSubChStart * m_slSubChSize;
                   pscchStatsParams.rbLength = currentSlot.numSlPscchRbs;
                   pscchStatsParams.priority = currentSlot.priority;
                   pscchStatsParams.mcs = currentSlot.mcs;
                   pscchStatsParams.tbSize = currentGrant.tbSize;
                   pscchStatsParams.slResourceReservePeriod = static_cast <uint16_t> (currentGrant.rri.GetMilliSeconds ());
-                  pscchStatsParams.totalSubChannels = GetTotalSubCh (m_poolId);
+                  pscchStatsParams.totalSubChannels = m_slTotalSubCh;
                   pscchStatsParams.slPsschSubChStart = currentSlot.slPsschSubChStart;
                   pscchStatsParams.slPsschSubChLength = currentSlot.slPsschSubChLength;
                   pscchStatsParams.slMaxNumPerReserve = currentSlot.maxNumPerReserve;
@@ -2160,7 +2203,8 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
 
           if (removeGrant)
             {
-              itGrant = itGrantMap.second.erase (itGrant);
+              RemoveNrSlGrantFromTimeline (itGrantMap->first, *itGrant);
+              itGrant = itGrantMap->second.erase (itGrant);
             }
           else
             {
@@ -2171,6 +2215,7 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
           m_nrSlMacPduTxed = false;
         }
     }
+  m_slGrantTimeline.erase (itDue);
   if (atLeastOneTransmissionInSlot)
     {
       NS_LOG_DEBUG ("IMSI " << m_imsi << " adding SFN history at sfn " << sfn);
@@ -2178,6 +2223,47 @@ NrUeMac::DoNrSlSlotIndication (const SfnSf& sfn)
     }
 }
 
+void
+NrUeMac::RemoveNrSlGrantFromTimeline (uint32_t dstL2Id, const NrSlUeMacSchedSapUser::NrSlGrant& grant)
+{
+  NS_LOG_FUNCTION (this << dstL2Id);
+
+  for (const auto &itSlotAlloc : grant.slotAllocations)
+    {
+      auto itSlot = m_slGrantTimeline.find (itSlotAlloc.sfn.Normalize ());
+      if (itSlot == m_slGrantTimeline.end ())
+        {
+          //already dropped, it was in the past
+          continue;
+        }
+      auto itDst = itSlot->second.find (dstL2Id);
+      NS_ASSERT_MSG (itDst != itSlot->second.end () && itDst->second > 0,
+                     "Slot allocation of destination " << dstL2Id << " not found in the timeline");
+      if (--itDst->second == 0)
+        {
+          itSlot->second.erase (itDst);
+          if (itSlot->second.empty ())
+            {
+              m_slGrantTimeline.erase (itSlot);
+            }
+        }
+    }
+}
+
+void
+NrUeMac::UpdateNrSlPoolParams (const SfnSf& sfn)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_slTxPool != nullptr, "No NR Sidelink TX pool installed");
+  m_slSubChSize = m_slTxPool->GetNrSlSubChSize (GetBwpId (), m_poolId);
+  m_slTotalSubCh = GetTotalSubCh (m_poolId);
+  const NrSlPoolCacheEntry &poolCache = GetNrSlPoolCacheEntry (m_slTxPool, GetBwpId (), m_poolId,
+                                                               sfn.GetNumerology (),
+                                                               m_nrSlUePhySapProvider->GetSlotPeriod ());
+  m_slSlotMap = &poolCache.m_slotMap;
+  m_slSensWindInSlots = poolCache.m_sensWindInSlots;
+}
+
 std::vector<uint8_t>
 NrUeMac::ComputeGaps (const SfnSf& sfn,
                       std::set <NrSlSlotAlloc>::const_iterator it, uint8_t slotNumInd)
@@ -2238,6 +2324,10 @@ NrUeMac::DoSchedUeNrSlConfigInd (uint32_t dstL2Id, const NrSlUeMacSchedSapUser::
         }
       it->second.push_back  (grant);
     }
+  for (const auto &itSlotAlloc : grant.slotAllocations)
+    {
+      m_slGrantTimeline[itSlotAlloc.sfn.Normalize ()][dstL2Id]++;
+    }
   // The grant has a set of NrSlSlotAlloc.  One of these slots will be for
   // new data and some for retransmissions.  For the new data slots, notify
   // the RLC layer of transmission opportunities.
@@ -2449,7 +2539,7 @@ NrUeMac::DoResetNrSlLcMap ()
     {
       if (it->first.lcId > 3) //SL DRB LC starts from 4
         {
-          m_nrSlLcInfoMap.erase (it);
+          it = m_nrSlLcInfoMap.erase (it);
         }
       else
         {
@@ -2495,6 +2585,8 @@ NrUeMac::DoAddNrSlCommTxPool (Ptr<const NrSlCommResourcePool> txPool)
 {
   NS_LOG_FUNCTION (this << txPool);
   m_slTxPool = txPool;
+  //pool parameters are computed again in the next slot
+  m_slSubChSize = 0;
 }
 
 void
@@ -2637,6 +2729,7 @@ void
 NrUeMac::SetSlActivePoolId (uint16_t poolId)
 {
   m_poolId =  poolId;
+  m_slSubChSize = 0;
 }
 
 uint8_t
@@ -37,8 +37,10 @@
 #include "nr-sl-ue-mac-sched-sap.h"
 #include "nr-sl-phy-mac-common.h"
 #include "nr-sl-ue-mac-scheduler.h"
+#include "nr-sl-pool-slot-map.h"
 #include <unordered_set>
 #include <map>
+#include <tuple>
 
 // test classes outside of namespace ns3
 class NrSensingTestCase;
@@ -1037,6 +1039,34 @@ private:
    return l.lcId < r.lcId || (l.lcId == r.lcId && l.srcL2Id < r.srcL2Id) || (l.lcId == r.lcId && l.srcL2Id == r.srcL2Id && l.dstL2Id < r.dstL2Id);
   }
 
+  /**
+   * \brief Equality operator
+   *
+   * \param l first SidelinkLcIdentifier
+   * \param r second SidelinkLcIdentifier
+   * \returns true if all the parameters of the two SidelinkLcIdentifier are equal
+   */
+  friend bool operator == (const SidelinkLcIdentifier &l, const SidelinkLcIdentifier &r)
+  {
+   return l.lcId == r.lcId && l.srcL2Id == r.srcL2Id && l.dstL2Id == r.dstL2Id;
+  }
+
+  ///Hash of a SidelinkLcIdentifier
+  struct SidelinkLcIdentifierHash
+  {
+    /**
+     * \brief Compute the hash of a SidelinkLcIdentifier
+     * \param id the SidelinkLcIdentifier
+     * \return the hash of the identifier
+     */
+    std::size_t operator () (const SidelinkLcIdentifier &id) const
+    {
+      // The L2 IDs are 24 bits long, the LCID 5 bits
+      uint64_t key = (static_cast<uint64_t> (id.srcL2Id) << 32) ^ (static_cast<uint64_t> (id.dstL2Id) << 5) ^ id.lcId;
+      return std::hash<uint64_t> () (key);
+    }
+  };
+
   ///Sidelink Logical Channel Information
   struct SlLcInfoUeMac
   {
@@ -1092,29 +1122,62 @@ Time slotPeriod, uint16_t resvPeriodSlots) const;
    * \return The list of NR compatible slot info
    */
   std::list <NrSlUeMacSchedSapProvider::NrSlSlotInfo> GetNrSupportedList (const SfnSf& sfn, std::list <NrSlCommResourcePool::SlotInfo> slotInfo);
+  /**
+   * \brief Values of a TX pool, computed once per BWP, pool and numerology
+   */
+  struct NrSlPoolCacheEntry
+  {
+    Ptr<const NrSlCommResourcePool> m_pool; //!< The pool the values were computed for
+    NrSlPoolSlotMap m_slotMap; //!< Map of the sidelink slots of the physical pool
+    uint16_t m_sensWindInSlots {0}; //!< Sensing window T0 in slots
+    uint16_t m_numSlPscchRbs {0}; //!< Number of PSCCH RBs of every SL slot
+    uint16_t m_slPscchSymStart {0}; //!< Starting PSCCH symbol of every SL slot
+    uint16_t m_slPscchSymLength {0}; //!< Number of PSCCH symbols of every SL slot
+    uint16_t m_slPsschSymStart {0}; //!< Starting PSSCH symbol of every SL slot
+    uint16_t m_slPsschSymLength {0}; //!< Number of PSSCH symbols of every SL slot
+    uint16_t m_slSubchannelSize {0}; //!< Sub-channel size in RBs
+    uint16_t m_slMaxNumPerReserve {0}; //!< Maximum number of reserved PSCCH/PSSCH resources
+  };
+  /**
+   * \brief Get the cached values of a TX pool, computing them if needed
+   *
+   * The values are computed again if the pool object of the BWP and pool id
+   * changes, e.g., when a new TX pool is installed.
+   *
+   * \param txPool The TX pool
+   * \param bwpId The bandwidth part id
+   * \param poolId The pool id
+   * \param numerology The numerology of the BWP
+   * \param slotPeriod The slot period of the BWP
+   * \return The cached values
+   */
+  const NrSlPoolCacheEntry& GetNrSlPoolCacheEntry (Ptr<const NrSlCommResourcePool> txPool, uint8_t bwpId,
+                                                    uint16_t poolId, uint16_t numerology, Time slotPeriod) const;
   /**
    * \brief Return all of the candidate single-slot resources (step 1 of
    *        TS 38.214 Section 8.1.4)
    *
-   * Method to convert the list of NrSlCommResourcePool::SlotInfo (slots)
-   * NrSlUeMacSchedSapProvider::NrSlSlotInfo (with widths of subchannels)
+   * Method to convert the sidelink slots of the selection window into
+   * NrSlUeMacSchedSapProvider::NrSlSlotInfo (with widths of subchannels).
+   * The slot parameters are the same for all the slots of a pool, and are
+   * taken from the pool cache, so no NrSlCommResourcePool::SlotInfo list is
+   * built.
    *
-   * NrSlCommResourcePool class exists in the LTE module, therefore, we can not
-   * have an object of NR SfnSf class there due to dependency issue. The use of
-   * SfnSf class makes our life easier since it already implements the necessary
-   * arithmetics of adding slots, constructing new SfnSf given the slot offset,
-   * and e.t.c. In this method, we use the slot offset value, which is the
-   * offset in number of slots from the current slot to construct the object of
-   * SfnSf class.
+   * In this method, we use the slot offset value, which is the offset in
+   * number of slots from the current slot to construct the object of SfnSf
+   * class.
    *
    * \param sfn The current system frame, subframe, and slot number. This SfnSf
    *        is aligned with the SfnSf of the physical layer.
    * \param lSubch Width of candidate resource (number of subchannels)
    * \param numSubch Number of contiguous subchannels
-   * \param slotInfo the list of LTE module compatible slot info
+   * \param poolCache The cached values of the TX pool
+   * \param slotOffsets The offsets of the sidelink slots of the selection window
    * \return The list of NR compatible slot info
    */
-  std::list <NrSlUeMacSchedSapProvider::NrSlSlotInfo> GetNrSlCandidateResourcesFromSlots (const SfnSf& sfn, uint16_t lSubch, uint16_t numSubch, std::list <NrSlCommResourcePool::SlotInfo> slotInfo) const;
+  std::list <NrSlUeMacSchedSapProvider::NrSlSlotInfo> GetNrSlCandidateResourcesFromSlots (const SfnSf& sfn, uint16_t lSubch, uint16_t numSubch,
+                                                                                          const NrSlPoolCacheEntry& poolCache,
+                                                                                          const std::vector<uint32_t>& slotOffsets) const;
 
   /**
    * \brief Removes resources which are already part of an existing published grant.
@@ -1151,6 +1214,20 @@ Time slotPeriod, uint16_t resvPeriodSlots) const;
    * \param imsi The IMSI of this instance 
    */
   void RemoveOldTransmitHistory (const SfnSf& sfn, uint16_t sensingWindow, std::list<SfnSf>& history, [[maybe_unused]] uint64_t imsi);
+  /**
+   * \brief Remove the remaining slot allocations of a grant from the timeline
+   *        of the granted slots.
+   * \param dstL2Id The destination layer 2 id of the grant
+   * \param grant The grant that is going to be removed from m_slGrants
+   */
+  void RemoveNrSlGrantFromTimeline (uint32_t dstL2Id, const NrSlUeMacSchedSapUser::NrSlGrant& grant);
+  /**
+   * \brief Compute the sub-channel size, the total number of sub-channels,
+   *        the sidelink slots and the sensing window of the active TX pool,
+   *        used in every slot.
+   * \param sfn The current slot, which gives the numerology
+   */
+  void UpdateNrSlPoolParams (const SfnSf& sfn);
   /**
    * \brief Compute the gaps in slots for the possible retransmissions
    *        indicated by an SCI 1-A.
@@ -1186,7 +1263,7 @@ Time slotPeriod, uint16_t resvPeriodSlots) const;
 
   std::list<SfnSf> m_transmitHistory; //!< History of slots used for transmission
 
-  std::map <SidelinkLcIdentifier, SlLcInfoUeMac> m_nrSlLcInfoMap; //!< Sidelink logical channel info map
+  std::unordered_map <SidelinkLcIdentifier, SlLcInfoUeMac, SidelinkLcIdentifierHash> m_nrSlLcInfoMap; //!< Sidelink logical channel info map
   NrSlMacSapProvider* m_nrSlMacSapProvider; //!< SAP interface to receive calls from the UE RLC instance
   NrSlMacSapUser* m_nrSlMacSapUser {nullptr}; //!< SAP interface to call the methods of UE RLC instance
   NrSlUeCmacSapProvider* m_nrSlUeCmacSapProvider; //!< Control SAP interface to receive calls from the UE RRC instance
@@ -1210,6 +1287,22 @@ Time slotPeriod, uint16_t resvPeriodSlots) const;
   NrSlUeMacSchedSapProvider* m_nrSlUeMacSchedSapProvider   {nullptr};  //!< SAP Provider
   Ptr<NrSlUeMacScheduler> m_nrSlUeMacScheduler {nullptr}; //!< Pointer to scheduler
   std::map<uint32_t, std::deque<NrSlUeMacSchedSapUser::NrSlGrant> > m_slGrants; //!< Grants provided by the sidelink scheduler
+  /**
+   * Timeline of the slot allocations of m_slGrants: normalized slot number ->
+   * destination layer 2 id -> number of slot allocations of the destination
+   * in that slot. It lets DoNrSlSlotIndication visit only the grants due in
+   * the current slot.
+   */
+  std::map<uint64_t, std::map<uint32_t, uint32_t> > m_slGrantTimeline;
+  uint16_t m_slSubChSize {0}; //!< Sub-channel size of the active TX pool, 0 if not computed yet
+  const NrSlPoolSlotMap* m_slSlotMap {nullptr}; //!< Sidelink slots of the active TX pool, in m_slPoolCache
+  uint16_t m_slSensWindInSlots {0}; //!< Sensing window of the active TX pool in slots
+  /**
+   * Cached values of the TX pools: (BWP id, pool id, numerology) -> values.
+   * Mutable since it is filled by the const GetNrSlCandidateResourcesPrivate.
+   */
+  mutable std::map<std::tuple<uint8_t, uint16_t, uint16_t>, NrSlPoolCacheEntry> m_slPoolCache;
+  uint8_t m_slTotalSubCh {0}; //!< Total number of sub-channels of the active TX pool
 
   double m_slProbResourceKeep {0.0}; //!< Sidelink probability of keeping a resource after resource re-selection counter reaches zero
   uint8_t m_slMaxTxTransNumPssch {0}; /**< Indicates the maximum transmission number
@@ -127,6 +127,14 @@ NrUePhy::GetTypeId (void)
                     BooleanValue (false),
                     MakeBooleanAccessor (&NrUePhy::SetEnableUplinkPowerControl),
                     MakeBooleanChecker ())
+    .AddAttribute ("IdleSlotElision",
+                   "If true, the PHY stops its slot loop when the UE has nothing to do "
+                   "in the next slots, and restarts it when a DCI or a CTRL message "
+                   "for the UE arrives, or when the MAC asks for it. The simulation "
+                   "output is the same, with fewer events for idle UEs.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NrUePhy::m_idleSlotElision),
+                   MakeBooleanChecker ())
     .AddAttribute ("FixedRankIndicator",
                    "The rank indicator",
                    UintegerValue (1),
@@ -350,6 +358,7 @@ void
 NrUePhy::RegisterToEnb (uint16_t bwpId)
 {
   NS_LOG_FUNCTION (this);
+  ResumeSlotLoop ();
 
   InitializeMessageList ();
   DoSetCellId (bwpId);
@@ -358,12 +367,14 @@ NrUePhy::RegisterToEnb (uint16_t bwpId)
 void
 NrUePhy::SetUlCtrlSyms(uint8_t ulCtrlSyms)
 {
+  ResumeSlotLoop ();
   m_ulCtrlSyms = ulCtrlSyms;
 }
 
 void
 NrUePhy::SetDlCtrlSyms(uint8_t dlCtrlSyms)
 {
+  ResumeSlotLoop ();
   m_dlCtrlSyms = dlCtrlSyms;
 }
 
@@ -377,6 +388,7 @@ void
 NrUePhy::SetPattern (const std::string &pattern)
 {
   NS_LOG_FUNCTION (this);
+  ResumeSlotLoop ();
 
   static std::unordered_map<std::string, LteNrTddSlotType> lookupTable =
   {
@@ -466,6 +478,38 @@ NrUePhy::PhyCtrlMessagesReceived (const Ptr<NrControlMessage> &msg)
 {
   NS_LOG_FUNCTION (this);
 
+  if (m_slotLoopSuspended)
+    {
+      // DCIs for other UEs are only traced, and MIB/SIB1 go to the RRC, that
+      // changes the PHY only through methods that resume the loop: for them,
+      // it is enough to know the current slot
+      bool notForMe = false;
+      if (msg->GetMessageType () == NrControlMessage::DL_DCI)
+        {
+          auto rnti = DynamicCast<NrDlDciMessage> (msg)->GetDciInfoElement ()->m_rnti;
+          notForMe = rnti != 0 && rnti != m_rnti;
+        }
+      else if (msg->GetMessageType () == NrControlMessage::UL_DCI)
+        {
+          auto rnti = DynamicCast<NrUlDciMessage> (msg)->GetDciInfoElement ()->m_rnti;
+          notForMe = rnti != 0 && rnti != m_rnti;
+        }
+      else if (msg->GetMessageType () == NrControlMessage::MIB
+               || msg->GetMessageType () == NrControlMessage::SIB1)
+        {
+          notForMe = true;
+        }
+
+      if (notForMe)
+        {
+          SyncSuspendedSlot ();
+        }
+      else
+        {
+          ResumeSlotLoop ();
+        }
+    }
+
   if (msg->GetMessageType () == NrControlMessage::DL_DCI)
     {
       auto dciMsg = DynamicCast<NrDlDciMessage> (msg);
@@ -682,9 +726,9 @@ NrUePhy::PushCtrlAllocations (const SfnSf currentSfnSf)
   if (m_tddPattern.size () == 0)
     {
       NS_LOG_INFO ("TDD Pattern unknown, insert DL CTRL at the beginning of the slot");
-      VarTtiAllocInfo dlCtrlSlot (std::make_shared<DciInfoElementTdma> (0, m_dlCtrlSyms,
-                                                                        DciInfoElementTdma::DL,
-                                                                        DciInfoElementTdma::CTRL, rbgBitmask));
+      VarTtiAllocInfo dlCtrlSlot (m_dciPool.Create (0, m_dlCtrlSyms,
+                                                    DciInfoElementTdma::DL,
+                                                    DciInfoElementTdma::CTRL, rbgBitmask));
       m_currSlotAllocInfo.m_varTtiAllocInfo.push_front (dlCtrlSlot);
       return;
     }
@@ -696,9 +740,9 @@ NrUePhy::PushCtrlAllocations (const SfnSf currentSfnSf)
       NS_LOG_INFO ("The current TDD pattern indicates that we are in a " <<
                    m_tddPattern[currentSlotN] <<
                    " slot, so insert DL CTRL at the beginning of the slot");
-      VarTtiAllocInfo dlCtrlSlot (std::make_shared<DciInfoElementTdma> (0, m_dlCtrlSyms,
-                                                                        DciInfoElementTdma::DL,
-                                                                        DciInfoElementTdma::CTRL, rbgBitmask));
+      VarTtiAllocInfo dlCtrlSlot (m_dciPool.Create (0, m_dlCtrlSyms,
+                                                    DciInfoElementTdma::DL,
+                                                    DciInfoElementTdma::CTRL, rbgBitmask));
       m_currSlotAllocInfo.m_varTtiAllocInfo.push_front (dlCtrlSlot);
     }
   if (m_tddPattern[currentSlotN] > LteNrTddSlotType::DL)
@@ -706,10 +750,10 @@ NrUePhy::PushCtrlAllocations (const SfnSf currentSfnSf)
       NS_LOG_INFO ("The current TDD pattern indicates that we are in a " <<
                    m_tddPattern[currentSlotN] <<
                    " slot, so insert UL CTRL at the end of the slot");
-      VarTtiAllocInfo ulCtrlSlot (std::make_shared<DciInfoElementTdma> (GetSymbolsPerSlot () - m_ulCtrlSyms,
-                                                                        m_ulCtrlSyms,
-                                                                        DciInfoElementTdma::UL,
-                                                                        DciInfoElementTdma::CTRL, rbgBitmask));
+      VarTtiAllocInfo ulCtrlSlot (m_dciPool.Create (GetSymbolsPerSlot () - m_ulCtrlSyms,
+                                                    m_ulCtrlSyms,
+                                                    DciInfoElementTdma::UL,
+                                                    DciInfoElementTdma::CTRL, rbgBitmask));
       m_currSlotAllocInfo.m_varTtiAllocInfo.push_back (ulCtrlSlot);
     }
 }
@@ -720,6 +764,8 @@ NrUePhy::StartSlot (const SfnSf &s)
   NS_LOG_FUNCTION (this);
   m_currentSlot = s;
   m_lastSlotStart = Simulator::Now ();
+  m_slotLoopSuspended = false;
+  m_resumeRequested = false;
 
   // Call MAC before doing anything in PHY
   m_phySapUser->SlotIndication (m_currentSlot);   // trigger mac
@@ -867,9 +913,13 @@ NrUePhy::UlSrs (const std::shared_ptr<DciInfoElementTdma> &dci)
   Time varTtiDuration = GetSymbolPeriod () * dci->m_numSym;
 
   // SRS will be transmitted over all streams/streams
+  bool traceSrs = !m_phyTxedCtrlMsgsTrace.IsEmpty ();
   for (uint8_t streamIndex = 0; streamIndex < m_spectrumPhys.size(); streamIndex++)
     {
-      m_phyTxedCtrlMsgsTrace (m_currentSlot,  GetCellId (), dci->m_rnti, GetBwpId (), *srsMsg.begin ());
+      if (traceSrs)
+        {
+          m_phyTxedCtrlMsgsTrace (m_currentSlot,  GetCellId (), dci->m_rnti, GetBwpId (), *srsMsg.begin ());
+        }
       m_spectrumPhys.at (streamIndex)->StartTxUlControlFrames (srsMsg, varTtiDuration - NanoSeconds (1.0));
     }
 
@@ -1093,8 +1143,19 @@ NrUePhy::EndVarTti (const std::shared_ptr<DciInfoElementTdma> &dci)
       // end of slot
       m_currentSlot.Add (1);
 
-      Simulator::Schedule (m_lastSlotStart + GetSlotPeriod () - Simulator::Now (),
-                           &NrUePhy::StartSlot, this, m_currentSlot);
+      if (CanSuspendSlotLoop ())
+        {
+          NS_LOG_INFO ("UE " << m_rnti << " idle, suspending the slot loop from slot " <<
+                       m_currentSlot);
+          m_slotLoopSuspended = true;
+          m_suspendedSlot = m_currentSlot;
+          m_suspendedSlotStart = m_lastSlotStart + GetSlotPeriod ();
+        }
+      else
+        {
+          Simulator::Schedule (m_lastSlotStart + GetSlotPeriod () - Simulator::Now (),
+                               &NrUePhy::StartSlot, this, m_currentSlot);
+        }
     }
   else
     {
@@ -1110,6 +1171,233 @@ NrUePhy::EndVarTti (const std::shared_ptr<DciInfoElementTdma> &dci)
   m_receptionEnabled = false;
 }
 
+bool
+NrUePhy::CanSuspendSlotLoop () const
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!m_idleSlotElision || m_resumeRequested || m_rnti == 0 || m_tddPattern.empty ())
+    {
+      return false;
+    }
+
+  if (SlotAllocInfoSize () > 0 || !IsCtrlMsgQueueEmpty () || !m_ctrlMsgs.empty ())
+    {
+      return false;
+    }
+
+  if (m_nrSlUePhySapUser != nullptr || m_slTxPool != nullptr || m_slRxPool != nullptr
+      || !m_slRxGrants.empty ())
+    {
+      return false;
+    }
+
+  // With UL CTRL slots, TryToPerformLbt () and UlCtrl () have no effect only if
+  // the channel is granted and stays granted
+  bool hasUlCtrl = std::any_of (m_tddPattern.begin (), m_tddPattern.end (),
+                                [] (LteNrTddSlotType type) { return type > LteNrTddSlotType::DL; });
+  if (hasUlCtrl && (m_channelStatus != GRANTED
+                    || DynamicCast<NrAlwaysOnAccessManager> (m_cam) == nullptr))
+    {
+      return false;
+    }
+
+  return true;
+}
+
+void
+NrUePhy::GetSuspendedSlot (SfnSf *slot, Time *slotStart) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (Simulator::Now () >= m_suspendedSlotStart);
+
+  int64_t elapsed = (Simulator::Now () - m_suspendedSlotStart).GetTimeStep () /
+      GetSlotPeriod ().GetTimeStep ();
+
+  // An event at the exact start of a slot comes before the slot-loop event
+  // of that time, as it was scheduled earlier. If the previous slot ends with
+  // the UL CTRL, its EndVarTti (that moves to the next slot) is still pending.
+  if (elapsed > 0 && Simulator::Now () == m_suspendedSlotStart + GetSlotPeriod () * elapsed)
+    {
+      SfnSf previous = m_suspendedSlot;
+      previous.Add (static_cast<uint32_t> (elapsed - 1));
+      if (m_tddPattern[previous.Normalize () % m_tddPattern.size ()] > LteNrTddSlotType::DL)
+        {
+          --elapsed;
+        }
+    }
+
+  *slot = m_suspendedSlot;
+  slot->Add (static_cast<uint32_t> (elapsed));
+  *slotStart = m_suspendedSlotStart + GetSlotPeriod () * elapsed;
+}
+
+void
+NrUePhy::SyncSuspendedSlot ()
+{
+  NS_LOG_FUNCTION (this);
+
+  if (Simulator::Now () < m_suspendedSlotStart)
+    {
+      return; // The slot before the suspension is still running
+    }
+
+  SfnSf slot;
+  Time slotStart;
+  GetSuspendedSlot (&slot, &slotStart);
+
+  m_currentSlot = slot;
+  if (Simulator::Now () == slotStart)
+    {
+      // StartSlot of this slot is not yet done
+      m_lastSlotStart = slotStart - GetSlotPeriod ();
+      return;
+    }
+
+  m_lastSlotStart = slotStart;
+  // In a DL slot, EndVarTti of the DL CTRL moves to the next slot
+  uint64_t slotN = slot.Normalize () % m_tddPattern.size ();
+  if (m_tddPattern[slotN] == LteNrTddSlotType::DL
+      && Simulator::Now () > slotStart + GetSymbolPeriod () * m_dlCtrlSyms)
+    {
+      m_currentSlot.Add (1);
+    }
+}
+
+uint64_t
+NrUePhy::CountSuspendedSlotEvents () const
+{
+  NS_LOG_FUNCTION (this);
+
+  if (Simulator::Now () <= m_suspendedSlotStart)
+    {
+      return 0;
+    }
+
+  // StartSlot, plus StartVarTti and EndVarTti for each CTRL allocation
+  auto slotEvents = [] (LteNrTddSlotType type) -> uint64_t
+    {
+      return 1 + 2 * ((type < LteNrTddSlotType::UL ? 1 : 0) + (type > LteNrTddSlotType::DL ? 1 : 0));
+    };
+
+  SfnSf slot;
+  Time slotStart;
+  GetSuspendedSlot (&slot, &slotStart);
+
+  // Slots that are over: the pattern repeats, so count each position once
+  uint64_t count = 0;
+  uint64_t pastSlots = static_cast<uint64_t> ((slotStart - m_suspendedSlotStart).GetTimeStep () /
+                                              GetSlotPeriod ().GetTimeStep ());
+  uint64_t patternSize = m_tddPattern.size ();
+  for (uint64_t i = 0; i < patternSize && i < pastSlots; ++i)
+    {
+      uint64_t occurrences = (pastSlots - i + patternSize - 1) / patternSize;
+      uint64_t slotN = (m_suspendedSlot.Normalize () + i) % patternSize;
+      count += occurrences * slotEvents (m_tddPattern[slotN]);
+    }
+
+  // The current slot: events strictly before now
+  Time now = Simulator::Now ();
+  if (now > slotStart)
+    {
+      LteNrTddSlotType type = m_tddPattern[slot.Normalize () % patternSize];
+      count++; // StartSlot
+      if (type < LteNrTddSlotType::UL)
+        {
+          count++; // StartVarTti of DL CTRL
+          count += (now > slotStart + GetSymbolPeriod () * m_dlCtrlSyms) ? 1 : 0;
+        }
+      if (type > LteNrTddSlotType::DL)
+        {
+          // EndVarTti of the UL CTRL is at the end of the slot
+          count += (now > slotStart + GetSymbolPeriod () * (GetSymbolsPerSlot () - m_ulCtrlSyms)) ? 1 : 0;
+        }
+    }
+
+  return count;
+}
+
+void
+NrUePhy::ResumeSlotLoop ()
+{
+  NS_LOG_FUNCTION (this);
+
+  m_resumeRequested = true;
+
+  if (!m_slotLoopSuspended)
+    {
+      return;
+    }
+
+  m_slotLoopSuspended = false;
+  m_elidedEvents += CountSuspendedSlotEvents ();
+
+  Time now = Simulator::Now ();
+  if (now <= m_suspendedSlotStart)
+    {
+      NS_LOG_INFO ("UE " << m_rnti << " resuming the slot loop at slot " << m_suspendedSlot);
+      Simulator::Schedule (m_suspendedSlotStart - now, &NrUePhy::StartSlot, this, m_suspendedSlot);
+      return;
+    }
+
+  SfnSf slot;
+  Time slotStart;
+  GetSuspendedSlot (&slot, &slotStart);
+  NS_LOG_INFO ("UE " << m_rnti << " resuming the slot loop in slot " << slot);
+
+  if (now == slotStart)
+    {
+      m_currentSlot = slot;
+      m_lastSlotStart = slotStart - GetSlotPeriod ();
+      Simulator::ScheduleNow (&NrUePhy::StartSlot, this, slot);
+      return;
+    }
+
+  // Redo what StartSlot () did at the beginning of this slot. The rest of
+  // StartSlot () has no effect for an idle UE (see CanSuspendSlotLoop ()).
+  // The caller did not yet change anything, so the MAC sees the same state.
+  m_currentSlot = slot;
+  m_lastSlotStart = slotStart;
+  m_phySapUser->SlotIndication (m_currentSlot);
+  m_currSlotAllocInfo = SlotAllocInfo (m_currentSlot);
+  PushCtrlAllocations (m_currentSlot);
+
+  // Skip the CTRL allocations that are over, and schedule the pending event
+  while (!m_currSlotAllocInfo.m_varTtiAllocInfo.empty ())
+    {
+      std::shared_ptr<DciInfoElementTdma> dci = m_currSlotAllocInfo.m_varTtiAllocInfo.front ().m_dci;
+      m_currSlotAllocInfo.m_varTtiAllocInfo.pop_front ();
+
+      Time varTtiStart = slotStart + GetSymbolPeriod () * dci->m_symStart;
+      Time varTtiEnd = varTtiStart + GetSymbolPeriod () * dci->m_numSym;
+
+      if (varTtiStart >= now)
+        {
+          Simulator::Schedule (varTtiStart - now, &NrUePhy::StartVarTti, this, dci);
+          return;
+        }
+      if (varTtiEnd >= now)
+        {
+          if (dci->m_format == DciInfoElementTdma::DL)
+            {
+              m_tryToPerformLbt = true; // as set by DlCtrl ()
+            }
+          Simulator::Schedule (varTtiEnd - now, &NrUePhy::EndVarTti, this, dci);
+          return;
+        }
+    }
+
+  // All the allocations of this slot are over
+  m_currentSlot.Add (1);
+  Simulator::Schedule (slotStart + GetSlotPeriod () - now, &NrUePhy::StartSlot, this, m_currentSlot);
+}
+
+uint64_t
+NrUePhy::GetElidedEventsCount () const
+{
+  return m_elidedEvents + (m_slotLoopSuspended ? CountSuspendedSlotEvents () : 0);
+}
+
 void
 NrUePhy::PhyDataPacketReceived (const Ptr<Packet> &p)
 {
@@ -1375,6 +1663,7 @@ void
 NrUePhy::DoSynchronizeWithEnb (uint16_t cellId)
 {
   NS_LOG_FUNCTION (this << cellId);
+  ResumeSlotLoop ();
   DoSetCellId (cellId);
   DoSetInitialBandwidth ();
 }
@@ -1508,6 +1797,7 @@ void
 NrUePhy::DoSetDlBandwidth (uint16_t dlBandwidth)
 {
   NS_LOG_FUNCTION (this << +dlBandwidth);
+  ResumeSlotLoop ();
 
   SetChannelBandwidth (dlBandwidth);
 
@@ -1544,6 +1834,7 @@ void
 NrUePhy::DoSetRnti (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << rnti);
+  ResumeSlotLoop ();
   m_rnti = rnti;
 }
 
@@ -261,6 +261,28 @@ public:
    */
   uint16_t GetRnti () __attribute__((warn_unused_result));
 
+  /**
+   * \brief Restart the slot loop, if it was suspended
+   *
+   * The PHY recovers the slot that would be running now and the events of
+   * that slot that are still pending, as if the slot loop had never stopped.
+   * When the loop is running, it only prevents its suspension at the end of
+   * the current slot.
+   *
+   * \see IdleSlotElision attribute
+   */
+  virtual void ResumeSlotLoop () override;
+
+  /**
+   * \brief Get the number of slot-loop events that were not scheduled
+   *
+   * Counts the StartSlot, StartVarTti and EndVarTti events saved by the
+   * IdleSlotElision attribute since the beginning of the simulation.
+   *
+   * \return the number of elided events
+   */
+  uint64_t GetElidedEventsCount () const;
+
   /**
    * \brief Get the HARQ feedback (on the transmission) from
    * NrSpectrumPhy and send it through ideal PUCCH to gNB
@@ -636,6 +658,44 @@ private:
    */
   void EndVarTti (const std::shared_ptr<DciInfoElementTdma> &dci);
 
+  /**
+   * \brief Check if the slot loop can be stopped at the end of the current slot
+   *
+   * The loop can be stopped when the next slots only contain the CTRL
+   * allocations, and processing them does not change anything: no DATA/SRS
+   * allocation, no CTRL message to send, no sidelink, the channel is
+   * always granted, and the MAC did not ask for the next slot indication.
+   *
+   * \return true if the slot loop can be suspended
+   */
+  bool CanSuspendSlotLoop () const;
+
+  /**
+   * \brief Find the slot that would be running now, if the loop was not suspended
+   *
+   * The caller is taken as scheduled before the slot-loop events of the same
+   * time, so at the start of a slot that follows a slot with UL CTRL, it is
+   * the previous slot, whose last EndVarTti is still pending.
+   *
+   * \param slot the slot (output)
+   * \param slotStart the start time of the slot (output)
+   */
+  void GetSuspendedSlot (SfnSf *slot, Time *slotStart) const;
+
+  /**
+   * \brief Update the current slot while the slot loop is suspended
+   *
+   * Used when receiving CTRL messages that do not require any processing,
+   * so that m_currentSlot is the same as without the suspension.
+   */
+  void SyncSuspendedSlot ();
+
+  /**
+   * \brief Count the slot-loop events that the current suspension saved so far
+   * \return the number of StartSlot/StartVarTti/EndVarTti events before now
+   */
+  uint64_t CountSuspendedSlotEvents () const;
+
   /**
    * \brief Set the Tx power spectral density based on the RB index vector
    * \param mask vector of the index of the RB (in SpectrumValue array)
@@ -843,6 +903,13 @@ private:
   uint8_t m_dlCtrlSyms {1}; //!< Number of CTRL symbols in DL
   uint8_t m_ulCtrlSyms {1}; //!< Number of CTRL symbols in UL
 
+  bool m_idleSlotElision {false};   //!< Stop the slot loop when idle (attribute)
+  bool m_slotLoopSuspended {false}; //!< True if the slot loop is stopped
+  bool m_resumeRequested {false};   //!< True if the loop cannot be stopped at the end of this slot
+  SfnSf m_suspendedSlot;            //!< First slot whose StartSlot was not scheduled
+  Time m_suspendedSlotStart;        //!< Start time of m_suspendedSlot
+  uint64_t m_elidedEvents {0};      //!< Slot-loop events saved by previous suspensions
+
   double m_rsrp {0}; //!< The latest measured RSRP value
 
   /**
@@ -1104,6 +1171,7 @@ private:
   Ptr<const NrSlCommResourcePool> m_slTxPool; //!< Sidelink communication transmission pools
   Ptr<const NrSlCommResourcePool> m_slRxPool; //!< Sidelink communication reception pools
   std::deque <SlRxGrantInfo> m_slRxGrants; //!< Sidelink RX grants indicated by SCI 1-A
+  NrDciPool m_dciPool; //!< Pool of the CTRL DCIs
 };
 
 }
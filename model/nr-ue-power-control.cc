@@ -366,6 +366,7 @@ NrUePowerControl::ReportTpcPusch (uint8_t tpc)
       m_deltaPusch.push_back (GetAbsoluteDelta (tpc));
       NS_LOG_INFO ("Reported TPC: " << (int)tpc << " delta absolute: " << GetAbsoluteDelta (tpc) << " Fc: " << m_fc);
     }
+  m_deltaPuschSum += m_deltaPusch.back ();
 
   /**
    * If m_technicalSpec == TS_38_213 we should only save the
@@ -390,11 +391,13 @@ NrUePowerControl::ReportTpcPusch (uint8_t tpc)
                   || (m_curPuschTxPower >= m_Pcmax && m_deltaPusch.at (0) > 0))
                 {
                   //TPC commands for serving cell shall not be accumulated
+                  m_deltaPuschSum -= m_deltaPusch.front ();
                   m_deltaPusch.erase (m_deltaPusch.begin ());
                 }
               else
                 {
                   m_fc = m_fc + m_deltaPusch.at (0);
+                  m_deltaPuschSum -= m_deltaPusch.front ();
                   m_deltaPusch.erase (m_deltaPusch.begin ());
                 }
             }
@@ -406,6 +409,7 @@ NrUePowerControl::ReportTpcPusch (uint8_t tpc)
       else
         { // m_deltaPusch contains absolute values, assign an absolute value
           m_fc = m_deltaPusch.at (0);
+          m_deltaPuschSum -= m_deltaPusch.front ();
           m_deltaPusch.erase (m_deltaPusch.begin ());
         }
     }
@@ -415,6 +419,7 @@ NrUePowerControl::ReportTpcPusch (uint8_t tpc)
       // the maximum number of command that will be saved is 100
       if (m_deltaPusch.size () == 100)
         {
+          m_deltaPuschSum -= m_deltaPusch.front ();
           m_deltaPusch.erase (m_deltaPusch.begin ());
         }
       // update of m_fc and m_hc happens in a separated function, UpdateFc
@@ -492,6 +497,7 @@ NrUePowerControl::ReportTpcPucch (uint8_t tpc)
    * accumulated mode for PUCCH.
    */
   m_deltaPucch.push_back (GetAccumulatedDelta (tpc));
+  m_deltaPucchSum += m_deltaPucch.back ();
 
   /**
    * If m_technicalSpec == TS_38_213 we should only save the
@@ -513,11 +519,13 @@ NrUePowerControl::ReportTpcPucch (uint8_t tpc)
           if ((m_curPucchTxPower <= m_Pcmin && m_deltaPucch.at (0) < 0) || (m_curPucchTxPower >= m_Pcmax && m_deltaPucch.at (0) > 0))
              {
                //TPC commands for should not be accumulated because the maximum or minimum is reached
+               m_deltaPucchSum -= m_deltaPucch.front ();
                m_deltaPucch.erase (m_deltaPucch.begin ());
               }
            else
              {
                 m_gc = m_gc + m_deltaPucch.at (0); // gc(i) = gc (i-1) + delta (i- KPUCCH) for TDD and FDD-TDD TS 36.213
+                m_deltaPucchSum -= m_deltaPucch.front ();
                 m_deltaPucch.erase (m_deltaPucch.begin ());
               }
          }
@@ -528,6 +536,7 @@ NrUePowerControl::ReportTpcPucch (uint8_t tpc)
       // the maximum number of command that will be saved is 100
       if (m_deltaPucch.size () == 100)
         {
+          m_deltaPucchSum -= m_deltaPucch.front ();
           m_deltaPucch.erase (m_deltaPucch.begin ());
         }
       // update of m_gc happens in a separated function UpdateGc
@@ -554,12 +563,11 @@ NrUePowerControl::UpdateFc ()
   // PUSCH power control accumulation or absolute value configuration
   if (m_accumulationEnabled)
     {
-      for (const auto& i: m_deltaPusch)
-        {
-          m_fc += i; // fc already hold value for fc(i-i0) occasion
-        }
-
+      // fc already hold value for fc(i-i0) occasion, the deltas are integers,
+      // so adding their sum is exact
+      m_fc += m_deltaPuschSum;
       m_deltaPusch.clear (); // we have used these values, no need to save them any more
+      m_deltaPuschSum = 0;
     }
   else
     {
@@ -568,6 +576,7 @@ NrUePowerControl::UpdateFc ()
           m_fc = m_deltaPusch.back ();
           m_deltaPusch.pop_back (); // use the last received absolute TPC command ( 7.1.1 UE behaviour)
           m_deltaPusch.clear ();
+          m_deltaPuschSum = 0;
         }
     }
 }
@@ -579,12 +588,30 @@ NrUePowerControl::UpdateGc ()
   NS_ABORT_MSG_IF (m_technicalSpec != TS_38_213, "This function is currently being used only for TS 38.213. ");
 
   // PUSCH power control accumulation or absolute value configuration
-  for (const auto& i: m_deltaPucch)
+  m_gc += m_deltaPucchSum; // gc already hold value for fc(i-i0) occasion
+  m_deltaPucch.clear (); // we have used these values, no need to save them any more
+  m_deltaPucchSum = 0;
+}
+
+double
+NrUePowerControl::GetRbComponent (std::size_t rbNum)
+{
+  uint16_t numerology = m_nrUePhy->GetNumerology ();
+  if (numerology != m_rbComponentNumerology)
     {
-      m_gc += i; // gc already hold value for fc(i-i0) occasion
+      m_rbComponentDb.clear ();
+      m_rbComponentNumerology = numerology;
     }
-
-  m_deltaPucch.clear (); // we have used these values, no need to save them any more
+  if (rbNum >= m_rbComponentDb.size ())
+    {
+      std::size_t first = m_rbComponentDb.size ();
+      m_rbComponentDb.resize (rbNum + 1, 0.0);
+      for (std::size_t rb = std::max<std::size_t> (first, 1); rb <= rbNum; ++rb)
+        {
+          m_rbComponentDb[rb] = 10 * log10 (std::pow (2, numerology) * rb);
+        }
+    }
+  return m_rbComponentDb[rbNum];
 }
 
 //TS 38.213 Table 7.1.1-1 and Table 7.2.1-1,  Mapping of TPC Command Field in DCI to accumulated and absolute value
@@ -610,16 +637,8 @@ NrUePowerControl::CalculatePuschTxPowerNr (std::size_t rbNum)
                " fc: " << m_fc <<
                " numerology:" << m_nrUePhy->GetNumerology ());
 
-  double puschComponent = 0;
-
-  if (rbNum > 0)
-    {
-      puschComponent = 10 * log10 ( std::pow (2, m_nrUePhy->GetNumerology ()) * rbNum);
-    }
-  else
-    {
-      NS_ABORT_MSG ("Should not be called CalculatePuschTxPowerNr if no RBs are assigned.");
-    }
+  NS_ABORT_MSG_IF (rbNum == 0, "Should not be called CalculatePuschTxPowerNr if no RBs are assigned.");
+  double puschComponent = GetRbComponent (rbNum);
 
   /**
    *  m_pathloss is a downlink path-loss estimate in dB calculated by the UE using
@@ -671,15 +690,8 @@ NrUePowerControl::CalculatePucchTxPowerNr (std::size_t rbNum)
     }
 
   int32_t PoPucch = m_PoNominalPucch + m_PoUePucch;
-  double pucchComponent = 0;
-  if (rbNum > 0)
-    {
-      pucchComponent = 10 * log10 ( std::pow (2, m_nrUePhy->GetNumerology ()) * rbNum);
-    }
-  else
-    {
-      NS_ABORT_MSG ("Should not be called CalculatePuschTxPowerNr if no RBs are assigned.");
-    }
+  NS_ABORT_MSG_IF (rbNum == 0, "Should not be called CalculatePuschTxPowerNr if no RBs are assigned.");
+  double pucchComponent = GetRbComponent (rbNum);
 
   /**
    *  - m_pathloss is a downlink path-loss estimate in dB calculated by the UE using
@@ -753,16 +765,8 @@ NrUePowerControl::CalculateSrsTxPowerNr (std::size_t rbNum)
    */
   m_hc = m_fc;
   double txPower = 0;
-  double component = 0;
-
-  if (rbNum > 0)
-    {
-      component = 10 * log10 (std::pow (2, m_nrUePhy->GetNumerology ()) * rbNum);
-    }
-  else
-    {
-      NS_ABORT_MSG ("Should not be called CalculateSrsTxPowerNr if no RBs are assigned.");
-    }
+  NS_ABORT_MSG_IF (rbNum == 0, "Should not be called CalculateSrsTxPowerNr if no RBs are assigned.");
+  double component = GetRbComponent (rbNum);
 
   if (m_technicalSpec == TS_36_213)
     {
@@ -306,6 +306,15 @@ private:
     * according to TS 38.213 7.2.1 formulas.
     */
    void UpdateGc ();
+   /**
+    * \brief Get the 10 * log10 (2^mu * M) component of the transmit power
+    *
+    * The values are computed once per number of RBs, and recomputed when the
+    * numerology of the PHY changes.
+    * \param rbNum number of RBs (M), greater than 0
+    * \return the component, in dB
+    */
+   double GetRbComponent (std::size_t rbNum);
    /**
     * \brief Calculates PUSCH transmit power
     * according TS 38.213 7.1.1 formulas
@@ -362,6 +371,10 @@ private:
   double m_pathLoss {100};                      //!< path loss value in dB
   std::vector <int8_t> m_deltaPucch;           //!< vector that saves TPC command accumulated values for PUCCH transmit power calculation
   std::vector <int8_t> m_deltaPusch;            //!< vector that saves TPC command accumulated values for PUSCH transmit power calculation
+  int32_t m_deltaPucchSum {0};                  //!< sum of the values in m_deltaPucch
+  int32_t m_deltaPuschSum {0};                  //!< sum of the values in m_deltaPusch
+  std::vector <double> m_rbComponentDb;         //!< 10 * log10 (2^mu * M) for each number of RBs M, see GetRbComponent
+  uint16_t m_rbComponentNumerology {UINT16_MAX}; //!< numerology of the values in m_rbComponentDb
   double m_fc {0.0};                            //!< FC
   double m_gc {0.0};                            //!< Is the current PUCCH power control adjustment state. This variable is used for calculation of PUCCH transmit power.
   double m_hc {0.0};                            //!< Is the current SRS power control adjustment state. This variable is used for calculation of SRS transmit power.
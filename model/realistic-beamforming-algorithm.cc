@@ -304,52 +304,70 @@ RealisticBeamformingAlgorithm::GetBeamformingVectors ()
       channelMatrix = GetChannelMatrix ();
     }
 
+  // Enumerate the candidate beams of both devices once; the search below
+  // visits the pairs in the same order as a nested loop over them would
+  std::vector<BeamformingVector> gnbBeams;
   for (double gnbTheta = 60; gnbTheta < 121; gnbTheta = gnbTheta + m_beamSearchAngleStep)
     {
       for (uint16_t gnbSector = 0; gnbSector <= gnbNumRows; gnbSector++)
         {
           NS_ASSERT(gnbSector < UINT16_MAX);
           m_gnbSpectrumPhy->GetBeamManager()->SetSector (gnbSector, gnbTheta);
-          complexVector_t gnbW = m_gnbSpectrumPhy->GetBeamManager ()->GetCurrentBeamformingVector ();
+          gnbBeams.emplace_back (m_gnbSpectrumPhy->GetBeamManager ()->GetCurrentBeamformingVector (),
+                                 BeamId (gnbSector, gnbTheta));
+        }
+    }
+
+  std::vector<BeamformingVector> ueBeams;
+  for (double ueTheta = 60; ueTheta < 121; ueTheta = static_cast<uint16_t> (ueTheta + m_beamSearchAngleStep))
+    {
+      for (uint16_t ueSector = 0; ueSector <= ueNumRows; ueSector++)
+        {
+          NS_ASSERT(ueSector < UINT16_MAX);
+          m_ueSpectrumPhy->GetBeamManager ()->SetSector (ueSector, ueTheta);
+          ueBeams.emplace_back (m_ueSpectrumPhy->GetBeamManager ()->GetCurrentBeamformingVector (),
+                                BeamId (ueSector, ueTheta));
+        }
+    }
+
+  // Each pair is evaluated on its own noisy estimate of H, drawn in the
+  // same order as before; the buffer of the estimate is reused by all pairs
+  Ptr<const PhasedArrayModel> gnbArray = m_gnbSpectrumPhy->GetAntenna ()->GetObject<PhasedArrayModel> ();
+  Ptr<const PhasedArrayModel> ueArray = m_ueSpectrumPhy->GetAntenna ()->GetObject<PhasedArrayModel> ();
+  const bool gnbIsU = channelMatrix->IsReverse (gnbArray->GetId (), ueArray->GetId ());
+  std::vector<std::complex<double> > estimatedChannel;
+
+  for (const auto &gnbBeam : gnbBeams)
+    {
+      for (const auto &ueBeam : ueBeams)
+        {
+          NS_ABORT_MSG_IF (gnbBeam.first.size () == 0 || ueBeam.first.size () == 0,
+                           "Beamforming vectors must be initialized in order to calculate the long term matrix.");
 
-          for (double ueTheta = 60; ueTheta < 121; ueTheta = static_cast<uint16_t> (ueTheta + m_beamSearchAngleStep))
+          const UniformPlanarArray::ComplexVector &sW = gnbIsU ? ueBeam.first : gnbBeam.first;
+          const UniformPlanarArray::ComplexVector &uW = gnbIsU ? gnbBeam.first : ueBeam.first;
+          GetEstimatedChannel (channelMatrix, srsSinr, &estimatedChannel);
+          const UniformPlanarArray::ComplexVector estimatedLongTermComponent = GetEstimatedLongTermComponent (channelMatrix, estimatedChannel, uW, sW);
+
+          double estimatedLongTermMetric = CalculateTheEstimatedLongTermMetric (estimatedLongTermComponent);
+
+          uint16_t gnbSector = gnbBeam.second.GetSector ();
+          uint16_t ueSector = ueBeam.second.GetSector ();
+          NS_LOG_LOGIC (" Estimated long term metric value: "<< estimatedLongTermMetric <<
+                        " gnb theta " << gnbBeam.second.GetElevation () <<
+                        " ue theta " << ueBeam.second.GetElevation () <<
+                        " gnb sector " << (M_PI *  static_cast<double> (gnbSector) / static_cast<double> (gnbNumRows) - 0.5 * M_PI) / (M_PI) * 180 <<
+                        " ue sector " << (M_PI * static_cast<double> (ueSector) / static_cast<double> (ueNumRows) - 0.5 * M_PI) / (M_PI) * 180);
+
+          if (max < estimatedLongTermMetric)
             {
-              for (uint16_t ueSector = 0; ueSector <= ueNumRows; ueSector++)
-                {
-                  NS_ASSERT(ueSector < UINT16_MAX);
-                  m_ueSpectrumPhy->GetBeamManager ()->SetSector (ueSector, ueTheta);
-                  complexVector_t ueW = m_ueSpectrumPhy->GetBeamManager ()->GetCurrentBeamformingVector ();
-
-                  NS_ABORT_MSG_IF (gnbW.size()==0 || ueW.size()==0,
-                                   "Beamforming vectors must be initialized in order to calculate the long term matrix.");
-
-                  const UniformPlanarArray::ComplexVector estimatedLongTermComponent = GetEstimatedLongTermComponent (channelMatrix, gnbW, ueW,
-                                                                                                                      m_gnbSpectrumPhy->GetObject<MobilityModel>(),
-                                                                                                                      m_ueSpectrumPhy->GetObject<MobilityModel>(),
-                                                                                                                      srsSinr,
-                                                                                                                      m_gnbSpectrumPhy->GetAntenna ()->GetObject<PhasedArrayModel>(),
-                                                                                                                      m_ueSpectrumPhy->GetAntenna ()->GetObject<PhasedArrayModel>()
-                                                                                                                      );
-
-                  double estimatedLongTermMetric = CalculateTheEstimatedLongTermMetric (estimatedLongTermComponent);
-
-                  NS_LOG_LOGIC (" Estimated long term metric value: "<< estimatedLongTermMetric <<
-                                " gnb theta " << gnbTheta <<
-                                " ue theta " << ueTheta <<
-                                " gnb sector " << (M_PI *  static_cast<double> (gnbSector) / static_cast<double> (gnbNumRows) - 0.5 * M_PI) / (M_PI) * 180 <<
-                                " ue sector " << (M_PI * static_cast<double> (ueSector) / static_cast<double> (ueNumRows) - 0.5 * M_PI) / (M_PI) * 180);
-
-                  if (max < estimatedLongTermMetric)
-                    {
-                      max = estimatedLongTermMetric;
-                      maxTxSector = gnbSector;
-                      maxRxSector = ueSector;
-                      maxTxTheta = gnbTheta;
-                      maxRxTheta = ueTheta;
-                      maxTxW = gnbW;
-                      maxRxW = ueW;
-                    }
-                }
+              max = estimatedLongTermMetric;
+              maxTxSector = gnbSector;
+              maxRxSector = ueSector;
+              maxTxTheta = gnbBeam.second.GetElevation ();
+              maxRxTheta = ueBeam.second.GetElevation ();
+              maxTxW = gnbBeam.first;
+              maxRxW = ueBeam.first;
             }
         }
     }
@@ -380,57 +398,62 @@ RealisticBeamformingAlgorithm::CalculateTheEstimatedLongTermMetric (const Unifor
 }
 
 
-UniformPlanarArray::ComplexVector
-RealisticBeamformingAlgorithm::GetEstimatedLongTermComponent (const Ptr<const MatrixBasedChannelModel::ChannelMatrix>& channelMatrix,
-                                                              const UniformPlanarArray::ComplexVector &aW,
-                                                              const UniformPlanarArray::ComplexVector &bW,
-                                                              Ptr<const MobilityModel> a,
-                                                              Ptr<const MobilityModel> b,
-                                                              double srsSinr,
-                                                              Ptr<const PhasedArrayModel> aArray,
-                                                              Ptr<const PhasedArrayModel> bArray
-) const
+void
+RealisticBeamformingAlgorithm::GetEstimatedChannel (const Ptr<const MatrixBasedChannelModel::ChannelMatrix>& channelMatrix,
+                                                    double srsSinr,
+                                                    std::vector<std::complex<double> > *estimatedChannel) const
 {
   NS_LOG_FUNCTION (this);
 
-  // check if the channel matrix was generated considering a as the s-node and
-  // b as the u-node or viceversa
-  UniformPlanarArray::ComplexVector sW, uW;
-  if (!channelMatrix->IsReverse (aArray->GetId (), bArray->GetId ()))
-    {
-      sW = aW;
-      uW = bW;
-    }
-  else
-    {
-      sW = bW;
-      uW = aW;
-    }
-
-  uint16_t sAntenna = static_cast<uint16_t> (sW.size ());
-  uint16_t uAntenna = static_cast<uint16_t> (uW.size ());
+  NS_ABORT_IF (srsSinr == 0);
 
-  NS_LOG_DEBUG ("Calculate the estimation of the long term component with sAntenna: " << sAntenna << " uAntenna: " << uAntenna);
-  UniformPlanarArray::ComplexVector estimatedlongTerm;
+  const std::size_t uAntenna = channelMatrix->m_channel.size ();
+  const std::size_t sAntenna = channelMatrix->m_channel[0].size ();
+  const std::size_t numCluster = channelMatrix->m_channel[0][0].size ();
 
-  NS_ABORT_IF (srsSinr == 0);
+  NS_LOG_DEBUG ("Estimate the channel with sAntenna: " << sAntenna << " uAntenna: " << uAntenna);
 
   double varError = 1 / (srsSinr); // SINR the SINR from UL SRS reception
-  uint8_t numCluster = static_cast<uint8_t> (channelMatrix->m_channel[0][0].size ());
+  estimatedChannel->resize (uAntenna * sAntenna * numCluster);
 
-  for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+  for (std::size_t cIndex = 0; cIndex < numCluster; cIndex++)
     {
-      std::complex<double> txSum (0,0);
-      for (uint16_t sIndex = 0; sIndex < sAntenna; sIndex++)
+      for (std::size_t sIndex = 0; sIndex < sAntenna; sIndex++)
         {
-          std::complex<double> rxSum (0,0);
-          for (uint16_t uIndex = 0; uIndex < uAntenna; uIndex++)
+          for (std::size_t uIndex = 0; uIndex < uAntenna; uIndex++)
             {
               //error is generated from the normal random variable with mean 0 and  variance varError*sqrt(1/2) for real/imaginary parts
               std::complex<double> error = std::complex <double> (m_normalRandomVariable->GetValue (0, sqrt (0.5) * varError),
                                                                   m_normalRandomVariable->GetValue (0, sqrt (0.5) * varError)) ;
-              std::complex<double> hEstimate = channelMatrix->m_channel [uIndex][sIndex][cIndex] + error;
-              rxSum += uW[uIndex] * (hEstimate);
+              (*estimatedChannel)[(cIndex * sAntenna + sIndex) * uAntenna + uIndex] = channelMatrix->m_channel [uIndex][sIndex][cIndex] + error;
+            }
+        }
+    }
+}
+
+UniformPlanarArray::ComplexVector
+RealisticBeamformingAlgorithm::GetEstimatedLongTermComponent (const Ptr<const MatrixBasedChannelModel::ChannelMatrix>& channelMatrix,
+                                                              const std::vector<std::complex<double> > &estimatedChannel,
+                                                              const UniformPlanarArray::ComplexVector &uW,
+                                                              const UniformPlanarArray::ComplexVector &sW) const
+{
+  const std::size_t uAntenna = channelMatrix->m_channel.size ();
+  const std::size_t sAntenna = channelMatrix->m_channel[0].size ();
+  const std::size_t numCluster = channelMatrix->m_channel[0][0].size ();
+  NS_ASSERT (uW.size () == uAntenna && sW.size () == sAntenna);
+
+  UniformPlanarArray::ComplexVector estimatedlongTerm;
+  estimatedlongTerm.reserve (numCluster);
+  const std::complex<double> *hEstimate = estimatedChannel.data ();
+  for (std::size_t cIndex = 0; cIndex < numCluster; cIndex++)
+    {
+      std::complex<double> txSum (0,0);
+      for (std::size_t sIndex = 0; sIndex < sAntenna; sIndex++)
+        {
+          std::complex<double> rxSum (0,0);
+          for (std::size_t uIndex = 0; uIndex < uAntenna; uIndex++)
+            {
+              rxSum += uW[uIndex] * (*hEstimate++);
             }
           txSum = txSum + sW[sIndex] * rxSum;
         }
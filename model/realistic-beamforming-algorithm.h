@@ -230,25 +230,31 @@ private:
    */
   Ptr<const MatrixBasedChannelModel::ChannelMatrix> GetChannelMatrix () const;
   /**
-   * \brief Calculates an estimation of the long term component based on the channel measurements
+   * \brief Draws an estimation of the channel matrix obtained from the SRS
+   *
+   * Every element of H gets an independent complex normal error whose
+   * variance depends on the SRS SINR/SNR. Each beam pair gets its own draw.
+   *
    * \param channelMatrix the channel matrix H
-   * \param aW the beamforming vector of the first device
-   * \param bW the beamforming vector of the second device
-   * \param a the first node mobility model
-   * \param b the second node mobility model
-   * \param srsSinr the SRS report to be used to estimate the long term component metric
-   * \param aArray the antenna array of the first device
-   * \param bArray the antenna array of the second device
+   * \param srsSinr the SRS report to be used to estimate the channel
+   * \param estimatedChannel the estimated H, flattened as [cIndex][sIndex][uIndex]
+   *        (output); its memory is reused between calls
+   */
+  void GetEstimatedChannel (const Ptr<const MatrixBasedChannelModel::ChannelMatrix>& channelMatrix,
+                            double srsSinr,
+                            std::vector<std::complex<double> > *estimatedChannel) const;
+  /**
+   * \brief Calculates an estimation of the long term component based on the channel measurements
+   * \param channelMatrix the channel matrix H, used for its dimensions
+   * \param estimatedChannel the estimated H, as drawn by GetEstimatedChannel
+   * \param uW the beamforming vector of the u-node
+   * \param sW the beamforming vector of the s-node
    * \return the estimated long term component
    */
   UniformPlanarArray::ComplexVector GetEstimatedLongTermComponent (const Ptr<const MatrixBasedChannelModel::ChannelMatrix>& channelMatrix,
-                                                                          const UniformPlanarArray::ComplexVector &aW,
-                                                                          const UniformPlanarArray::ComplexVector &bW,
-                                                                          Ptr<const MobilityModel> a,
-                                                                          Ptr<const MobilityModel> b,
-                                                                          double srsSinr,
-                                                                          Ptr<const PhasedArrayModel> aArray,
-                                                                          Ptr<const PhasedArrayModel> bArray) const;
+                                                                   const std::vector<std::complex<double> > &estimatedChannel,
+                                                                   const UniformPlanarArray::ComplexVector &uW,
+                                                                   const UniformPlanarArray::ComplexVector &sW) const;
 
   /*
    * \brief Calculates the total metric based on the each element of the long term component
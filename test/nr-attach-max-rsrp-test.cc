@@ -0,0 +1,155 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/antenna-module.h"
+#include <cmath>
+
+/**
+ * \file nr-attach-max-rsrp-test.cc
+ * \ingroup test
+ *
+ * \brief Check that NrHelper::AttachToMaxRsrpEnb attaches each UE to the
+ * sector of its site that faces it. The three sectors of a site are
+ * co-located, and only the closest site is a candidate, so the choice
+ * depends only on the gain of the antenna element of each sector.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ * \brief Attach UEs around two three-sector sites
+ */
+class NrAttachMaxRsrpSectorTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrAttachMaxRsrpSectorTestCase ()
+    : TestCase ("Attachment to the sector that faces the UE")
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+};
+
+void
+NrAttachMaxRsrpSectorTestCase::DoRun ()
+{
+  const std::vector<Vector> sites {Vector (0.0, 0.0, 25.0), Vector (1000.0, 0.0, 25.0)};
+  const std::vector<double> bearings {30.0, 150.0, 270.0}; // degrees
+  const double ueDistance = 150.0;
+
+  NodeContainer gnbNodes;
+  gnbNodes.Create (sites.size () * bearings.size ());
+  NodeContainer ueNodes;
+  ueNodes.Create (sites.size () * bearings.size ());
+
+  // Sector s of site i is the gNB i * 3 + s; its UE is in front of it
+  Ptr<ListPositionAllocator> gnbPositions = CreateObject<ListPositionAllocator> ();
+  Ptr<ListPositionAllocator> uePositions = CreateObject<ListPositionAllocator> ();
+  for (const auto &site : sites)
+    {
+      for (double bearing : bearings)
+        {
+          gnbPositions->Add (site);
+          uePositions->Add (Vector (site.x + ueDistance * std::cos (bearing * M_PI / 180),
+                                    site.y + ueDistance * std::sin (bearing * M_PI / 180), 1.5));
+        }
+    }
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (gnbPositions);
+  mobility.Install (gnbNodes);
+  mobility.SetPositionAllocator (uePositions);
+  mobility.Install (ueNodes);
+
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  CcBwpCreator ccBwpCreator;
+  CcBwpCreator::SimpleOperationBandConf bandConf (3.5e9, 20e6, 1, BandwidthPartInfo::UMa_LoS);
+  OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc (bandConf);
+  nrHelper->SetPathlossAttribute ("ShadowingEnabled", BooleanValue (false));
+  nrHelper->InitializeOperationBand (&band);
+  BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps ({band});
+
+  nrHelper->SetGnbAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetGnbAntennaAttribute ("NumColumns", UintegerValue (1));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement", PointerValue (CreateObject<ThreeGppAntennaModel> ()));
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+
+  NetDeviceContainer gnbDevs = nrHelper->InstallGnbDevice (gnbNodes, allBwps);
+  NetDeviceContainer ueDevs = nrHelper->InstallUeDevice (ueNodes, allBwps);
+
+  // The orientation of the sectors is set after the installation, as the
+  // scenario helpers do
+  for (uint32_t i = 0; i < gnbDevs.GetN (); ++i)
+    {
+      Ptr<UniformPlanarArray> antenna =
+        DynamicCast<UniformPlanarArray> (nrHelper->GetGnbPhy (gnbDevs.Get (i), 0)->GetSpectrumPhy ()->GetAntenna ());
+      antenna->SetAttribute ("BearingAngle", DoubleValue (bearings[i % bearings.size ()] * M_PI / 180));
+    }
+
+  int64_t stream = 1;
+  stream += nrHelper->AssignStreams (gnbDevs, stream);
+  stream += nrHelper->AssignStreams (ueDevs, stream);
+
+  for (auto it = gnbDevs.Begin (); it != gnbDevs.End (); ++it)
+    {
+      DynamicCast<NrGnbNetDevice> (*it)->UpdateConfig ();
+    }
+  for (auto it = ueDevs.Begin (); it != ueDevs.End (); ++it)
+    {
+      DynamicCast<NrUeNetDevice> (*it)->UpdateConfig ();
+    }
+
+  nrHelper->AttachToMaxRsrpEnb (ueDevs, gnbDevs, 1);
+
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      Ptr<NrUeNetDevice> ueDev = DynamicCast<NrUeNetDevice> (ueDevs.Get (i));
+      Ptr<NrGnbNetDevice> facingGnb = DynamicCast<NrGnbNetDevice> (gnbDevs.Get (i));
+      NS_TEST_ASSERT_MSG_NE (ueDev->GetTargetEnb (), nullptr, "UE " << i << " is not attached");
+      NS_TEST_EXPECT_MSG_EQ (ueDev->GetTargetEnb ()->GetCellId (), facingGnb->GetCellId (),
+                             "UE " << i << " is not attached to the sector that faces it");
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup test
+ * \brief Test suite for NrHelper::AttachToMaxRsrpEnb
+ */
+class NrAttachMaxRsrpTestSuite : public TestSuite
+{
+public:
+  NrAttachMaxRsrpTestSuite () : TestSuite ("nr-attach-max-rsrp", SYSTEM)
+  {
+    AddTestCase (new NrAttachMaxRsrpSectorTestCase (), QUICK);
+  }
+};
+
+static NrAttachMaxRsrpTestSuite g_nrAttachMaxRsrpTestSuite; //!< AttachToMaxRsrpEnb test suite
+
+}  // namespace ns3
@@ -0,0 +1,200 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <ns3/test.h>
+#include <ns3/boolean.h>
+#include <ns3/string.h>
+#include <ns3/simulator.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/nr-bearer-stats-calculator.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+/**
+ * \file nr-delay-histogram-test.cc
+ * \ingroup test
+ *
+ * \brief Feed the delay histogram of NrBearerStatsCalculator with known
+ * delay distributions, and check that its p50, p95 and p99 are within the
+ * bucket error bound of the exact quantiles of the same values: never
+ * below them, and above them by less than 1 / SUB_BUCKETS of their value
+ * (exact below 2 * SUB_BUCKETS). Check also that the memory of the
+ * histogram does not grow with the number or the magnitude of the values,
+ * and that the calculator returns the same quantiles, in seconds.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ * \brief Compare the quantiles of the delay histogram with the exact ones
+ */
+class NrDelayHistogramTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param name name of the distribution
+   * \param numValues number of values
+   * \param draw function that draws a value, in ns, from a uniform
+   * random variable in [0, 1)
+   */
+  NrDelayHistogramTestCase (const std::string &name, uint32_t numValues,
+                            const std::function<uint64_t (double)> &draw)
+    : TestCase ("Delay histogram quantiles, " + name),
+    m_numValues (numValues),
+    m_draw (draw)
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Get the exact quantile of sorted values, with the rank used by
+   * the histogram
+   * \param sorted the values, sorted
+   * \param q the quantile
+   * \return the value of rank ceil (q * n)
+   */
+  static uint64_t GetExactQuantile (const std::vector<uint64_t> &sorted, double q);
+
+  uint32_t m_numValues;                    //!< Number of values
+  std::function<uint64_t (double)> m_draw; //!< Draw a value
+};
+
+uint64_t
+NrDelayHistogramTestCase::GetExactQuantile (const std::vector<uint64_t> &sorted, double q)
+{
+  uint64_t rank = static_cast<uint64_t> (std::ceil (q * sorted.size ()));
+  return sorted.at (std::max<uint64_t> (rank, 1) - 1);
+}
+
+void
+NrDelayHistogramTestCase::DoRun ()
+{
+  typedef NrBearerStatsCalculator::DelayHistogram DelayHistogram;
+  const uint64_t imsi = 1;
+  const uint8_t lcid = 3;
+
+  Ptr<NrBearerStatsCalculator> calculator = CreateObject<NrBearerStatsCalculator> ("RLC");
+  calculator->SetAttribute ("DelayHistogram", BooleanValue (true));
+  calculator->SetAttribute ("DlRlcOutputFilename",
+                            StringValue (CreateTempDirFilename ("NrDlRlcStatsE2E.txt")));
+  calculator->SetAttribute ("UlRlcOutputFilename",
+                            StringValue (CreateTempDirFilename ("NrUlRlcStatsE2E.txt")));
+
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uniform->SetStream (1);
+
+  DelayHistogram histogram;
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetMemoryUsage (), 0,
+                         "The memory should be allocated at the first update");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (0.5), 0, "An empty histogram should give 0");
+
+  std::vector<uint64_t> values;
+  values.reserve (m_numValues);
+  std::size_t memory = 0;
+  for (uint32_t i = 0; i < m_numValues; ++i)
+    {
+      uint64_t v = m_draw (uniform->GetValue ());
+      values.push_back (v);
+      histogram.Update (v);
+      calculator->DlRxPdu (1, imsi, 1, lcid, 100, v);
+      if (i == 0)
+        {
+          memory = histogram.GetMemoryUsage ();
+          NS_TEST_ASSERT_MSG_EQ (memory, DelayHistogram::NUM_BUCKETS * sizeof (uint32_t),
+                                 "The histogram should allocate all its buckets at once");
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetMemoryUsage (), memory,
+                         "The memory of the histogram should not grow with the values");
+
+  std::sort (values.begin (), values.end ());
+  for (double q : {0.5, 0.95, 0.99})
+    {
+      uint64_t exact = GetExactQuantile (values, q);
+      uint64_t estimate = histogram.GetQuantile (q);
+      NS_TEST_ASSERT_MSG_EQ (estimate >= exact, true,
+                             "p" << 100 * q << " " << estimate << " is below the exact " << exact);
+      if (exact < 2 * DelayHistogram::SUB_BUCKETS)
+        {
+          NS_TEST_ASSERT_MSG_EQ (estimate, exact,
+                                 "p" << 100 * q << " of a small value should be exact");
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_EQ (estimate - exact < exact / DelayHistogram::SUB_BUCKETS, true,
+                                 "p" << 100 * q << " " << estimate << " is beyond the error bound of "
+                                     << exact);
+        }
+      NS_TEST_ASSERT_MSG_EQ_TOL (calculator->GetDlDelayQuantile (imsi, lcid, q), estimate * 1e-9,
+                                 1e-15, "The calculator should give the quantile of its histogram");
+    }
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (1.0), values.back (),
+                         "The largest quantile should be the largest value");
+
+  histogram.Reset ();
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetQuantile (0.99), 0, "A reset histogram should be empty");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetMemoryUsage (), memory, "Reset should keep the memory");
+
+  calculator->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup test
+ * \brief Test suite for the delay histogram of NrBearerStatsCalculator
+ */
+class NrDelayHistogramTestSuite : public TestSuite
+{
+public:
+  NrDelayHistogramTestSuite () : TestSuite ("nr-delay-histogram", UNIT)
+  {
+    const uint32_t numValues = 100000;
+
+    // The non-uniform distributions are drawn by inverting their CDF
+    AddTestCase (new NrDelayHistogramTestCase ("constant 3 ms", numValues,
+                                               [] (double) { return 3000000; }),
+                 QUICK);
+    AddTestCase (new NrDelayHistogramTestCase ("uniform 0-31 ns", numValues,
+                                               [] (double u) { return static_cast<uint64_t> (32 * u); }),
+                 QUICK);
+    AddTestCase (new NrDelayHistogramTestCase ("uniform 0.1-10 ms", numValues,
+                                               [] (double u) { return static_cast<uint64_t> (1e5 + 9.9e6 * u); }),
+                 QUICK);
+    AddTestCase (new NrDelayHistogramTestCase ("exponential, mean 2 ms", numValues,
+                                               [] (double u) { return static_cast<uint64_t> (-2e6 * std::log (1 - u)); }),
+                 QUICK);
+    AddTestCase (new NrDelayHistogramTestCase ("bimodal 1 ms (90%) and 50 ms (10%)", numValues,
+                                               [] (double u)
+                                               {
+                                                 return u < 0.9
+                                                        ? static_cast<uint64_t> (5e5 + 1e6 * u / 0.9)
+                                                        : static_cast<uint64_t> (4e7 + 2e7 * (u - 0.9) / 0.1);
+                                               }),
+                 QUICK);
+    AddTestCase (new NrDelayHistogramTestCase ("Pareto, scale 0.1 ms, shape 1.5", numValues,
+                                               [] (double u) { return static_cast<uint64_t> (1e5 / std::pow (1 - u, 1 / 1.5)); }),
+                 QUICK);
+  }
+};
+
+static NrDelayHistogramTestSuite g_nrDelayHistogramTestSuite; //!< Delay histogram test suite
+
+}  // namespace ns3
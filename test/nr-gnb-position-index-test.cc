@@ -0,0 +1,128 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/nr-gnb-position-index.h>
+#include <algorithm>
+
+/**
+ * \file nr-gnb-position-index-test.cc
+ * \ingroup test
+ *
+ * \brief Check that the k-d tree used to attach the UEs finds the same
+ * closest (and k closest) positions as a linear search, ties included.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ * \brief Compare NrGnbPositionIndex with a linear search
+ */
+class NrGnbPositionIndexTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param numPositions number of indexed positions
+   * \param onGrid if true, the positions are on a coarse grid, with many
+   * co-located positions (as the sectors of a site)
+   */
+  NrGnbPositionIndexTestCase (uint32_t numPositions, bool onGrid)
+    : TestCase ("Position index with " + std::to_string (numPositions) +
+                (onGrid ? " positions on a grid" : " random positions")),
+      m_numPositions (numPositions),
+      m_onGrid (onGrid)
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+
+  uint32_t m_numPositions {0}; //!< Number of indexed positions
+  bool m_onGrid {false};       //!< Positions on a coarse grid
+};
+
+void
+NrGnbPositionIndexTestCase::DoRun ()
+{
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+
+  auto drawPosition = [this, random] (double height)
+    {
+      if (m_onGrid)
+        {
+          return Vector (100.0 * random->GetInteger (0, 5), 100.0 * random->GetInteger (0, 5), height);
+        }
+      return Vector (random->GetValue (0, 1000), random->GetValue (0, 1000), height);
+    };
+
+  std::vector<Vector> positions;
+  for (uint32_t i = 0; i < m_numPositions; ++i)
+    {
+      positions.push_back (drawPosition (25.0));
+    }
+
+  NrGnbPositionIndex index;
+  index.Build (positions);
+  NS_TEST_ASSERT_MSG_EQ (index.GetN (), m_numPositions, "Wrong number of indexed positions");
+
+  for (uint32_t q = 0; q < 500; ++q)
+    {
+      Vector uePos = drawPosition (1.5);
+
+      std::vector<std::pair<double, uint32_t>> all;
+      for (uint32_t i = 0; i < positions.size (); ++i)
+        {
+          all.emplace_back (CalculateDistance (uePos, positions[i]), i);
+        }
+      std::sort (all.begin (), all.end ());
+
+      NS_TEST_ASSERT_MSG_EQ (index.FindClosest (uePos), all.front ().second,
+                             "The closest position differs from the linear search");
+
+      uint32_t k = 1 + q % 7;
+      std::vector<uint32_t> kClosest = index.FindKClosest (uePos, k);
+      NS_TEST_ASSERT_MSG_EQ (kClosest.size (), std::min<size_t> (k, positions.size ()),
+                             "Wrong number of closest positions");
+      for (uint32_t i = 0; i < kClosest.size (); ++i)
+        {
+          NS_TEST_ASSERT_MSG_EQ (kClosest[i], all[i].second,
+                                 "The k closest positions differ from the linear search");
+        }
+    }
+}
+
+/**
+ * \ingroup test
+ * \brief Test suite for NrGnbPositionIndex
+ */
+class NrGnbPositionIndexTestSuite : public TestSuite
+{
+public:
+  NrGnbPositionIndexTestSuite () : TestSuite ("nr-gnb-position-index", UNIT)
+  {
+    AddTestCase (new NrGnbPositionIndexTestCase (1, false), QUICK);
+    AddTestCase (new NrGnbPositionIndexTestCase (57, false), QUICK);
+    AddTestCase (new NrGnbPositionIndexTestCase (57, true), QUICK);
+    AddTestCase (new NrGnbPositionIndexTestCase (500, false), QUICK);
+  }
+};
+
+static NrGnbPositionIndexTestSuite g_nrGnbPositionIndexTestSuite; //!< NrGnbPositionIndex test suite
+
+}  // namespace ns3
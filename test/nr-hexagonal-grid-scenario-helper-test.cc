@@ -0,0 +1,216 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/hexagonal-grid-scenario-helper.h>
+#include <ns3/mobility-model.h>
+#include <cmath>
+#include <set>
+
+/**
+ * \file nr-hexagonal-grid-scenario-helper-test.cc
+ * \ingroup test
+ *
+ * \brief Check the deployment of HexagonalGridScenarioHelper: the number of
+ * sites of each number of rings, the positions of the first 37 sites against
+ * the reference distances and angles, the wrap-around of large deployments,
+ * and the drop of the UEs in their cells.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ * \brief Check the site positions and the wrap-around of HexagonalGridScenarioHelper
+ */
+class NrHexagonalGridSitesTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrHexagonalGridSitesTestCase ()
+    : TestCase ("Site positions and wrap-around of the hexagonal grid")
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+};
+
+void
+NrHexagonalGridSitesTestCase::DoRun ()
+{
+  const double isd = 500.0;
+  const double tolerance = 1e-9;
+
+  // Number of sites for 0 to 8 rings
+  const std::vector<std::size_t> expectedSites {1, 7, 13, 19, 31, 37, 43, 55, 61};
+  for (uint8_t numRings = 0; numRings < expectedSites.size (); ++numRings)
+    {
+      HexagonalGridScenarioHelper grid;
+      grid.SetSectorization (HexagonalGridScenarioHelper::TRIPLE);
+      grid.SetNumRings (numRings);
+      NS_TEST_EXPECT_MSG_EQ (grid.GetNumSites (), expectedSites[numRings],
+                             "Wrong number of sites for " << +numRings << " rings");
+      NS_TEST_EXPECT_MSG_EQ (grid.GetNumCells (), 3 * expectedSites[numRings],
+                             "Wrong number of cells for " << +numRings << " rings");
+    }
+
+  // Reference distances (in ISD units) and angles (in degrees) of the first 37 sites
+  const double d2 = std::sqrt (3);
+  const double d4 = std::sqrt (7);
+  const std::vector<double> distances {0,
+                                       1, 1, 1, 1, 1, 1,
+                                       d2, d2, d2, d2, d2, d2,
+                                       2, 2, 2, 2, 2, 2,
+                                       d4, d4, d4, d4, d4, d4, d4, d4, d4, d4, d4, d4,
+                                       3, 3, 3, 3, 3, 3};
+  const double a1 = std::atan2 (1, (3 * std::sqrt (3))) * (180 / M_PI);
+  const double a2 = 90 - std::atan2 (std::sqrt (3), 2) * (180 / M_PI);
+  const double a3 = 90 - std::atan2 (3, (5 * std::sqrt (3))) * (180 / M_PI);
+  const std::vector<double> angles {0,
+                                    30, 90, 150, 210, 270, 330,
+                                    0, 60, 120, 180, 240, 300,
+                                    30, 90, 150, 210, 270, 330,
+                                    a1, a2, a3, 180 - a3, 180 - a2, 180 - a1,
+                                    180 + a1, 180 + a2, 180 + a3, -a3, -a2, -a1,
+                                    30, 90, 150, 210, 270, 330};
+
+  HexagonalGridScenarioHelper grid;
+  grid.SetSectorization (HexagonalGridScenarioHelper::TRIPLE);
+  grid.m_isd = isd;
+  grid.m_bsHeight = 25.0;
+  grid.SetNumRings (5);
+  std::vector<Vector> sites = grid.GetSitePositions ();
+  NS_TEST_ASSERT_MSG_EQ (sites.size (), distances.size (), "Wrong number of site positions");
+  for (std::size_t i = 0; i < sites.size (); ++i)
+    {
+      double angleRad = angles[i] * M_PI / 180;
+      NS_TEST_EXPECT_MSG_EQ_TOL (sites[i].x, isd * distances[i] * std::cos (angleRad), tolerance,
+                                 "Wrong x of site " << i);
+      NS_TEST_EXPECT_MSG_EQ_TOL (sites[i].y, isd * distances[i] * std::sin (angleRad), tolerance,
+                                 "Wrong y of site " << i);
+      NS_TEST_EXPECT_MSG_EQ (sites[i].z, 25.0, "Wrong z of site " << i);
+    }
+
+  // Wrap-around of 10 hexagonal rings (331 sites, 993 cells): the 7 copies
+  // of the deployment must tile the plane without overlapping
+  const uint32_t numHexRings = 10;
+  grid.SetSitesNumber (1 + 3 * numHexRings * (numHexRings + 1));
+  sites = grid.GetSitePositions ();
+  std::set<std::pair<int64_t, int64_t> > latticeSites;
+  auto addLatticeSite = [&latticeSites, isd] (const Vector &pos)
+    {
+      // Back to the axial coordinates of the lattice
+      int64_t q = std::llround (2 * pos.x / (std::sqrt (3) * isd));
+      int64_t r = std::llround (pos.y / isd - q / 2.0);
+      latticeSites.insert (std::make_pair (q, r));
+    };
+  const std::array<Vector, 6> offsets = grid.GetWrapAroundOffsets ();
+  for (const auto &site : sites)
+    {
+      addLatticeSite (site);
+      for (const auto &offset : offsets)
+        {
+          NS_TEST_EXPECT_MSG_EQ_TOL (std::hypot (offset.x, offset.y), isd * std::sqrt (sites.size ()),
+                                     tolerance, "Wrong length of the wrap-around offset");
+          addLatticeSite (Vector (site.x + offset.x, site.y + offset.y, site.z));
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (latticeSites.size (), 7 * sites.size (), "The wrap-around copies overlap");
+
+  // A site on the right edge, seen from the left edge, is wrapped around
+  Vector rightSite = sites.back ();
+  Vector leftPos (-rightSite.x, rightSite.y, 1.5);
+  Vector wrapped = grid.GetWrapAroundPosition (rightSite, leftPos);
+  NS_TEST_EXPECT_MSG_LT (CalculateDistance (wrapped, leftPos), CalculateDistance (rightSite, leftPos),
+                         "The wrap-around position should be closer");
+  NS_TEST_EXPECT_MSG_EQ (grid.GetWrapAroundPosition (rightSite, rightSite), rightSite,
+                         "The wrap-around position of a close site should be the site");
+
+  // The cached offsets follow the number of sites
+  grid.SetNumRings (1);
+  NS_TEST_EXPECT_MSG_EQ_TOL (std::hypot (grid.GetWrapAroundOffsets ()[0].x, grid.GetWrapAroundOffsets ()[0].y),
+                             isd * std::sqrt (7), tolerance, "The wrap-around offsets were not recomputed");
+}
+
+/**
+ * \ingroup test
+ * \brief Check the drop of the UEs of HexagonalGridScenarioHelper
+ */
+class NrHexagonalGridUtDropTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrHexagonalGridUtDropTestCase ()
+    : TestCase ("UE drop of the hexagonal grid")
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+};
+
+void
+NrHexagonalGridUtDropTestCase::DoRun ()
+{
+  HexagonalGridScenarioHelper grid;
+  grid.SetScenarioParameters ("UMa");
+  grid.SetNumRings (3);
+  grid.SetUtNumber (grid.GetNumCells () * 10);
+  grid.SetTopologyFileFormat (HexagonalGridScenarioHelper::NO_FILE);
+  grid.AssignStreams (1);
+  grid.CreateScenario ();
+
+  const NodeContainer &bs = grid.GetBaseStations ();
+  const NodeContainer &ut = grid.GetUserTerminals ();
+  NS_TEST_ASSERT_MSG_EQ (bs.GetN (), grid.GetNumCells (), "Wrong number of gNBs");
+  NS_TEST_ASSERT_MSG_EQ (ut.GetN (), grid.GetNumCells () * 10, "Wrong number of UEs");
+
+  const double radius = grid.GetHexagonalCellRadius ();
+  const double maxDistance = radius * std::sqrt (3) / 2 - grid.m_minBsUtDistance;
+  for (uint32_t utId = 0; utId < ut.GetN (); ++utId)
+    {
+      uint16_t cellId = grid.GetCellIndex (utId);
+      Vector bsPos = bs.Get (cellId)->GetObject<MobilityModel> ()->GetPosition ();
+      Vector utPos = ut.Get (utId)->GetObject<MobilityModel> ()->GetPosition ();
+      Vector cellCenter = grid.GetHexagonalCellCenter (bsPos, cellId);
+      cellCenter.z = utPos.z;
+      NS_TEST_EXPECT_MSG_LT_OR_EQ (CalculateDistance (utPos, cellCenter), maxDistance + 1e-9,
+                                   "UE " << utId << " is out of its cell");
+      NS_TEST_EXPECT_MSG_EQ (utPos.z, grid.m_utHeight, "Wrong height of UE " << utId);
+    }
+}
+
+/**
+ * \ingroup test
+ * \brief Test suite for HexagonalGridScenarioHelper
+ */
+class NrHexagonalGridScenarioHelperTestSuite : public TestSuite
+{
+public:
+  NrHexagonalGridScenarioHelperTestSuite () : TestSuite ("nr-hexagonal-grid-scenario-helper", UNIT)
+  {
+    AddTestCase (new NrHexagonalGridSitesTestCase (), QUICK);
+    AddTestCase (new NrHexagonalGridUtDropTestCase (), QUICK);
+  }
+};
+
+static NrHexagonalGridScenarioHelperTestSuite g_nrHexagonalGridScenarioHelperTestSuite; //!< HexagonalGridScenarioHelper test suite
+
+}  // namespace ns3
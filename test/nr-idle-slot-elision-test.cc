@@ -0,0 +1,369 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <ns3/test.h>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/nr-module.h"
+#include "ns3/antenna-module.h"
+#include <iomanip>
+#include <sstream>
+
+/**
+ * \file nr-idle-slot-elision-test.cc
+ * \ingroup test
+ *
+ * \brief Check that the IdleSlotElision attribute of NrUePhy does not change
+ * the simulation output.
+ *
+ * The same scenario, with sparse DL and UL UDP traffic, runs with the
+ * attribute off and on. The UE PHY and MAC CTRL message traces, the DL DATA
+ * SINR, the gNB DL/UL scheduling and the packets received must be the same,
+ * and so must the current slot of each UE PHY, read at the start of DL, F and
+ * UL slots and in the middle of a slot. The packets are sent exactly at slot
+ * boundaries, so that the loop is also resumed there.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ * \brief Run the scenario with and without the idle slot elision, and
+ * compare the outputs
+ */
+class NrIdleSlotElisionTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrIdleSlotElisionTestCase ()
+    : TestCase ("The idle slot elision does not change the traces and the slot of the UEs")
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Run the scenario
+   * \param idleSlotElision the value of the IdleSlotElision attribute
+   * \param elidedEvents the slot-loop events elided by all the UEs (output)
+   * \return the outputs of the simulation, in the order they happened
+   */
+  std::vector<std::string> Run (bool idleSlotElision, uint64_t *elidedEvents);
+
+  /**
+   * \brief Save a CTRL message seen by the PHY or the MAC of a UE
+   * \param context the UE and the trace
+   * \param sfn the slot
+   * \param cellId the cell ID
+   * \param rnti the RNTI
+   * \param bwpId the BWP ID
+   * \param msg the message
+   */
+  void CtrlMsgTrace (std::string context, SfnSf sfn, uint16_t cellId, uint16_t rnti,
+                     uint8_t bwpId, Ptr<const NrControlMessage> msg);
+
+  /**
+   * \brief Save the SINR of a DL DATA reception
+   * \param context the UE
+   * \param cellId the cell ID
+   * \param rnti the RNTI
+   * \param avgSinr the average SINR
+   * \param bwpId the BWP ID
+   * \param streamId the stream ID
+   */
+  void DlDataSinrTrace (std::string context, uint16_t cellId, uint16_t rnti, double avgSinr,
+                        uint16_t bwpId, uint8_t streamId);
+
+  /**
+   * \brief Save a DL or UL allocation of the gNB
+   * \param context the direction
+   * \param info the allocation
+   */
+  void SchedulingTrace (std::string context, NrSchedulingCallbackInfo info);
+
+  /**
+   * \brief Save the current slot of the UE PHYs
+   * \param phys the UE PHYs
+   *
+   * The probe is scheduled before the run, so it comes before the slot-loop
+   * events of the same time, as any event scheduled in advance. It resumes
+   * the slot loop, that is what makes the current slot valid.
+   */
+  void ProbeSlot (std::vector<Ptr<NrUePhy> > phys);
+
+  std::vector<std::string> m_output; //!< Outputs of the current run
+};
+
+void
+NrIdleSlotElisionTestCase::CtrlMsgTrace (std::string context, SfnSf sfn, uint16_t cellId,
+                                         uint16_t rnti, uint8_t bwpId, Ptr<const NrControlMessage> msg)
+{
+  std::ostringstream oss;
+  oss << Simulator::Now ().GetTimeStep () << " " << context << " " << sfn << " " << cellId
+      << " " << rnti << " " << +bwpId << " " << msg->GetMessageType ();
+  m_output.push_back (oss.str ());
+}
+
+void
+NrIdleSlotElisionTestCase::DlDataSinrTrace (std::string context, uint16_t cellId, uint16_t rnti,
+                                            double avgSinr, uint16_t bwpId, uint8_t streamId)
+{
+  std::ostringstream oss;
+  oss << Simulator::Now ().GetTimeStep () << " " << context << " " << cellId << " " << rnti
+      << " " << std::setprecision (17) << avgSinr << " " << bwpId << " " << +streamId;
+  m_output.push_back (oss.str ());
+}
+
+void
+NrIdleSlotElisionTestCase::SchedulingTrace (std::string context, NrSchedulingCallbackInfo info)
+{
+  std::ostringstream oss;
+  oss << Simulator::Now ().GetTimeStep () << " " << context << " " << info.m_frameNum << " "
+      << +info.m_subframeNum << " " << info.m_slotNum << " " << +info.m_symStart << " "
+      << +info.m_numSym << " " << info.m_rnti << " " << +info.m_mcs << " " << info.m_tbSize
+      << " " << +info.m_ndi << " " << +info.m_rv << " " << +info.m_harqId;
+  m_output.push_back (oss.str ());
+}
+
+void
+NrIdleSlotElisionTestCase::ProbeSlot (std::vector<Ptr<NrUePhy> > phys)
+{
+  for (uint32_t i = 0; i < phys.size (); ++i)
+    {
+      phys[i]->ResumeSlotLoop ();
+      std::ostringstream oss;
+      oss << Simulator::Now ().GetTimeStep () << " ue" << i << " slot " << phys[i]->GetCurrentSfnSf ();
+      m_output.push_back (oss.str ());
+    }
+}
+
+std::vector<std::string>
+NrIdleSlotElisionTestCase::Run (bool idleSlotElision, uint64_t *elidedEvents)
+{
+  const uint16_t ueNum = 4;
+  const Time appStartTime = MilliSeconds (400);
+  const Time simTime = MilliSeconds (800);
+  const uint32_t packetSize = 100;
+
+  m_output.clear ();
+
+  Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (999999999));
+  Config::SetDefault ("ns3::NrUePhy::IdleSlotElision", BooleanValue (idleSlotElision));
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  NodeContainer gNbNodes;
+  NodeContainer ueNodes;
+  gNbNodes.Create (1);
+  ueNodes.Create (ueNum);
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  Ptr<ListPositionAllocator> gnbPositionAlloc = CreateObject<ListPositionAllocator> ();
+  gnbPositionAlloc->Add (Vector (0.0, 0.0, 10.0));
+  mobility.SetPositionAllocator (gnbPositionAlloc);
+  mobility.Install (gNbNodes);
+  Ptr<ListPositionAllocator> uePositionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint16_t i = 0; i < ueNum; ++i)
+    {
+      uePositionAlloc->Add (Vector (20.0 + 15.0 * i, 10.0 * i, 1.5));
+    }
+  mobility.SetPositionAllocator (uePositionAlloc);
+  mobility.Install (ueNodes);
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<IdealBeamformingHelper> idealBeamformingHelper = CreateObject<IdealBeamformingHelper> ();
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  nrHelper->SetBeamformingHelper (idealBeamformingHelper);
+  nrHelper->SetEpcHelper (epcHelper);
+  idealBeamformingHelper->SetAttribute ("BeamformingMethod", TypeIdValue (DirectPathBeamforming::GetTypeId ()));
+
+  CcBwpCreator ccBwpCreator;
+  CcBwpCreator::SimpleOperationBandConf bandConf (3.5e9, 20e6, 1, BandwidthPartInfo::UMa);
+  OperationBandInfo band = ccBwpCreator.CreateOperationBandContiguousCc (bandConf);
+  nrHelper->SetChannelConditionModelAttribute ("UpdatePeriod", TimeValue (MilliSeconds (0)));
+  nrHelper->SetPathlossAttribute ("ShadowingEnabled", BooleanValue (false));
+  nrHelper->InitializeOperationBand (&band);
+  BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps ({band});
+
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbAntennaAttribute ("NumRows", UintegerValue (2));
+  nrHelper->SetGnbAntennaAttribute ("NumColumns", UintegerValue (2));
+  nrHelper->SetGnbAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetGnbPhyAttribute ("Numerology", UintegerValue (0));
+  nrHelper->SetGnbPhyAttribute ("Pattern", StringValue ("DL|DL|DL|F|UL|UL|UL|UL|UL|UL|"));
+
+  NetDeviceContainer gnbDevs = nrHelper->InstallGnbDevice (gNbNodes, allBwps);
+  NetDeviceContainer ueDevs = nrHelper->InstallUeDevice (ueNodes, allBwps);
+  int64_t randomStream = 1;
+  randomStream += nrHelper->AssignStreams (gnbDevs, randomStream);
+  randomStream += nrHelper->AssignStreams (ueDevs, randomStream);
+  for (auto it = gnbDevs.Begin (); it != gnbDevs.End (); ++it)
+    {
+      DynamicCast<NrGnbNetDevice> (*it)->UpdateConfig ();
+    }
+  for (auto it = ueDevs.Begin (); it != ueDevs.End (); ++it)
+    {
+      DynamicCast<NrUeNetDevice> (*it)->UpdateConfig ();
+    }
+
+  Ptr<Node> pgw = epcHelper->GetPgwNode ();
+  NodeContainer remoteHostContainer;
+  remoteHostContainer.Create (1);
+  Ptr<Node> remoteHost = remoteHostContainer.Get (0);
+  InternetStackHelper internet;
+  internet.Install (remoteHostContainer);
+  PointToPointHelper p2ph;
+  p2ph.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("100Gb/s")));
+  p2ph.SetDeviceAttribute ("Mtu", UintegerValue (2500));
+  p2ph.SetChannelAttribute ("Delay", TimeValue (Seconds (0.000)));
+  NetDeviceContainer internetDevices = p2ph.Install (pgw, remoteHost);
+  Ipv4AddressHelper ipv4h;
+  ipv4h.SetBase ("1.0.0.0", "255.0.0.0");
+  Ipv4InterfaceContainer internetIpIfaces = ipv4h.Assign (internetDevices);
+  Ipv4Address remoteHostAddr = internetIpIfaces.GetAddress (1);
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  Ptr<Ipv4StaticRouting> remoteHostStaticRouting = ipv4RoutingHelper.GetStaticRouting (remoteHost->GetObject<Ipv4> ());
+  remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"), 1);
+  internet.Install (ueNodes);
+  Ipv4InterfaceContainer ueIpIface = epcHelper->AssignUeIpv4Address (ueDevs);
+  for (uint32_t j = 0; j < ueNodes.GetN (); ++j)
+    {
+      Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ueNodes.Get (j)->GetObject<Ipv4> ());
+      ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+    }
+
+  nrHelper->AttachToClosestEnb (ueDevs, gnbDevs);
+
+  // Sparse traffic, with packets sent at slot boundaries: the first two UEs
+  // receive, the other two send, each with a different period
+  uint16_t port = 1234;
+  ApplicationContainer clientApps;
+  ApplicationContainer serverApps;
+  for (uint32_t j = 0; j < ueNodes.GetN (); ++j)
+    {
+      bool isDl = j < ueNum / 2;
+      UdpServerHelper server (port);
+      serverApps.Add (server.Install (isDl ? ueNodes.Get (j) : remoteHost));
+      UdpClientHelper client (isDl ? ueIpIface.GetAddress (j) : remoteHostAddr, port);
+      client.SetAttribute ("MaxPackets", UintegerValue (0xFFFFFFFF));
+      client.SetAttribute ("PacketSize", UintegerValue (packetSize));
+      client.SetAttribute ("Interval", TimeValue (MilliSeconds (17 + 6 * j)));
+      clientApps.Add (client.Install (isDl ? remoteHost : ueNodes.Get (j)));
+      ++port;
+    }
+  serverApps.Start (appStartTime);
+  clientApps.Start (appStartTime);
+  serverApps.Stop (simTime);
+  clientApps.Stop (simTime);
+
+  std::vector<Ptr<NrUePhy> > phys;
+  for (uint32_t j = 0; j < ueDevs.GetN (); ++j)
+    {
+      std::string ue = "ue" + std::to_string (j);
+      Ptr<NrUePhy> phy = nrHelper->GetUePhy (ueDevs.Get (j), 0);
+      Ptr<NrUeMac> mac = nrHelper->GetUeMac (ueDevs.Get (j), 0);
+      phy->TraceConnect ("UePhyRxedCtrlMsgsTrace", ue + " phy-rx",
+                         MakeCallback (&NrIdleSlotElisionTestCase::CtrlMsgTrace, this));
+      phy->TraceConnect ("UePhyTxedCtrlMsgsTrace", ue + " phy-tx",
+                         MakeCallback (&NrIdleSlotElisionTestCase::CtrlMsgTrace, this));
+      phy->TraceConnect ("DlDataSinr", ue + " sinr",
+                         MakeCallback (&NrIdleSlotElisionTestCase::DlDataSinrTrace, this));
+      mac->TraceConnect ("UeMacRxedCtrlMsgsTrace", ue + " mac-rx",
+                         MakeCallback (&NrIdleSlotElisionTestCase::CtrlMsgTrace, this));
+      mac->TraceConnect ("UeMacTxedCtrlMsgsTrace", ue + " mac-tx",
+                         MakeCallback (&NrIdleSlotElisionTestCase::CtrlMsgTrace, this));
+      phys.push_back (phy);
+    }
+  Ptr<NrGnbMac> gnbMac = nrHelper->GetGnbMac (gnbDevs.Get (0), 0);
+  gnbMac->TraceConnect ("DlScheduling", "dl", MakeCallback (&NrIdleSlotElisionTestCase::SchedulingTrace, this));
+  gnbMac->TraceConnect ("UlScheduling", "ul", MakeCallback (&NrIdleSlotElisionTestCase::SchedulingTrace, this));
+
+  // Slots 0-2 are DL, 3 is F, 4-9 are UL: read the slot at the start of a
+  // slot after an UL, a DL and a F slot, and in the middle of a slot
+  for (Time t : {MilliSeconds (600), MilliSeconds (601), MicroSeconds (602500), MilliSeconds (604),
+                 MilliSeconds (750), MicroSeconds (757300)})
+    {
+      Simulator::Schedule (t, &NrIdleSlotElisionTestCase::ProbeSlot, this, phys);
+    }
+
+  Simulator::Stop (simTime);
+  Simulator::Run ();
+
+  for (uint32_t j = 0; j < serverApps.GetN (); ++j)
+    {
+      std::ostringstream oss;
+      oss << "server" << j << " received " << serverApps.Get (j)->GetObject<UdpServer> ()->GetReceived ();
+      m_output.push_back (oss.str ());
+    }
+
+  *elidedEvents = 0;
+  for (const auto & phy : phys)
+    {
+      *elidedEvents += phy->GetElidedEventsCount ();
+    }
+
+  Simulator::Destroy ();
+  return m_output;
+}
+
+void
+NrIdleSlotElisionTestCase::DoRun ()
+{
+  uint64_t elidedOff = 0;
+  uint64_t elidedOn = 0;
+  std::vector<std::string> outputOff = Run (false, &elidedOff);
+  std::vector<std::string> outputOn = Run (true, &elidedOn);
+
+  NS_TEST_EXPECT_MSG_EQ (elidedOff, 0, "Events elided with IdleSlotElision off");
+  NS_TEST_EXPECT_MSG_GT (elidedOn, 0, "No event elided with IdleSlotElision on");
+
+  NS_TEST_ASSERT_MSG_EQ (outputOn.size (), outputOff.size (), "Different number of outputs");
+  for (std::size_t i = 0; i < outputOff.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (outputOn[i], outputOff[i], "Output " << i << " differs");
+    }
+}
+
+/**
+ * \ingroup test
+ * \brief Test suite for the idle slot elision of NrUePhy
+ */
+class NrIdleSlotElisionTestSuite : public TestSuite
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrIdleSlotElisionTestSuite ()
+    : TestSuite ("nr-idle-slot-elision", SYSTEM)
+  {
+    AddTestCase (new NrIdleSlotElisionTestCase (), QUICK);
+  }
+};
+
+static NrIdleSlotElisionTestSuite g_nrIdleSlotElisionTestSuite; //!< Idle slot elision test suite
+
+}  // namespace ns3
@@ -0,0 +1,166 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/nr-spectrum-value-helper.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/nr-lte-mi-error-model.h>
+#include <cmath>
+
+/**
+ * \file nr-lte-mi-error-model-test.cc
+ * \ingroup test
+ *
+ * \brief Check the HARQ combining of NrLteMiErrorModel. The MI accumulated
+ * in the outputs must give exactly the MI obtained by summing the MI and code
+ * bits of the whole history, and the TBLER must be the one of the effective
+ * MI and code rate obtained by walking the whole history, for random SINRs,
+ * RB maps and MCSs.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ * \brief Compare the HARQ MI of NrLteMiErrorModel with a sum over the history
+ */
+class NrLteMiErrorModelHarqTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param numTbs number of random TBs
+   */
+  NrLteMiErrorModelHarqTestCase (uint32_t numTbs)
+    : TestCase ("MI HARQ combining of " + std::to_string (numTbs) + " random TBs"),
+      m_numTbs (numTbs)
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+
+  uint32_t m_numTbs {0}; //!< Number of random TBs
+};
+
+void
+NrLteMiErrorModelHarqTestCase::DoRun ()
+{
+  const uint32_t numRbs = 50;
+  const uint32_t maxTx = 4;
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+
+  NrSpectrumValueHelper helper;
+  Ptr<const SpectrumModel> sm = helper.GetSpectrumModel (numRbs, 3.6e9, 15000);
+  Ptr<NrLteMiErrorModel> errorModel = CreateObject<NrLteMiErrorModel> ();
+
+  for (uint32_t tb = 0; tb < m_numTbs; tb++)
+    {
+      uint8_t mcs = random->GetInteger (0, errorModel->GetMaxMcs ());
+      uint32_t tbSize = random->GetInteger (100, 4000);
+      NrErrorModel::NrErrorModelHistory history;
+
+      for (uint32_t tx = 0; tx < maxTx; tx++)
+        {
+          SpectrumValue sinr (sm);
+          std::vector<int> map;
+          for (uint32_t rb = 0; rb < numRbs; rb++)
+            {
+              // Include SINRs beyond the last value of the MI maps
+              sinr[rb] = std::pow (10.0, random->GetValue (-10.0, 60.0) / 10.0);
+              if (random->GetValue () < 0.5)
+                {
+                  map.push_back (rb);
+                }
+            }
+
+          Ptr<NrLteMiErrorModelOutput> output = DynamicCast<NrLteMiErrorModelOutput>
+            (errorModel->GetTbDecodificationStats (sinr, map, tbSize, mcs, history));
+          NS_TEST_ASSERT_MSG_NE (output, nullptr, "Wrong output type");
+          NS_TEST_EXPECT_MSG_EQ ((output->m_mi >= 0.0 && output->m_mi <= 1.0), true, "MI out of [0, 1]");
+
+          double expectedMi = output->m_mi;
+          if (history.size () > 0)
+            {
+              // HARQ IR combining, as the model did before caching the sums:
+              // the code bits and MI of the history, walked in order, plus
+              // the untruncated code bits of the current transmission
+              uint32_t historyCodeBits = 0;
+              double historyMi = 0.0;
+              for (const Ptr<NrErrorModelOutput> &h : history)
+                {
+                  Ptr<NrLteMiErrorModelOutput> miHistory = DynamicCast<NrLteMiErrorModelOutput> (h);
+                  historyCodeBits += miHistory->m_codeBits;
+                  historyMi += (miHistory->m_mi * miHistory->m_codeBits);
+                }
+              double ecr = NrLteMiErrorModel::GetMcsEcr (mcs);
+              uint32_t codeBitsSum = historyCodeBits;
+              double miSum = historyMi;
+              codeBitsSum += (tbSize * 8) / ecr;
+              miSum += output->m_mi * ((tbSize * 8) / ecr);
+              expectedMi = miSum / static_cast<double> (codeBitsSum);
+              double infoBits = DynamicCast<NrLteMiErrorModelOutput> (history.front ())->m_infoBits;
+              double expectedReff = infoBits / static_cast<double> (codeBitsSum);
+
+              NS_TEST_EXPECT_MSG_EQ (output->m_codeBitsSum, historyCodeBits + output->m_codeBits,
+                                     "Accumulated code bits differ from the sum over the history at tx " << tx);
+              NS_TEST_EXPECT_MSG_EQ (output->m_tbler,
+                                     NrLteMiErrorModel::GetTbler (expectedMi, expectedReff, mcs, tbSize * 8, true),
+                                     "TBLER differs from the one of the walked history at tx " << tx);
+            }
+          else
+            {
+              NS_TEST_EXPECT_MSG_EQ (output->m_tbler,
+                                     NrLteMiErrorModel::GetTbler (output->m_mi, 0.0, mcs, tbSize * 8, false),
+                                     "TBLER of the first transmission differs from the one of its MI");
+            }
+          NS_TEST_EXPECT_MSG_EQ (output->m_miTotal, expectedMi,
+                                 "Accumulated MI differs from the sum over the history at tx " << tx);
+
+          history.push_back (output);
+        }
+    }
+
+  // All the RBs above the last SINR of the MI maps
+  SpectrumValue sinr (sm);
+  sinr = 1e9;
+  std::vector<int> map {0, 1, 2, 3};
+  for (uint8_t mcs = 0; mcs <= errorModel->GetMaxMcs (); mcs++)
+    {
+      Ptr<NrLteMiErrorModelOutput> output = DynamicCast<NrLteMiErrorModelOutput>
+        (errorModel->GetTbDecodificationStats (sinr, map, 100, mcs, NrErrorModel::NrErrorModelHistory ()));
+      NS_TEST_EXPECT_MSG_EQ (output->m_mi, 1.0, "The MI of a very high SINR should be 1 for MCS " << +mcs);
+    }
+}
+
+/**
+ * \ingroup test
+ * \brief Test suite for NrLteMiErrorModel
+ */
+class NrLteMiErrorModelTestSuite : public TestSuite
+{
+public:
+  NrLteMiErrorModelTestSuite () : TestSuite ("nr-lte-mi-error-model", UNIT)
+  {
+    AddTestCase (new NrLteMiErrorModelHarqTestCase (200), QUICK);
+  }
+};
+
+static NrLteMiErrorModelTestSuite g_nrLteMiErrorModelTestSuite; //!< NrLteMiErrorModel test suite
+
+}  // namespace ns3
@@ -0,0 +1,493 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/packet.h>
+#include <ns3/buffer.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/nr-sl-pc5-signalling-header.h>
+
+/**
+ * \file nr-sl-pc5-signalling-header-test.cc
+ * \ingroup test
+ *
+ * \brief Round trip of randomly filled PC5 signalling messages. The
+ * serialized bytes are compared with a reference encoding written one
+ * octet (or one 4-octet ID) at a time, as the headers were originally
+ * serialized, and the deserialized fields with the original ones. A few
+ * fixed messages are also compared, in both directions, with the bytes
+ * that the original implementation of the headers produced for them.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ * \brief Round trip of random PC5 signalling messages
+ */
+class NrSlPc5SignallingHeaderTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param numMessages number of random messages of each type
+   */
+  NrSlPc5SignallingHeaderTestCase (uint32_t numMessages)
+    : TestCase ("Round trip of " + std::to_string (numMessages) + " random PC5 signalling messages of each type"),
+      m_numMessages (numMessages)
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Check that a header is serialized as the reference bytes, and
+   *        return the serialized packet
+   * \param header the header
+   * \param reference the reference encoding
+   * \return the packet with the serialized header
+   */
+  Ptr<Packet> CheckBytes (const Header &header, const Buffer &reference);
+
+  /**
+   * \brief Draw a vector of random values
+   * \param size the vector size
+   * \param max the maximum value
+   * \return the vector
+   */
+  template <typename T>
+  std::vector<T> DrawVector (uint32_t size, uint32_t max);
+
+  uint32_t m_numMessages {0};           //!< Number of random messages of each type
+  Ptr<UniformRandomVariable> m_random;  //!< Random variable
+};
+
+template <typename T>
+std::vector<T>
+NrSlPc5SignallingHeaderTestCase::DrawVector (uint32_t size, uint32_t max)
+{
+  std::vector<T> values (size);
+  for (auto &v : values)
+    {
+      v = static_cast<T> (m_random->GetInteger (0, max));
+    }
+  return values;
+}
+
+Ptr<Packet>
+NrSlPc5SignallingHeaderTestCase::CheckBytes (const Header &header, const Buffer &reference)
+{
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (header);
+
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), reference.GetSize (), "Wrong serialized size");
+  if (packet->GetSize () == reference.GetSize ())
+    {
+      std::vector<uint8_t> bytes (packet->GetSize ());
+      packet->CopyData (bytes.data (), bytes.size ());
+      Buffer::Iterator it = reference.Begin ();
+      for (uint32_t index = 0; index < bytes.size (); index++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (+bytes[index], +it.ReadU8 (), "Serialized octet " << index << " differs");
+        }
+    }
+  return packet;
+}
+
+void
+NrSlPc5SignallingHeaderTestCase::DoRun ()
+{
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (1);
+
+  for (uint32_t n = 0; n < m_numMessages; n++)
+    {
+      // Request, with a random subset of the optional IEs
+      std::vector<uint32_t> proseAppIds = DrawVector<uint32_t> (m_random->GetInteger (1, ProseDirectLinkEstablishmentRequest::MaxProseAppIds), UINT32_MAX);
+      std::vector<uint8_t> secCapabilities = DrawVector<uint8_t> (m_random->GetInteger (1, ProseDirectLinkEstablishmentRequest::MaxSecCapabilitiesSize), UINT8_MAX);
+      std::vector<uint8_t> nonce1 = DrawVector<uint8_t> (ProseDirectLinkEstablishmentRequest::NonceSize, UINT8_MAX);
+      uint8_t seq = m_random->GetInteger (0, UINT8_MAX);
+      uint32_t srcUserInfo = m_random->GetInteger (0, UINT32_MAX);
+      uint8_t ueSigSecPolicy = m_random->GetInteger (0, UINT8_MAX);
+      // Zero means absent for the optional IEs set through SetParameters
+      uint8_t keyEsInfoContainer = m_random->GetInteger (0, 1) * m_random->GetInteger (1, UINT8_MAX);
+      bool hasNonce1 = m_random->GetInteger (0, 1);
+      uint8_t msb = m_random->GetInteger (0, 1) * m_random->GetInteger (1, UINT8_MAX);
+      uint32_t tgtUserInfo = m_random->GetInteger (0, 1) * m_random->GetInteger (1, UINT32_MAX);
+      uint32_t knrpId = m_random->GetInteger (0, 1) * m_random->GetInteger (1, UINT32_MAX);
+      uint32_t relayServiceCode = m_random->GetInteger (0, 1) * m_random->GetInteger (1, 0xffffff);
+
+      ProseDirectLinkEstablishmentRequest request;
+      request.SetParameters (seq, proseAppIds, srcUserInfo, secCapabilities, ueSigSecPolicy,
+                             keyEsInfoContainer, hasNonce1 ? nonce1 : std::vector<uint8_t> (),
+                             msb, tgtUserInfo, knrpId, relayServiceCode);
+
+      Buffer reference;
+      reference.AddAtStart (2 + 2 + 4 * proseAppIds.size () + 6 + 2 + secCapabilities.size () + 2
+                            + (keyEsInfoContainer ? 3 : 0) + (hasNonce1 ? 17 : 0) + (msb ? 2 : 0)
+                            + (tgtUserInfo ? 6 : 0) + (knrpId ? 5 : 0) + (relayServiceCode ? 4 : 0));
+      Buffer::Iterator i = reference.Begin ();
+      i.WriteU8 (NrSlPc5SignallingMessageType::ProseDirectLinkEstablishmentRequest);
+      i.WriteU8 (seq);
+      i.WriteU8 (0);
+      i.WriteU8 (proseAppIds.size () * 4);
+      for (uint32_t id : proseAppIds)
+        {
+          i.WriteU32 (id);
+        }
+      i.WriteU8 (0);
+      i.WriteU8 (4);
+      i.WriteU32 (srcUserInfo);
+      i.WriteU8 (0);
+      i.WriteU8 (secCapabilities.size ());
+      for (uint8_t octet : secCapabilities)
+        {
+          i.WriteU8 (octet);
+        }
+      i.WriteU8 (0);
+      i.WriteU8 (ueSigSecPolicy);
+      if (keyEsInfoContainer)
+        {
+          i.WriteU8 (74);
+          i.WriteU8 (1);
+          i.WriteU8 (keyEsInfoContainer);
+        }
+      if (hasNonce1)
+        {
+          i.WriteU8 (53);
+          for (uint8_t octet : nonce1)
+            {
+              i.WriteU8 (octet);
+            }
+        }
+      if (msb)
+        {
+          i.WriteU8 (54);
+          i.WriteU8 (msb);
+        }
+      if (tgtUserInfo)
+        {
+          i.WriteU8 (28);
+          i.WriteU8 (4);
+          i.WriteU32 (tgtUserInfo);
+        }
+      if (knrpId)
+        {
+          i.WriteU8 (52);
+          i.WriteU32 (knrpId);
+        }
+      if (relayServiceCode)
+        {
+          i.WriteU8 (25);
+          i.WriteU8 (relayServiceCode & 0xff);
+          i.WriteU8 ((relayServiceCode >> 8) & 0xff);
+          i.WriteU8 ((relayServiceCode >> 16) & 0xff);
+        }
+
+      Ptr<Packet> packet = CheckBytes (request, reference);
+
+      NrSlPc5SignallingMessageType msgType;
+      packet->PeekHeader (msgType);
+      NS_TEST_EXPECT_MSG_EQ (+msgType.GetMessageType (), +NrSlPc5SignallingMessageType::ProseDirectLinkEstablishmentRequest,
+                             "Wrong message type");
+      NS_TEST_EXPECT_MSG_EQ (msgType.GetMessageName (), "PROSE DIRECT LINK ESTABLISHMENT REQUEST", "Wrong message name");
+      NS_TEST_EXPECT_MSG_EQ (msgType.GetMessageAcronym (), "PDL-Es-Rq", "Wrong message acronym");
+
+      ProseDirectLinkEstablishmentRequest rxRequest;
+      packet->RemoveHeader (rxRequest);
+      NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 0, "The deserialized size does not match the serialized one");
+      NS_TEST_EXPECT_MSG_EQ (rxRequest.GetSequenceNumber (), +seq, "Wrong sequence number");
+      NS_TEST_EXPECT_MSG_EQ ((rxRequest.GetProseApplicationIds () == proseAppIds), true, "Wrong ProSe application ids");
+      NS_TEST_EXPECT_MSG_EQ (rxRequest.GetSourceUserInfo (), srcUserInfo, "Wrong source user info");
+      NS_TEST_EXPECT_MSG_EQ ((rxRequest.GetUeSecurityCapabilities () == secCapabilities), true, "Wrong security capabilities");
+      NS_TEST_EXPECT_MSG_EQ (+rxRequest.GetUeSignallingSecurityPolicy (), +ueSigSecPolicy, "Wrong signalling security policy");
+      NS_TEST_EXPECT_MSG_EQ (+rxRequest.GetKeyEstablishmentInfoContainer (), +keyEsInfoContainer, "Wrong key establishment info");
+      if (hasNonce1)
+        {
+          NS_TEST_EXPECT_MSG_EQ ((rxRequest.GetNonce1 () == nonce1), true, "Wrong nonce");
+        }
+      NS_TEST_EXPECT_MSG_EQ (+rxRequest.GetMsbKdId (), +msb, "Wrong MSB of the KD-sess ID");
+      NS_TEST_EXPECT_MSG_EQ (rxRequest.GetTargetUserInfo (), tgtUserInfo, "Wrong target user info");
+      NS_TEST_EXPECT_MSG_EQ (rxRequest.GetKnrpId (), knrpId, "Wrong Knrp ID");
+      NS_TEST_EXPECT_MSG_EQ (rxRequest.GetRelayServiceCode (), relayServiceCode, "Wrong relay service code");
+
+      // Accept, with or without the link-local IPv6 address
+      std::vector<uint8_t> qosFlowDescriptions = DrawVector<uint8_t> (m_random->GetInteger (0, 300), UINT8_MAX);
+      std::vector<uint8_t> linkLocalIpv6Address = DrawVector<uint8_t> (ProseDirectLinkEstablishmentAccept::LinkLocalIpv6AddressSize, UINT8_MAX);
+      uint8_t userPlaneSecConfig = m_random->GetInteger (0, UINT8_MAX);
+      uint8_t ipAddressConfig = m_random->GetInteger (0, UINT8_MAX);
+      bool hasLinkLocalIpv6Address = m_random->GetInteger (0, 1);
+
+      ProseDirectLinkEstablishmentAccept accept;
+      accept.SetSequenceNumber (seq);
+      accept.SetSourceUserInfo (srcUserInfo);
+      accept.SetPc5QoSFlowDescriptions (qosFlowDescriptions);
+      accept.SetUserPlaneSecurityProtectionConfiguration (userPlaneSecConfig);
+      accept.SetIpAddressConfig (ipAddressConfig);
+      if (hasLinkLocalIpv6Address)
+        {
+          accept.SetLinkLocalIpv6Address (linkLocalIpv6Address);
+        }
+
+      reference = Buffer ();
+      reference.AddAtStart (2 + 6 + 3 + qosFlowDescriptions.size () + 2 + 2 + (hasLinkLocalIpv6Address ? 17 : 0));
+      i = reference.Begin ();
+      i.WriteU8 (NrSlPc5SignallingMessageType::ProseDirectLinkEstablishmentAccept);
+      i.WriteU8 (seq);
+      i.WriteU8 (0);
+      i.WriteU8 (4);
+      i.WriteU32 (srcUserInfo);
+      i.WriteU8 (0);
+      i.WriteU16 (qosFlowDescriptions.size ());
+      for (uint8_t octet : qosFlowDescriptions)
+        {
+          i.WriteU8 (octet);
+        }
+      i.WriteU8 (0);
+      i.WriteU8 (userPlaneSecConfig);
+      i.WriteU8 (57);
+      i.WriteU8 (ipAddressConfig);
+      if (hasLinkLocalIpv6Address)
+        {
+          i.WriteU8 (58);
+          for (uint8_t octet : linkLocalIpv6Address)
+            {
+              i.WriteU8 (octet);
+            }
+        }
+
+      packet = CheckBytes (accept, reference);
+
+      ProseDirectLinkEstablishmentAccept rxAccept;
+      packet->RemoveHeader (rxAccept);
+      NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 0, "The deserialized size does not match the serialized one");
+      NS_TEST_EXPECT_MSG_EQ (rxAccept.GetSequenceNumber (), +seq, "Wrong sequence number");
+      NS_TEST_EXPECT_MSG_EQ (rxAccept.GetSourceUserInfo (), srcUserInfo, "Wrong source user info");
+      NS_TEST_EXPECT_MSG_EQ ((rxAccept.GetPc5QoSFlowDescriptions () == qosFlowDescriptions), true, "Wrong QoS flow descriptions");
+      NS_TEST_EXPECT_MSG_EQ (rxAccept.GetUserPlaneSecurityProtectionConfiguration (), +userPlaneSecConfig,
+                             "Wrong user plane security protection configuration");
+      NS_TEST_EXPECT_MSG_EQ (+rxAccept.GetIpAddressConfig (), +ipAddressConfig, "Wrong IP address configuration");
+      if (hasLinkLocalIpv6Address)
+        {
+          NS_TEST_EXPECT_MSG_EQ ((rxAccept.GetLinkLocalIpv6Address () == linkLocalIpv6Address), true,
+                                 "Wrong link-local IPv6 address");
+        }
+
+      // Reject
+      uint8_t cause = m_random->GetInteger (0, UINT8_MAX);
+      ProseDirectLinkEstablishmentReject reject;
+      reject.SetSequenceNumber (seq);
+      reject.SetPc5SignallingProtocolCause (cause);
+
+      reference = Buffer ();
+      reference.AddAtStart (3);
+      i = reference.Begin ();
+      i.WriteU8 (NrSlPc5SignallingMessageType::ProseDirectLinkEstablishmentReject);
+      i.WriteU8 (seq);
+      i.WriteU8 (cause);
+
+      packet = CheckBytes (reject, reference);
+
+      ProseDirectLinkEstablishmentReject rxReject;
+      packet->RemoveHeader (rxReject);
+      NS_TEST_EXPECT_MSG_EQ (rxReject.GetSequenceNumber (), +seq, "Wrong sequence number");
+      NS_TEST_EXPECT_MSG_EQ (+rxReject.GetPc5SignallingProtocolCause (), +cause, "Wrong cause");
+    }
+}
+
+/**
+ * \ingroup test
+ * \brief Serialize and deserialize fixed PC5 signalling messages, against
+ * the bytes of the original implementation of the headers
+ */
+class NrSlPc5SignallingHeaderGoldenTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrSlPc5SignallingHeaderGoldenTestCase ()
+    : TestCase ("Fixed PC5 signalling messages against the bytes of the original headers")
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Check that a header is serialized as the golden bytes, and
+   *        return a packet made of the golden bytes
+   * \param header the header
+   * \param golden the golden bytes
+   * \return a packet that holds the golden bytes
+   */
+  Ptr<Packet> CheckGolden (const Header &header, const std::vector<uint8_t> &golden);
+};
+
+Ptr<Packet>
+NrSlPc5SignallingHeaderGoldenTestCase::CheckGolden (const Header &header, const std::vector<uint8_t> &golden)
+{
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (header);
+
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), golden.size (), "Wrong serialized size");
+  if (packet->GetSize () == golden.size ())
+    {
+      std::vector<uint8_t> bytes (packet->GetSize ());
+      packet->CopyData (bytes.data (), bytes.size ());
+      for (uint32_t index = 0; index < bytes.size (); index++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (+bytes[index], +golden[index], "Serialized octet " << index << " differs");
+        }
+    }
+  return Create<Packet> (golden.data (), golden.size ());
+}
+
+void
+NrSlPc5SignallingHeaderGoldenTestCase::DoRun ()
+{
+  // The golden bytes were derived from the serializers of the headers before
+  // the bounded fields were stored inline. The multi-octet fields are
+  // written with Buffer::Iterator::WriteU16 and WriteU32, i.e., least
+  // significant octet first.
+
+  // Request with the mandatory IEs only
+  ProseDirectLinkEstablishmentRequest request;
+  request.SetParameters (0x2a, {0x01020304}, 0xa1b2c3d4, {0x11, 0x22}, 0x33,
+                         0, std::vector<uint8_t> (), 0, 0, 0, 0);
+  const std::vector<uint8_t> requestGolden {
+    0x01, 0x2a,                         // message type, sequence number
+    0x00, 0x04, 0x04, 0x03, 0x02, 0x01, // ProSe application IDs
+    0x00, 0x04, 0xd4, 0xc3, 0xb2, 0xa1, // source user info
+    0x00, 0x02, 0x11, 0x22,             // UE security capabilities
+    0x00, 0x33                          // UE signalling security policy
+  };
+  Ptr<Packet> packet = CheckGolden (request, requestGolden);
+  ProseDirectLinkEstablishmentRequest rxRequest;
+  packet->RemoveHeader (rxRequest);
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 0, "The golden request was not entirely deserialized");
+  NS_TEST_EXPECT_MSG_EQ (rxRequest.GetSequenceNumber (), 0x2a, "Wrong sequence number");
+  NS_TEST_EXPECT_MSG_EQ ((rxRequest.GetProseApplicationIds () == std::vector<uint32_t> {0x01020304}), true,
+                         "Wrong ProSe application ids");
+  NS_TEST_EXPECT_MSG_EQ (rxRequest.GetSourceUserInfo (), 0xa1b2c3d4, "Wrong source user info");
+  NS_TEST_EXPECT_MSG_EQ ((rxRequest.GetUeSecurityCapabilities () == std::vector<uint8_t> {0x11, 0x22}), true,
+                         "Wrong security capabilities");
+  NS_TEST_EXPECT_MSG_EQ (+rxRequest.GetUeSignallingSecurityPolicy (), 0x33, "Wrong signalling security policy");
+  NS_TEST_EXPECT_MSG_EQ (+rxRequest.GetKeyEstablishmentInfoContainer (), 0, "Unexpected key establishment info");
+  NS_TEST_EXPECT_MSG_EQ (rxRequest.GetRelayServiceCode (), 0, "Unexpected relay service code");
+
+  // Request with all the optional IEs
+  std::vector<uint8_t> nonce1 (ProseDirectLinkEstablishmentRequest::NonceSize);
+  for (uint8_t n = 0; n < nonce1.size (); n++)
+    {
+      nonce1[n] = n;
+    }
+  ProseDirectLinkEstablishmentRequest fullRequest;
+  fullRequest.SetParameters (0x07, {0xdeadbeef, 0x00000005}, 0x00000102, {0xaa}, 0x01,
+                             0x5c, nonce1, 0x9e, 0x0a0b0c0d, 0x12345678, 0x00abcdef);
+  const std::vector<uint8_t> fullRequestGolden {
+    0x01, 0x07,                         // message type, sequence number
+    0x00, 0x08, 0xef, 0xbe, 0xad, 0xde,
+    0x05, 0x00, 0x00, 0x00,             // ProSe application IDs
+    0x00, 0x04, 0x02, 0x01, 0x00, 0x00, // source user info
+    0x00, 0x01, 0xaa,                   // UE security capabilities
+    0x00, 0x01,                         // UE signalling security policy
+    74, 0x01, 0x5c,                     // key establishment information container
+    53, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, // nonce 1
+    54, 0x9e,                           // MSB of the KNRP-sess ID
+    28, 0x04, 0x0d, 0x0c, 0x0b, 0x0a,   // target user info
+    52, 0x78, 0x56, 0x34, 0x12,         // KNRP ID
+    25, 0xef, 0xcd, 0xab                // relay service code
+  };
+  packet = CheckGolden (fullRequest, fullRequestGolden);
+  ProseDirectLinkEstablishmentRequest rxFullRequest;
+  packet->RemoveHeader (rxFullRequest);
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 0, "The golden request was not entirely deserialized");
+  NS_TEST_EXPECT_MSG_EQ ((rxFullRequest.GetProseApplicationIds () == std::vector<uint32_t> {0xdeadbeef, 0x00000005}), true,
+                         "Wrong ProSe application ids");
+  NS_TEST_EXPECT_MSG_EQ (rxFullRequest.GetSourceUserInfo (), 0x00000102, "Wrong source user info");
+  NS_TEST_EXPECT_MSG_EQ (+rxFullRequest.GetKeyEstablishmentInfoContainer (), 0x5c, "Wrong key establishment info");
+  NS_TEST_EXPECT_MSG_EQ ((rxFullRequest.GetNonce1 () == nonce1), true, "Wrong nonce");
+  NS_TEST_EXPECT_MSG_EQ (+rxFullRequest.GetMsbKdId (), 0x9e, "Wrong MSB of the KD-sess ID");
+  NS_TEST_EXPECT_MSG_EQ (rxFullRequest.GetTargetUserInfo (), 0x0a0b0c0d, "Wrong target user info");
+  NS_TEST_EXPECT_MSG_EQ (rxFullRequest.GetKnrpId (), 0x12345678, "Wrong Knrp ID");
+  NS_TEST_EXPECT_MSG_EQ (rxFullRequest.GetRelayServiceCode (), 0x00abcdef, "Wrong relay service code");
+
+  // Accept with the optional IEs
+  std::vector<uint8_t> linkLocalIpv6Address (ProseDirectLinkEstablishmentAccept::LinkLocalIpv6AddressSize, 0);
+  linkLocalIpv6Address.front () = 0xfe;
+  linkLocalIpv6Address.at (1) = 0x80;
+  linkLocalIpv6Address.back () = 0x01;
+  ProseDirectLinkEstablishmentAccept accept;
+  accept.SetSequenceNumber (0x2a);
+  accept.SetSourceUserInfo (0xa1b2c3d4);
+  accept.SetPc5QoSFlowDescriptions ({0x01, 0x02, 0x03});
+  accept.SetUserPlaneSecurityProtectionConfiguration (0x44);
+  accept.SetIpAddressConfig (0x55);
+  accept.SetLinkLocalIpv6Address (linkLocalIpv6Address);
+  const std::vector<uint8_t> acceptGolden {
+    0x02, 0x2a,                         // message type, sequence number
+    0x00, 0x04, 0xd4, 0xc3, 0xb2, 0xa1, // source user info
+    0x00, 0x03, 0x00, 0x01, 0x02, 0x03, // PC5 QoS flow descriptions, 16-bit length
+    0x00, 0x44,                         // user plane security protection
+    57, 0x55,                           // IP address configuration
+    58, 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 // link-local IPv6 address
+  };
+  packet = CheckGolden (accept, acceptGolden);
+  ProseDirectLinkEstablishmentAccept rxAccept;
+  packet->RemoveHeader (rxAccept);
+  NS_TEST_EXPECT_MSG_EQ (packet->GetSize (), 0, "The golden accept was not entirely deserialized");
+  NS_TEST_EXPECT_MSG_EQ (rxAccept.GetSequenceNumber (), 0x2a, "Wrong sequence number");
+  NS_TEST_EXPECT_MSG_EQ (rxAccept.GetSourceUserInfo (), 0xa1b2c3d4, "Wrong source user info");
+  NS_TEST_EXPECT_MSG_EQ ((rxAccept.GetPc5QoSFlowDescriptions () == std::vector<uint8_t> {0x01, 0x02, 0x03}), true,
+                         "Wrong QoS flow descriptions");
+  NS_TEST_EXPECT_MSG_EQ (rxAccept.GetUserPlaneSecurityProtectionConfiguration (), 0x44,
+                         "Wrong user plane security protection configuration");
+  NS_TEST_EXPECT_MSG_EQ (+rxAccept.GetIpAddressConfig (), 0x55, "Wrong IP address configuration");
+  NS_TEST_EXPECT_MSG_EQ ((rxAccept.GetLinkLocalIpv6Address () == linkLocalIpv6Address), true,
+                         "Wrong link-local IPv6 address");
+
+  // Reject
+  ProseDirectLinkEstablishmentReject reject;
+  reject.SetSequenceNumber (0x2a);
+  reject.SetPc5SignallingProtocolCause (0x05);
+  const std::vector<uint8_t> rejectGolden {0x03, 0x2a, 0x05};
+  packet = CheckGolden (reject, rejectGolden);
+  ProseDirectLinkEstablishmentReject rxReject;
+  packet->RemoveHeader (rxReject);
+  NS_TEST_EXPECT_MSG_EQ (rxReject.GetSequenceNumber (), 0x2a, "Wrong sequence number");
+  NS_TEST_EXPECT_MSG_EQ (+rxReject.GetPc5SignallingProtocolCause (), 0x05, "Wrong cause");
+}
+
+/**
+ * \ingroup test
+ * \brief Test suite for the PC5 signalling headers
+ */
+class NrSlPc5SignallingHeaderTestSuite : public TestSuite
+{
+public:
+  NrSlPc5SignallingHeaderTestSuite () : TestSuite ("nr-sl-pc5-signalling-header", UNIT)
+  {
+    AddTestCase (new NrSlPc5SignallingHeaderGoldenTestCase (), QUICK);
+    AddTestCase (new NrSlPc5SignallingHeaderTestCase (200), QUICK);
+  }
+};
+
+static NrSlPc5SignallingHeaderTestSuite g_nrSlPc5SignallingHeaderTestSuite; //!< PC5 signalling header test suite
+
+}  // namespace ns3
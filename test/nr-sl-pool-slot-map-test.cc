@@ -0,0 +1,278 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <array>
+#include <bitset>
+#include <unordered_map>
+#include <ns3/test.h>
+#include <ns3/nr-sl-pool-slot-map.h>
+#include <ns3/nr-sl-comm-resource-pool.h>
+#include <ns3/nr-sl-comm-resource-pool-factory.h>
+#include <ns3/lte-rrc-sap.h>
+#include <ns3/nr-sl-ue-rrc.h>
+
+/**
+ * \file nr-sl-pool-slot-map-test.cc
+ * \ingroup test
+ *
+ * \brief Check that NrSlPoolSlotMap gives the same sidelink slots of
+ * NrSlCommResourcePool::IsSidelinkSlot and
+ * NrSlCommResourcePool::GetNrSlCommOpportunities, for the SL bitmaps and TDD
+ * patterns used in the examples, and some others.
+ */
+namespace ns3 {
+
+/**
+ * \brief Create a pool with one BWP and one pool (id 0), as done by LteUeRrc
+ * \param slBitmap The SL bitmap
+ * \param tddPattern The TDD pattern
+ * \return The pool
+ */
+static Ptr<NrSlCommResourcePool>
+CreatePoolForSlotMapTest (const std::vector <std::bitset<1> > &slBitmap,
+                          const std::vector<NrSlUeRrc::LteNrTddSlotType> &tddPattern)
+{
+  Ptr<NrSlCommResourcePoolFactory> ptrFactory = Create<NrSlCommResourcePoolFactory> ();
+  ptrFactory->SetSlTimeResources (slBitmap);
+  ptrFactory->SetSlSensingWindow (100);
+  ptrFactory->SetSlSelectionWindow (5);
+  ptrFactory->SetSlFreqResourcePscch (10);
+  ptrFactory->SetSlSubchannelSize (50);
+  ptrFactory->SetSlMaxNumPerReserve (3);
+  LteRrcSap::SlResourcePoolNr slResourcePoolNr = ptrFactory->CreatePool ();
+
+  LteRrcSap::SlResourcePoolConfigNr slresoPoolConfigNr;
+  slresoPoolConfigNr.haveSlResourcePoolConfigNr = true;
+  slresoPoolConfigNr.slResourcePoolId.id = 0;
+  slresoPoolConfigNr.slResourcePool = slResourcePoolNr;
+
+  LteRrcSap::SlBwpPoolConfigCommonNr slBwpPoolConfigCommonNr;
+  slBwpPoolConfigCommonNr.slTxPoolSelectedNormal [0] = slresoPoolConfigNr;
+
+  LteRrcSap::Bwp bwp;
+  bwp.numerology = 2;
+  bwp.symbolsPerSlots = 14;
+  bwp.rbPerRbg = 1;
+  bwp.bandwidth = 400;
+
+  LteRrcSap::SlBwpGeneric slBwpGeneric;
+  slBwpGeneric.bwp = bwp;
+  slBwpGeneric.slLengthSymbols = LteRrcSap::GetSlLengthSymbolsEnum (14);
+  slBwpGeneric.slStartSymbol = LteRrcSap::GetSlStartSymbolEnum (0);
+
+  LteRrcSap::SlBwpConfigCommonNr slBwpConfigCommonNr;
+  slBwpConfigCommonNr.haveSlBwpGeneric = true;
+  slBwpConfigCommonNr.slBwpGeneric = slBwpGeneric;
+  slBwpConfigCommonNr.haveSlBwpPoolConfigCommonNr = true;
+  slBwpConfigCommonNr.slBwpPoolConfigCommonNr = slBwpPoolConfigCommonNr;
+
+  LteRrcSap::SlFreqConfigCommonNr slFreConfigCommonNr;
+  slFreConfigCommonNr.slBwpList [0] = slBwpConfigCommonNr;
+  std::array <LteRrcSap::SlFreqConfigCommonNr, 1> slPreconfigFreqInfoList;
+  slPreconfigFreqInfoList [0] = slFreConfigCommonNr;
+
+  // From LteUeRrc::PopulateNrSlPools ()
+  std::unordered_map <uint16_t, std::vector <std::bitset<1>>> mapPerPool;
+  mapPerPool.emplace (0, NrSlUeRrc::GetPhysicalSlPool (slResourcePoolNr.slTimeResource, tddPattern));
+  std::unordered_map<uint8_t, std::unordered_map <uint16_t, std::vector <std::bitset<1>>> > mapPerBwp;
+  mapPerBwp.emplace (0, mapPerPool);
+
+  Ptr<NrSlCommResourcePool> slPool = CreateObject <NrSlCommResourcePool> ();
+  slPool->SetNrSlPreConfigFreqInfoList (slPreconfigFreqInfoList);
+  slPool->SetNrSlPhysicalPoolMap (mapPerBwp);
+  slPool->SetNrSlSchedulingType (NrSlCommResourcePool::UE_SELECTED);
+  slPool->SetTddPattern (tddPattern);
+  return slPool;
+}
+
+/**
+ * \ingroup test
+ * \brief Compare NrSlPoolSlotMap with NrSlCommResourcePool for a SL bitmap
+ * and a TDD pattern
+ */
+class NrSlPoolSlotMapTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param name The name of the test case
+   * \param slBitmap The SL bitmap
+   * \param tddPattern The TDD pattern
+   */
+  NrSlPoolSlotMapTestCase (const std::string &name,
+                           const std::vector <std::bitset<1> > &slBitmap,
+                           const std::vector<NrSlUeRrc::LteNrTddSlotType> &tddPattern)
+    : TestCase (name),
+      m_slBitmap (slBitmap),
+      m_tddPattern (tddPattern)
+  {
+  }
+
+private:
+  void DoRun () override;
+
+  std::vector <std::bitset<1> > m_slBitmap; //!< SL bitmap
+  std::vector<NrSlUeRrc::LteNrTddSlotType> m_tddPattern; //!< TDD pattern
+};
+
+void
+NrSlPoolSlotMapTestCase::DoRun ()
+{
+  const uint8_t bwpId = 0;
+  const uint16_t poolId = 0;
+  const uint16_t numerology = 2;
+  Ptr<NrSlCommResourcePool> slPool = CreatePoolForSlotMapTest (m_slBitmap, m_tddPattern);
+  NrSlPoolSlotMap slotMap (slPool->GetNrSlPhyPool (bwpId, poolId));
+
+  uint32_t period = slotMap.GetPeriod ();
+  NS_TEST_ASSERT_MSG_GT (period, 0, "Empty physical pool");
+
+  uint32_t numSlSlots = 0;
+  for (uint32_t i = 0; i < period; ++i)
+    {
+      numSlSlots += slPool->IsSidelinkSlot (bwpId, poolId, i) ? 1 : 0;
+    }
+  NS_TEST_ASSERT_MSG_EQ (slotMap.GetNumSlSlotsPerPeriod (), numSlSlots, "Wrong number of SL slots per period");
+
+  std::vector<uint32_t> offsets;
+  // start from a large slot index, as in a long simulation
+  const uint64_t firstSlot = 1000 * period;
+  for (uint64_t absSlotIndex = firstSlot; absSlotIndex < firstSlot + 3 * period; ++absSlotIndex)
+    {
+      bool isSl = slPool->IsSidelinkSlot (bwpId, poolId, absSlotIndex);
+      NS_TEST_ASSERT_MSG_EQ (slotMap.IsSidelinkSlot (absSlotIndex), isSl,
+                             "Wrong IsSidelinkSlot for slot " << absSlotIndex);
+      if (isSl)
+        {
+          NS_TEST_ASSERT_MSG_EQ (slotMap.GetPhysicalSlotIndex (slotMap.GetLogicalSlotIndex (absSlotIndex)),
+                                 absSlotIndex, "Wrong logical <-> physical conversion of slot " << absSlotIndex);
+        }
+
+      for (uint8_t t1 = 0; t1 <= 4; ++t1)
+        {
+          for (uint16_t t2 : {static_cast<uint16_t> (t1), uint16_t (5), uint16_t (32), uint16_t (100)})
+            {
+              if (t2 < t1)
+                {
+                  continue;
+                }
+              std::list <NrSlCommResourcePool::SlotInfo> slots = slPool->GetNrSlCommOpportunities (absSlotIndex, bwpId, numerology, poolId, t1, t2);
+              slotMap.GetSlSlotOffsets (absSlotIndex, t1, t2, offsets);
+              NS_TEST_ASSERT_MSG_EQ (offsets.size (), slots.size (),
+                                     "Wrong number of SL slots in [n + " << +t1 << ", n + " << t2 << "], n = " << absSlotIndex);
+              NS_TEST_ASSERT_MSG_EQ (slotMap.CountSlSlots (absSlotIndex + t1, absSlotIndex + t2), slots.size (),
+                                     "Wrong count of SL slots in [n + " << +t1 << ", n + " << t2 << "], n = " << absSlotIndex);
+              auto itOffset = offsets.begin ();
+              for (const auto &slot : slots)
+                {
+                  NS_TEST_ASSERT_MSG_EQ (*itOffset, slot.slotOffset, "Wrong slot offset, n = " << absSlotIndex);
+                  ++itOffset;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \ingroup test
+ * \brief Check the slot map of a bitmap, without a resource pool
+ */
+class NrSlPoolSlotMapBitmapTestCase : public TestCase
+{
+public:
+  NrSlPoolSlotMapBitmapTestCase ()
+    : TestCase ("Slot map of a bitmap with SL slots across the 64 bits boundary")
+  {
+  }
+
+private:
+  void DoRun () override;
+};
+
+void
+NrSlPoolSlotMapBitmapTestCase::DoRun ()
+{
+  NrSlPoolSlotMap emptyMap;
+  NS_TEST_ASSERT_MSG_EQ (emptyMap.IsSidelinkSlot (7), false, "The empty map has no SL slot");
+  NS_TEST_ASSERT_MSG_EQ (emptyMap.CountSlSlots (0, 100), 0, "The empty map has no SL slot");
+
+  std::vector <std::bitset<1> > phyPool (130, 0);
+  std::vector<uint32_t> slPositions = {0, 1, 62, 63, 64, 65, 127, 129};
+  for (const auto &it : slPositions)
+    {
+      phyPool [it] = 1;
+    }
+  NrSlPoolSlotMap slotMap (phyPool);
+  NS_TEST_ASSERT_MSG_EQ (slotMap.GetPeriod (), 130, "Wrong period");
+  NS_TEST_ASSERT_MSG_EQ (slotMap.GetNumSlSlotsPerPeriod (), slPositions.size (), "Wrong number of SL slots");
+
+  for (uint64_t i = 0; i < 3 * 130; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (slotMap.IsSidelinkSlot (i), phyPool [i % 130] == 1, "Wrong IsSidelinkSlot for slot " << i);
+    }
+  for (uint64_t logical = 0; logical < 3 * slPositions.size (); ++logical)
+    {
+      uint64_t expected = (logical / slPositions.size ()) * 130 + slPositions [logical % slPositions.size ()];
+      NS_TEST_ASSERT_MSG_EQ (slotMap.GetPhysicalSlotIndex (logical), expected, "Wrong physical slot of logical slot " << logical);
+      NS_TEST_ASSERT_MSG_EQ (slotMap.GetLogicalSlotIndex (expected), logical, "Wrong logical slot of physical slot " << expected);
+    }
+
+  // window across the end of the period: slots 127, 129, 130 (0) and 131 (1)
+  std::vector<uint32_t> offsets;
+  slotMap.GetSlSlotOffsets (120, 5, 11, offsets);
+  std::vector<uint32_t> expectedOffsets = {7, 9, 10, 11};
+  NS_TEST_ASSERT_MSG_EQ (offsets.size (), expectedOffsets.size (), "Wrong number of SL slots in the window");
+  for (uint32_t i = 0; i < offsets.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (offsets [i], expectedOffsets [i], "Wrong SL slot offset " << i);
+    }
+}
+
+/**
+ * \ingroup test
+ * \brief NrSlPoolSlotMap test suite
+ */
+class NrSlPoolSlotMapTestSuite : public TestSuite
+{
+public:
+  NrSlPoolSlotMapTestSuite () : TestSuite ("nr-sl-pool-slot-map", UNIT)
+  {
+    std::vector<NrSlUeRrc::LteNrTddSlotType> slPattern = { NrSlUeRrc::DL, NrSlUeRrc::DL, NrSlUeRrc::DL,
+                                                           NrSlUeRrc::F, NrSlUeRrc::UL, NrSlUeRrc::UL,
+                                                           NrSlUeRrc::UL, NrSlUeRrc::UL, NrSlUeRrc::UL,
+                                                           NrSlUeRrc::UL};
+    std::vector<NrSlUeRrc::LteNrTddSlotType> dlSulPattern = { NrSlUeRrc::DL, NrSlUeRrc::S, NrSlUeRrc::UL,
+                                                              NrSlUeRrc::UL, NrSlUeRrc::DL, NrSlUeRrc::DL,
+                                                              NrSlUeRrc::S, NrSlUeRrc::UL, NrSlUeRrc::UL,
+                                                              NrSlUeRrc::DL};
+    std::vector<NrSlUeRrc::LteNrTddSlotType> ulPattern (10, NrSlUeRrc::UL);
+
+    // bitmap and TDD pattern of the V2X and ProSe examples
+    AddTestCase (new NrSlPoolSlotMapTestCase ("Example bitmap, DL|DL|DL|F|UL|UL|UL|UL|UL|UL|",
+                                              {1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1}, slPattern), QUICK);
+    AddTestCase (new NrSlPoolSlotMapTestCase ("Full bitmap, DL|DL|DL|F|UL|UL|UL|UL|UL|UL|",
+                                              {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}, slPattern), QUICK);
+    AddTestCase (new NrSlPoolSlotMapTestCase ("Sparse bitmap, DL|S|UL|UL|DL|DL|S|UL|UL|DL|",
+                                              {1, 0, 1, 1, 0, 0, 1, 0, 0, 1, 1, 1}, dlSulPattern), QUICK);
+    AddTestCase (new NrSlPoolSlotMapTestCase ("Alternate bitmap, all UL",
+                                              {1, 1, 0, 1, 1, 0, 1, 1, 0, 1}, ulPattern), QUICK);
+    AddTestCase (new NrSlPoolSlotMapBitmapTestCase (), QUICK);
+  }
+};
+
+static NrSlPoolSlotMapTestSuite nrSlPoolSlotMapTestSuite; //!< NrSlPoolSlotMap test suite
+
+}  // namespace ns3
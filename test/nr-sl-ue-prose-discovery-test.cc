@@ -0,0 +1,492 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/nr-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/antenna-module.h"
+#include <map>
+#include <tuple>
+
+/**
+ * \file nr-sl-ue-prose-discovery-test.cc
+ * \ingroup test
+ *
+ * \brief Check the ProSe discovery messages of NrSlUeProse between two UEs:
+ * - the message of a code is sent when the code is added, even if the
+ *   discovery timer of the UE is already running for another code, and then
+ *   repeated every DiscoveryInterval from that time;
+ * - with MaxDiscoveryCodesPerPdu greater than 1, the aggregated messages and
+ *   the one-shot responses of a Discoveree are all received, once per round;
+ * - with DiscoveryJitter, each round is delayed by less than the jitter, and
+ *   the delays are the same when the streams are the same.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ * \brief Two UEs with the sidelink and the ProSe layer, and the discovery
+ * messages they send and receive
+ */
+class NrSlUeProseDiscoveryTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param name the name of the test case
+   */
+  NrSlUeProseDiscoveryTestCase (const std::string &name)
+    : TestCase (name)
+  {
+  }
+
+protected:
+  /**
+   * \brief A discovery message seen by the DiscoveryTrace of a UE
+   */
+  struct DiscoveryRecord
+  {
+    Time m_time;             //!< Time of the trace
+    uint32_t m_senderL2Id;   //!< L2 ID of the sender
+    uint32_t m_receiverL2Id; //!< L2 ID of the receiver
+    bool m_isTx;             //!< True for a transmission
+    uint8_t m_msgType;       //!< Discovery message type
+    uint32_t m_appCode;      //!< Application code
+  };
+
+  /**
+   * \brief Create the two UEs, and connect their DiscoveryTrace
+   * \param maxCodesPerPdu the MaxDiscoveryCodesPerPdu attribute
+   * \param jitter the DiscoveryJitter attribute
+   * \param stream the first random stream
+   * \return the devices of the UEs
+   */
+  NetDeviceContainer CreateUes (uint32_t maxCodesPerPdu, Time jitter, int64_t stream);
+
+  /**
+   * \brief Get the L2 ID of a UE
+   * \param ueDev the device of the UE
+   * \return its L2 ID
+   */
+  static uint32_t GetL2Id (Ptr<NetDevice> ueDev);
+
+  /**
+   * \brief Save a discovery message
+   * \param senderL2Id the L2 ID of the sender
+   * \param receiverL2Id the L2 ID of the receiver
+   * \param isTx true for a transmission
+   * \param discHeader the discovery message
+   */
+  void DiscoveryTrace (uint32_t senderL2Id, uint32_t receiverL2Id, bool isTx, NrSlDiscoveryHeader discHeader);
+
+  const Time m_discInterval {Seconds (1.0)};  //!< The DiscoveryInterval attribute
+  Ptr<NrSlProseHelper> m_proseHelper;          //!< The ProSe helper of the UEs
+  std::vector<DiscoveryRecord> m_records;      //!< The discovery messages sent and received
+};
+
+NetDeviceContainer
+NrSlUeProseDiscoveryTestCase::CreateUes (uint32_t maxCodesPerPdu, Time jitter, int64_t stream)
+{
+  const uint16_t numerologyBwpSl = 2;
+  const uint16_t bandwidthBandSl = 400;
+
+  Config::SetDefault ("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue (999999999));
+  Config::SetDefault ("ns3::NrSlUeProse::DiscoveryInterval", TimeValue (m_discInterval));
+  Config::SetDefault ("ns3::NrSlUeProse::DiscoveryJitter", TimeValue (jitter));
+  Config::SetDefault ("ns3::NrSlUeProse::MaxDiscoveryCodesPerPdu", UintegerValue (maxCodesPerPdu));
+
+  NodeContainer ueNodes;
+  ueNodes.Create (2);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  Ptr<ListPositionAllocator> positionAllocUe = CreateObject<ListPositionAllocator> ();
+  positionAllocUe->Add (Vector (0.0, 0.0, 1.5));
+  positionAllocUe->Add (Vector (20.0, 0.0, 1.5));
+  mobility.SetPositionAllocator (positionAllocUe);
+  mobility.Install (ueNodes);
+
+  Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper> ();
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  nrHelper->SetEpcHelper (epcHelper);
+
+  CcBwpCreator ccBwpCreator;
+  CcBwpCreator::SimpleOperationBandConf bandConfSl (5.89e9, bandwidthBandSl, 1, BandwidthPartInfo::V2V_Highway);
+  OperationBandInfo bandSl = ccBwpCreator.CreateOperationBandContiguousCc (bandConfSl);
+  nrHelper->SetChannelConditionModelAttribute ("UpdatePeriod", TimeValue (MilliSeconds (0)));
+  nrHelper->SetPathlossAttribute ("ShadowingEnabled", BooleanValue (false));
+  nrHelper->InitializeOperationBand (&bandSl);
+  BandwidthPartInfoPtrVector allBwps = CcBwpCreator::GetAllBwps ({bandSl});
+
+  nrHelper->SetUeAntennaAttribute ("NumRows", UintegerValue (1));
+  nrHelper->SetUeAntennaAttribute ("NumColumns", UintegerValue (2));
+  nrHelper->SetUeAntennaAttribute ("AntennaElement", PointerValue (CreateObject<IsotropicAntennaModel> ()));
+  nrHelper->SetUeMacAttribute ("EnableSensing", BooleanValue (false));
+  nrHelper->SetUeMacAttribute ("T1", UintegerValue (2));
+  nrHelper->SetUeMacAttribute ("T2", UintegerValue (33));
+  nrHelper->SetUeMacAttribute ("ActivePoolId", UintegerValue (0));
+
+  uint8_t bwpId = 0;
+  nrHelper->SetBwpManagerTypeId (TypeId::LookupByName ("ns3::NrSlBwpManagerUe"));
+  nrHelper->SetUeBwpManagerAlgorithmAttribute ("GBR_MC_PUSH_TO_TALK", UintegerValue (bwpId));
+  std::set<uint8_t> bwpIdContainer {bwpId};
+
+  NetDeviceContainer ueDevs = nrHelper->InstallUeDevice (ueNodes, allBwps);
+  for (auto it = ueDevs.Begin (); it != ueDevs.End (); ++it)
+    {
+      DynamicCast<NrUeNetDevice> (*it)->UpdateConfig ();
+    }
+
+  Ptr<NrSlHelper> nrSlHelper = CreateObject <NrSlHelper> ();
+  nrSlHelper->SetEpcHelper (epcHelper);
+  nrSlHelper->SetSlErrorModel ("ns3::NrEesmIrT1");
+  nrSlHelper->SetUeSlAmcAttribute ("AmcModel", EnumValue (NrAmc::ErrorModel));
+  nrSlHelper->SetNrSlSchedulerTypeId (NrSlUeMacSchedulerDefault::GetTypeId ());
+  nrSlHelper->SetUeSlSchedulerAttribute ("FixNrSlMcs", BooleanValue (true));
+  nrSlHelper->SetUeSlSchedulerAttribute ("InitialNrSlMcs", UintegerValue (14));
+  nrSlHelper->PrepareUeForSidelink (ueDevs, bwpIdContainer);
+
+  Ptr<NrSlCommResourcePoolFactory> ptrFactory = Create<NrSlCommResourcePoolFactory> ();
+  std::vector <std::bitset<1> > slBitmap = {1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1};
+  ptrFactory->SetSlTimeResources (slBitmap);
+  ptrFactory->SetSlSensingWindow (100);
+  ptrFactory->SetSlSelectionWindow (5);
+  ptrFactory->SetSlFreqResourcePscch (10);
+  ptrFactory->SetSlSubchannelSize (10);
+  ptrFactory->SetSlMaxNumPerReserve (3);
+  ptrFactory->SetSlResourceReservePeriodList ({0, 100});
+
+  LteRrcSap::SlResourcePoolIdNr slResourcePoolIdNr;
+  slResourcePoolIdNr.id = 0;
+  LteRrcSap::SlResourcePoolConfigNr slresoPoolConfigNr;
+  slresoPoolConfigNr.haveSlResourcePoolConfigNr = true;
+  slresoPoolConfigNr.slResourcePoolId = slResourcePoolIdNr;
+  slresoPoolConfigNr.slResourcePool = ptrFactory->CreatePool ();
+  LteRrcSap::SlBwpPoolConfigCommonNr slBwpPoolConfigCommonNr;
+  slBwpPoolConfigCommonNr.slTxPoolSelectedNormal [slResourcePoolIdNr.id] = slresoPoolConfigNr;
+
+  LteRrcSap::Bwp bwp;
+  bwp.numerology = numerologyBwpSl;
+  bwp.symbolsPerSlots = 14;
+  bwp.rbPerRbg = 1;
+  bwp.bandwidth = bandwidthBandSl;
+  LteRrcSap::SlBwpGeneric slBwpGeneric;
+  slBwpGeneric.bwp = bwp;
+  slBwpGeneric.slLengthSymbols = LteRrcSap::GetSlLengthSymbolsEnum (14);
+  slBwpGeneric.slStartSymbol = LteRrcSap::GetSlStartSymbolEnum (0);
+  LteRrcSap::SlBwpConfigCommonNr slBwpConfigCommonNr;
+  slBwpConfigCommonNr.haveSlBwpGeneric = true;
+  slBwpConfigCommonNr.slBwpGeneric = slBwpGeneric;
+  slBwpConfigCommonNr.haveSlBwpPoolConfigCommonNr = true;
+  slBwpConfigCommonNr.slBwpPoolConfigCommonNr = slBwpPoolConfigCommonNr;
+  LteRrcSap::SlFreqConfigCommonNr slFreConfigCommonNr;
+  slFreConfigCommonNr.slBwpList [bwpId] = slBwpConfigCommonNr;
+
+  LteRrcSap::TddUlDlConfigCommon tddUlDlConfigCommon;
+  tddUlDlConfigCommon.tddPattern = "DL|DL|DL|F|UL|UL|UL|UL|UL|UL|";
+  LteRrcSap::SlPreconfigGeneralNr slPreconfigGeneralNr;
+  slPreconfigGeneralNr.slTddConfig = tddUlDlConfigCommon;
+  LteRrcSap::SlUeSelectedConfig slUeSelectedPreConfig;
+  slUeSelectedPreConfig.slProbResourceKeep = 0;
+  LteRrcSap::SlPsschTxParameters psschParams;
+  psschParams.slMaxTxTransNumPssch = 5;
+  LteRrcSap::SlPsschTxConfigList pscchTxConfigList;
+  pscchTxConfigList.slPsschTxParameters [0] = psschParams;
+  slUeSelectedPreConfig.slPsschTxConfigList = pscchTxConfigList;
+
+  LteRrcSap::SidelinkPreconfigNr slPreConfigNr;
+  slPreConfigNr.slPreconfigGeneral = slPreconfigGeneralNr;
+  slPreConfigNr.slUeSelectedPreConfig = slUeSelectedPreConfig;
+  slPreConfigNr.slPreconfigFreqInfoList [0] = slFreConfigCommonNr;
+  nrSlHelper->InstallNrSlPreConfiguration (ueDevs, slPreConfigNr);
+
+  InternetStackHelper internet;
+  internet.Install (ueNodes);
+  epcHelper->AssignUeIpv4Address (ueDevs);
+
+  m_proseHelper = CreateObject <NrSlProseHelper> ();
+  m_proseHelper->PrepareUesForProse (ueDevs);
+
+  stream += nrHelper->AssignStreams (ueDevs, stream);
+  stream += nrSlHelper->AssignStreams (ueDevs, stream);
+
+  for (auto it = ueDevs.Begin (); it != ueDevs.End (); ++it)
+    {
+      Ptr<NrSlUeProse> prose = (*it)->GetObject<NrUeNetDevice> ()->GetSlUeService ()->GetObject<NrSlUeProse> ();
+      prose->TraceConnectWithoutContext ("DiscoveryTrace",
+                                         MakeCallback (&NrSlUeProseDiscoveryTestCase::DiscoveryTrace, this));
+    }
+  return ueDevs;
+}
+
+uint32_t
+NrSlUeProseDiscoveryTestCase::GetL2Id (Ptr<NetDevice> ueDev)
+{
+  // The L2 ID given to the ProSe layer by NrSlProseHelper
+  return ueDev->GetObject<NrUeNetDevice> ()->GetRrc ()->GetSourceL2Id ();
+}
+
+void
+NrSlUeProseDiscoveryTestCase::DiscoveryTrace (uint32_t senderL2Id, uint32_t receiverL2Id,
+                                              bool isTx, NrSlDiscoveryHeader discHeader)
+{
+  m_records.push_back ({Simulator::Now (), senderL2Id, receiverL2Id, isTx,
+                        discHeader.GetDiscoveryMsgType (), discHeader.GetApplicationCode ()});
+}
+
+/**
+ * \ingroup test
+ * \brief Add a second announcing code in the middle of a discovery interval
+ */
+class NrSlUeProseDiscoveryTimingTestCase : public NrSlUeProseDiscoveryTestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrSlUeProseDiscoveryTimingTestCase ()
+    : NrSlUeProseDiscoveryTestCase ("Timing of the discovery messages of a code added while the discovery timer runs")
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+};
+
+void
+NrSlUeProseDiscoveryTimingTestCase::DoRun ()
+{
+  const Time firstCodeTime = Seconds (1.0);
+  const Time secondCodeTime = Seconds (1.4);
+  const Time simTime = Seconds (4.2);
+
+  NetDeviceContainer ueDevs = CreateUes (1, Seconds (0), 1);
+
+  // The second code is added while the timer runs for the first one
+  Simulator::Schedule (firstCodeTime, &NrSlProseHelper::StartDiscoveryApp, m_proseHelper,
+                       ueDevs.Get (0), 1, 100, NrSlUeProse::Announcing);
+  Simulator::Schedule (secondCodeTime, &NrSlProseHelper::StartDiscoveryApp, m_proseHelper,
+                       ueDevs.Get (0), 2, 100, NrSlUeProse::Announcing);
+  Simulator::Stop (simTime);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::map<uint32_t, std::vector<Time> > txTimes;
+  for (const auto &record : m_records)
+    {
+      if (record.m_isTx)
+        {
+          txTimes[record.m_appCode].push_back (record.m_time);
+        }
+    }
+
+  const std::map<uint32_t, Time> startTimes {{1, firstCodeTime}, {2, secondCodeTime}};
+  for (const auto &it : startTimes)
+    {
+      const std::vector<Time> &codeTxTimes = txTimes[it.first];
+      std::size_t expectedTx = (simTime - it.second).GetInteger () / m_discInterval.GetInteger () + 1;
+      NS_TEST_ASSERT_MSG_EQ (codeTxTimes.size (), expectedTx, "Wrong number of messages of code " << it.first);
+      for (std::size_t i = 0; i < codeTxTimes.size (); ++i)
+        {
+          NS_TEST_EXPECT_MSG_EQ (codeTxTimes[i], it.second + NanoSeconds (i * m_discInterval.GetNanoSeconds ()),
+                                 "Wrong time of message " << i << " of code " << it.first);
+        }
+    }
+}
+
+/**
+ * \ingroup test
+ * \brief Aggregate the periodic messages of a UE, and answer them with one-shot
+ * responses, with MaxDiscoveryCodesPerPdu equal to 2
+ */
+class NrSlUeProseDiscoveryAggregationTestCase : public NrSlUeProseDiscoveryTestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrSlUeProseDiscoveryAggregationTestCase ()
+    : NrSlUeProseDiscoveryTestCase ("Aggregated discovery messages and one-shot responses")
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+};
+
+void
+NrSlUeProseDiscoveryAggregationTestCase::DoRun ()
+{
+  const Time startTime = Seconds (1.0);
+  const uint32_t rounds = 3;
+  const uint32_t dstL2Id = 100;
+  const std::vector<uint32_t> announcedCodes {1, 2, 3};
+  const uint32_t queryCode = 5;
+
+  NetDeviceContainer ueDevs = CreateUes (2, Seconds (0), 1);
+  uint32_t announcerL2Id = GetL2Id (ueDevs.Get (0));
+  uint32_t monitorL2Id = GetL2Id (ueDevs.Get (1));
+
+  // The UE 0 sends four periodic messages per round (two full PDUs), the
+  // UE 1 answers the query with a response of its own in each round
+  for (uint32_t code : announcedCodes)
+    {
+      Simulator::Schedule (startTime, &NrSlProseHelper::StartDiscoveryApp, m_proseHelper,
+                           ueDevs.Get (0), code, dstL2Id, NrSlUeProse::Announcing);
+      Simulator::Schedule (startTime - MilliSeconds (100), &NrSlProseHelper::StartDiscoveryApp, m_proseHelper,
+                           ueDevs.Get (1), code, dstL2Id, NrSlUeProse::Monitoring);
+    }
+  Simulator::Schedule (startTime, &NrSlProseHelper::StartDiscoveryApp, m_proseHelper,
+                       ueDevs.Get (0), queryCode, dstL2Id, NrSlUeProse::Discoverer);
+  Simulator::Schedule (startTime - MilliSeconds (100), &NrSlProseHelper::StartDiscoveryApp, m_proseHelper,
+                       ueDevs.Get (1), queryCode, dstL2Id, NrSlUeProse::Discoveree);
+  Simulator::Stop (startTime + NanoSeconds (rounds * m_discInterval.GetNanoSeconds ()) - MilliSeconds (100));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // Messages received by each UE, per round and per code
+  std::map<std::tuple<uint32_t, uint32_t, uint32_t>, uint32_t> rxCount;
+  uint32_t responsesTx = 0;
+  for (const auto &record : m_records)
+    {
+      if (record.m_isTx)
+        {
+          if (record.m_msgType == NrSlDiscoveryHeader::DISC_RESTRICTED_RESPONSE)
+            {
+              ++responsesTx;
+            }
+          continue;
+        }
+      NS_TEST_ASSERT_MSG_EQ (record.m_time >= startTime, true, "Message received before the first round");
+      uint32_t round = static_cast<uint32_t> ((record.m_time - startTime).GetInteger () / m_discInterval.GetInteger ());
+      ++rxCount[std::make_tuple (record.m_receiverL2Id, round, record.m_appCode)];
+    }
+
+  NS_TEST_EXPECT_MSG_EQ (responsesTx, rounds, "Wrong number of responses sent");
+  for (uint32_t round = 0; round < rounds; ++round)
+    {
+      for (uint32_t code : announcedCodes)
+        {
+          NS_TEST_EXPECT_MSG_EQ (rxCount[std::make_tuple (monitorL2Id, round, code)], 1,
+                                 "Announcement of code " << code << " not received once in round " << round);
+        }
+      NS_TEST_EXPECT_MSG_EQ (rxCount[std::make_tuple (monitorL2Id, round, queryCode)], 1,
+                             "Query not received once in round " << round);
+      NS_TEST_EXPECT_MSG_EQ (rxCount[std::make_tuple (announcerL2Id, round, queryCode)], 1,
+                             "Response not received once in round " << round);
+    }
+}
+
+/**
+ * \ingroup test
+ * \brief Delay the rounds of discovery messages by a random jitter
+ */
+class NrSlUeProseDiscoveryJitterTestCase : public NrSlUeProseDiscoveryTestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrSlUeProseDiscoveryJitterTestCase ()
+    : NrSlUeProseDiscoveryTestCase ("Jitter of the discovery rounds")
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Run a UE that announces one code
+   * \param stream the first random stream
+   * \return the transmission times of the messages
+   */
+  std::vector<Time> Run (int64_t stream);
+};
+
+std::vector<Time>
+NrSlUeProseDiscoveryJitterTestCase::Run (int64_t stream)
+{
+  const Time startTime = Seconds (1.0);
+  const uint32_t rounds = 5;
+
+  m_records.clear ();
+  NetDeviceContainer ueDevs = CreateUes (1, MilliSeconds (200), stream);
+  Simulator::Schedule (startTime, &NrSlProseHelper::StartDiscoveryApp, m_proseHelper,
+                       ueDevs.Get (0), 1, 100, NrSlUeProse::Announcing);
+  Simulator::Stop (startTime + NanoSeconds (rounds * m_discInterval.GetNanoSeconds ()));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::vector<Time> txTimes;
+  for (const auto &record : m_records)
+    {
+      if (record.m_isTx)
+        {
+          txTimes.push_back (record.m_time);
+        }
+    }
+  return txTimes;
+}
+
+void
+NrSlUeProseDiscoveryJitterTestCase::DoRun ()
+{
+  const Time startTime = Seconds (1.0);
+  const Time jitter = MilliSeconds (200);
+  const uint32_t rounds = 5;
+
+  std::vector<Time> txTimes = Run (1);
+  NS_TEST_ASSERT_MSG_EQ (txTimes.size (), rounds, "Wrong number of messages");
+  bool anyDelayed = false;
+  for (uint32_t i = 0; i < txTimes.size (); ++i)
+    {
+      Time nominal = startTime + NanoSeconds (i * m_discInterval.GetNanoSeconds ());
+      NS_TEST_EXPECT_MSG_EQ (txTimes[i] >= nominal, true, "Message " << i << " sent before its round");
+      NS_TEST_EXPECT_MSG_LT (txTimes[i], nominal + jitter, "Message " << i << " delayed by more than the jitter");
+      anyDelayed = anyDelayed || txTimes[i] > nominal;
+    }
+  NS_TEST_EXPECT_MSG_EQ (anyDelayed, true, "No round was delayed");
+
+  // The jitter is drawn from the stream assigned by the helpers
+  std::vector<Time> sameStreamTxTimes = Run (1);
+  NS_TEST_ASSERT_MSG_EQ (sameStreamTxTimes.size (), txTimes.size (), "Wrong number of messages");
+  for (uint32_t i = 0; i < txTimes.size (); ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (sameStreamTxTimes[i], txTimes[i], "Different jitter of message " << i << " with the same streams");
+    }
+}
+
+/**
+ * \ingroup test
+ * \brief Test suite for the ProSe discovery of NrSlUeProse
+ */
+class NrSlUeProseDiscoveryTestSuite : public TestSuite
+{
+public:
+  NrSlUeProseDiscoveryTestSuite () : TestSuite ("nr-sl-ue-prose-discovery", SYSTEM)
+  {
+    AddTestCase (new NrSlUeProseDiscoveryTimingTestCase (), QUICK);
+    AddTestCase (new NrSlUeProseDiscoveryAggregationTestCase (), QUICK);
+    AddTestCase (new NrSlUeProseDiscoveryJitterTestCase (), QUICK);
+  }
+};
+
+static NrSlUeProseDiscoveryTestSuite g_nrSlUeProseDiscoveryTestSuite; //!< NrSlUeProse discovery test suite
+
+}  // namespace ns3
@@ -0,0 +1,364 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/abort.h>
+#include <ns3/boolean.h>
+#include <ns3/uinteger.h>
+#include <ns3/pointer.h>
+#include <ns3/nr-stats-sink.h>
+#include <ns3/nr-helper.h>
+#include <ns3/nr-phy-rx-trace.h>
+#include <ns3/nr-mac-rx-trace.h>
+#include <ns3/nr-bearer-stats-simple.h>
+#include <cstdio>
+#include <fstream>
+
+#ifdef HAVE_SQLITE3
+#include <sqlite3.h>
+#endif
+
+/**
+ * \file nr-stats-sink-test.cc
+ * \ingroup test
+ *
+ * \brief Write two tables through NrStatsSink, with a small batch size,
+ * and read back the binary columnar file, to check that every row is
+ * written once, in order, and with its values. Check that the sink set on
+ * the NrHelper receives the rows of the PHY, MAC and bearer traces. If the
+ * simulator is built with SQLite, also check that DeleteWhere () replaces
+ * the rows of a simulation written again in the same database.
+ */
+namespace ns3 {
+
+/**
+ * \ingroup test
+ * \brief Check the columnar output of NrStatsSink
+ */
+class NrStatsSinkTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrStatsSinkTestCase () : TestCase ("NrStatsSink columnar output")
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Read a value from the file
+   * \param file the file
+   * \return the value
+   */
+  template <typename T>
+  static T Read (std::ifstream &file)
+  {
+    T value;
+    file.read (reinterpret_cast<char*> (&value), sizeof (value));
+    return value;
+  }
+
+  /**
+   * \brief Read a string from the file
+   * \param file the file
+   * \return the string
+   */
+  static std::string ReadString (std::ifstream &file)
+  {
+    uint32_t length = Read<uint32_t> (file);
+    std::string value (length, '\0');
+    file.read (&value[0], length);
+    return value;
+  }
+};
+
+void
+NrStatsSinkTestCase::DoRun ()
+{
+  const uint32_t batchSize = 3;
+  const uint32_t slotRows = 10;
+  const uint32_t rxRows = 4;
+  std::string fileName = CreateTempDirFilename ("nr-stats-sink-test.bin");
+
+  Ptr<NrStatsSink> sink = CreateObject<NrStatsSink> ();
+  sink->SetAttribute ("UseSqlite", BooleanValue (false));
+  sink->SetAttribute ("BatchSize", UintegerValue (batchSize));
+  sink->Open (fileName);
+
+  uint32_t slotTable = sink->AddTable ("slot", {{"Slot", NrStatsSink::INTEGER},
+                                                {"Load", NrStatsSink::REAL}});
+  uint32_t rxTable = sink->AddTable ("rx", {{"Direction", NrStatsSink::TEXT},
+                                            {"Rnti", NrStatsSink::INTEGER}});
+
+  for (uint32_t i = 0; i < slotRows; ++i)
+    {
+      sink->BeginRow (slotTable);
+      sink->Put (i);
+      sink->Put (i / 10.0);
+      sink->EndRow ();
+
+      if (i < rxRows)
+        {
+          sink->BeginRow (rxTable);
+          sink->Put (std::string (i % 2 == 0 ? "DL" : "UL"));
+          sink->Put (static_cast<uint16_t> (100 + i));
+          sink->EndRow ();
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (sink->GetWrittenRows (),
+                         (slotRows / batchSize + rxRows / batchSize) * batchSize,
+                         "Only the full batches should have been written");
+  sink->Dispose ();
+  NS_TEST_ASSERT_MSG_EQ (sink->GetWrittenRows (), slotRows + rxRows,
+                         "All the rows should be written when the sink is disposed");
+
+  std::ifstream file (fileName, std::ios::binary);
+  NS_TEST_ASSERT_MSG_EQ (file.is_open (), true, "Could not open the output");
+  char magic[8];
+  file.read (magic, sizeof (magic));
+  NS_TEST_ASSERT_MSG_EQ (std::string (magic, sizeof (magic)), "NRSTATS1", "Wrong magic");
+
+  uint32_t tablesDeclared = 0;
+  uint32_t nextSlot = 0;
+  uint32_t nextRx = 0;
+  char record;
+  while (file.get (record))
+    {
+      uint32_t tableId = Read<uint32_t> (file);
+      if (record == 'T')
+        {
+          NS_TEST_ASSERT_MSG_EQ (tableId, tablesDeclared, "Wrong table id");
+          NS_TEST_ASSERT_MSG_EQ (ReadString (file), tableId == slotTable ? "slot" : "rx",
+                                 "Wrong table name");
+          uint32_t numColumns = Read<uint32_t> (file);
+          NS_TEST_ASSERT_MSG_EQ (numColumns, 2, "Wrong number of columns");
+          for (uint32_t i = 0; i < numColumns; ++i)
+            {
+              Read<uint8_t> (file);
+              ReadString (file);
+            }
+          ++tablesDeclared;
+          continue;
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (record, 'B', "Unknown record");
+      uint32_t rows = Read<uint32_t> (file);
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (rows, batchSize, "Batch larger than the batch size");
+      if (tableId == slotTable)
+        {
+          for (uint32_t i = 0; i < rows; ++i)
+            {
+              NS_TEST_ASSERT_MSG_EQ (Read<int64_t> (file), nextSlot + i, "Wrong slot");
+            }
+          for (uint32_t i = 0; i < rows; ++i)
+            {
+              NS_TEST_ASSERT_MSG_EQ (Read<double> (file), (nextSlot + i) / 10.0, "Wrong load");
+            }
+          nextSlot += rows;
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_EQ (tableId, rxTable, "Unknown table");
+          for (uint32_t i = 0; i < rows; ++i)
+            {
+              NS_TEST_ASSERT_MSG_EQ (ReadString (file), (nextRx + i) % 2 == 0 ? "DL" : "UL",
+                                     "Wrong direction");
+            }
+          for (uint32_t i = 0; i < rows; ++i)
+            {
+              NS_TEST_ASSERT_MSG_EQ (Read<int64_t> (file), 100 + nextRx + i, "Wrong RNTI");
+            }
+          nextRx += rows;
+        }
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (tablesDeclared, 2, "Wrong number of tables");
+  NS_TEST_ASSERT_MSG_EQ (nextSlot, slotRows, "Wrong number of slot rows");
+  NS_TEST_ASSERT_MSG_EQ (nextRx, rxRows, "Wrong number of rx rows");
+}
+
+/**
+ * \ingroup test
+ * \brief Check that the traces set on a NrStatsSink write their rows in it
+ */
+class NrStatsSinkTracesTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrStatsSinkTracesTestCase () : TestCase ("NrStatsSink rows of the PHY, MAC and bearer traces")
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+};
+
+void
+NrStatsSinkTracesTestCase::DoRun ()
+{
+  const uint32_t calls = 5;
+  std::string fileName = CreateTempDirFilename ("nr-stats-sink-traces-test.bin");
+
+  Ptr<NrStatsSink> sink = CreateObject<NrStatsSink> ();
+  sink->SetAttribute ("UseSqlite", BooleanValue (false));
+  sink->Open (fileName);
+
+  Ptr<NrHelper> nrHelper = CreateObject<NrHelper> ();
+  nrHelper->SetAttribute ("StatsSink", PointerValue (sink));
+  NS_TEST_ASSERT_MSG_EQ (nrHelper->GetStatsSink (), sink, "The attribute did not set the sink");
+
+  Ptr<NrMacRxTrace> macStats = CreateObject<NrMacRxTrace> ();
+  macStats->SetStatsSink (sink);
+  Ptr<NrBearerStatsSimple> pdcpStats = CreateObject<NrBearerStatsSimple> ("PDCP");
+  pdcpStats->SetStatsSink (sink);
+
+  RxPacketTraceParams params;
+  params.m_sinr = 10.0;
+  Ptr<const NrControlMessage> msg = Create<NrSRMessage> ();
+  for (uint32_t i = 0; i < calls; ++i)
+    {
+      SfnSf sfn (i, 0, 0, 0);
+      NrPhyRxTrace::RxPacketTraceUeCallback (nrHelper->GetPhyRxTrace (), "", params);
+      NrMacRxTrace::RxedGnbMacCtrlMsgsCallback (macStats, "", sfn, 1, 1, 0, msg);
+      NrMacRxTrace::TxedUeMacCtrlMsgsCallback (macStats, "", sfn, 2, 1, 0, msg);
+      pdcpStats->DlTxPdu (1, 1, 1, 3, 100);
+      pdcpStats->UlRxPdu (1, 1, 1, 3, 100, 1000000);
+    }
+
+  sink->Dispose ();
+  NS_TEST_ASSERT_MSG_EQ (sink->GetWrittenRows (), 5 * calls,
+                         "Every call of a trace should write one row in the sink");
+}
+
+#ifdef HAVE_SQLITE3
+/**
+ * \ingroup test
+ * \brief Check that NrStatsSink::DeleteWhere () deletes only the rows of
+ * the given seed and run
+ */
+class NrStatsSinkDeleteWhereTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   */
+  NrStatsSinkDeleteWhereTestCase () : TestCase ("NrStatsSink deletion of the rows of a run")
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief Write rows in the table "kpi" of the database
+   * \param fileName the database
+   * \param rows the rows to write, as pairs (RUN, Value), all with SEED 1
+   * \param deleteRun the run whose rows are deleted before writing
+   */
+  static void Write (const std::string &fileName,
+                     const std::vector<std::pair<int64_t, double> > &rows,
+                     int64_t deleteRun);
+
+  /**
+   * \brief Count the rows of a run in the table "kpi"
+   * \param fileName the database
+   * \param run the run
+   * \return the number of rows
+   */
+  static int64_t Count (const std::string &fileName, int64_t run);
+};
+
+void
+NrStatsSinkDeleteWhereTestCase::Write (const std::string &fileName,
+                                       const std::vector<std::pair<int64_t, double> > &rows,
+                                       int64_t deleteRun)
+{
+  Ptr<NrStatsSink> sink = CreateObject<NrStatsSink> ();
+  sink->Open (fileName);
+  uint32_t table = sink->AddTable ("kpi", {{"Value", NrStatsSink::REAL},
+                                           {"SEED", NrStatsSink::INTEGER},
+                                           {"RUN", NrStatsSink::INTEGER}});
+  sink->DeleteWhere (table, 1, deleteRun);
+  for (const auto & row : rows)
+    {
+      sink->BeginRow (table);
+      sink->Put (row.second);
+      sink->Put (1);
+      sink->Put (row.first);
+      sink->EndRow ();
+    }
+  sink->Dispose ();
+}
+
+int64_t
+NrStatsSinkDeleteWhereTestCase::Count (const std::string &fileName, int64_t run)
+{
+  sqlite3 *db;
+  NS_ABORT_IF (sqlite3_open (fileName.c_str (), &db) != SQLITE_OK);
+  sqlite3_stmt *stmt;
+  std::string query = "SELECT COUNT(*) FROM kpi WHERE SEED = 1 AND RUN = ?;";
+  NS_ABORT_IF (sqlite3_prepare_v2 (db, query.c_str (), -1, &stmt, nullptr) != SQLITE_OK);
+  NS_ABORT_IF (sqlite3_bind_int64 (stmt, 1, run) != SQLITE_OK);
+  NS_ABORT_IF (sqlite3_step (stmt) != SQLITE_ROW);
+  int64_t count = sqlite3_column_int64 (stmt, 0);
+  sqlite3_finalize (stmt);
+  sqlite3_close (db);
+  return count;
+}
+
+void
+NrStatsSinkDeleteWhereTestCase::DoRun ()
+{
+  std::string fileName = CreateTempDirFilename ("nr-stats-sink-test.db");
+  std::remove (fileName.c_str ());
+
+  Write (fileName, {{1, 0.1}, {1, 0.2}, {1, 0.3}, {2, 0.4}, {2, 0.5}}, 1);
+  NS_TEST_ASSERT_MSG_EQ (Count (fileName, 1), 3, "Wrong number of rows of run 1");
+  NS_TEST_ASSERT_MSG_EQ (Count (fileName, 2), 2, "Wrong number of rows of run 2");
+
+  // Run 1 again: its rows are replaced, the ones of run 2 are kept
+  Write (fileName, {{1, 0.6}}, 1);
+  NS_TEST_ASSERT_MSG_EQ (Count (fileName, 1), 1, "The rows of run 1 were not replaced");
+  NS_TEST_ASSERT_MSG_EQ (Count (fileName, 2), 2, "The rows of run 2 were deleted");
+}
+#endif
+
+/**
+ * \ingroup test
+ * \brief Test suite for NrStatsSink
+ */
+class NrStatsSinkTestSuite : public TestSuite
+{
+public:
+  NrStatsSinkTestSuite () : TestSuite ("nr-stats-sink", UNIT)
+  {
+    AddTestCase (new NrStatsSinkTestCase (), QUICK);
+    AddTestCase (new NrStatsSinkTracesTestCase (), QUICK);
+#ifdef HAVE_SQLITE3
+    AddTestCase (new NrStatsSinkDeleteWhereTestCase (), QUICK);
+#endif
+  }
+};
+
+static NrStatsSinkTestSuite g_nrStatsSinkTestSuite; //!< NrStatsSink test suite
+
+}  // namespace ns3
@@ -0,0 +1,359 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License version 2 as
+ *   published by the Free Software Foundation;
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/boolean.h>
+#include <ns3/nstime.h>
+#include <ns3/rng-seed-manager.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/ipv4-address.h>
+#include <ns3/inet-socket-address.h>
+#include <ns3/nr-stats-sink.h>
+#include <ns3/nr-v2x-kpi-accumulator.h>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+#ifdef HAVE_SQLITE3
+#include <sqlite3.h>
+#include "../examples/nr-v2x-examples/v2x-kpi.h"
+#endif
+
+/**
+ * \file nr-v2x-kpi-accumulator-test.cc
+ * \ingroup test
+ *
+ * \brief Feed NrV2xKpiAccumulator with random V2X traffic, and store the
+ * same traffic in the "pktTxRx" table of a database, as the V2X examples
+ * do. Then, run the V2xKpi class of the V2X examples on that database,
+ * write the KPIs of the accumulator in another database, and check that
+ * the tables "avrgPir", "thput" and "avrgPrr" of the two databases are
+ * equal. The test needs SQLite.
+ */
+namespace ns3 {
+
+#ifdef HAVE_SQLITE3
+/**
+ * \ingroup test
+ * \brief Compare NrV2xKpiAccumulator with V2xKpi
+ */
+class NrV2xKpiAccumulatorTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param range the range of the PIR and PRR, in m (0 to disable it)
+   * \param considerAllTx report zero throughput for unheard transmitters
+   */
+  NrV2xKpiAccumulatorTestCase (uint16_t range, bool considerAllTx)
+    : TestCase ("V2X KPI accumulator, range " + std::to_string (range) +
+                (considerAllTx ? " all TX" : " heard TX only")),
+      m_range (range),
+      m_considerAllTx (considerAllTx)
+  {
+  }
+
+private:
+  virtual void DoRun (void) override;
+
+  /**
+   * \brief A row of the table pktTxRx, as stored by UeToUePktTxRxOutputStats
+   */
+  struct PktRecord
+  {
+    double time;         //!< time, in s
+    std::string txRx;    //!< "tx" or "rx"
+    uint32_t nodeId;     //!< node id of the TX or RX node
+    uint64_t imsi;       //!< IMSI of the TX or RX node
+    uint32_t pktSize;    //!< packet size
+    std::string srcIp;   //!< IP of the transmitter
+    std::string dstIp;   //!< IP of the receiver, or of the transmitter for "tx"
+    uint32_t pktSeq;     //!< sequence number
+  };
+
+  /**
+   * \brief A value read from a table
+   */
+  struct Cell
+  {
+    bool isText;         //!< true if the value is a TEXT
+    std::string text;    //!< the value, if TEXT
+    double value;        //!< the value, if INTEGER or REAL
+  };
+
+  /**
+   * \brief Write the packet records in the table pktTxRx of a database,
+   * with the empty PSSCH tables that V2xKpi::WriteKpis () also reads
+   * \param fileName the database
+   */
+  void WriteTraceDb (const std::string &fileName) const;
+
+  /**
+   * \brief Read all the rows of a query
+   * \param fileName the database
+   * \param query the query
+   * \return the rows
+   */
+  static std::vector<std::vector<Cell>> ReadRows (const std::string &fileName,
+                                                  const std::string &query);
+
+  /**
+   * \brief Check that a query returns the same rows on the two databases
+   * \param table the name of the table, for the messages
+   * \param query the query
+   * \param v2xKpiDb the database written by V2xKpi
+   * \param accumulatorDb the database written by NrV2xKpiAccumulator
+   */
+  void CompareTables (const std::string &table, const std::string &query,
+                      const std::string &v2xKpiDb, const std::string &accumulatorDb);
+
+  std::vector<PktRecord> m_records;   //!< Rows of the table pktTxRx
+  uint16_t m_range {0};               //!< Range
+  bool m_considerAllTx {true};        //!< Consider all TX
+};
+
+void
+NrV2xKpiAccumulatorTestCase::WriteTraceDb (const std::string &fileName) const
+{
+  sqlite3 *db;
+  NS_ABORT_IF (sqlite3_open (fileName.c_str (), &db) != SQLITE_OK);
+
+  // Same columns of UeToUePktTxRxOutputStats::SetDb ()
+  std::string cmd = "CREATE TABLE pktTxRx ("
+                    "timeSec DOUBLE NOT NULL,"
+                    "txRx TEXT NOT NULL,"
+                    "nodeId INTEGER NOT NULL,"
+                    "imsi INTEGER NOT NULL,"
+                    "pktSizeBytes INTEGER NOT NULL,"
+                    "srcIp TEXT NOT NULL,"
+                    "srcPort TEXT NOT NULL,"
+                    "dstIp TEXT NOT NULL,"
+                    "dstPort TEXT NOT NULL,"
+                    "pktSeqNum INTEGER NOT NULL,"
+                    "SEED INTEGER NOT NULL,"
+                    "RUN INTEGER NOT NULL);"
+                    // No PSSCH traces: V2xKpi only needs the tables to select from
+                    "CREATE TABLE psschTxUeMac (SEED INTEGER NOT NULL, RUN INTEGER NOT NULL);"
+                    "CREATE TABLE psschRxUePhy (SEED INTEGER NOT NULL, RUN INTEGER NOT NULL);"
+                    "BEGIN TRANSACTION;";
+  NS_ABORT_IF (sqlite3_exec (db, cmd.c_str (), nullptr, nullptr, nullptr) != SQLITE_OK);
+
+  sqlite3_stmt *stmt;
+  cmd = "INSERT INTO pktTxRx VALUES (?,?,?,?,?,?,?,?,?,?,?,?);";
+  NS_ABORT_IF (sqlite3_prepare_v2 (db, cmd.c_str (), -1, &stmt, nullptr) != SQLITE_OK);
+  for (const auto & r : m_records)
+    {
+      NS_ABORT_IF (sqlite3_bind_double (stmt, 1, r.time) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_bind_text (stmt, 2, r.txRx.c_str (), -1, SQLITE_TRANSIENT) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_bind_int (stmt, 3, r.nodeId) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_bind_int64 (stmt, 4, r.imsi) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_bind_int (stmt, 5, r.pktSize) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_bind_text (stmt, 6, r.srcIp.c_str (), -1, SQLITE_TRANSIENT) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_bind_int (stmt, 7, 8000) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_bind_text (stmt, 8, r.dstIp.c_str (), -1, SQLITE_TRANSIENT) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_bind_int (stmt, 9, 8000) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_bind_int (stmt, 10, r.pktSeq) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_bind_int (stmt, 11, RngSeedManager::GetSeed ()) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_bind_int64 (stmt, 12, RngSeedManager::GetRun ()) != SQLITE_OK);
+      NS_ABORT_IF (sqlite3_step (stmt) != SQLITE_DONE);
+      NS_ABORT_IF (sqlite3_reset (stmt) != SQLITE_OK);
+    }
+  sqlite3_finalize (stmt);
+  NS_ABORT_IF (sqlite3_exec (db, "END TRANSACTION;", nullptr, nullptr, nullptr) != SQLITE_OK);
+  sqlite3_close (db);
+}
+
+std::vector<std::vector<NrV2xKpiAccumulatorTestCase::Cell>>
+NrV2xKpiAccumulatorTestCase::ReadRows (const std::string &fileName, const std::string &query)
+{
+  sqlite3 *db;
+  NS_ABORT_IF (sqlite3_open (fileName.c_str (), &db) != SQLITE_OK);
+  sqlite3_stmt *stmt;
+  NS_ABORT_MSG_IF (sqlite3_prepare_v2 (db, query.c_str (), -1, &stmt, nullptr) != SQLITE_OK,
+                   "Error in " << query << ": " << sqlite3_errmsg (db));
+
+  std::vector<std::vector<Cell>> rows;
+  int rc;
+  while ((rc = sqlite3_step (stmt)) == SQLITE_ROW)
+    {
+      std::vector<Cell> row;
+      for (int i = 0; i < sqlite3_column_count (stmt); ++i)
+        {
+          if (sqlite3_column_type (stmt, i) == SQLITE_TEXT)
+            {
+              row.push_back ({true, reinterpret_cast<const char*> (sqlite3_column_text (stmt, i)), 0.0});
+            }
+          else
+            {
+              row.push_back ({false, "", sqlite3_column_double (stmt, i)});
+            }
+        }
+      rows.push_back (row);
+    }
+  NS_ABORT_IF (rc != SQLITE_DONE);
+  sqlite3_finalize (stmt);
+  sqlite3_close (db);
+  return rows;
+}
+
+void
+NrV2xKpiAccumulatorTestCase::CompareTables (const std::string &table, const std::string &query,
+                                            const std::string &v2xKpiDb, const std::string &accumulatorDb)
+{
+  std::vector<std::vector<Cell>> expected = ReadRows (v2xKpiDb, query);
+  std::vector<std::vector<Cell>> actual = ReadRows (accumulatorDb, query);
+
+  NS_TEST_ASSERT_MSG_EQ (expected.empty (), false, "V2xKpi wrote no rows in " << table);
+  NS_TEST_ASSERT_MSG_EQ (actual.size (), expected.size (), "Wrong number of rows in " << table);
+  for (size_t r = 0; r < expected.size (); ++r)
+    {
+      NS_TEST_ASSERT_MSG_EQ (actual[r].size (), expected[r].size (), "Wrong number of columns in " << table);
+      for (size_t c = 0; c < expected[r].size (); ++c)
+        {
+          NS_TEST_ASSERT_MSG_EQ (actual[r][c].isText, expected[r][c].isText,
+                                 "Wrong type of column " << c << " in " << table);
+          if (expected[r][c].isText)
+            {
+              NS_TEST_ASSERT_MSG_EQ (actual[r][c].text, expected[r][c].text,
+                                     "Wrong column " << c << " of row " << r << " in " << table);
+            }
+          else
+            {
+              NS_TEST_ASSERT_MSG_EQ_TOL (actual[r][c].value, expected[r][c].value, 1e-9,
+                                         "Wrong column " << c << " of row " << r << " in " << table);
+            }
+        }
+    }
+}
+
+void
+NrV2xKpiAccumulatorTestCase::DoRun ()
+{
+  const uint32_t numNodes = 7;
+  const uint32_t numPeriods = 50;
+  const Time txAppDuration = Seconds (5);
+
+  Ptr<NrV2xKpiAccumulator> acc = CreateObject<NrV2xKpiAccumulator> ();
+  acc->SetAttribute ("Range", DoubleValue (m_range));
+  acc->SetAttribute ("ConsiderAllTx", BooleanValue (m_considerAllTx));
+  acc->SetAttribute ("TxAppDuration", TimeValue (txAppDuration));
+
+  V2xKpi v2xKpi;
+  v2xKpi.SetTxAppDuration (txAppDuration.GetSeconds ());
+  v2xKpi.ConsiderAllTx (m_considerAllTx);
+  v2xKpi.SetRangeForV2xKpis (m_range);
+
+  std::vector<Ipv4Address> ips;
+  std::vector<std::string> ipStrings;
+  std::vector<Vector> positions;
+  for (uint32_t i = 0; i < numNodes; ++i)
+    {
+      std::ostringstream oss;
+      oss << "10.0.0." << i + 1;
+      ips.emplace_back (oss.str ().c_str ());
+      ipStrings.push_back (oss.str ());
+      positions.emplace_back (100.0 * i, (i % 2) * 4.0, 1.5);
+      acc->AddNode (i, 1000 + i, ips.back (), positions.back ());
+      v2xKpi.FillPosPerIpMap (oss.str (), positions.back ());
+    }
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (7);
+
+  // The last node only receives; the one before transmits a single packet,
+  // so that its receivers can not compute the PIR
+  for (uint32_t k = 0; k < numPeriods; ++k)
+    {
+      for (uint32_t tx = 0; tx + 1 < numNodes; ++tx)
+        {
+          if (tx == numNodes - 2 && k > 0)
+            {
+              continue;
+            }
+          Time txTime = MilliSeconds (100 * k + tx) + MicroSeconds (random->GetInteger (0, 500));
+          uint32_t size = 200 + random->GetInteger (0, 100);
+          Simulator::Schedule (txTime, &NrV2xKpiAccumulator::NotifyTx, acc, tx, size, k);
+          m_records.push_back ({txTime.GetNanoSeconds () / (double) 1e9, "tx", tx, 1000 + tx, size,
+                                ipStrings[tx], ipStrings[tx], k});
+
+          for (uint32_t rx = 0; rx < numNodes; ++rx)
+            {
+              double distance = CalculateDistance (positions[tx], positions[rx]);
+              // Node 0 never hears node 2, even if in range
+              if (rx == tx || (tx == 2 && rx == 0) || random->GetValue () > 1.0 - distance / 700.0)
+                {
+                  continue;
+                }
+              Time rxTime = txTime + MicroSeconds (10 * (rx + 1));
+              Simulator::Schedule (rxTime, &NrV2xKpiAccumulator::NotifyRx, acc, rx,
+                                   Address (InetSocketAddress (ips[tx], 8000)), size, k);
+              m_records.push_back ({rxTime.GetNanoSeconds () / (double) 1e9, "rx", rx, 1000 + rx, size,
+                                    ipStrings[tx], ipStrings[rx], k});
+            }
+        }
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // V2xKpi appends ".db" to the path, and writes its KPIs in the same
+  // database of the traces
+  std::string v2xKpiDb = CreateTempDirFilename ("nr-v2x-kpi-accumulator-test-v2x-kpi");
+  std::string accumulatorDb = CreateTempDirFilename ("nr-v2x-kpi-accumulator-test-accumulator.db");
+  std::remove ((v2xKpiDb + ".db").c_str ());
+  std::remove (accumulatorDb.c_str ());
+
+  WriteTraceDb (v2xKpiDb + ".db");
+  v2xKpi.SetDbPath (v2xKpiDb);
+  v2xKpi.WriteKpis ();
+
+  Ptr<NrStatsSink> sink = CreateObject<NrStatsSink> ();
+  sink->SetAttribute ("UseSqlite", BooleanValue (true));
+  sink->Open (accumulatorDb);
+  acc->WriteKpis (sink);
+  sink->Dispose ();
+
+  CompareTables ("avrgPir", "SELECT * FROM avrgPir ORDER BY nodeId, srcIp;",
+                 v2xKpiDb + ".db", accumulatorDb);
+  CompareTables ("thput", "SELECT * FROM thput ORDER BY nodeId, srcIp;",
+                 v2xKpiDb + ".db", accumulatorDb);
+  CompareTables ("avrgPrr", "SELECT * FROM avrgPrr ORDER BY nodeId;",
+                 v2xKpiDb + ".db", accumulatorDb);
+}
+#endif
+
+/**
+ * \ingroup test
+ * \brief Test suite for NrV2xKpiAccumulator
+ */
+class NrV2xKpiAccumulatorTestSuite : public TestSuite
+{
+public:
+  NrV2xKpiAccumulatorTestSuite () : TestSuite ("nr-v2x-kpi-accumulator", UNIT)
+  {
+#ifdef HAVE_SQLITE3
+    AddTestCase (new NrV2xKpiAccumulatorTestCase (0, true), QUICK);
+    AddTestCase (new NrV2xKpiAccumulatorTestCase (250, true), QUICK);
+    AddTestCase (new NrV2xKpiAccumulatorTestCase (250, false), QUICK);
+#endif
+  }
+};
+
+static NrV2xKpiAccumulatorTestSuite g_nrV2xKpiAccumulatorTestSuite; //!< NrV2xKpiAccumulator test suite
+
+}  // namespace ns3
@@ -23,6 +23,8 @@
 #include "ns3/string.h"
 #include "ns3/simulator.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -53,6 +55,19 @@ DistanceBasedThreeGppSpectrumPropagationLossModel::GetTypeId (void)
                   MakeDoubleAccessor (&DistanceBasedThreeGppSpectrumPropagationLossModel::SetMaxDistance,
                                       &DistanceBasedThreeGppSpectrumPropagationLossModel::GetMaxDistance),
                   MakeDoubleChecker<double> ())
+    .AddAttribute ("SkipFarReceivers",
+                   "If true, the spectrum channel does not deliver the signals to the "
+                   "receivers that are farther than MaxDistance, instead of delivering "
+                   "a 0 PSD. It takes effect when the channel is configured "
+                   "(see ConfigureChannel), and it changes objects shared with the rest "
+                   "of the simulation: a RangePropagationLossModel is appended to the "
+                   "propagation loss chain of the channel, so any other user of that "
+                   "chain (another channel, the REM helper, a direct CalcRxPower call) "
+                   "gets -1000 dBm beyond MaxDistance; and the MaxLossDb of the channel "
+                   "is lowered to 999 dB if it was higher, for all its transmissions.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&DistanceBasedThreeGppSpectrumPropagationLossModel::m_skipFarReceivers),
+                   MakeBooleanChecker ())
     ;
   return tid;
 }
@@ -61,6 +76,10 @@ void
 DistanceBasedThreeGppSpectrumPropagationLossModel::SetMaxDistance (double maxDistance)
 {
   m_maxDistance = maxDistance;
+  if (m_rangeModel != nullptr)
+    {
+      m_rangeModel->SetAttribute ("MaxRange", DoubleValue (maxDistance));
+    }
 }
 
 double
@@ -69,6 +88,37 @@ DistanceBasedThreeGppSpectrumPropagationLossModel::GetMaxDistance () const
   return m_maxDistance;
 }
 
+void
+DistanceBasedThreeGppSpectrumPropagationLossModel::ConfigureChannel (const Ptr<SpectrumChannel> &channel)
+{
+  NS_LOG_FUNCTION (this << channel);
+
+  if (!m_skipFarReceivers)
+    {
+      return;
+    }
+
+  Ptr<PropagationLossModel> last = channel->GetPropagationLossModel ();
+  NS_ABORT_MSG_IF (last == nullptr, "The channel needs a propagation loss model to skip far receivers");
+  NS_ABORT_MSG_IF (m_rangeModel != nullptr, "This model already configured a channel");
+
+  // Append the cut-off at the end of the chain, so the channel keeps
+  // returning the original model in GetPropagationLossModel ()
+  while (last->GetNext () != nullptr)
+    {
+      last = last->GetNext ();
+    }
+
+  m_rangeModel = CreateObject<RangePropagationLossModel> ();
+  m_rangeModel->SetAttribute ("MaxRange", DoubleValue (m_maxDistance));
+  last->SetNext (m_rangeModel);
+
+  // Out of range, RangePropagationLossModel returns -1000 dBm, and the channel
+  // computes the loss with a 0 dBm transmission: the loss is 1000 dB
+  DoubleValue maxLossDb;
+  channel->GetAttribute ("MaxLossDb", maxLossDb);
+  channel->SetAttribute ("MaxLossDb", DoubleValue (std::min (maxLossDb.Get (), 999.0)));
+}
 
 Ptr<SpectrumValue>
 DistanceBasedThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<const SpectrumValue> txPsd,
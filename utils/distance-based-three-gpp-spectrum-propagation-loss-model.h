@@ -20,6 +20,8 @@
 #define DISTANCE_BASED_THREE_GPP_SPECTRUM_PROPAGATION_LOSS_H
 
 #include "ns3/three-gpp-spectrum-propagation-loss-model.h"
+#include "ns3/range-propagation-loss-model.h"
+#include "ns3/spectrum-channel.h"
 
 namespace ns3 {
 
@@ -33,6 +35,11 @@ namespace ns3 {
  * max allowed distance that can be configured
  * through the attribute of this class.
  *
+ * Beyond the max distance, the channel would still deliver a 0 PSD signal
+ * to each receiver, which then processes it as any other signal. With the
+ * attribute SkipFarReceivers, ConfigureChannel() makes the channel drop such
+ * receivers before computing their PSD and before scheduling the reception.
+ *
  * \see ThreeGppSpectrumPropagationLossModel
  */
 class DistanceBasedThreeGppSpectrumPropagationLossModel : public ThreeGppSpectrumPropagationLossModel
@@ -64,6 +71,32 @@ public:
    */
   double GetMaxDistance () const;
 
+  /**
+   * \brief Let the channel skip the receivers beyond the max distance
+   *
+   * If the attribute SkipFarReceivers is true, append a
+   * RangePropagationLossModel (with MaxRange equal to the max distance) to
+   * the propagation loss chain of the channel, and set the channel
+   * MaxLossDb below the loss that such model gives out of range. The
+   * channel checks MaxLossDb for each receiver before applying this model
+   * and before scheduling the reception, so far receivers get nothing
+   * instead of a 0 PSD. The path loss trace of the channel reports them
+   * with a loss of 1000 dB. Otherwise, do nothing.
+   *
+   * Both changes outlive this model and are seen by the whole simulation.
+   * The propagation loss model of the channel is the one of the BWP, so the
+   * cut-off applies to every other user of that object: another channel
+   * that shares it, the REM helper, or a direct call to CalcRxPower. The
+   * lower MaxLossDb applies to every transmission of the channel, including
+   * those of devices that do not use this model.
+   *
+   * Called by the NrHelper when it creates the channel. The propagation
+   * loss model must already be in the channel.
+   *
+   * \param channel the channel that uses this model
+   */
+  void ConfigureChannel (const Ptr<SpectrumChannel> &channel);
+
   /**
    * \brief Computes the received PSD.
    *
@@ -87,6 +120,8 @@ public:
 private:
 
   double m_maxDistance {1000}; //!< the maximum distance of the nodes a and b in order to calcluate fast fading and the beamforming gain
+  bool m_skipFarReceivers {false}; //!< Let the channel skip receivers beyond m_maxDistance (attribute)
+  Ptr<RangePropagationLossModel> m_rangeModel; //!< Cut-off model in the channel loss chain, if any
 };
 } // namespace ns3
 